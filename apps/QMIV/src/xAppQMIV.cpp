@@ -94,6 +94,13 @@ usage::IV_specific ----------------------------------------------------------
  -unc  UnnoticeableCoef   IV-metric unnoticeable color difference threshold coeff
                           ("Lm:Cb:Cr:0" or "R:G:B:0" - per component coeff,
                           default="0.01:0.01:0.01:0", quotes are mandatory)
+ -iar  IVApproxRowStep    IV-PSNR approximate mode - search every N-th row only
+                          (optional, default=1 --> exact metric)
+ -ias  IVApproxSrchRange  IV-PSNR approximate mode - reduced search range
+                          (optional, default=0 --> same as SearchRange)
+                          (approximate mode reports deviation from exact metric caused by
+                          both row sampling and reduced search range, measured on 1/16 of
+                          rows searched exhaustively, not applicable to mask mode)
 
 usage::structural_similarity_specific ---------------------------------------
  -ssm  StructSimMode      (optional, default=BlockAveraged)
@@ -102,6 +109,20 @@ usage::structural_similarity_specific ---------------------------------------
                           [None, Nearest, Reflect, Mirror, Zero] (see scipy.ndimage.generic_filter)
  -sss  StructSimStride    (optional, default=4)
  -ssw  StructSimWindow    (optional, applies to Block modes only, default=8, [8,16,32])
+ -sse  StructSimSeparable Separable sliding window SSIM engine (flag, default disabled)
+                          (results differ within 1e-5, applies to Regular modes
+                          with StructSimStride=1)
+                          (if more than one SSIM metric is calculated, window statistics
+                          are shared between metrics by separable RegularGaussianFlt/Int
+                          and sub-block BlockAveraged engines only - statistics are not
+                          shared in default BlockAveraged 8x8/4 mode, in RegularAveraged
+                          mode and with StructSimFlt32 enabled)
+ -ssf  StructSimFlt32     Single precision SSIM engine (flag, default disabled)
+                          (results differ within 1e-5, applies to RegularGaussianFlt and
+                          RegularGaussianInt with StructSimStride=1 and to BlockAveraged
+                          when sub-block engine is selected - StructSimWindow>=4*StructSimStride
+                          and StructSimWindow being a multiple of StructSimStride,
+                          inactive in default BlockAveraged mode with 8x8 window and stride 4)
 
 usage::valiation ------------------------------------------------------------
  -ipa  InvalidPelActn     Select action taken if invalid pixel value is detected 
@@ -127,7 +148,10 @@ VerboseLevel:
   1 = 0 + configuration + detected frame numbers
   2 = 1 + argc/argv + frame level metric values
   3 = 2 + computing time (could slightly slow down computations)
-  4 = 3 + IV specific debug data (GlobalColorShift, R2T+T2R, NumNonMasked)
+  4 = 3 + IV specific debug data (GlobalColorShift, R2T+T2R, NumNonMasked,
+          displacement maps - IVPSNR search stores best match displacements,
+          SCP is generated from stored maps, maps are dumped to
+          DUMP_DISPMAP_{R2T,T2R}_WxH_16bps.yuv, packed as dy*256+(dx&0xFF))
   9 = stdout flood 
 
 -----------------------------------------------------------------------------
@@ -187,11 +211,15 @@ void xAppQMIV::registerCmdParams()
   m_CfgParser.addCmdParm("cws", "CmpWeightsSearch" , "", "CmpWeightsSearch"    );
   m_CfgParser.addCmdParm("cwa", "CmpWeightsAverage", "", "CmpWeightsAverage"   );
   m_CfgParser.addCmdParm("unc", "UnnoticeableCoef" , "", "UnnoticeableCoef"    );
+  m_CfgParser.addCmdParm("iar", "IVApproxRowStep"  , "", "IVApproxRowStep"     );
+  m_CfgParser.addCmdParm("ias", "IVApproxSrchRange", "", "IVApproxSrchRange"   );
   //ssim specific
   m_CfgParser.addCmdParm("ssm", "StructSimMode"    , "", "StructSimMode"       );
   m_CfgParser.addCmdParm("ssb", "StructSimBrdExt"  , "", "StructSimBrdExt"     );
   m_CfgParser.addCmdParm("sss", "StructSimStride"  , "", "StructSimStride"     );
   m_CfgParser.addCmdParm("ssw", "StructSimWindow"  , "", "StructSimWindow"     );
+  m_CfgParser.addCmdFlag("sse", "StructSimSeparable", "", "StructSimSeparable", "1");
+  m_CfgParser.addCmdFlag("ssf", "StructSimFlt32"   , "", "StructSimFlt32", "1");
   //validation 
   m_CfgParser.addCmdParm("ipa", "InvalidPelActn"   , "", "InvalidPelActn"      );
   m_CfgParser.addCmdParm("nma", "NameMismatchActn" , "", "NameMismatchActn"    );
@@ -321,6 +349,11 @@ bool xAppQMIV::readConfiguration()
   m_CmpWeightsAverage = xFmtScn::scanIntWeights(CmpWeightsAverageS);
   m_UnnoticeableCoef  = xFmtScn::scanFltWeights(UnnoticeableCoefS );
 
+  m_ApproxRowStep     = m_CfgParser.getParam1stArg("IVApproxRowStep"    , xIVPSNR::c_DefaultApproxRowStep);
+  m_ApproxSearchRange = m_CfgParser.getParam1stArg("IVApproxSrchRange"  , 0);
+  if(m_ApproxRowStep < 1) { m_ErrorLog += "!  IVApproxRowStep value must be greater than zero\n"; AnyError = true; }
+  if(m_ApproxSearchRange < 0 || m_ApproxSearchRange > m_SearchRange) { m_ErrorLog += "!  IVApproxSrchRange value must be in range 0-SearchRange\n"; AnyError = true; }
+
   //ssim specific -----------------------------------------------------------------------------------------------------
   m_StructSimMode = m_CfgParser.cvtParam1stArg("StructSimMode", xSSIM::c_DefaultStructSimMode, xSSIM::xStrToMode);
   if(m_StructSimMode == xSSIM::eMode::INVALID) { m_ErrorLog += "!  StructSimMode value is not valid\n"; AnyError = true; }  
@@ -330,6 +363,8 @@ bool xAppQMIV::readConfiguration()
   m_StructSimWindow = m_CfgParser.getParam1stArg("StructSimWindow", xSSIM::determineWindowSize(m_StructSimMode, xSSIM::c_DefaultStructSimWindow));
   if(m_StructSimStride < 1 || m_StructSimStride > m_StructSimWindow) { m_ErrorLog += "! StructSimStride must be in range 1-StructSimWindow\n"; AnyError = true; }
   if(xSSIM::isRegularMode(m_StructSimMode) && m_StructSimWindow != 11) { m_ErrorLog += "! In regular struct sim mode only StructSimWindow==11 is allowed\n"; AnyError = true; }
+  m_StructSimSeparable = m_CfgParser.getParam1stArg("StructSimSeparable", false);
+  m_StructSimFlt32  = m_CfgParser.getParam1stArg("StructSimFlt32", false);
 
   //validation --------------------------------------------------------------------------------------------------------
   m_InvalidPelActn   = m_CfgParser.cvtParam1stArg("InvalidPelActn"  , eActn::STOP, xStr2Actn);
@@ -342,13 +377,18 @@ bool xAppQMIV::readConfiguration()
   //derrived ----------------------------------------------------------------------------------------------------------  
   m_NumInputsCur = !m_UseMask ? 2 : 3;
   
-  m_CalcPSNRs    = getCalcMetric(eMetric::PSNR) || getCalcMetric(eMetric::WSPSNR) || getCalcMetric(eMetric::IVPSNR);
+  m_CalcPSNRs    = getCalcMetric(eMetric::MSE) || getCalcMetric(eMetric::PSNR) || getCalcMetric(eMetric::WSPSNR) || getCalcMetric(eMetric::IVPSNR);
   m_CalcSSIMs    = getCalcMetric(eMetric::SSIM) || getCalcMetric(eMetric::IVSSIM) || getCalcMetric(eMetric::MSSSIM) || getCalcMetric(eMetric::IVMSSSIM);
   m_CalcIVs      = getCalcMetric(eMetric::IVPSNR) || getCalcMetric(eMetric::IVSSIM) || getCalcMetric(eMetric::IVMSSSIM);
   m_CalcMSs      = getCalcMetric(eMetric::MSSSIM) || getCalcMetric(eMetric::IVMSSSIM);
   m_CalcSCP      = m_WriteSCP || getCalcMetric(eMetric::IVSSIM) || getCalcMetric(eMetric::IVMSSSIM);
   m_CalcGCD      = m_CalcIVs || m_CalcSCP;
-  m_UsePicI      = getCalcMetric(eMetric::IVPSNR) || m_CalcSCP || m_UseMask;
+  m_InterleavedPic = m_UseMask || !xCorrespPixelShift::c_VectorizedPlanar;
+  m_UsePicI      = m_InterleavedPic && (getCalcMetric(eMetric::IVPSNR) || m_CalcSCP || m_UseMask);
+  m_ApproxIV     = m_ApproxRowStep > 1 || (m_ApproxSearchRange > 0 && m_ApproxSearchRange < m_SearchRange);
+  m_UseDispMap   = getCalcMetric(eMetric::IVPSNR) && !m_ApproxIV && m_VerboseLevel >= 4;
+  m_FusedSCP     = getCalcMetric(eMetric::IVPSNR) && m_CalcSCP && !m_ApproxIV && !m_UseDispMap;
+  m_UseDiffStats = !m_UseMask && (getCalcMetric(eMetric::MSE) || getCalcMetric(eMetric::PSNR) || getCalcMetric(eMetric::WSPSNR) || m_CalcGCD);
 
   m_PicMargin    = xRoundUpToNearestMultiple(m_SearchRange, 2);
   m_WindowSize   = 2 * m_SearchRange + 1;
@@ -357,12 +397,15 @@ bool xAppQMIV::readConfiguration()
   m_PrintDebug   = m_VerboseLevel >= 4;
 
   //post-validation ---------------------------------------------------------------------------------------------------
-  if(m_UseMask && m_CalcSSIMs) { m_ErrorLog += "! Structural Similarity metrics cannot be combined with Mask mode\n"; AnyError = true; }
+  if(m_UseMask && m_ApproxIV ) { m_ErrorLog += "! IV-PSNR approximate mode cannot be combined with Mask mode\n"; AnyError = true; }
   if(m_FileFormat != eFileFmt::RAW && m_ColorSpaceInput != eClrSpcApp::RGB) { m_ErrorLog += fmt::format("! Input FileFormat={} contains data in RGB color space whitch conflicts with defined ColorSpaceInput={}\n", xFileFmt2Str(m_FileFormat), xClrSpcApp2Str(m_ColorSpaceInput)); AnyError = true; }
   if(m_FileFormat != eFileFmt::RAW && m_BitDepth != 8) { m_ErrorLog += fmt::format("! Input FileFormat={} contains 8-bit per pixel data whitch conflicts with defined BitDepth={}\n", xFileFmt2Str(m_FileFormat), m_BitDepth); AnyError = true; }
   if(m_UseMask && !xSSIM::isRegularMode(m_StructSimMode)) { m_ErrorLog += "! Mask mode requires regular SSIM mode\n"; AnyError = true; }
   if(m_UseMask && m_StructSimStride != 1) { m_ErrorLog += "! Mask mode requires StructSimStride=1\n"; AnyError = true; }
   if(m_UseMask && m_CalcMSs) { m_ErrorLog += "! MS-SSIM and IV-MS-SSIM does not support mask mode\n"; AnyError = true; }
+
+  //engine selection depends on mode, window and stride - selected early to allow reporting (reapplied in createProcessors)
+  if(!AnyError) { xSetStructSimEngines(); }
   
   return !AnyError;
 }
@@ -401,11 +444,16 @@ std::string xAppQMIV::formatConfiguration()
   Config += fmt::format("CmpWeightsSearch  = {}{}\n", xFmtScn::formatIntWeights(m_CmpWeightsSearch ), m_CmpWeightsSearch  == xCorrespPixelShiftPrms::c_DefaultCmpWeights ? "  (default)" : "  (custom)");
   Config += fmt::format("CmpWeightsAverage = {}{}\n", xFmtScn::formatIntWeights(m_CmpWeightsAverage), m_CmpWeightsAverage == xCorrespPixelShiftPrms::c_DefaultCmpWeights ? "  (default)" : "  (custom)");
   Config += fmt::format("UnnoticeableCoef  = {}{}\n", xFmtScn::formatFltWeights(m_UnnoticeableCoef ), m_UnnoticeableCoef  == xGlobClrDiffPrms      ::c_DefaultUnntcbCoef ? "  (default)" : "  (custom)");
+  Config += fmt::format("IVApproxRowStep   = {}{}\n", m_ApproxRowStep    , m_ApproxIV ? "  (approximate)" : "  (exact)");
+  Config += fmt::format("IVApproxSrchRange = {}{}\n", m_ApproxSearchRange, m_ApproxIV ? "  (approximate)" : "  (exact)");
   //ssim specific
   Config += fmt::format("StructSimMode     = {}\n", xSSIM::xModeToStr(m_StructSimMode));
   Config += fmt::format("StructSimBrdExt   = {}\n", xMrgExt2Str(m_StructSimBrdExt));
   Config += fmt::format("StructSimStride   = {}\n", m_StructSimStride);
   Config += fmt::format("StructSimWindow   = {}\n", m_StructSimWindow);
+  Config += fmt::format("StructSimSeparable= {:d}{}\n", m_StructSimSeparable, m_StructSimSeparable && !m_ProcSSIM.isSeparableActive() ? "  (inactive for selected mode)" : "");
+  Config += fmt::format("StructSimFlt32    = {:d}{}\n", m_StructSimFlt32, m_StructSimFlt32 && !m_ProcSSIM.isFlt32Active() ? "  (inactive for selected mode)" : "");
+  Config += fmt::format("StructSimMomCache = {:d}  (auto - statistics shared between SSIM metrics)\n", m_ProcSSIM.isMomentCacheActive());
   //validation 
   Config += fmt::format("InvalidPelActn    = {}\n", xActn2Str(m_InvalidPelActn  ));
   Config += fmt::format("NameMismatchActn  = {}\n", xActn2Str(m_NameMismatchActn));
@@ -464,6 +512,10 @@ std::string xAppQMIV::formatWarnings()
   {
     Warnings += fmt::format("CONFORMANCE WARNING: Software was executed with SearchRange different than default one. This leads to result different than expected for MPEG Common Test Conditions defined for immersive video. The default range is DefaultSearchRange={}.\n\n", xCorrespPixelShiftPrms::c_DefaultSearchRange);
   }
+  if(m_ApproxIV && getCalcMetric(eMetric::IVPSNR))
+  {
+    Warnings += fmt::format("CONFORMANCE WARNING: Software was executed with IV-PSNR approximate mode (IVApproxRowStep={}, IVApproxSrchRange={}). Reported IV-PSNR is an estimate and differs from the exact metric defined for MPEG Common Test Conditions for immersive video.\n\n", m_ApproxRowStep, m_ApproxSearchRange);
+  }
   if(xc_USE_RUNTIME_CMPWEIGHTS && m_CmpWeightsSearch != xCorrespPixelShiftPrms::c_DefaultCmpWeights)
   {
     Warnings += fmt::format("CONFORMANCE WARNING: Software was executed with CmpWeightsSearch different than default one. This leads to result different than expected for MPEG Common Test Conditions defined for immersive video. The default weights are DefaultCmpWeights={}.\n\n", xFmtScn::formatIntWeights(xCorrespPixelShiftPrms::c_DefaultCmpWeights));
@@ -488,6 +540,18 @@ std::string xAppQMIV::formatWarnings()
   {
     Warnings += fmt::format("CONFORMANCE WARNING: Software was executed with StructSimWindow different than default one. This leads to result different than expected for MPEG Common Test Conditions defined for immersive video. The default setting is StructSimWindow={}.\n\n", xSSIM::c_DefaultStructSimWindow);
   }
+  if(m_UseMask && (getCalcMetric(eMetric::SSIM) || getCalcMetric(eMetric::IVSSIM)))
+  {
+    Warnings += fmt::format("CONFORMANCE WARNING: Software was executed with SSIM or IV-SSIM in Mask mode. Masked structural similarity is averaged over non-masked samples only and is not defined for MPEG Common Test Conditions for immersive video. Results are not comparable with results of unmasked SSIM or IV-SSIM.\n\n");
+  }
+  if(m_ProcSSIM.isSeparableActive() && m_StructSimMode != xSSIM::eMode::RegularAveraged)
+  {
+    Warnings += fmt::format("CONFORMANCE WARNING: Software was executed with StructSimSeparable enabled. Separable engine uses double precision gaussian kernel, SSIM values may differ from window based ones in the 5th decimal place. The default setting is StructSimSeparable=0.\n\n");
+  }
+  if(m_ProcSSIM.isFlt32Active())
+  {
+    Warnings += fmt::format("CONFORMANCE WARNING: Software was executed with StructSimFlt32 enabled. SSIM and MS-SSIM values may differ from double precision ones in the 5th decimal place. The default setting is StructSimFlt32=0.\n\n");
+  }
 
   //SSIM notes
   if((m_StructSimMode != xSSIM::eMode::RegularGaussianFlt && m_StructSimMode != xSSIM::eMode::RegularGaussianInt) || m_StructSimStride != 1)
@@ -650,6 +714,9 @@ eAppRes xAppQMIV::setupSeqAndBuffs()
     }
   }
 
+  //displacement maps
+  if(m_UseDispMap) { for(int32 i = 0; i < NumInputsSeq; i++) { xDispMapUtils::createMap(&m_DispMap[i], m_PictureSize); } }
+
   return eAppRes::Good;
 }
 eAppRes xAppQMIV::ceaseSeqAndBuffs()
@@ -668,6 +735,8 @@ eAppRes xAppQMIV::ceaseSeqAndBuffs()
     for(int32 i = 0; i < NumInputsSeq; i++) { m_PicSCP[i].destroy(); }
     if(m_UsePicI) { for(int32 i = 0; i < NumInputsSeq; i++) { m_PicSCI[i].destroy(); } }
   }
+  //displacement maps
+  if(m_UseDispMap) { for(int32 i = 0; i < NumInputsSeq; i++) { m_DispMap[i].destroy(); } }
   //output sequences && buffers
   if(m_WriteSCP)
   {
@@ -683,6 +752,12 @@ void xAppQMIV::createProcessors()
   const int32 PictureWidth  = m_PictureSize.getX();
   const int32 PictureHeight = m_PictureSize.getY();
 
+  if(m_UseDiffStats)
+  {
+    QMIV_TRACE(3, "DiffStats");
+    m_DiffStats.bindThrdPoolIntf(&m_TPI);
+  }
+
   if(m_CalcGCD)
   {
     QMIV_TRACE(3, "ProcGCD");
@@ -706,6 +781,7 @@ void xAppQMIV::createProcessors()
     m_ProcPSNR.setCmpWeightsSearch (m_CmpWeightsSearch );
     m_ProcPSNR.setCmpWeightsAverage(m_CmpWeightsAverage);
     m_ProcPSNR.setUnntcbCoef       (m_UnnoticeableCoef );
+    m_ProcPSNR.setApproxMode       (m_ApproxRowStep, m_ApproxSearchRange);
     m_ProcPSNR.bindThrdPoolIntf    (&m_TPI             );
     m_ProcPSNR.initRowBuffers(PictureHeight);
     if(m_IsEquirectangular) { m_ProcPSNR.initWS(true, PictureWidth, PictureHeight, m_BitDepth, m_LonRangeDeg, m_LatRangeDeg); }
@@ -719,10 +795,15 @@ void xAppQMIV::createProcessors()
     m_ProcSSIM.setCmpWeightsSearch (m_CmpWeightsSearch );
     m_ProcSSIM.setCmpWeightsAverage(m_CmpWeightsAverage);
     m_ProcSSIM.setUnntcbCoef       (m_UnnoticeableCoef );
-    m_ProcSSIM.setStructSimParams  (m_StructSimMode, m_StructSimBrdExt, m_StructSimWindow, m_StructSimStride);
+    xSetStructSimEngines();
     m_ProcSSIM.bindThrdPoolIntf    (&m_TPI             );
     m_ProcSSIM.initRowBuffers(PictureHeight);
     if(m_IsEquirectangular) { m_ProcSSIM.initWS(true, PictureWidth, PictureHeight, m_BitDepth, m_LonRangeDeg, m_LatRangeDeg); }
+    if(getCalcMetric(eMetric::MSSSIM) && getCalcMetric(eMetric::IVMSSSIM)) //pyramids of Tst and Ref are reused between metrics
+    {
+      m_PyramidCache.create(m_PictureSize, m_BitDepth, m_PicMargin, xSSIM::xCalcNumScales(m_PictureSize));
+      m_ProcSSIM.setPyramidCache(&m_PyramidCache);
+    }
   }
 
   QMIV_TRACE(3, "initMetric");
@@ -739,15 +820,25 @@ void xAppQMIV::createProcessors()
   if(m_PrintDebug)
   {
     if(m_CalcPSNRs) { m_ProcPSNR.setDebugCallbackQAP([this](flt64 R2T, flt64 T2R) { m_LastR2T = R2T; m_LastT2R = T2R; }); }
+    if(m_CalcPSNRs) { m_ProcPSNR.setDebugCallbackEMP([this](int64 R2T, int64 T2R) { m_LastExactMatchR2T = R2T; m_LastExactMatchT2R = T2R; }); }
     if(m_CalcSSIMs) { m_ProcSSIM.setDebugCallbackQAP([this](flt64 R2T, flt64 T2R) { m_LastR2T = R2T; m_LastT2R = T2R; }); }
   }
 }
+void xAppQMIV::xSetStructSimEngines()
+{
+  m_ProcSSIM.setStructSimParams(m_StructSimMode, m_StructSimBrdExt, m_StructSimWindow, m_StructSimStride);
+  m_ProcSSIM.setUseSeparable   (m_StructSimSeparable);
+  m_ProcSSIM.setUseFlt32       (m_StructSimFlt32    );
+  const int32 NumStructSimMetrics = (int32)getCalcMetric(eMetric::SSIM) + (int32)getCalcMetric(eMetric::MSSSIM) + (int32)getCalcMetric(eMetric::IVSSIM) + (int32)getCalcMetric(eMetric::IVMSSSIM);
+  m_ProcSSIM.setUseMomentCache (NumStructSimMetrics > 1 && m_ProcSSIM.isMomentCacheUsable()); //statistics are reused between metrics
+}
 void xAppQMIV::destroyProcessors()
 {
   QMIV_TRACE(2, "");
   if(m_CalcSSIMs)
   {
     m_ProcSSIM.destroy();
+    m_PyramidCache.destroy();
   }
 }
 
@@ -785,7 +876,7 @@ eAppRes xAppQMIV::processAllFrames()
     uint64 T4 = m_GatherTime ? xTSC() : 0;
     if(m_CalcGCD) { calcFrameGCD(f); }
     uint64 T5 = m_GatherTime ? xTSC() : 0;
-    if(m_CalcSCP) { calcFrameSCP(f); }
+    if(m_CalcSCP && !m_FusedSCP && !m_UseDispMap) { calcFrameSCP(f); } //otherwise done within calcFrame__IVPSNR
     uint64 T6 = m_GatherTime ? xTSC() : 0;
     if(getCalcMetric(eMetric::MSE)) { calcFrame_____MSE(f); }
     uint64 T7 = m_GatherTime ? xTSC() : 0;
@@ -796,6 +887,7 @@ eAppRes xAppQMIV::processAllFrames()
     if(getCalcMetric(eMetric::IVPSNR)) { calcFrame__IVPSNR(f); }
     uint64 T10 = m_GatherTime ? xTSC() : 0;
     if(m_StructSimBrdExt != eMrgExt::None) { addStructSimMargs(f); }
+    if(m_CalcSSIMs) { m_ProcSSIM.invalidateMomentCache(); m_PyramidCache.invalidate(); } //new frame
     uint64 T11 = m_GatherTime ? xTSC() : 0;
     if(getCalcMetric(eMetric::SSIM)) { calcFrame____SSIM(f); }
     uint64 T12 = m_GatherTime ? xTSC() : 0;
@@ -891,9 +983,17 @@ void xAppQMIV::preprocessFrames(int32 /**/)
     }
   }
 
-  for(int32 CmpIdx = 0; CmpIdx < m_PicInP[0].getNumCmps(); CmpIdx++)
+  if(m_UseDiffStats) //exact components detected as side product
   {
-    m_ExactCmps[CmpIdx] = m_PicInP[0].equalCmp(&m_PicInP[1], (eCmp)CmpIdx);
+    m_DiffStats.calcPicDiffStats(&m_PicInP[0], &m_PicInP[1]);
+    m_ExactCmps = m_DiffStats.getExactCmps();
+  }
+  else
+  {
+    for(int32 CmpIdx = 0; CmpIdx < m_PicInP[0].getNumCmps(); CmpIdx++)
+    {
+      m_ExactCmps[CmpIdx] = m_PicInP[0].equalCmp(&m_PicInP[1], (eCmp)CmpIdx);
+    }
   }
 
   for(int32 i = 0; i < m_NumInputsCur; i++) { m_TPI.storeTask([this, i](int32) { m_PicInP[i].extend(); } ); }
@@ -928,7 +1028,7 @@ void xAppQMIV::calcFrameGCD(int32 FrameIdx)
 {
   QMIV_TRACE(3, "");
   if(m_UseMask) { m_GCD_R2T = m_ProcGCD.CalcGlobalColorDiffM(&m_PicInP[0], &m_PicInP[1], &m_PicInP[2], m_NumNonMasked); }
-  else          { m_GCD_R2T = m_ProcGCD.CalcGlobalColorDiff (&m_PicInP[0], &m_PicInP[1]                              ); }
+  else          { m_GCD_R2T = m_ProcGCD.CalcGlobalColorDiff (&m_DiffStats                                             ); }
   if(m_PrintDebug) { fmt::print("Frame {:08d} GCD-R2T {} {} {} {}\n", FrameIdx, m_GCD_R2T[0], m_GCD_R2T[1], m_GCD_R2T[2], m_GCD_R2T[3]); }
 }
 void xAppQMIV::calcFrameSCP(int32 /*FrameIdx*/)
@@ -946,12 +1046,39 @@ void xAppQMIV::calcFrameSCP(int32 /*FrameIdx*/)
     m_ProcSCP.GenShftCompPics(&m_PicSCP[1], &m_PicSCP[0], &m_PicInP[1], &m_PicInP[0], m_GCD_R2T);
   }
 }
+void xAppQMIV::dumpFrameDispMaps(int32 FrameIdx)
+{
+  QMIV_TRACE(3, "");
+  static const std::string DirNames[NumInputsSeq] = { "R2T", "T2R" };
+  xPlane<uint16> Dump(m_PictureSize, xDispMapUtils::c_BitDepth, 0);
+  for(int32 i = 0; i < NumInputsSeq; i++)
+  {
+    const xDispMap& Map = m_DispMap[i];
+    int64 NumZero = 0, SumAbsDX = 0, SumAbsDY = 0;
+    for(int32 y = 0; y < m_PictureSize.getY(); y++)
+    {
+      const int16* MapRow  = Map .getAddr() + y * Map .getStride();
+      uint16*      DumpRow = Dump.getAddr() + y * Dump.getStride();
+      for(int32 x = 0; x < m_PictureSize.getX(); x++)
+      {
+        const int16 Disp = MapRow[x];
+        NumZero  += Disp == 0;
+        SumAbsDX += xAbs(xDispMapUtils::getDX(Disp));
+        SumAbsDY += xAbs(xDispMapUtils::getDY(Disp));
+        DumpRow[x] = (uint16)Disp;
+      }
+    }
+    const flt64 InvArea = 1.0 / (flt64)m_PictureSize.getMul();
+    fmt::print("Frame {:08d} DispMap-{} ZeroDisp {:6.2f}%  AvgAbsDX {:6.3f}  AvgAbsDY {:6.3f}\n", FrameIdx, DirNames[i], 100.0 * NumZero * InvArea, SumAbsDX * InvArea, SumAbsDY * InvArea);
+    xSeq::dumpFrame(&Dump, fmt::format("DUMP_DISPMAP_{}_{}x{}_16bps.yuv", DirNames[i], m_PictureSize.getX(), m_PictureSize.getY()), eCrF::CF400, FrameIdx != 0);
+  }
+}
 void xAppQMIV::calcFrame_____MSE(int32 FrameIdx)
 {
   QMIV_TRACE(3, "");
   flt64V4 MSE  = xMakeVec4(0.0);
   if(m_UseMask) { MSE = m_ProcPSNR.calcPicMSEM(&m_PicInP[0], &m_PicInP[1], &m_PicInP[2], m_NumNonMasked); }
-  else          { MSE = m_ProcPSNR.calcPicMSE (&m_PicInP[0], &m_PicInP[1]                              ); }
+  else          { MSE = m_ProcPSNR.calcPicMSE (&m_DiffStats                                             ); }
   m_MetricData[(int32)eMetric::MSE].setPerCmpMeric(MSE, FrameIdx);
 
   if(m_PrintFrame)
@@ -969,7 +1096,7 @@ void xAppQMIV::calcFrame____PSNR(int32 FrameIdx)
   QMIV_TRACE(3, "");
   flt64V4 PSNR  = xMakeVec4(0.0);
   if(m_UseMask) { PSNR = m_ProcPSNR.calcPicPSNRM(&m_PicInP[0], &m_PicInP[1], &m_PicInP[2], m_NumNonMasked); }
-  else          { PSNR = m_ProcPSNR.calcPicPSNR (&m_PicInP[0], &m_PicInP[1]                              ); }
+  else          { PSNR = m_ProcPSNR.calcPicPSNR (&m_DiffStats                                             ); }
 
   for(int32 CmpIdx = 0; CmpIdx < 3; CmpIdx++)
   { 
@@ -997,7 +1124,7 @@ void xAppQMIV::calcFrame__WSPSNR(int32 FrameIdx)
   flt64V4 WSPSNR = xMakeVec4(0.0);
 
   if(m_UseMask) { WSPSNR = m_ProcPSNR.calcPicWSPSNRM(&m_PicInP[0], &m_PicInP[1], &m_PicInP[2], m_NumNonMasked); }
-  else          { WSPSNR = m_ProcPSNR.calcPicWSPSNR (&m_PicInP[0], &m_PicInP[1]                              ); }
+  else          { WSPSNR = m_ProcPSNR.calcPicWSPSNR (&m_DiffStats                                             ); }
 
   for(int32 CmpIdx = 0; CmpIdx < 3; CmpIdx++)
   {
@@ -1022,22 +1149,54 @@ void xAppQMIV::calcFrame__WSPSNR(int32 FrameIdx)
 void xAppQMIV::calcFrame__IVPSNR(int32 FrameIdx)
 {
   QMIV_TRACE(3, "");
+  //fused mode - single search generates both IVPSNR row distortions and SCP pictures
+  xPicI* ShftCompRefI = m_FusedSCP ? &m_PicSCI[1] : nullptr;
+  xPicI* ShftCompTstI = m_FusedSCP ? &m_PicSCI[0] : nullptr;
+  xPicP* ShftCompRefP = m_FusedSCP ? &m_PicSCP[1] : nullptr;
+  xPicP* ShftCompTstP = m_FusedSCP ? &m_PicSCP[0] : nullptr;
+
   flt64 IVPSNR = 0.0;
-  if(m_UseMask)
+  if(m_UseDispMap) //debug mode - single search generates IVPSNR row distortions and displacement maps, SCP pictures generated from maps
+  {
+    if     (m_UseMask       ) { IVPSNR = m_ProcPSNR.calcPicIVPSNRMAndGenDispMaps(&m_PicInI[0], &m_PicInI[1], &m_PicInP[2], m_NumNonMasked, m_GCD_R2T, &m_DispMap[0], &m_DispMap[1]); }
+    else if(m_InterleavedPic) { IVPSNR = m_ProcPSNR.calcPicIVPSNRAndGenDispMaps (&m_PicInI[0], &m_PicInI[1],                              m_GCD_R2T, &m_DispMap[0], &m_DispMap[1]); }
+    else                      { IVPSNR = m_ProcPSNR.calcPicIVPSNRAndGenDispMaps (&m_PicInP[0], &m_PicInP[1],                              m_GCD_R2T, &m_DispMap[0], &m_DispMap[1]); }
+    if(m_CalcSCP)
+    {
+      //masked search swaps roles of Tst and Ref --> R2T map describes Tst pixels searched within Ref
+      if     (m_UseMask       ) { m_ProcSCP.GenShftCompPicsFromDispMapsM(&m_PicSCI[1], &m_PicSCI[0], &m_PicInI[1], &m_PicInI[0], &m_PicInP[2], &m_DispMap[1], &m_DispMap[0], m_GCD_R2T); }
+      else if(m_InterleavedPic) { m_ProcSCP.GenShftCompPicsFromDispMaps (&m_PicSCI[1], &m_PicSCI[0], &m_PicInI[1], &m_PicInI[0],               &m_DispMap[0], &m_DispMap[1], m_GCD_R2T); }
+      else                      { m_ProcSCP.GenShftCompPicsFromDispMaps (&m_PicSCP[1], &m_PicSCP[0], &m_PicInP[1], &m_PicInP[0],               &m_DispMap[0], &m_DispMap[1], m_GCD_R2T); }
+    }
+    dumpFrameDispMaps(FrameIdx);
+  }
+  else if(m_UseMask)
   {
-    IVPSNR = m_ProcPSNR.calcPicIVPSNRM(&m_PicInI[0], &m_PicInI[1], &m_PicInP[2], m_NumNonMasked, m_GCD_R2T);
+    IVPSNR = m_ProcPSNR.calcPicIVPSNRM(&m_PicInI[0], &m_PicInI[1], &m_PicInP[2], m_NumNonMasked, m_GCD_R2T, ShftCompRefI, ShftCompTstI);
   }
   else
   {
-    if  (m_InterleavedPic) { IVPSNR = m_ProcPSNR.calcPicIVPSNR(&m_PicInI[0], &m_PicInI[1], m_GCD_R2T); }
-    else                   { IVPSNR = m_ProcPSNR.calcPicIVPSNR(&m_PicInP[0], &m_PicInP[1], m_GCD_R2T); }
+    if  (m_InterleavedPic) { IVPSNR = m_ProcPSNR.calcPicIVPSNR(&m_PicInI[0], &m_PicInI[1], m_GCD_R2T, ShftCompRefI, ShftCompTstI); }
+    else                   { IVPSNR = m_ProcPSNR.calcPicIVPSNR(&m_PicInP[0], &m_PicInP[1], m_GCD_R2T, ShftCompRefP, ShftCompTstP); }
+  }
+  if((m_FusedSCP || (m_UseDispMap && m_CalcSCP)) && m_InterleavedPic)
+  {
+    for(int32 i = 0; i < NumInputsSeq; i++) { m_TPI.storeTask([this, i](int32) { m_PicSCI[i].rearrangeToPlanar(&m_PicSCP[i]); }); }
+    m_TPI.executeStoredTasks();
   }
   m_MetricData[(int32)eMetric::IVPSNR].setPerPicMeric(IVPSNR, FrameIdx);
+  if(m_ApproxIV)
+  {
+    const flt64 Deviation = m_ProcPSNR.getLastApproxDeviation();
+    m_ApproxDeviationSum += Deviation;
+    m_ApproxDeviationMax  = xMax(m_ApproxDeviationMax, xAbs(Deviation));
+  }
 
   if(m_PrintFrame)
   {
     std::string Log = fmt::format("Frame {:08d} ", FrameIdx) + m_MetricData[(int32)eMetric::IVPSNR].formatPerPicMetric(FrameIdx);
-    if(m_PrintDebug) { Log += fmt::format("    R2T {:7.4f}  T2R {:7.4f}", m_LastR2T, m_LastT2R); }
+    if(m_ApproxIV  ) { Log += fmt::format("    ApproxDeviation {:+7.4f}", m_ProcPSNR.getLastApproxDeviation()); }
+    if(m_PrintDebug) { Log += fmt::format("    R2T {:7.4f}  T2R {:7.4f}    ExactMatch R2T {}  T2R {}", m_LastR2T, m_LastT2R, m_LastExactMatchR2T, m_LastExactMatchT2R); }
     fmt::print("{}\n", Log);
   }
 }
@@ -1045,7 +1204,7 @@ void xAppQMIV::calcFrame____SSIM(int32 FrameIdx)
 {
   QMIV_TRACE(3, "");
   flt64V4 SSIM = xMakeVec4(0.0);
-  if(m_UseMask){ SSIM = m_ProcSSIM.calcPicSSIMM(&m_PicInP[0], &m_PicInP[1], &m_PicInP[2], m_NumNonMasked); }
+  if(m_UseMask){ SSIM = m_ProcSSIM.calcPicSSIMM(&m_PicInP[0], &m_PicInP[1], &m_PicInP[2]); } //non-masked pixels are counted within evaluated SSIM area
   else         { SSIM = m_ProcSSIM.calcPicSSIM (&m_PicInP[0], &m_PicInP[1]                              ); }
   m_MetricData[(int32)eMetric::SSIM].setPerCmpMeric(SSIM, FrameIdx);
 
@@ -1059,7 +1218,7 @@ void xAppQMIV::calcFrame____SSIM(int32 FrameIdx)
   {
     xPlane<uint16> Vis(m_PictureSize, 8, 0);
     m_ProcSSIM.visualizeSSIM(&Vis, &m_PicInP[0], &m_PicInP[1], eCmp::C0);
-    xSeq::dumpFrame(&Vis, fmt::format("DUMP_SSIM_{}x{}_8bps.yuv", m_PictureSize.getX(), m_PictureSize.getY()), eCrF::CF420, FrameIdx == 0);
+    xSeq::dumpFrame(&Vis, fmt::format("DUMP_SSIM_{}x{}_8bps.yuv", m_PictureSize.getX(), m_PictureSize.getY()), eCrF::CF420, FrameIdx != 0);
   }
 }
 void xAppQMIV::calcFrame__MSSSIM(int32 FrameIdx)
@@ -1075,7 +1234,7 @@ void xAppQMIV::calcFrame__IVSSIM(int32 FrameIdx)
 {
   QMIV_TRACE(3, "");
   flt64 IVSSIM = 0.0;
-  if(m_UseMask) { IVSSIM = m_ProcSSIM.calcPicIVSSIMM(&m_PicInP[0], &m_PicInP[1], &m_PicSCP[0], &m_PicSCP[1], &m_PicInP[2], m_NumNonMasked); }
+  if(m_UseMask) { IVSSIM = m_ProcSSIM.calcPicIVSSIMM(&m_PicInP[0], &m_PicInP[1], &m_PicSCP[0], &m_PicSCP[1], &m_PicInP[2]); } //non-masked pixels are counted within evaluated SSIM area
   else          { IVSSIM = m_ProcSSIM.calcPicIVSSIM (&m_PicInP[0], &m_PicInP[1], &m_PicSCP[0], &m_PicSCP[1]                              ); }
   m_MetricData[(int32)eMetric::IVSSIM].setPerPicMeric(IVSSIM, FrameIdx);
 
@@ -1090,7 +1249,7 @@ void xAppQMIV::calcFrame__IVSSIM(int32 FrameIdx)
   {
     xPlane<uint16> Vis(m_PictureSize, 8, 0);
     m_ProcSSIM.visualizeIVSSIM(&Vis, &m_PicInP[0], &m_PicInP[1], &m_PicSCP[0], &m_PicSCP[1], eCmp::C0);
-    xSeq::dumpFrame(&Vis, fmt::format("DUMP_IVSSIM_{}x{}_8bps.yuv", m_PictureSize.getX(), m_PictureSize.getY()), eCrF::CF420, FrameIdx == 0);
+    xSeq::dumpFrame(&Vis, fmt::format("DUMP_IVSSIM_{}x{}_8bps.yuv", m_PictureSize.getX(), m_PictureSize.getY()), eCrF::CF420, FrameIdx != 0);
   }
 }
 void xAppQMIV::calcFrameIVMSSSIM(int32 FrameIdx)
@@ -1159,6 +1318,11 @@ std::string xAppQMIV::formatResultsStdOut()
     if(MD.getEnabled()) { Result += MD.formatAvgMetric("Average      ") + "\n"; }
   }
 
+  if(m_ApproxIV && getCalcMetric(eMetric::IVPSNR))
+  {
+    Result += fmt::format("\nApproximate IVPSNR deviation (row sampling and reduced search range, measured on 1/{} of rows)  avg {:+.4f} dB  max |{:.4f}| dB\n", xIVPSNR::c_DefaultApproxCheckStep, m_ApproxDeviationSum / m_NumFrames, m_ApproxDeviationMax);
+  }
+
   if(m_GatherTime)
   {
     tDurationMS AvgDuration____Load = tDurationMS((flt64)m_Ticks____Load * m_InvDurationDenominator);
@@ -1175,7 +1339,7 @@ std::string xAppQMIV::formatResultsStdOut()
     Result += fmt::format("AvgTime       PREPROC {:9.2f} ms\n", AvgDuration_Preproc.count());
     if(m_UsePicI) { Result += fmt::format("AvgTime     Rearrange {:9.2f} ms\n", AvgDuration_Arrange.count()); }
     if(m_CalcGCD) { Result += fmt::format("AvgTime           GCD {:9.2f} ms\n", AvgDuration_____GCD.count()); }
-    if(m_CalcSCP) { Result += fmt::format("AvgTime           SCP {:9.2f} ms\n", AvgDuration_____SCP.count()); }
+    if(m_CalcSCP) { Result += fmt::format("AvgTime           SCP {:9.2f} ms{}\n", AvgDuration_____SCP.count(), m_FusedSCP ? "  (fused with IVPSNR)" : m_UseDispMap ? "  (from IVPSNR displacement maps)" : ""); }
     if(m_StructSimBrdExt != eMrgExt::None) { Result += fmt::format("AvgTime        Margin {:9.2f} ms\n", AvgDuration__Margin.count()); }
     
     for(int32 m = 0; m < c_MetricsNum; m++)
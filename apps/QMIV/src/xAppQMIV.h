@@ -75,18 +75,21 @@ public:
   int32V4     m_CmpWeightsSearch ;
   int32V4     m_CmpWeightsAverage;
   flt32V4     m_UnnoticeableCoef ;
+  int32       m_ApproxRowStep    ;
+  int32       m_ApproxSearchRange;
   //ssim specific
   xSSIM::eMode m_StructSimMode  ;
   eMrgExt      m_StructSimBrdExt;
   int32        m_StructSimStride;
   int32        m_StructSimWindow;
+  bool         m_StructSimSeparable;
+  bool         m_StructSimFlt32 ;
   //validation 
   eActn       m_InvalidPelActn;
   eActn       m_NameMismatchActn;
   //operation
   int32       m_NumberOfThreads;
   int32       m_VerboseLevel;
-  bool        m_InterleavedPic = true ;
   bool        m_DebugDump      = false;
   //derrived
   bool        m_UseMask;
@@ -103,6 +106,11 @@ public:
   bool        m_CalcMSs;
   bool        m_CalcGCD;
   bool        m_CalcSCP;
+  bool        m_FusedSCP; //SCP generated within IVPSNR search
+  bool        m_UseDispMap; //IVPSNR search generates displacement maps (debug), SCP generated from maps
+  bool        m_UseDiffStats; //single pass difference statistics shared by MSE, PSNR, WSPSNR, GCD and exact components detection
+  bool        m_ApproxIV; //approximate IV-PSNR (subsampled rows or reduced search range)
+  bool        m_InterleavedPic; //search on interleaved pictures (planar search is not vectorized or mask is used)
   bool        m_UsePicI;
   int32       m_PicMargin;
   int32       m_WindowSize;
@@ -127,14 +135,17 @@ protected:
   std::array<xPicI   , NumInputsSeq> m_PicInI ; //0=Tst,1=Ref
   std::array<xPicP   , NumInputsSeq> m_PicSCP ; //0=Tst,1=Ref
   std::array<xPicI   , NumInputsSeq> m_PicSCI ; //0=Tst,1=Ref
+  std::array<xDispMap, NumInputsSeq> m_DispMap; //0=R2T,1=T2R
   std::array<xPicP   , NumOutputMax> m_PicOutP; //0=Tst,1=Ref 
   std::array<xSeq    , NumInputsMax> m_SeqOut ; //0=Tst,1=Ref,2=Msk
 
   //processors
+  xDiffStats       m_DiffStats;
   xGlobClrDiffProc m_ProcGCD;
   xShftCompPicProc m_ProcSCP;
   xIVPSNRM         m_ProcPSNR;
   xIVSSIM          m_ProcSSIM;
+  xStructSimPyramidCache m_PyramidCache; //MS-SSIM pyramids of source pictures shared by MSSSIM and IVMSSSIM
 
   //intermediates
   boolV4  m_ExactCmps    = xMakeVec4<bool>(false);
@@ -144,6 +155,12 @@ protected:
   //debug data
   flt64   m_LastR2T = 0;
   flt64   m_LastT2R = 0;
+  int64   m_LastExactMatchR2T = 0;
+  int64   m_LastExactMatchT2R = 0;
+
+  //approximate IV-PSNR deviation stats
+  flt64   m_ApproxDeviationSum = 0;
+  flt64   m_ApproxDeviationMax = 0;
   
 
   //merics data & stats
@@ -188,6 +205,7 @@ public:
   void        addStructSimMargs(int32 FrameIdx);
   void        calcFrameGCD     (int32 FrameIdx);
   void        calcFrameSCP     (int32 FrameIdx);
+  void        dumpFrameDispMaps(int32 FrameIdx);
   void        calcFrame_____MSE(int32 FrameIdx);
   void        calcFrame____PSNR(int32 FrameIdx);
   void        calcFrame__WSPSNR(int32 FrameIdx);
@@ -203,6 +221,9 @@ public:
   std::string formatResultsStdOut();
   std::string formatResultsFile  ();
 
+protected:
+  void        xSetStructSimEngines(); //mode, window, stride and optional engines
+
 public:
   const std::string& getErrorLog() { return m_ErrorLog; }
   int32 getVerboseLevel() { return m_VerboseLevel; }
@@ -56,39 +56,53 @@ public:
   static inline  int64 CalcSD (const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionAVX512::CalcSD (Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
   static inline uint64 CalcSAD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionAVX512::CalcSAD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
   static inline uint64 CalcSSD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionAVX512::CalcSSD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
+  static inline tSDSSD CalcSDSSD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionAVX512::CalcSDSSD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
+  static inline  int64 CalcWeightedSD (const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height) { return xDistortionAVX512::CalcWeightedSD (Tst, Ref, Mask, TstStride, RefStride, MskStride, Width,  Height); }
+  static inline uint64 CalcWeightedSSD(const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height) { return xDistortionAVX512::CalcWeightedSSD(Tst, Ref, Mask, TstStride, RefStride, MskStride, Width,  Height); }
 
 #elif X_CAN_USE_AVX
 
   static inline  int64 CalcSD (const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionAVX::CalcSD (Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
   static inline uint64 CalcSAD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionAVX::CalcSAD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
   static inline uint64 CalcSSD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionAVX::CalcSSD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
+  static inline tSDSSD CalcSDSSD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionAVX::CalcSDSSD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
+  static inline  int64 CalcWeightedSD (const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height) { return xDistortionAVX::CalcWeightedSD (Tst, Ref, Mask, TstStride, RefStride, MskStride, Width,  Height); }
+  static inline uint64 CalcWeightedSSD(const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height) { return xDistortionAVX::CalcWeightedSSD(Tst, Ref, Mask, TstStride, RefStride, MskStride, Width,  Height); }
 
 #elif X_CAN_USE_SSE
 
   static inline  int64 CalcSD (const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionSSE::CalcSD (Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
   static inline uint64 CalcSAD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionSSE::CalcSAD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
   static inline uint64 CalcSSD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionSSE::CalcSSD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
+  static inline tSDSSD CalcSDSSD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionSSE::CalcSDSSD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
+  //SSE weighted kernels (no 32x32-->64 bit multiply of all lanes) are slower than autovectorized STD code
+  static inline  int64 CalcWeightedSD (const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height) { return xDistortionSTD::CalcWeightedSD (Tst, Ref, Mask, TstStride, RefStride, MskStride, Width,  Height); }
+  static inline uint64 CalcWeightedSSD(const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height) { return xDistortionSTD::CalcWeightedSSD(Tst, Ref, Mask, TstStride, RefStride, MskStride, Width,  Height); }
 
 #elif X_CAN_USE_NEON
 
   static inline  int32 CalcSD (const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionNEON::CalcSD (Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
   static inline uint32 CalcSAD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionNEON::CalcSAD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
   static inline uint64 CalcSSD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionNEON::CalcSSD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
+  static inline tSDSSD CalcSDSSD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionSTD ::CalcSDSSD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
+  static inline  int64 CalcWeightedSD (const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height) { return xDistortionSTD::CalcWeightedSD (Tst, Ref, Mask, TstStride, RefStride, MskStride, Width,  Height); }
+  static inline uint64 CalcWeightedSSD(const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height) { return xDistortionSTD::CalcWeightedSSD(Tst, Ref, Mask, TstStride, RefStride, MskStride, Width,  Height); }
 
 #else
 
   static inline  int64 CalcSD (const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionSTD::CalcSD (Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
   static inline uint64 CalcSAD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionSTD::CalcSAD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
   static inline uint64 CalcSSD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionSTD::CalcSSD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
+  static inline tSDSSD CalcSDSSD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return xDistortionSTD::CalcSDSSD(Tst, Ref, TstStride, RefStride, Width, Height, BitDepth); }
+  static inline  int64 CalcWeightedSD (const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height) { return xDistortionSTD::CalcWeightedSD (Tst, Ref, Mask, TstStride, RefStride, MskStride, Width,  Height); }
+  static inline uint64 CalcWeightedSSD(const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height) { return xDistortionSTD::CalcWeightedSSD(Tst, Ref, Mask, TstStride, RefStride, MskStride, Width,  Height); }
 
 #endif
 
   static inline  int64 CalcSD (const uint16* Tst, const uint16* Ref, int32 Area, int32 BitDepth) { return CalcSD (Tst, Ref, NOT_VALID, NOT_VALID, Area, 1, BitDepth); }
   static inline uint64 CalcSAD(const uint16* Tst, const uint16* Ref, int32 Area, int32 BitDepth) { return CalcSAD(Tst, Ref, NOT_VALID, NOT_VALID, Area, 1, BitDepth); }
   static inline uint64 CalcSSD(const uint16* Tst, const uint16* Ref, int32 Area, int32 BitDepth) { return CalcSSD(Tst, Ref, NOT_VALID, NOT_VALID, Area, 1, BitDepth); }
-
-  static inline  int64 CalcWeightedSD (const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height) { return xDistortionSTD::CalcWeightedSD (Tst, Ref, Mask, TstStride, RefStride, MskStride, Width,  Height); }
-  static inline uint64 CalcWeightedSSD(const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height) { return xDistortionSTD::CalcWeightedSSD(Tst, Ref, Mask, TstStride, RefStride, MskStride, Width,  Height); }
+  static inline tSDSSD CalcSDSSD(const uint16* Tst, const uint16* Ref, int32 Area, int32 BitDepth) { return CalcSDSSD(Tst, Ref, NOT_VALID, NOT_VALID, Area, 1, BitDepth); }
 
   static inline  int64 CalcWeightedSD (const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 Area) { return CalcWeightedSD (Tst, Ref, Mask, NOT_VALID, NOT_VALID, NOT_VALID, Area, 1); }
   static inline uint64 CalcWeightedSSD(const uint16* Tst, const uint16* Ref, const uint16* Mask, int32 Area) { return CalcWeightedSSD(Tst, Ref, Mask, NOT_VALID, NOT_VALID, NOT_VALID, Area, 1); }
@@ -357,6 +357,103 @@ uint64 xDistortionAVX::CalcSSD14(const uint16* restrict Tst, const uint16* restr
     return SSD;
   }
 }
+tSDSSD xDistortionAVX::CalcSDSSD14(const uint16* restrict Tst, const uint16* restrict Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height)
+{
+  const int32   Width16  = (int32)((uint32)Width & c_MultipleMask16<uint32>);
+  const __m256i One_I16V = _mm256_set1_epi16(1);
+  int64   SD           = 0;
+  uint64  SSD          = 0;
+  __m256i SD_I64_V256  = _mm256_setzero_si256();
+  __m256i SSD_U64_V256 = _mm256_setzero_si256();
+
+  for(int32 y=0; y<Height; y++)
+  {
+    for(int32 x=0; x<Width16; x+=16)
+    {
+      __m256i Tst_U16V   = _mm256_loadu_si256((__m256i*) & Tst[x]);
+      __m256i Ref_U16V   = _mm256_loadu_si256((__m256i*) & Ref[x]);
+      __m256i Diff_I16V  = _mm256_sub_epi16     (Tst_U16V, Ref_U16V);
+      __m256i SumD_I32V  = _mm256_madd_epi16    (Diff_I16V, One_I16V );
+      __m256i PowD_U32V  = _mm256_madd_epi16    (Diff_I16V, Diff_I16V);
+      __m256i SumD_I64V  = _mm256_add_epi64     (_mm256_cvtepi32_epi64(_mm256_castsi256_si128(SumD_I32V)), _mm256_cvtepi32_epi64(_mm256_extracti128_si256(SumD_I32V, 1)));
+      __m256i SumP_U64V  = _mm256_add_epi64     (_mm256_unpacklo_epi32(PowD_U32V, _mm256_setzero_si256()), _mm256_unpackhi_epi32(PowD_U32V, _mm256_setzero_si256()));
+      SD_I64_V256        = _mm256_add_epi64     (SD_I64_V256 , SumD_I64V);
+      SSD_U64_V256       = _mm256_add_epi64     (SSD_U64_V256, SumP_U64V);
+    } //x
+    for(int32 x=Width16; x<Width; x++)
+    {
+      int32 D = (int32)Tst[x] - (int32)Ref[x];
+      SD  += D;
+      SSD += xPow2(D);
+    }
+    Tst += TstStride;
+    Ref += RefStride;
+  } //y
+  SD  += xHorVecSumI64_epi64(SD_I64_V256 );
+  SSD += xHorVecSumI64_epi64(SSD_U64_V256);
+  return { SD, SSD };
+}
+int64 xDistortionAVX::CalcWeightedSD(const uint16* restrict Tst, const uint16* restrict Ref, const uint16* restrict Msk, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height)
+{
+  const int32 Width16 = (int32)((uint32)Width & c_MultipleMask16<uint32>);
+  int64   SD          = 0;
+  __m256i SD_I64_V256 = _mm256_setzero_si256();
+
+  for(int32 y=0; y<Height; y++)
+  {
+    for(int32 x=0; x<Width16; x+=16)
+    {
+      __m256i Tst_U16V   = _mm256_loadu_si256((__m256i*) & Tst[x]);
+      __m256i Ref_U16V   = _mm256_loadu_si256((__m256i*) & Ref[x]);
+      __m256i Msk_U16V   = _mm256_loadu_si256((__m256i*) & Msk[x]);
+      __m256i DiffL_I32V = _mm256_sub_epi32     (_mm256_unpacklo_epi16(Tst_U16V, _mm256_setzero_si256()), _mm256_unpacklo_epi16(Ref_U16V, _mm256_setzero_si256()));
+      __m256i DiffH_I32V = _mm256_sub_epi32     (_mm256_unpackhi_epi16(Tst_U16V, _mm256_setzero_si256()), _mm256_unpackhi_epi16(Ref_U16V, _mm256_setzero_si256()));
+      __m256i MskL_I32V  = _mm256_unpacklo_epi16(Msk_U16V, _mm256_setzero_si256());
+      __m256i MskH_I32V  = _mm256_unpackhi_epi16(Msk_U16V, _mm256_setzero_si256());
+      //32x32-->64 bit products of even and odd lanes (product of 17bit signed difference and 16bit mask does not fit int32)
+      __m256i SumL_I64V  = _mm256_add_epi64(_mm256_mul_epi32(DiffL_I32V, MskL_I32V), _mm256_mul_epi32(_mm256_srli_epi64(DiffL_I32V, 32), _mm256_srli_epi64(MskL_I32V, 32)));
+      __m256i SumH_I64V  = _mm256_add_epi64(_mm256_mul_epi32(DiffH_I32V, MskH_I32V), _mm256_mul_epi32(_mm256_srli_epi64(DiffH_I32V, 32), _mm256_srli_epi64(MskH_I32V, 32)));
+      SD_I64_V256        = _mm256_add_epi64(SD_I64_V256, _mm256_add_epi64(SumL_I64V, SumH_I64V));
+    } //x
+    for(int32 x=Width16; x<Width; x++) { SD += (int64)((int32)Tst[x] - (int32)Ref[x]) * (int64)Msk[x]; }
+    Tst += TstStride;
+    Ref += RefStride;
+    Msk += MskStride;
+  } //y
+  SD += xHorVecSumI64_epi64(SD_I64_V256);
+  return SD;
+}
+uint64 xDistortionAVX::CalcWeightedSSD(const uint16* restrict Tst, const uint16* restrict Ref, const uint16* restrict Msk, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height)
+{
+  const int32 Width16 = (int32)((uint32)Width & c_MultipleMask16<uint32>);
+  uint64  SSD          = 0;
+  __m256i SSD_U64_V256 = _mm256_setzero_si256();
+
+  for(int32 y=0; y<Height; y++)
+  {
+    for(int32 x=0; x<Width16; x+=16)
+    {
+      __m256i Tst_U16V   = _mm256_loadu_si256((__m256i*) & Tst[x]);
+      __m256i Ref_U16V   = _mm256_loadu_si256((__m256i*) & Ref[x]);
+      __m256i Msk_U16V   = _mm256_loadu_si256((__m256i*) & Msk[x]);
+      __m256i DiffL_I32V = _mm256_sub_epi32     (_mm256_unpacklo_epi16(Tst_U16V, _mm256_setzero_si256()), _mm256_unpacklo_epi16(Ref_U16V, _mm256_setzero_si256()));
+      __m256i DiffH_I32V = _mm256_sub_epi32     (_mm256_unpackhi_epi16(Tst_U16V, _mm256_setzero_si256()), _mm256_unpackhi_epi16(Ref_U16V, _mm256_setzero_si256()));
+      __m256i PowL_U32V  = _mm256_mullo_epi32   (DiffL_I32V, DiffL_I32V); //squared 17bit signed difference fits uint32
+      __m256i PowH_U32V  = _mm256_mullo_epi32   (DiffH_I32V, DiffH_I32V);
+      __m256i MskL_U32V  = _mm256_unpacklo_epi16(Msk_U16V, _mm256_setzero_si256());
+      __m256i MskH_U32V  = _mm256_unpackhi_epi16(Msk_U16V, _mm256_setzero_si256());
+      __m256i SumL_U64V  = _mm256_add_epi64(_mm256_mul_epu32(PowL_U32V, MskL_U32V), _mm256_mul_epu32(_mm256_srli_epi64(PowL_U32V, 32), _mm256_srli_epi64(MskL_U32V, 32)));
+      __m256i SumH_U64V  = _mm256_add_epi64(_mm256_mul_epu32(PowH_U32V, MskH_U32V), _mm256_mul_epu32(_mm256_srli_epi64(PowH_U32V, 32), _mm256_srli_epi64(MskH_U32V, 32)));
+      SSD_U64_V256       = _mm256_add_epi64(SSD_U64_V256, _mm256_add_epi64(SumL_U64V, SumH_U64V));
+    } //x
+    for(int32 x=Width16; x<Width; x++) { SSD += (uint64)xPow2((int64)Tst[x] - (int64)Ref[x]) * (uint64)Msk[x]; }
+    Tst += TstStride;
+    Ref += RefStride;
+    Msk += MskStride;
+  } //y
+  SSD += xHorVecSumI64_epi64(SSD_U64_V256);
+  return SSD;
+}
 
 //===============================================================================================================================================================================================================
 
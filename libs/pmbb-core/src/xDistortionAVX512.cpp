@@ -254,6 +254,114 @@ uint64 xDistortionAVX512::CalcSSD14(const uint16* restrict Tst, const uint16* re
   uint64 SSD = xHorVecSumI64_epi64(SSD_I64V);
   return SSD;
 }
+tSDSSD xDistortionAVX512::CalcSDSSD14(const uint16* restrict Tst, const uint16* restrict Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height)
+{
+  const int32     Width32  = (int32)((uint32)Width & c_MultipleMask32<uint32>);
+  const uint32    Remain32 = (uint32)Width & c_RemainderMask32<uint32>;
+  const __mmask32 Mask     = ((uint32)1 << Remain32) - 1;
+  const __m512i   One_I16V = _mm512_set1_epi16(1);
+  __m512i SD_I64V  = _mm512_setzero_si512();
+  __m512i SSD_I64V = _mm512_setzero_si512();
+
+  auto Accumulate = [&](const __m512i& Tst_U16V, const __m512i& Ref_U16V)
+  {
+    __m512i Diff_I16V = _mm512_sub_epi16 (Tst_U16V , Ref_U16V);
+    __m512i SumD_I32V = _mm512_madd_epi16(Diff_I16V, One_I16V);
+    __m512i Pow_I32V  = _mm512_madd_epi16(Diff_I16V, Diff_I16V);
+    __m512i SumD_I64V = _mm512_add_epi64 (_mm512_cvtepi32_epi64(_mm512_castsi512_si256(SumD_I32V)), _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(SumD_I32V, 1)));
+    __m512i Sum_I64V  = _mm512_add_epi64 (_mm512_unpacklo_epi32(Pow_I32V, _mm512_setzero_si512()), _mm512_unpackhi_epi32(Pow_I32V, _mm512_setzero_si512()));
+    SD_I64V           = _mm512_add_epi64 (SD_I64V , SumD_I64V);
+    SSD_I64V          = _mm512_add_epi64 (SSD_I64V, Sum_I64V );
+  };
+
+  for(int32 y=0; y<Height; y++)
+  {
+    for(int32 x=0; x<Width32; x+=32)
+    {
+      Accumulate(_mm512_loadu_si512((__m512i*) & Tst[x]), _mm512_loadu_si512((__m512i*) & Ref[x]));
+    } //x
+    if(Remain32) //tail - masked pixels give zero difference
+    {
+      Accumulate(_mm512_maskz_loadu_epi16(Mask, (__m512i*) & Tst[Width32]), _mm512_maskz_loadu_epi16(Mask, (__m512i*) & Ref[Width32]));
+    }
+    Tst += TstStride;
+    Ref += RefStride;
+  } //y
+  int64  SD  = xHorVecSumI64_epi64(SD_I64V );
+  uint64 SSD = xHorVecSumI64_epi64(SSD_I64V);
+  return { SD, SSD };
+}
+int64 xDistortionAVX512::CalcWeightedSD(const uint16* restrict Tst, const uint16* restrict Ref, const uint16* restrict Msk, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height)
+{
+  const int32     Width32  = (int32)((uint32)Width & c_MultipleMask32<uint32>);
+  const uint32    Remain32 = (uint32)Width & c_RemainderMask32<uint32>;
+  const __mmask32 Mask     = ((uint32)1 << Remain32) - 1;
+  __m512i SD_I64V = _mm512_setzero_si512();
+
+  auto Accumulate = [&](const __m512i& Tst_U16V, const __m512i& Ref_U16V, const __m512i& Msk_U16V)
+  {
+    __m512i DiffL_I32V = _mm512_sub_epi32     (_mm512_unpacklo_epi16(Tst_U16V, _mm512_setzero_si512()), _mm512_unpacklo_epi16(Ref_U16V, _mm512_setzero_si512()));
+    __m512i DiffH_I32V = _mm512_sub_epi32     (_mm512_unpackhi_epi16(Tst_U16V, _mm512_setzero_si512()), _mm512_unpackhi_epi16(Ref_U16V, _mm512_setzero_si512()));
+    __m512i MskL_I32V  = _mm512_unpacklo_epi16(Msk_U16V, _mm512_setzero_si512());
+    __m512i MskH_I32V  = _mm512_unpackhi_epi16(Msk_U16V, _mm512_setzero_si512());
+    //32x32-->64 bit products of even and odd lanes (product of 17bit signed difference and 16bit mask does not fit int32)
+    __m512i SumL_I64V  = _mm512_add_epi64(_mm512_mul_epi32(DiffL_I32V, MskL_I32V), _mm512_mul_epi32(_mm512_srli_epi64(DiffL_I32V, 32), _mm512_srli_epi64(MskL_I32V, 32)));
+    __m512i SumH_I64V  = _mm512_add_epi64(_mm512_mul_epi32(DiffH_I32V, MskH_I32V), _mm512_mul_epi32(_mm512_srli_epi64(DiffH_I32V, 32), _mm512_srli_epi64(MskH_I32V, 32)));
+    SD_I64V            = _mm512_add_epi64(SD_I64V, _mm512_add_epi64(SumL_I64V, SumH_I64V));
+  };
+
+  for(int32 y=0; y<Height; y++)
+  {
+    for(int32 x=0; x<Width32; x+=32)
+    {
+      Accumulate(_mm512_loadu_si512((__m512i*) & Tst[x]), _mm512_loadu_si512((__m512i*) & Ref[x]), _mm512_loadu_si512((__m512i*) & Msk[x]));
+    } //x
+    if(Remain32) //masked out pixels gives zero difference and zero weight
+    {
+      Accumulate(_mm512_maskz_loadu_epi16(Mask, (__m512i*) & Tst[Width32]), _mm512_maskz_loadu_epi16(Mask, (__m512i*) & Ref[Width32]), _mm512_maskz_loadu_epi16(Mask, (__m512i*) & Msk[Width32]));
+    }
+    Tst += TstStride;
+    Ref += RefStride;
+    Msk += MskStride;
+  } //y
+  return xHorVecSumI64_epi64(SD_I64V);
+}
+uint64 xDistortionAVX512::CalcWeightedSSD(const uint16* restrict Tst, const uint16* restrict Ref, const uint16* restrict Msk, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height)
+{
+  const int32     Width32  = (int32)((uint32)Width & c_MultipleMask32<uint32>);
+  const uint32    Remain32 = (uint32)Width & c_RemainderMask32<uint32>;
+  const __mmask32 Mask     = ((uint32)1 << Remain32) - 1;
+  __m512i SSD_U64V = _mm512_setzero_si512();
+
+  auto Accumulate = [&](const __m512i& Tst_U16V, const __m512i& Ref_U16V, const __m512i& Msk_U16V)
+  {
+    __m512i DiffL_I32V = _mm512_sub_epi32     (_mm512_unpacklo_epi16(Tst_U16V, _mm512_setzero_si512()), _mm512_unpacklo_epi16(Ref_U16V, _mm512_setzero_si512()));
+    __m512i DiffH_I32V = _mm512_sub_epi32     (_mm512_unpackhi_epi16(Tst_U16V, _mm512_setzero_si512()), _mm512_unpackhi_epi16(Ref_U16V, _mm512_setzero_si512()));
+    __m512i PowL_U32V  = _mm512_mullo_epi32   (DiffL_I32V, DiffL_I32V); //squared 17bit signed difference fits uint32
+    __m512i PowH_U32V  = _mm512_mullo_epi32   (DiffH_I32V, DiffH_I32V);
+    __m512i MskL_U32V  = _mm512_unpacklo_epi16(Msk_U16V, _mm512_setzero_si512());
+    __m512i MskH_U32V  = _mm512_unpackhi_epi16(Msk_U16V, _mm512_setzero_si512());
+    __m512i SumL_U64V  = _mm512_add_epi64(_mm512_mul_epu32(PowL_U32V, MskL_U32V), _mm512_mul_epu32(_mm512_srli_epi64(PowL_U32V, 32), _mm512_srli_epi64(MskL_U32V, 32)));
+    __m512i SumH_U64V  = _mm512_add_epi64(_mm512_mul_epu32(PowH_U32V, MskH_U32V), _mm512_mul_epu32(_mm512_srli_epi64(PowH_U32V, 32), _mm512_srli_epi64(MskH_U32V, 32)));
+    SSD_U64V           = _mm512_add_epi64(SSD_U64V, _mm512_add_epi64(SumL_U64V, SumH_U64V));
+  };
+
+  for(int32 y=0; y<Height; y++)
+  {
+    for(int32 x=0; x<Width32; x+=32)
+    {
+      Accumulate(_mm512_loadu_si512((__m512i*) & Tst[x]), _mm512_loadu_si512((__m512i*) & Ref[x]), _mm512_loadu_si512((__m512i*) & Msk[x]));
+    } //x
+    if(Remain32) //masked out pixels gives zero difference and zero weight
+    {
+      Accumulate(_mm512_maskz_loadu_epi16(Mask, (__m512i*) & Tst[Width32]), _mm512_maskz_loadu_epi16(Mask, (__m512i*) & Ref[Width32]), _mm512_maskz_loadu_epi16(Mask, (__m512i*) & Msk[Width32]));
+    }
+    Tst += TstStride;
+    Ref += RefStride;
+    Msk += MskStride;
+  } //y
+  return (uint64)xHorVecSumI64_epi64(SSD_U64V);
+}
 
 //===============================================================================================================================================================================================================
 
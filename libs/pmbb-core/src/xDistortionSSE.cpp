@@ -286,6 +286,42 @@ uint64 xDistortionSSE::CalcSSD14(const uint16* restrict Tst, const uint16* restr
     return SSD;
   }  
 }
+tSDSSD xDistortionSSE::CalcSDSSD14(const uint16* restrict Tst, const uint16* restrict Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height)
+{
+  const int32   Width8   = (int32)((uint32)Width & c_MultipleMask8<uint32>);
+  const __m128i One_I16V = _mm_set1_epi16(1);
+  int64   SD       = 0;
+  uint64  SSD      = 0;
+  __m128i SD_I64V  = _mm_setzero_si128();
+  __m128i SSD_U64V = _mm_setzero_si128();
+
+  for(int32 y=0; y<Height; y++)
+  {
+    for(int32 x=0; x<Width8; x+=8)
+    {
+      __m128i Tst_U16V  = _mm_loadu_si128((__m128i*) & Tst[x]);
+      __m128i Ref_U16V  = _mm_loadu_si128((__m128i*) & Ref[x]);
+      __m128i Diff_I16V = _mm_sub_epi16     (Tst_U16V, Ref_U16V);
+      __m128i SumD_I32V = _mm_madd_epi16    (Diff_I16V, One_I16V );
+      __m128i Pow_U32V  = _mm_madd_epi16    (Diff_I16V, Diff_I16V);
+      __m128i SumD_I64V = _mm_add_epi64     (_mm_cvtepi32_epi64(SumD_I32V), _mm_cvtepi32_epi64(_mm_srli_si128(SumD_I32V, 8)));
+      __m128i Sum_U64V  = _mm_add_epi64     (_mm_unpacklo_epi32(Pow_U32V, _mm_setzero_si128()), _mm_unpackhi_epi32(Pow_U32V, _mm_setzero_si128()));
+      SD_I64V           = _mm_add_epi64     (SD_I64V , SumD_I64V);
+      SSD_U64V          = _mm_add_epi64     (SSD_U64V, Sum_U64V );
+    }
+    for(int32 x=Width8; x<Width; x++)
+    {
+      int32 D = (int32)Tst[x] - (int32)Ref[x];
+      SD  += D;
+      SSD += xPow2(D);
+    }
+    Tst += TstStride;
+    Ref += RefStride;
+  } //y
+  SD  += xHorVecSumI64_epi64(SD_I64V );
+  SSD += xHorVecSumI64_epi64(SSD_U64V);
+  return { SD, SSD };
+}
 
 //===============================================================================================================================================================================================================
 
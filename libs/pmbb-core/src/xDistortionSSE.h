@@ -21,10 +21,12 @@ public:
   static  int64 CalcSD16 (const uint16* restrict Tst, const uint16* restrict Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height);
   static uint64 CalcSAD16(const uint16* restrict Tst, const uint16* restrict Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height);
   static uint64 CalcSSD14(const uint16* restrict Tst, const uint16* restrict Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height);
+  static tSDSSD CalcSDSSD14(const uint16* restrict Tst, const uint16* restrict Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height); //SD and SSD within single pass
 
   static inline  int64 CalcSD (const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return BitDepth <= 14 ? CalcSD14 (Tst, Ref, TstStride, RefStride, Width, Height) : CalcSD16(Tst, Ref, TstStride, RefStride, Width, Height); }
   static inline uint64 CalcSAD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32         ) { return CalcSAD16(Tst, Ref, TstStride, RefStride, Width, Height); }
   static inline uint64 CalcSSD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return BitDepth <= 14 ? CalcSSD14(Tst, Ref, TstStride, RefStride, Width, Height) : xDistortionSTD::CalcSSD16(Tst, Ref, TstStride, RefStride, Width, Height); }
+  static inline tSDSSD CalcSDSSD(const uint16* Tst, const uint16* Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height, int32 BitDepth) { return BitDepth <= 14 ? CalcSDSSD14(Tst, Ref, TstStride, RefStride, Width, Height) : xDistortionSTD::CalcSDSSD16(Tst, Ref, TstStride, RefStride, Width, Height); }
 };
 
 //===============================================================================================================================================================================================================
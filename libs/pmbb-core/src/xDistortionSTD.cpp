@@ -42,12 +42,24 @@ uint64 xDistortionSTD::CalcSSD16(const uint16* restrict Tst, const uint16* restr
   }
   return SSD;
 }
+tSDSSD xDistortionSTD::CalcSDSSD16(const uint16* restrict Tst, const uint16* restrict Ref, int32 TstStride, int32 RefStride, int32 Width, int32 Height)
+{
+  int64  SD  = 0;
+  uint64 SSD = 0;
+  for(int32 y=0; y<Height; y++)
+  {
+    for(int32 x=0; x<Width; x++) { int64 D = ((int64)Tst[x]) - ((int64)Ref[x]); SD += D; SSD += (uint64)xPow2(D); }
+    Tst += TstStride;
+    Ref += RefStride;
+  }
+  return { SD, SSD };
+}
 int64 xDistortionSTD::CalcWeightedSD(const uint16* restrict Tst, const uint16* restrict Ref, const uint16* restrict Msk, int32 TstStride, int32 RefStride, int32 MskStride, int32 Width, int32 Height)
 {
   int64 SD = 0;
   for(int32 y=0; y<Height; y++)
   {
-    for(int32 x=0; x<Width; x++) { SD += ((int32)Tst[x] - (int32)Ref[x]) * (int32)Msk[x]; }
+    for(int32 x=0; x<Width; x++) { SD += (int64)((int32)Tst[x] - (int32)Ref[x]) * (int64)Msk[x]; }
     Tst += TstStride;
     Ref += RefStride;
     Msk += MskStride;
@@ -59,7 +71,7 @@ uint64 xDistortionSTD::CalcWeightedSSD(const uint16* restrict Tst, const uint16*
   uint64 SSD = 0;
   for(int32 y=0; y<Height; y++)
   {
-    for(int32 x=0; x<Width; x++) { SSD += ((uint64)xPow2(((int32)Tst[x]) - ((int32)Ref[x]))) * (uint64)Msk[x]; }
+    for(int32 x=0; x<Width; x++) { SSD += (uint64)xPow2((int64)Tst[x] - (int64)Ref[x]) * (uint64)Msk[x]; }
     Tst += TstStride;
     Ref += RefStride;
     Msk += MskStride;
@@ -20,7 +20,7 @@ bool xStream::openFile(tCStr& FilePath, const eMode OpenMode)
   std::ios_base::openmode OpenFlags = std::ios_base::binary;
   if(OpenMode == eMode::Read  ) { StrmDirF = eDirF::Read ; OpenFlags |= std::ios_base::in;                       }
   if(OpenMode == eMode::Write ) { StrmDirF = eDirF::Write; OpenFlags |= std::ios_base::out;                      }
-  if(OpenMode == eMode::Append) { StrmDirF = eDirF::Write; OpenFlags |= std::ios_base::out | std::ios_base::ate; }
+  if(OpenMode == eMode::Append) { StrmDirF = eDirF::Write; OpenFlags |= std::ios_base::out | std::ios_base::app; }
 
   std::fstream* FileHandle = new std::fstream();
 
@@ -7,6 +7,7 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
 #include <functional>
+#include <tuple>
 #include "../src/xCommonDefCORE.h"
 #include "../src/xDistortion.h"
 #include "../src/xPlane.h"
@@ -503,6 +504,96 @@ void testDistortion(
 }
 
 
+using tFunWSD  = std::function< int64(const uint16*, const uint16*, const uint16*, int32, int32, int32, int32, int32)>;
+using tFunWSSD = std::function<uint64(const uint16*, const uint16*, const uint16*, int32, int32, int32, int32, int32)>;
+
+void testDistortionWeighted(tFunWSD FunWSD, tFunWSSD FunWSSD)
+{
+  uint32 State = xTestUtils::c_XorShiftSeed;
+
+  for(const int32 y : c_Dimms)
+  {
+    for(const int32 x : c_Dimms)
+    {
+      int32V2 Size = { x, y };
+      int64   Area = x * y;
+
+      for(const int32 m : c_Margs)
+      {
+        for(const int32 b : c_BitDs)
+        {
+          const std::string Description = fmt::format("SizeXxY={}x{} Margin={} BitDepth={}", x, y, m, b);
+
+          //buffers create
+          tPlane* PL = new tPlane(Size, b , m);
+          tPlane* PU = new tPlane(Size, b , m);
+          tPlane* PM = new tPlane(Size, 16, m);
+
+          //extreme constant values with extreme weights
+          const int64 MaxVal = xBitDepth2MaxValue(b);
+          const std::vector<int64> Weights = { 0, 1, 255, 65535 };
+          PL->fill(             0);
+          PU->fill((uint16)MaxVal);
+          for(const int64 w : Weights)
+          {
+            CAPTURE(Description + fmt::format(" extreme constant values Max={} Weight={}", MaxVal, w));
+            PM->fill((uint16)w);
+            CHECK(FunWSD (PL->getAddr(), PU->getAddr(), PM->getAddr(), PL->getStride(), PU->getStride(), PM->getStride(), x, y) == -MaxVal * w * Area);
+            CHECK(FunWSD (PU->getAddr(), PL->getAddr(), PM->getAddr(), PU->getStride(), PL->getStride(), PM->getStride(), x, y) ==  MaxVal * w * Area);
+            CHECK(FunWSSD(PL->getAddr(), PU->getAddr(), PM->getAddr(), PL->getStride(), PU->getStride(), PM->getStride(), x, y) == (uint64)(xPow2<int64>(MaxVal) * w * Area));
+          }
+
+          //pseudo-random values and weights - compared with STD
+          CAPTURE(Description + " pseudo-random values");
+          State = xTestUtils::fillRandom(PL->getAddr(), PL->getStride(), PL->getWidth(), PL->getHeight(), PL->getBitDepth(), State);
+          State = xTestUtils::fillRandom(PU->getAddr(), PU->getStride(), PU->getWidth(), PU->getHeight(), PU->getBitDepth(), State);
+          State = xTestUtils::fillRandom(PM->getAddr(), PM->getStride(), PM->getWidth(), PM->getHeight(), PM->getBitDepth(), State);
+          CHECK(FunWSD (PL->getAddr(), PU->getAddr(), PM->getAddr(), PL->getStride(), PU->getStride(), PM->getStride(), x, y) == xDistortionSTD::CalcWeightedSD (PL->getAddr(), PU->getAddr(), PM->getAddr(), PL->getStride(), PU->getStride(), PM->getStride(), x, y));
+          CHECK(FunWSSD(PL->getAddr(), PU->getAddr(), PM->getAddr(), PL->getStride(), PU->getStride(), PM->getStride(), x, y) == xDistortionSTD::CalcWeightedSSD(PL->getAddr(), PU->getAddr(), PM->getAddr(), PL->getStride(), PU->getStride(), PM->getStride(), x, y));
+
+          //buffers destroy
+          delete PL;
+          delete PU;
+          delete PM;
+        }
+      }
+    }
+  }
+}
+
+flt64 testDistortionWeightedPerf(tFunWSD FunWSD, tFunWSSD FunWSSD)
+{
+  constexpr int32V2 Size       = { 1920, 1080 };
+  constexpr int32   Margin     = 32;
+  constexpr int32   NumRepeats = 64;
+
+  tPlane* PL = new tPlane(Size, 10, Margin);
+  tPlane* PU = new tPlane(Size, 10, Margin);
+  tPlane* PM = new tPlane(Size, 16, Margin);
+  uint32 State = xTestUtils::c_XorShiftSeed;
+  State = xTestUtils::fillRandom(PL->getAddr(), PL->getStride(), PL->getWidth(), PL->getHeight(), PL->getBitDepth(), State);
+  State = xTestUtils::fillRandom(PU->getAddr(), PU->getStride(), PU->getWidth(), PU->getHeight(), PU->getBitDepth(), State);
+  State = xTestUtils::fillRandom(PM->getAddr(), PM->getStride(), PM->getWidth(), PM->getHeight(), PM->getBitDepth(), State);
+
+  int64  SD  = 0;
+  uint64 SSD = 0;
+  tTimePoint T0 = tClock::now();
+  for(int32 r = 0; r < NumRepeats; r++)
+  {
+    SD  += FunWSD (PL->getAddr(), PU->getAddr(), PM->getAddr(), PL->getStride(), PU->getStride(), PM->getStride(), Size.getX(), Size.getY());
+    SSD += FunWSSD(PL->getAddr(), PU->getAddr(), PM->getAddr(), PL->getStride(), PU->getStride(), PM->getStride(), Size.getX(), Size.getY());
+  }
+  tTimePoint T1 = tClock::now();
+  CHECK(SD  == NumRepeats * xDistortionSTD::CalcWeightedSD (PL->getAddr(), PU->getAddr(), PM->getAddr(), PL->getStride(), PU->getStride(), PM->getStride(), Size.getX(), Size.getY()));
+  CHECK(SSD == NumRepeats * xDistortionSTD::CalcWeightedSSD(PL->getAddr(), PU->getAddr(), PM->getAddr(), PL->getStride(), PU->getStride(), PM->getStride(), Size.getX(), Size.getY()));
+
+  delete PL;
+  delete PU;
+  delete PM;
+
+  return std::chrono::duration_cast<tDurationS>(T1 - T0).count();
+}
+
 //===============================================================================================================================================================================================================
 
 TEST_CASE("xDistortionSTD")
@@ -510,6 +601,8 @@ TEST_CASE("xDistortionSTD")
   testDistortionSD (&xDistortionSTD::CalcSD16 , 16);
   testDistortionSAD(&xDistortionSTD::CalcSAD16, 16);
   testDistortionSSD(&xDistortionSTD::CalcSSD16, 16);
+  testDistortionSSS(&xDistortionSTD::CalcSDSSD16, 16);
+  testDistortionWeighted(&xDistortionSTD::CalcWeightedSD, &xDistortionSTD::CalcWeightedSSD);
 }
 
 #if X_SIMD_CAN_USE_SSE
@@ -519,6 +612,7 @@ TEST_CASE("xDistortionSSE")
   testDistortionSD (&xDistortionSSE::CalcSD16 , 16);
   testDistortionSAD(&xDistortionSSE::CalcSAD16, 16);
   testDistortionSSD(&xDistortionSSE::CalcSSD14, 14);
+  testDistortionSSS(&xDistortionSSE::CalcSDSSD14, 14);
 }
 #endif //X_SIMD_CAN_USE_SSE
 
@@ -529,6 +623,8 @@ TEST_CASE("xDistortionAVX")
   testDistortionSD (&xDistortionAVX::CalcSD16 , 16);
   testDistortionSAD(&xDistortionAVX::CalcSAD16, 16);
   testDistortionSSD(&xDistortionAVX::CalcSSD14, 14);
+  testDistortionSSS(&xDistortionAVX::CalcSDSSD14, 14);
+  testDistortionWeighted(&xDistortionAVX::CalcWeightedSD, &xDistortionAVX::CalcWeightedSSD);
 }
 #endif //X_SIMD_CAN_USE_AVX
 
@@ -539,9 +635,29 @@ TEST_CASE("xDistortionAVX512")
   testDistortionSD (&xDistortionAVX512::CalcSD16 , 16);
   testDistortionSAD(&xDistortionAVX512::CalcSAD16, 16);
   testDistortionSSD(&xDistortionAVX512::CalcSSD14, 14);
+  testDistortionSSS(&xDistortionAVX512::CalcSDSSD14, 14);
+  testDistortionWeighted(&xDistortionAVX512::CalcWeightedSD, &xDistortionAVX512::CalcWeightedSSD);
 }
 #endif //X_SIMD_CAN_USE_AVX512
 
+//1080p benchmark, skipped by default (run with --no-skip)
+TEST_CASE("xDistortionWeighted_Perf" * doctest::skip())
+{
+  std::vector<std::tuple<std::string, tFunWSD, tFunWSSD>> Kernels = { { "STD", &xDistortionSTD::CalcWeightedSD, &xDistortionSTD::CalcWeightedSSD } };
+#if X_SIMD_CAN_USE_AVX
+  Kernels.push_back({ "AVX", &xDistortionAVX::CalcWeightedSD, &xDistortionAVX::CalcWeightedSSD });
+#endif //X_SIMD_CAN_USE_AVX
+#if X_SIMD_CAN_USE_AVX512
+  Kernels.push_back({ "AVX512", &xDistortionAVX512::CalcWeightedSD, &xDistortionAVX512::CalcWeightedSSD });
+#endif //X_SIMD_CAN_USE_AVX512
+
+  for(const auto& [Name, FunWSD, FunWSSD] : Kernels)
+  {
+    flt64 Time = testDistortionWeightedPerf(FunWSD, FunWSSD);
+    fmt::print("TIME(xDistortion{}::CalcWeightedSD+SSD) = {}s\n", Name, Time);
+  }
+}
+
 #if X_SIMD_CAN_USE_NEON
 TEST_CASE("xDistortionNEON")
 {
@@ -1,7 +1,7 @@
 set(SRCLIST_COMMON_H src/xCommonDefIVQM.h)
 
-set(SRCLIST_MTC_H src/xMetricCommon.h  )
-set(SRCLIST_MTC_C src/xMetricCommon.cpp)
+set(SRCLIST_MTC_H src/xMetricCommon.h   src/xDiffStats.h  )
+set(SRCLIST_MTC_C src/xMetricCommon.cpp src/xDiffStats.cpp)
 
 set(SRCLIST_WS_H src/xWeightedSpherically.h  )
 set(SRCLIST_WS_C src/xWeightedSpherically.cpp)
@@ -9,14 +9,14 @@ set(SRCLIST_WS_C src/xWeightedSpherically.cpp)
 set(SRCLIST_GCD_H src/xGlobClrDiff.h  )
 set(SRCLIST_GCD_C src/xGlobClrDiff.cpp)
 
-set(SRCLIST_CPS_H src/xCorrespPixelShiftPrms.h src/xCorrespPixelShift.h src/xCorrespPixelShiftSTD.h   src/xCorrespPixelShiftSSE.h   src/xCorrespPixelShiftNEON.h   src/xShftCompPic.h  )
-set(SRCLIST_CPS_C                                                       src/xCorrespPixelShiftSTD.cpp src/xCorrespPixelShiftSSE.cpp src/xCorrespPixelShiftNEON.cpp src/xShftCompPic.cpp)
+set(SRCLIST_CPS_H src/xCorrespPixelShiftPrms.h src/xDispMap.h src/xCorrespPixelShift.h src/xCorrespPixelShiftSTD.h   src/xCorrespPixelShiftSSE.h   src/xCorrespPixelShiftAVX.h   src/xCorrespPixelShiftAVX512.h   src/xCorrespPixelShiftNEON.h   src/xShftCompPic.h  )
+set(SRCLIST_CPS_C                                                                      src/xCorrespPixelShiftSTD.cpp src/xCorrespPixelShiftSSE.cpp src/xCorrespPixelShiftAVX.cpp src/xCorrespPixelShiftAVX512.cpp src/xCorrespPixelShiftNEON.cpp src/xShftCompPic.cpp)
 
 set(SRCLIST_PSNR_H src/xPSNR.h   src/xWSPSNR.h   src/xIVPSNR.h   )
 set(SRCLIST_PSNR_C src/xPSNR.cpp src/xWSPSNR.cpp src/xIVPSNR.cpp )
 
-set(SRCLIST_SSIM_H src/xStructSimConsts.h src/xStructSim.h   src/xStructSimSTD.h   src/xStructSimSSE.h   src/xStructSimAVX.h   src/xStructSimAVX512.h   src/xStructSimNEON.h   src/xSSIM.h   src/xIVSSIM.h  )
-set(SRCLIST_SSIM_C                                           src/xStructSimSTD.cpp src/xStructSimSSE.cpp src/xStructSimAVX.cpp src/xStructSimAVX512.cpp src/xStructSimNEON.cpp src/xSSIM.cpp src/xIVSSIM.cpp)
+set(SRCLIST_SSIM_H src/xStructSimConsts.h src/xStructSim.h   src/xStructSimSTD.h   src/xStructSimSSE.h   src/xStructSimAVX.h   src/xStructSimAVX512.h   src/xStructSimNEON.h   src/xStructSimSeparable.h   src/xStructSimSubBlock.h   src/xStructSimMomentCache.h   src/xStructSimPyramidCache.h   src/xSSIM.h   src/xIVSSIM.h  )
+set(SRCLIST_SSIM_C                                           src/xStructSimSTD.cpp src/xStructSimSSE.cpp src/xStructSimAVX.cpp src/xStructSimAVX512.cpp src/xStructSimNEON.cpp src/xStructSimSeparable.cpp src/xStructSimSubBlock.cpp src/xStructSimMomentCache.cpp src/xStructSimPyramidCache.cpp src/xSSIM.cpp src/xIVSSIM.cpp)
 
 set(SRCLIST_UTIL_H src/xTestUtilsIVQM.h  )
 set(SRCLIST_UTIL_C src/xTestUtilsIVQM.cpp)
@@ -20,6 +20,22 @@
 #define X_CORRESPPIXELSHIFT_CAN_USE_SSE 0
 #endif
 
+//AVX implementation
+#if X_SIMD_CAN_USE_AVX && __has_include("xCorrespPixelShiftAVX.h")
+#define X_CORRESPPIXELSHIFT_CAN_USE_AVX 1
+#include "xCorrespPixelShiftAVX.h"
+#else
+#define X_CORRESPPIXELSHIFT_CAN_USE_AVX 0
+#endif
+
+//AVX512 implementation
+#if X_SIMD_CAN_USE_AVX512 && __has_include("xCorrespPixelShiftAVX512.h")
+#define X_CORRESPPIXELSHIFT_CAN_USE_AVX512 1
+#include "xCorrespPixelShiftAVX512.h"
+#else
+#define X_CORRESPPIXELSHIFT_CAN_USE_AVX512 0
+#endif
+
 //NEON implementation
 #if X_SIMD_CAN_USE_NEON && __has_include("xCorrespPixelShiftNEON.h")
 #define X_CORRESPPIXELSHIFT_CAN_USE_NEON 1
@@ -36,31 +52,117 @@ namespace PMBB_NAMESPACE {
 class xCorrespPixelShift
 {
 public:
+  //planar search is vectorized - interleaving input pictures gives no benefit
+  static constexpr bool c_VectorizedPlanar = X_CORRESPPIXELSHIFT_CAN_USE_AVX512 || X_CORRESPPIXELSHIFT_CAN_USE_AVX;
+
+  //exact-match shortcut - NumExactMatchPels (optional) receives number of pixels matching center candidate (search skipped, result unchanged)
+
   //asymetric Q planar
-  static uint64V4 CalcDistAsymmetricRow   (const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftSTD::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights); }
+#if X_CORRESPPIXELSHIFT_CAN_USE_AVX512
+  static inline uint64V4 CalcDistAsymmetricRow(const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels = nullptr) { return xCorrespPixelShiftAVX512::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static inline uint64V4 CalcDistAsymmetricRow(const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels = nullptr) { return xCorrespPixelShiftAVX   ::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+#else //X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static inline uint64V4 CalcDistAsymmetricRow(const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels = nullptr) { return xCorrespPixelShiftSTD   ::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+#endif //X_CORRESPPIXELSHIFT_CAN_USE_AVX
   
   //asymetric Q interleaved
-#if X_CORRESPPIXELSHIFT_CAN_USE_SSE
-  static inline uint64V4 CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftSSE ::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights); }
+#if X_CORRESPPIXELSHIFT_CAN_USE_AVX512
+  static inline uint64V4 CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels = nullptr) { return xCorrespPixelShiftAVX512::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static inline uint64V4 CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels = nullptr) { return xCorrespPixelShiftAVX ::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_SSE
+  static inline uint64V4 CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels = nullptr) { return xCorrespPixelShiftSSE ::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
 #elif X_CORRESPPIXELSHIFT_CAN_USE_NEON
-  static inline uint64V4 CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftNEON::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights); }
+  static inline uint64V4 CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels = nullptr) { if(NumExactMatchPels != nullptr) { *NumExactMatchPels = 0; } return xCorrespPixelShiftNEON::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights); }
 #else //X_CORRESPPIXELSHIFT_CAN_USE_SSE
-  static inline uint64V4 CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftSTD ::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights); }
+  static inline uint64V4 CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels = nullptr) { return xCorrespPixelShiftSTD ::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
 #endif //X_CORRESPPIXELSHIFT_CAN_USE_SSE
 
   //asymetric Q interleaved - with mask
-  static inline uint64V4 CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftSTD::CalcDistAsymmetricRowM(Tst, Ref, Msk, y, GlobalColorShift, SearchRange, CmpWeights); }
+#if X_CORRESPPIXELSHIFT_CAN_USE_AVX512
+  static inline uint64V4 CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels = nullptr) { return xCorrespPixelShiftAVX512::CalcDistAsymmetricRowM(Tst, Ref, Msk, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static inline uint64V4 CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels = nullptr) { return xCorrespPixelShiftAVX   ::CalcDistAsymmetricRowM(Tst, Ref, Msk, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_SSE
+  static inline uint64V4 CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels = nullptr) { return xCorrespPixelShiftSSE   ::CalcDistAsymmetricRowM(Tst, Ref, Msk, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+#else //X_CORRESPPIXELSHIFT_CAN_USE_SSE
+  static inline uint64V4 CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels = nullptr) { return xCorrespPixelShiftSTD   ::CalcDistAsymmetricRowM(Tst, Ref, Msk, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+#endif //X_CORRESPPIXELSHIFT_CAN_USE_SSE
 
   //shift-compensated picture generation
-  static void GenShftCompRow(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { xCorrespPixelShiftSTD::GenShftCompRow(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
-#if X_CORRESPPIXELSHIFT_CAN_USE_SSE
+#if X_CORRESPPIXELSHIFT_CAN_USE_AVX512
+  static void GenShftCompRow(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { xCorrespPixelShiftAVX512::GenShftCompRow(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static void GenShftCompRow(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { xCorrespPixelShiftAVX   ::GenShftCompRow(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#else //X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static void GenShftCompRow(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { xCorrespPixelShiftSTD   ::GenShftCompRow(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#endif //X_CORRESPPIXELSHIFT_CAN_USE_AVX
+#if X_CORRESPPIXELSHIFT_CAN_USE_AVX512
+  static void GenShftCompRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { xCorrespPixelShiftAVX512::GenShftCompRow(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static void GenShftCompRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { xCorrespPixelShiftAVX::GenShftCompRow(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_SSE
   static void GenShftCompRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { xCorrespPixelShiftSSE::GenShftCompRow(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
 #else //X_CORRESPPIXELSHIFT_CAN_USE_SSE
   static void GenShftCompRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { xCorrespPixelShiftSTD::GenShftCompRow(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
 #endif //X_CORRESPPIXELSHIFT_CAN_USE_SSE
 
   //shift-compensated picture generation - with mask
-  static void GenShftCompRowM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { xCorrespPixelShiftSTD::GenShftCompRowM(DstRef, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); }
+#if X_CORRESPPIXELSHIFT_CAN_USE_AVX512
+  static void GenShftCompRowM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { xCorrespPixelShiftAVX512::GenShftCompRowM(DstRef, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static void GenShftCompRowM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { xCorrespPixelShiftAVX   ::GenShftCompRowM(DstRef, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_SSE
+  static void GenShftCompRowM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { xCorrespPixelShiftSSE   ::GenShftCompRowM(DstRef, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); }
+#else //X_CORRESPPIXELSHIFT_CAN_USE_SSE
+  static void GenShftCompRowM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { xCorrespPixelShiftSTD   ::GenShftCompRowM(DstRef, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); }
+#endif //X_CORRESPPIXELSHIFT_CAN_USE_SSE
+
+  //fused shift-compensated picture generation and asymetric Q (single search)
+#if X_CORRESPPIXELSHIFT_CAN_USE_AVX512
+  static uint64V4 GenShftCompRowAndCalcDist(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftAVX512::GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static uint64V4 GenShftCompRowAndCalcDist(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftAVX   ::GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#else //X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static uint64V4 GenShftCompRowAndCalcDist(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftSTD   ::GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#endif //X_CORRESPPIXELSHIFT_CAN_USE_AVX
+#if X_CORRESPPIXELSHIFT_CAN_USE_AVX512
+  static uint64V4 GenShftCompRowAndCalcDist(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftAVX512::GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static uint64V4 GenShftCompRowAndCalcDist(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftAVX   ::GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_SSE
+  static uint64V4 GenShftCompRowAndCalcDist(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftSSE   ::GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#else //X_CORRESPPIXELSHIFT_CAN_USE_SSE
+  static uint64V4 GenShftCompRowAndCalcDist(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftSTD   ::GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#endif //X_CORRESPPIXELSHIFT_CAN_USE_SSE
+#if X_CORRESPPIXELSHIFT_CAN_USE_AVX512
+  static uint64V4 GenShftCompRowAndCalcDistM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftAVX512::GenShftCompRowAndCalcDistM(DstRef, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static uint64V4 GenShftCompRowAndCalcDistM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftAVX   ::GenShftCompRowAndCalcDistM(DstRef, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); }
+#elif X_CORRESPPIXELSHIFT_CAN_USE_SSE
+  static uint64V4 GenShftCompRowAndCalcDistM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftSSE   ::GenShftCompRowAndCalcDistM(DstRef, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); }
+#else //X_CORRESPPIXELSHIFT_CAN_USE_SSE
+  static uint64V4 GenShftCompRowAndCalcDistM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftSTD   ::GenShftCompRowAndCalcDistM(DstRef, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); }
+#endif //X_CORRESPPIXELSHIFT_CAN_USE_SSE
+
+  //displacement map generation (asymetric Q as side product)
+#if X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static uint64V4 GenDispMapRowAndCalcDist(xDispMap* DispMap, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftAVX::GenDispMapRowAndCalcDist(DispMap, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+  static uint64V4 GenDispMapRowAndCalcDist(xDispMap* DispMap, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftAVX::GenDispMapRowAndCalcDist(DispMap, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#else //X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static uint64V4 GenDispMapRowAndCalcDist(xDispMap* DispMap, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftSTD::GenDispMapRowAndCalcDist(DispMap, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+  static uint64V4 GenDispMapRowAndCalcDist(xDispMap* DispMap, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftSTD::GenDispMapRowAndCalcDist(DispMap, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+#endif //X_CORRESPPIXELSHIFT_CAN_USE_AVX
+  static uint64V4 GenDispMapRowAndCalcDistM(xDispMap* DispMap, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return xCorrespPixelShiftSTD::GenDispMapRowAndCalcDistM(DispMap, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); }
+
+  //asymetric Q and shift-compensated picture generation from displacement map (no search)
+  static uint64V4 CalcDistAsymmetricRowFromDispMap (const xDispMap* DispMap, const xPicP* Tst, const xPicP* Ref,                   const int32 y, const int32V4& GlobalColorShift) { return xCorrespPixelShiftSTD::CalcDistAsymmetricRowFromDispMap (DispMap, Tst, Ref,      y, GlobalColorShift); }
+  static uint64V4 CalcDistAsymmetricRowFromDispMap (const xDispMap* DispMap, const xPicI* Tst, const xPicI* Ref,                   const int32 y, const int32V4& GlobalColorShift) { return xCorrespPixelShiftSTD::CalcDistAsymmetricRowFromDispMap (DispMap, Tst, Ref,      y, GlobalColorShift); }
+  static uint64V4 CalcDistAsymmetricRowFromDispMapM(const xDispMap* DispMap, const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift) { return xCorrespPixelShiftSTD::CalcDistAsymmetricRowFromDispMapM(DispMap, Tst, Ref, Msk, y, GlobalColorShift); }
+  static void     GenShftCompRowFromDispMap        (xPicP* DstRef, const xDispMap* DispMap, const xPicP* Ref,                   const int32 y, const int32V4& GlobalColorShift) { xCorrespPixelShiftSTD::GenShftCompRowFromDispMap (DstRef, DispMap, Ref,      y, GlobalColorShift); }
+  static void     GenShftCompRowFromDispMap        (xPicI* DstRef, const xDispMap* DispMap, const xPicI* Ref,                   const int32 y, const int32V4& GlobalColorShift) { xCorrespPixelShiftSTD::GenShftCompRowFromDispMap (DstRef, DispMap, Ref,      y, GlobalColorShift); }
+  static void     GenShftCompRowFromDispMapM       (xPicI* DstRef, const xDispMap* DispMap, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift) { xCorrespPixelShiftSTD::GenShftCompRowFromDispMapM(DstRef, DispMap, Ref, Msk, y, GlobalColorShift); }
 };
 
 //===============================================================================================================================================================================================================
@@ -0,0 +1,489 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "xCorrespPixelShiftAVX.h"
+#include "xCorrespPixelShiftPrms.h"
+#include "xHelpersSIMD.h"
+
+#if X_SIMD_CAN_USE_AVX
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//  asymetric Q planar
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftAVX::CalcDistAsymmetricRow(const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels)
+{
+  assert(Tst->isCompatible(Ref));
+
+  const int32 Width = Tst->getWidth();
+  if(Width < 8 || Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+  return xProcessRowP<true, false>(nullptr, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, nullptr, NumExactMatchPels);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//  asymetric Q interleaved
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftAVX::CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels)
+{
+  assert(Tst->isCompatible(Ref));
+
+  const int32 Width = Tst->getWidth();
+  if(Width < 8 || Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+  return xProcessRow<true, false>(nullptr, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, nullptr, nullptr, NumExactMatchPels);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//  asymetric Q interleaved - with mask
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftAVX::CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels)
+{
+  assert(Tst->isCompatible(Ref));
+
+  const int32 Width = Tst->getWidth();
+  if(Width < 8 || Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::CalcDistAsymmetricRowM(Tst, Ref, Msk, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+  return xProcessRow<true, false, false, true>(nullptr, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, nullptr, Msk, NumExactMatchPels);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// shift-compensated picture generation
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void xCorrespPixelShiftAVX::GenShftCompRow(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  const int32 Width = Tst->getWidth();
+  if(Width < 8 || Tst->getBitDepth() > 14) { xCorrespPixelShiftSTD::GenShftCompRow(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); return; }
+  xProcessRowP<false, true>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights);
+}
+void xCorrespPixelShiftAVX::GenShftCompRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  const int32 Width = Tst->getWidth();
+  if(Width < 8 || Tst->getBitDepth() > 14) { xCorrespPixelShiftSTD::GenShftCompRow(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); return; }
+  xProcessRow<false, true>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights);
+}
+void xCorrespPixelShiftAVX::GenShftCompRowM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  const int32 Width = Tst->getWidth();
+  if(Width < 8 || Tst->getBitDepth() > 14) { xCorrespPixelShiftSTD::GenShftCompRowM(DstRef, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); return; }
+  xProcessRow<false, true, false, true>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, nullptr, Msk);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// fused shift-compensated picture generation and asymetric Q (single search)
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftAVX::GenShftCompRowAndCalcDist(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+
+  const int32 Width = Tst->getWidth();
+  if(Width < 8 || Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+  return xProcessRowP<true, true>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights);
+}
+uint64V4 xCorrespPixelShiftAVX::GenShftCompRowAndCalcDist(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+
+  const int32 Width = Tst->getWidth();
+  if(Width < 8 || Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+  return xProcessRow<true, true>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights);
+}
+uint64V4 xCorrespPixelShiftAVX::GenShftCompRowAndCalcDistM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+
+  const int32 Width = Tst->getWidth();
+  if(Width < 8 || Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::GenShftCompRowAndCalcDistM(DstRef, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); }
+  return xProcessRow<true, true, false, true>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, nullptr, Msk);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// displacement map generation (asymetric Q as side product)
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftAVX::GenDispMapRowAndCalcDist(xDispMap* DispMap, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+  assert(SearchRange <= xDispMapUtils::c_MaxSearchRange);
+
+  const int32 Width = Tst->getWidth();
+  if(Width < 8 || Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::GenDispMapRowAndCalcDist(DispMap, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+  return xProcessRowP<true, false, true>(nullptr, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, DispMap);
+}
+uint64V4 xCorrespPixelShiftAVX::GenDispMapRowAndCalcDist(xDispMap* DispMap, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+  assert(SearchRange <= xDispMapUtils::c_MaxSearchRange);
+
+  const int32 Width = Tst->getWidth();
+  if(Width < 8 || Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::GenDispMapRowAndCalcDist(DispMap, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+  return xProcessRow<true, false, true>(nullptr, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, DispMap);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// common search - planar
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template<bool CalcDist, bool GenShftComp, bool GenDispMap> uint64V4 xCorrespPixelShiftAVX::xProcessRowP(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, xDispMap* DispMap, int32* NumExactMatchPels)
+{
+  return xCorrespPixelShiftSpec::select(SearchRange, CmpWeights, [&](auto SR, auto DCW) { return xSearchRowP<CalcDist, GenShftComp, GenDispMap, decltype(SR)::value, decltype(DCW)::value>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, DispMap, NumExactMatchPels); });
+}
+template<bool CalcDist, bool GenShftComp, bool GenDispMap, int32 SR, bool DefCmpWeights> uint64V4 xCorrespPixelShiftAVX::xSearchRowP(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, xDispMap* DispMap, int32* NumExactMatchPels)
+{
+  const int32 Width      = Tst->getWidth ();
+  const int32 TstStride  = Tst->getStride();
+  const int32 TstOffset  = y * TstStride;
+  const int32 RefStride  = Ref->getStride();
+  const int32 RefOffset  = (y - SearchRange) * RefStride - SearchRange;
+  const int32 RefCenter  = SearchRange * RefStride + SearchRange;
+  const int32 WindowSize = xCorrespPixelShiftSpec::getWindowSize<SR>(SearchRange); //compile time constant for specialized kernels
+  const bool  ExactMatchShortcut = !GenDispMap && xCorrespPixelShiftSpec::isExactMatchShortcutValid(CmpWeights); //displacement of first zero error candidate may differ
+
+  const __m256i GlobalColorShiftL_I32_V = _mm256_set1_epi32(GlobalColorShift[0]);
+  const __m256i GlobalColorShiftB_I32_V = _mm256_set1_epi32(GlobalColorShift[1]);
+  const __m256i GlobalColorShiftR_I32_V = _mm256_set1_epi32(GlobalColorShift[2]);
+  const __m256i CmpWeightL_I32_V        = _mm256_set1_epi32(CmpWeights[0]);
+  const __m256i CmpWeightB_I32_V        = _mm256_set1_epi32(CmpWeights[1]);
+  const __m256i CmpWeightR_I32_V        = _mm256_set1_epi32(CmpWeights[2]);
+  const __m256i PelIdx_I32_V            = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+  const uint16* TstPtrL = Tst->getAddr(eCmp::LM) + TstOffset;
+  const uint16* TstPtrB = Tst->getAddr(eCmp::CB) + TstOffset;
+  const uint16* TstPtrR = Tst->getAddr(eCmp::CR) + TstOffset;
+  const uint16* RefPtrL = Ref->getAddr(eCmp::LM) + RefOffset;
+  const uint16* RefPtrB = Ref->getAddr(eCmp::CB) + RefOffset;
+  const uint16* RefPtrR = Ref->getAddr(eCmp::CR) + RefOffset;
+  uint16* restrict DstPtrL = GenShftComp ? DstRef->getAddr(eCmp::LM) + TstOffset : nullptr;
+  uint16* restrict DstPtrB = GenShftComp ? DstRef->getAddr(eCmp::CB) + TstOffset : nullptr;
+  uint16* restrict DstPtrR = GenShftComp ? DstRef->getAddr(eCmp::CR) + TstOffset : nullptr;
+  const __m256i MaxValue_I32_V = _mm256_set1_epi32(GenShftComp ? DstRef->getMaxPelValue() : 0);
+  int16* restrict DispPtr = GenDispMap ? DispMap->getRowAddr(y) : nullptr;
+
+  __m256i RowDistL_U64_V = _mm256_setzero_si256();
+  __m256i RowDistB_U64_V = _mm256_setzero_si256();
+  __m256i RowDistR_U64_V = _mm256_setzero_si256();
+  int32   NumExactMatch  = 0;
+
+  for(int32 x = 0; x < Width; x += 8)
+  {
+    const int32 BlockX = xMin(x, Width - 8); //last block overlaps previous one
+
+    const __m256i TstL_I32_V = _mm256_add_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)(TstPtrL + BlockX))), GlobalColorShiftL_I32_V); //TODO - xc_CLIP_CURR_TST_RANGE
+    const __m256i TstB_I32_V = _mm256_add_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)(TstPtrB + BlockX))), GlobalColorShiftB_I32_V);
+    const __m256i TstR_I32_V = _mm256_add_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)(TstPtrR + BlockX))), GlobalColorShiftR_I32_V);
+
+    __m256i BestError_I32_V = _mm256_set1_epi32(std::numeric_limits<int32>::max());
+    __m256i BestRefL_I32_V  = _mm256_setzero_si256();
+    __m256i BestRefB_I32_V  = _mm256_setzero_si256();
+    __m256i BestRefR_I32_V  = _mm256_setzero_si256();
+    __m256i BestDisp_I32_V  = _mm256_setzero_si256();
+
+    //exact-match shortcut - all pixels equal to center candidate (zero error), remaining candidates cannot change the result
+    bool ExactMatch = false;
+    if(ExactMatchShortcut)
+    {
+      const __m256i CntrL_I32_V = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)(RefPtrL + RefCenter + BlockX)));
+      const __m256i CntrB_I32_V = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)(RefPtrB + RefCenter + BlockX)));
+      const __m256i CntrR_I32_V = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)(RefPtrR + RefCenter + BlockX)));
+      const __m256i Equal_I32_V = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi32(TstL_I32_V, CntrL_I32_V), _mm256_cmpeq_epi32(TstB_I32_V, CntrB_I32_V)), _mm256_cmpeq_epi32(TstR_I32_V, CntrR_I32_V));
+      if(_mm256_movemask_epi8(Equal_I32_V) == -1)
+      {
+        BestRefL_I32_V = CntrL_I32_V;
+        BestRefB_I32_V = CntrB_I32_V;
+        BestRefR_I32_V = CntrR_I32_V;
+        NumExactMatch += xMin(Width - x, 8); //skip already processed pixels
+        ExactMatch     = true;
+      }
+    }
+
+    if(!ExactMatch)
+    {
+      for(int32 dy = 0; dy < WindowSize; dy++)
+      {
+        const int32 RefOffsetY = dy * RefStride + BlockX;
+        for(int32 dx = 0; dx < WindowSize; dx++)
+        {
+          const __m256i RefL_I32_V = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)(RefPtrL + RefOffsetY + dx)));
+          const __m256i RefB_I32_V = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)(RefPtrB + RefOffsetY + dx)));
+          const __m256i RefR_I32_V = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)(RefPtrR + RefOffsetY + dx)));
+          __m256i Error_I32_V  = xCalcError<DefCmpWeights>(xCalcDistP(TstL_I32_V, RefL_I32_V), xCalcDistP(TstB_I32_V, RefB_I32_V), xCalcDistP(TstR_I32_V, RefR_I32_V), CmpWeightL_I32_V, CmpWeightB_I32_V, CmpWeightR_I32_V);
+          __m256i Better_I32_V = _mm256_cmpgt_epi32(BestError_I32_V, Error_I32_V);
+          BestError_I32_V = _mm256_min_epi32  (BestError_I32_V, Error_I32_V);
+          BestRefL_I32_V  = _mm256_blendv_epi8(BestRefL_I32_V, RefL_I32_V, Better_I32_V);
+          BestRefB_I32_V  = _mm256_blendv_epi8(BestRefB_I32_V, RefB_I32_V, Better_I32_V);
+          BestRefR_I32_V  = _mm256_blendv_epi8(BestRefR_I32_V, RefR_I32_V, Better_I32_V);
+          if constexpr(GenDispMap) { BestDisp_I32_V = _mm256_blendv_epi8(BestDisp_I32_V, _mm256_set1_epi32(xDispMapUtils::pack(dx - SearchRange, dy - SearchRange)), Better_I32_V); }
+        } //dx
+      } //dy
+    }
+
+    if constexpr(CalcDist)
+    {
+      const __m256i Valid_I32_V = _mm256_cmpgt_epi32(PelIdx_I32_V, _mm256_set1_epi32(x - BlockX - 1)); //skip already processed pixels
+      __m256i BestDistL_I32_V = _mm256_and_si256(xCalcDistP(TstL_I32_V, BestRefL_I32_V), Valid_I32_V);
+      __m256i BestDistB_I32_V = _mm256_and_si256(xCalcDistP(TstB_I32_V, BestRefB_I32_V), Valid_I32_V);
+      __m256i BestDistR_I32_V = _mm256_and_si256(xCalcDistP(TstR_I32_V, BestRefR_I32_V), Valid_I32_V);
+      RowDistL_U64_V = _mm256_add_epi64(RowDistL_U64_V, _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(BestDistL_I32_V)), _mm256_cvtepu32_epi64(_mm256_extracti128_si256(BestDistL_I32_V, 1))));
+      RowDistB_U64_V = _mm256_add_epi64(RowDistB_U64_V, _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(BestDistB_I32_V)), _mm256_cvtepu32_epi64(_mm256_extracti128_si256(BestDistB_I32_V, 1))));
+      RowDistR_U64_V = _mm256_add_epi64(RowDistR_U64_V, _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(BestDistR_I32_V)), _mm256_cvtepu32_epi64(_mm256_extracti128_si256(BestDistR_I32_V, 1))));
+    }
+
+    if constexpr(GenShftComp) //overlapped pixels are written twice with the same value
+    {
+      _mm_storeu_si128((__m128i*)(DstPtrL + BlockX), xPackClipU16(_mm256_sub_epi32(BestRefL_I32_V, GlobalColorShiftL_I32_V), MaxValue_I32_V));
+      _mm_storeu_si128((__m128i*)(DstPtrB + BlockX), xPackClipU16(_mm256_sub_epi32(BestRefB_I32_V, GlobalColorShiftB_I32_V), MaxValue_I32_V));
+      _mm_storeu_si128((__m128i*)(DstPtrR + BlockX), xPackClipU16(_mm256_sub_epi32(BestRefR_I32_V, GlobalColorShiftR_I32_V), MaxValue_I32_V));
+    }
+
+    if constexpr(GenDispMap) //packed displacements fits int16
+    {
+      __m256i Disp_I16_V = _mm256_permute4x64_epi64(_mm256_packs_epi32(BestDisp_I32_V, BestDisp_I32_V), 0b10001000);
+      _mm_storeu_si128((__m128i*)(DispPtr + BlockX), _mm256_castsi256_si128(Disp_I16_V));
+    }
+  } //x
+
+  if(NumExactMatchPels != nullptr) { *NumExactMatchPels = NumExactMatch; }
+  if constexpr(CalcDist)
+  {
+    uint64V4 RowDist = { (uint64)xHorVecSumI64_epi64(RowDistL_U64_V), (uint64)xHorVecSumI64_epi64(RowDistB_U64_V), (uint64)xHorVecSumI64_epi64(RowDistR_U64_V), 0 };
+    return RowDist;
+  }
+  else { return xMakeVec4<uint64>(0); }
+}
+__m256i xCorrespPixelShiftAVX::xCalcDistP(const __m256i& Tst_I32_V, const __m256i& Ref_I32_V)
+{
+  //abs diffs fits 15 bits (upper halves are zero), so madd gives exact square
+  __m256i Diff_I32_V = _mm256_abs_epi32(_mm256_sub_epi32(Tst_I32_V, Ref_I32_V));
+  return _mm256_madd_epi16(Diff_I32_V, Diff_I32_V);
+}
+template<bool DefCmpWeights> __m256i xCorrespPixelShiftAVX::xCalcError(const __m256i& DistL_I32_V, const __m256i& DistB_I32_V, const __m256i& DistR_I32_V, const __m256i& CmpWeightL_I32_V, const __m256i& CmpWeightB_I32_V, const __m256i& CmpWeightR_I32_V)
+{
+  if constexpr(DefCmpWeights) //4:1:1 - shift instead of multiplications
+  {
+    return _mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(DistL_I32_V, 2), DistB_I32_V), DistR_I32_V);
+  }
+  else
+  {
+    return _mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi32(DistL_I32_V, CmpWeightL_I32_V), _mm256_mullo_epi32(DistB_I32_V, CmpWeightB_I32_V)), _mm256_mullo_epi32(DistR_I32_V, CmpWeightR_I32_V));
+  }
+}
+__m128i xCorrespPixelShiftAVX::xPackClipU16(const __m256i& Val_I32_V, const __m256i& MaxValue_I32_V)
+{
+  //packus clips negative values to 0
+  __m256i Val_U16_V = _mm256_packus_epi32(_mm256_min_epi32(Val_I32_V, MaxValue_I32_V), _mm256_setzero_si256());
+  return _mm256_castsi256_si128(_mm256_permute4x64_epi64(Val_U16_V, 0b10001000));
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// common search - interleaved
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template<bool CalcDist, bool GenShftComp, bool GenDispMap, bool UseMask> uint64V4 xCorrespPixelShiftAVX::xProcessRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, xDispMap* DispMap, const xPicP* Msk, int32* NumExactMatchPels)
+{
+  return xCorrespPixelShiftSpec::select(SearchRange, CmpWeights, [&](auto SR, auto DCW) { return xSearchRow<CalcDist, GenShftComp, GenDispMap, UseMask, decltype(SR)::value, decltype(DCW)::value>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, DispMap, Msk, NumExactMatchPels); });
+}
+template<bool CalcDist, bool GenShftComp, bool GenDispMap, bool UseMask, int32 SR, bool DefCmpWeights> uint64V4 xCorrespPixelShiftAVX::xSearchRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, xDispMap* DispMap, const xPicP* Msk, int32* NumExactMatchPels)
+{
+  const int32 Width      = Tst->getWidth ();
+  const int32 TstStride  = Tst->getStride();
+  const int32 TstOffset  = y * TstStride;
+  const int32 RefStride  = Ref->getStride();
+  const int32 RefCenter  = SearchRange * RefStride + SearchRange;
+  const int32 WindowSize = xCorrespPixelShiftSpec::getWindowSize<SR>(SearchRange); //compile time constant for specialized kernels
+  const bool  ExactMatchShortcut = !GenDispMap && xCorrespPixelShiftSpec::isExactMatchShortcutValid(CmpWeights); //displacement of first zero error candidate may differ
+
+  const int16   GL = (int16)GlobalColorShift[0], GB = (int16)GlobalColorShift[1], GR = (int16)GlobalColorShift[2], GX = (int16)GlobalColorShift[3];
+  const __m256i GlobalColorShiftLB_I16_V = _mm256_setr_epi16(GL, GL, GL, GL, GB, GB, GB, GB, GL, GL, GL, GL, GB, GB, GB, GB);
+  const __m256i GlobalColorShiftRX_I16_V = _mm256_setr_epi16(GR, GR, GR, GR, GX, GX, GX, GX, GR, GR, GR, GR, GX, GX, GX, GX);
+  const __m256i CmpWeightL_I32_V         = _mm256_set1_epi32(CmpWeights[0]);
+  const __m256i CmpWeightB_I32_V         = _mm256_set1_epi32(CmpWeights[1]);
+  const __m256i CmpWeightR_I32_V         = _mm256_set1_epi32(CmpWeights[2]);
+  const __m256i PelIdx_I32_V             = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7); //pixel order after xDeinterleave
+  const __m256i Zero_V                   = _mm256_setzero_si256();
+
+  const uint16V4*    TstPtr = Tst->getAddr() + TstOffset;
+  const uint16V4*    RefPtr = Ref->getAddr() + (y - SearchRange) * RefStride - SearchRange;
+  uint16V4* restrict DstPtr = GenShftComp ? DstRef->getAddr() + TstOffset : nullptr;
+  const __m256i MaxValue_I16_V = _mm256_set1_epi16(GenShftComp ? (int16)DstRef->getMaxPelValue() : 0);
+  int16* restrict DispPtr = GenDispMap ? DispMap->getRowAddr(y) : nullptr;
+  const int32   MskStride = UseMask ? Msk->getStride() : 0;
+  const uint16* TstMskPtr = UseMask ? Msk->getAddr(eCmp::LM) + y * MskStride : nullptr;
+  const uint16* RefMskPtr = UseMask ? Msk->getAddr(eCmp::LM) + (y - SearchRange) * MskStride - SearchRange : nullptr;
+
+  __m256i RowDistL_U64_V = _mm256_setzero_si256();
+  __m256i RowDistB_U64_V = _mm256_setzero_si256();
+  __m256i RowDistR_U64_V = _mm256_setzero_si256();
+  int32   NumExactMatch  = 0;
+
+  for(int32 x = 0; x < Width; x += 8)
+  {
+    const int32   BlockX      = xMin(x, Width - 8); //last block overlaps previous one
+    const __m256i Valid_I32_V = _mm256_cmpgt_epi32(PelIdx_I32_V, _mm256_set1_epi32(x - BlockX - 1)); //skip already processed pixels
+
+    __m256i TstLB_I16_V, TstRX_I16_V;
+    xDeinterleave(TstLB_I16_V, TstRX_I16_V, _mm256_loadu_si256((__m256i*)(TstPtr + BlockX)), _mm256_loadu_si256((__m256i*)(TstPtr + BlockX + 4)));
+    TstLB_I16_V = _mm256_add_epi16(TstLB_I16_V, GlobalColorShiftLB_I16_V); //TODO - xc_CLIP_CURR_TST_RANGE
+    TstRX_I16_V = _mm256_add_epi16(TstRX_I16_V, GlobalColorShiftRX_I16_V);
+    const __m128i TstMsk_U16_V = UseMask ? _mm_loadu_si128((__m128i*)(TstMskPtr + BlockX)) : _mm_setzero_si128(); //natural pixel order
+
+    __m256i BestError_I32_V = _mm256_set1_epi32(std::numeric_limits<int32>::max());
+    __m256i BestRefLB_U16_V = _mm256_setzero_si256();
+    __m256i BestRefRX_U16_V = _mm256_setzero_si256();
+    __m256i BestDisp_I32_V  = _mm256_setzero_si256();
+
+    //exact-match shortcut - all unmasked pixels equal to center candidate (zero error), remaining candidates cannot change the result
+    bool ExactMatch = false;
+    if(ExactMatchShortcut)
+    {
+      __m256i CntrLB_U16_V, CntrRX_U16_V;
+      xDeinterleave(CntrLB_U16_V, CntrRX_U16_V, _mm256_loadu_si256((__m256i*)(RefPtr + RefCenter + BlockX)), _mm256_loadu_si256((__m256i*)(RefPtr + RefCenter + BlockX + 4)));
+      __m256i Equal_I16_V = _mm256_and_si256(_mm256_cmpeq_epi16(TstLB_I16_V, CntrLB_U16_V), _mm256_cmpeq_epi16(TstRX_I16_V, CntrRX_U16_V)); //[L&R | B&X] in each lane
+      Equal_I16_V = _mm256_and_si256(Equal_I16_V, _mm256_srli_si256(Equal_I16_V, 8));
+      const __m256i Equal_I32_V    = _mm256_unpacklo_epi16(Equal_I16_V, Equal_I16_V); //xDeinterleave pixel order
+      const __m256i Required_I32_V = UseMask ? _mm256_xor_si256(_mm256_cmpeq_epi32(xToPelOrder(TstMsk_U16_V), Zero_V), _mm256_set1_epi32(-1)) : _mm256_set1_epi32(-1);
+      if(_mm256_testc_si256(Equal_I32_V, Required_I32_V))
+      {
+        BestRefLB_U16_V = CntrLB_U16_V;
+        BestRefRX_U16_V = CntrRX_U16_V;
+        NumExactMatch  += _mm_popcnt_u32(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(Required_I32_V, Valid_I32_V))));
+        ExactMatch      = true;
+      }
+    }
+
+    if(!ExactMatch)
+    {
+      for(int32 dy = 0; dy < WindowSize; dy++)
+      {
+        const uint16V4* RefPtrY = RefPtr + dy * RefStride + BlockX;
+        const uint16*   MskPtrY = UseMask ? RefMskPtr + dy * MskStride + BlockX : nullptr;
+        for(int32 dx = 0; dx < WindowSize; dx++)
+        {
+          __m256i RefLB_U16_V, RefRX_U16_V;
+          xDeinterleave(RefLB_U16_V, RefRX_U16_V, _mm256_loadu_si256((__m256i*)(RefPtrY + dx)), _mm256_loadu_si256((__m256i*)(RefPtrY + dx + 4)));
+          __m256i DistL_I32_V, DistB_I32_V, DistR_I32_V;
+          xCalcDist(DistL_I32_V, DistB_I32_V, DistR_I32_V, TstLB_I16_V, TstRX_I16_V, RefLB_U16_V, RefRX_U16_V);
+          __m256i Error_I32_V  = xCalcError<DefCmpWeights>(DistL_I32_V, DistB_I32_V, DistR_I32_V, CmpWeightL_I32_V, CmpWeightB_I32_V, CmpWeightR_I32_V);
+          if constexpr(UseMask) //masked candidates gets max error, so they are never selected
+          {
+            __m256i RefMsk_I32_V = xToPelOrder(_mm_loadu_si128((__m128i*)(MskPtrY + dx)));
+            Error_I32_V = _mm256_or_si256(Error_I32_V, _mm256_srli_epi32(_mm256_cmpeq_epi32(RefMsk_I32_V, Zero_V), 1));
+          }
+          __m256i Better_I32_V = _mm256_cmpgt_epi32(BestError_I32_V, Error_I32_V);
+          __m256i Better_I16_V = _mm256_packs_epi32(Better_I32_V, Better_I32_V); //matches LB and RX layout
+          BestError_I32_V = _mm256_min_epi32  (BestError_I32_V, Error_I32_V);
+          BestRefLB_U16_V = _mm256_blendv_epi8(BestRefLB_U16_V, RefLB_U16_V, Better_I16_V);
+          BestRefRX_U16_V = _mm256_blendv_epi8(BestRefRX_U16_V, RefRX_U16_V, Better_I16_V);
+          if constexpr(GenDispMap) { BestDisp_I32_V = _mm256_blendv_epi8(BestDisp_I32_V, _mm256_set1_epi32(xDispMapUtils::pack(dx - SearchRange, dy - SearchRange)), Better_I32_V); }
+        } //dx
+      } //dy
+    }
+
+    if constexpr(CalcDist)
+    {
+      __m256i BestDistL_I32_V, BestDistB_I32_V, BestDistR_I32_V;
+      xCalcDist(BestDistL_I32_V, BestDistB_I32_V, BestDistR_I32_V, TstLB_I16_V, TstRX_I16_V, BestRefLB_U16_V, BestRefRX_U16_V);
+      BestDistL_I32_V = _mm256_and_si256(BestDistL_I32_V, Valid_I32_V);
+      BestDistB_I32_V = _mm256_and_si256(BestDistB_I32_V, Valid_I32_V);
+      BestDistR_I32_V = _mm256_and_si256(BestDistR_I32_V, Valid_I32_V);
+      if constexpr(UseMask) //distortion weighted by mask value (masked pixels gets zero weight)
+      {
+        const __m256i TstMsk_I32_V = xToPelOrder(TstMsk_U16_V);
+        RowDistL_U64_V = _mm256_add_epi64(RowDistL_U64_V, xMulU32ToU64(BestDistL_I32_V, TstMsk_I32_V));
+        RowDistB_U64_V = _mm256_add_epi64(RowDistB_U64_V, xMulU32ToU64(BestDistB_I32_V, TstMsk_I32_V));
+        RowDistR_U64_V = _mm256_add_epi64(RowDistR_U64_V, xMulU32ToU64(BestDistR_I32_V, TstMsk_I32_V));
+      }
+      else
+      {
+        RowDistL_U64_V = _mm256_add_epi64(RowDistL_U64_V, _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(BestDistL_I32_V)), _mm256_cvtepu32_epi64(_mm256_extracti128_si256(BestDistL_I32_V, 1))));
+        RowDistB_U64_V = _mm256_add_epi64(RowDistB_U64_V, _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(BestDistB_I32_V)), _mm256_cvtepu32_epi64(_mm256_extracti128_si256(BestDistB_I32_V, 1))));
+        RowDistR_U64_V = _mm256_add_epi64(RowDistR_U64_V, _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(BestDistR_I32_V)), _mm256_cvtepu32_epi64(_mm256_extracti128_si256(BestDistR_I32_V, 1))));
+      }
+    }
+
+    if constexpr(GenShftComp) //overlapped pixels are written twice with the same value
+    {
+      __m256i DstLB_U16_V = _mm256_min_epi16(_mm256_max_epi16(_mm256_sub_epi16(BestRefLB_U16_V, GlobalColorShiftLB_I16_V), Zero_V), MaxValue_I16_V);
+      __m256i DstRX_U16_V = _mm256_min_epi16(_mm256_max_epi16(_mm256_sub_epi16(BestRefRX_U16_V, GlobalColorShiftRX_I16_V), Zero_V), MaxValue_I16_V);
+      __m256i DstA_U16_V, DstB_U16_V;
+      xInterleave(DstA_U16_V, DstB_U16_V, DstLB_U16_V, DstRX_U16_V);
+      if constexpr(UseMask) //masked pixels are left untouched
+      {
+        const __m128i Store_I16_V = _mm_xor_si128(_mm_cmpeq_epi16(TstMsk_U16_V, _mm_setzero_si128()), _mm_set1_epi32(-1));
+        _mm256_maskstore_epi64((long long*)(DstPtr + BlockX    ), _mm256_cvtepi16_epi64(Store_I16_V                   ), DstA_U16_V);
+        _mm256_maskstore_epi64((long long*)(DstPtr + BlockX + 4), _mm256_cvtepi16_epi64(_mm_srli_si128(Store_I16_V, 8)), DstB_U16_V);
+      }
+      else
+      {
+        _mm256_storeu_si256((__m256i*)(DstPtr + BlockX    ), DstA_U16_V);
+        _mm256_storeu_si256((__m256i*)(DstPtr + BlockX + 4), DstB_U16_V);
+      }
+    }
+
+    if constexpr(GenDispMap) //back to natural pixel order, packed displacements fits int16
+    {
+      __m256i Disp_I32_V = _mm256_permutevar8x32_epi32(BestDisp_I32_V, PelIdx_I32_V);
+      __m256i Disp_I16_V = _mm256_permute4x64_epi64(_mm256_packs_epi32(Disp_I32_V, Disp_I32_V), 0b10001000);
+      _mm_storeu_si128((__m128i*)(DispPtr + BlockX), _mm256_castsi256_si128(Disp_I16_V));
+    }
+  } //x
+
+  if(NumExactMatchPels != nullptr) { *NumExactMatchPels = NumExactMatch; }
+  if constexpr(CalcDist)
+  {
+    uint64V4 RowDist = { (uint64)xHorVecSumI64_epi64(RowDistL_U64_V), (uint64)xHorVecSumI64_epi64(RowDistB_U64_V), (uint64)xHorVecSumI64_epi64(RowDistR_U64_V), 0 };
+    return RowDist;
+  }
+  else { return xMakeVec4<uint64>(0); }
+}
+__m256i xCorrespPixelShiftAVX::xToPelOrder(const __m128i& Msk_U16_V)
+{
+  //[01 23 45 67] --> [01 45 23 67] then zero extend
+  return _mm256_cvtepu16_epi32(_mm_shuffle_epi32(Msk_U16_V, 0b11011000));
+}
+__m256i xCorrespPixelShiftAVX::xMulU32ToU64(const __m256i& A_U32_V, const __m256i& B_U32_V)
+{
+  //products of even and odd 32-bit lanes, summed pairwise
+  __m256i Even_U64_V = _mm256_mul_epu32(A_U32_V, B_U32_V);
+  __m256i Odd_U64_V  = _mm256_mul_epu32(_mm256_srli_epi64(A_U32_V, 32), _mm256_srli_epi64(B_U32_V, 32));
+  return _mm256_add_epi64(Even_U64_V, Odd_U64_V);
+}
+void xCorrespPixelShiftAVX::xCalcDist(__m256i& DistL_I32_V, __m256i& DistB_I32_V, __m256i& DistR_I32_V, const __m256i& TstLB_I16_V, const __m256i& TstRX_I16_V, const __m256i& RefLB_U16_V, const __m256i& RefRX_U16_V)
+{
+  const __m256i Zero_V = _mm256_setzero_si256();
+  __m256i DiffLB_I16_V = _mm256_sub_epi16(TstLB_I16_V, RefLB_U16_V);
+  __m256i DiffRX_I16_V = _mm256_sub_epi16(TstRX_I16_V, RefRX_U16_V);
+  //upper halves are zero, so madd gives exact square
+  __m256i DiffL_I32_V  = _mm256_unpacklo_epi16(DiffLB_I16_V, Zero_V);
+  __m256i DiffB_I32_V  = _mm256_unpackhi_epi16(DiffLB_I16_V, Zero_V);
+  __m256i DiffR_I32_V  = _mm256_unpacklo_epi16(DiffRX_I16_V, Zero_V);
+  DistL_I32_V = _mm256_madd_epi16(DiffL_I32_V, DiffL_I32_V);
+  DistB_I32_V = _mm256_madd_epi16(DiffB_I32_V, DiffB_I32_V);
+  DistR_I32_V = _mm256_madd_epi16(DiffR_I32_V, DiffR_I32_V);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// (de)interleaving
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void xCorrespPixelShiftAVX::xDeinterleave(__m256i& LB_U16_V, __m256i& RX_U16_V, const __m256i& PelsA_U16_V, const __m256i& PelsB_U16_V)
+{
+  //[L0 B0 R0 X0 L1 B1 R1 X1] --> [L0 L1 B0 B1 R0 R1 X0 X1] (within 128-bit lane)
+  const __m256i ShuffleCtrl = _mm256_setr_epi8(0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15, 0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+  __m256i A_U16_V = _mm256_shuffle_epi8(PelsA_U16_V, ShuffleCtrl);
+  __m256i B_U16_V = _mm256_shuffle_epi8(PelsB_U16_V, ShuffleCtrl);
+  LB_U16_V = _mm256_unpacklo_epi32(A_U16_V, B_U16_V);
+  RX_U16_V = _mm256_unpackhi_epi32(A_U16_V, B_U16_V);
+}
+void xCorrespPixelShiftAVX::xInterleave(__m256i& PelsA_U16_V, __m256i& PelsB_U16_V, const __m256i& LB_U16_V, const __m256i& RX_U16_V)
+{
+  //[L0 L1 B0 B1 R0 R1 X0 X1] --> [L0 B0 R0 X0 L1 B1 R1 X1] (within 128-bit lane)
+  const __m256i ShuffleCtrl = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15, 0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+  __m256i LR_U16_V = _mm256_unpacklo_epi32(LB_U16_V, RX_U16_V);
+  __m256i BX_U16_V = _mm256_unpackhi_epi32(LB_U16_V, RX_U16_V);
+  PelsA_U16_V = _mm256_shuffle_epi8(_mm256_unpacklo_epi32(LR_U16_V, BX_U16_V), ShuffleCtrl);
+  PelsB_U16_V = _mm256_shuffle_epi8(_mm256_unpackhi_epi32(LR_U16_V, BX_U16_V), ShuffleCtrl);
+}
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
+
+#endif //X_SIMD_CAN_USE_AVX
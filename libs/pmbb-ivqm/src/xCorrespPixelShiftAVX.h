@@ -0,0 +1,73 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+#include "xCommonDefIVQM.h"
+#include "xPic.h"
+#include "xCorrespPixelShiftSTD.h"
+
+#if X_SIMD_CAN_USE_AVX
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+// processes 8 pixels at once, valid for BitDepth <= 14 (differences fits int16), falls back to STD otherwise
+//===============================================================================================================================================================================================================
+class xCorrespPixelShiftAVX
+{
+  //asymetric Q planar
+public:
+  static uint64V4 CalcDistAsymmetricRow(const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, nullptr); }
+  static uint64V4 CalcDistAsymmetricRow(const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels);
+
+  //asymetric Q interleaved
+public:
+  static uint64V4 CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, nullptr); }
+  static uint64V4 CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels);
+
+  //asymetric Q interleaved - with mask
+public:
+  static uint64V4 CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return CalcDistAsymmetricRowM(Tst, Ref, Msk, y, GlobalColorShift, SearchRange, CmpWeights, nullptr); }
+  static uint64V4 CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels);
+
+  //shift-compensated picture generation
+public:
+  static void GenShftCompRow (xPicP* DstRef, const xPicP* Ref, const xPicP* Tst,                   const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static void GenShftCompRow (xPicI* DstRef, const xPicI* Ref, const xPicI* Tst,                   const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static void GenShftCompRowM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+
+  //fused shift-compensated picture generation and asymetric Q (single search)
+public:
+  static uint64V4 GenShftCompRowAndCalcDist (xPicP* DstRef, const xPicP* Ref, const xPicP* Tst,                   const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static uint64V4 GenShftCompRowAndCalcDist (xPicI* DstRef, const xPicI* Ref, const xPicI* Tst,                   const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static uint64V4 GenShftCompRowAndCalcDistM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+
+  //displacement map generation (asymetric Q as side product)
+public:
+  static uint64V4 GenDispMapRowAndCalcDist(xDispMap* DispMap, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static uint64V4 GenDispMapRowAndCalcDist(xDispMap* DispMap, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+
+protected:
+  //selects kernel specialized for search range and weights (generic one otherwise)
+  template<bool CalcDist, bool GenShftComp, bool GenDispMap = false> static uint64V4 xProcessRowP(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, xDispMap* DispMap = nullptr, int32* NumExactMatchPels = nullptr);
+  template<bool CalcDist, bool GenShftComp, bool GenDispMap = false, bool UseMask = false> static uint64V4 xProcessRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, xDispMap* DispMap = nullptr, const xPicP* Msk = nullptr, int32* NumExactMatchPels = nullptr);
+  template<bool CalcDist, bool GenShftComp, bool GenDispMap, int32 SR, bool DefCmpWeights> static uint64V4 xSearchRowP(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, xDispMap* DispMap, int32* NumExactMatchPels);
+  template<bool CalcDist, bool GenShftComp, bool GenDispMap, bool UseMask, int32 SR, bool DefCmpWeights> static uint64V4 xSearchRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, xDispMap* DispMap, const xPicP* Msk, int32* NumExactMatchPels);
+  static inline __m256i xCalcDistP  (const __m256i& Tst_I32_V, const __m256i& Ref_I32_V);
+  template<bool DefCmpWeights> static inline __m256i xCalcError(const __m256i& DistL_I32_V, const __m256i& DistB_I32_V, const __m256i& DistR_I32_V, const __m256i& CmpWeightL_I32_V, const __m256i& CmpWeightB_I32_V, const __m256i& CmpWeightR_I32_V);
+  static inline __m128i xPackClipU16(const __m256i& Val_I32_V, const __m256i& MaxValue_I32_V);
+  static inline __m256i xToPelOrder (const __m128i& Msk_U16_V); //8 x uint16 mask values --> 8 x int32 in xDeinterleave pixel order
+  static inline __m256i xMulU32ToU64(const __m256i& A_U32_V, const __m256i& B_U32_V);
+  static inline void xCalcDist(__m256i& DistL_I32_V, __m256i& DistB_I32_V, __m256i& DistR_I32_V, const __m256i& TstLB_I16_V, const __m256i& TstRX_I16_V, const __m256i& RefLB_U16_V, const __m256i& RefRX_U16_V);
+
+  //8 interleaved pixels (LBRX) <--> [L0 L1 L4 L5 B0 B1 B4 B5 | L2 L3 L6 L7 B2 B3 B6 B7] + [R... X... | R... X...]
+  static inline void xDeinterleave(__m256i& LB_U16_V, __m256i& RX_U16_V, const __m256i& PelsA_U16_V, const __m256i& PelsB_U16_V);
+  static inline void xInterleave  (__m256i& PelsA_U16_V, __m256i& PelsB_U16_V, const __m256i& LB_U16_V, const __m256i& RX_U16_V);
+};
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
+
+#endif //X_SIMD_CAN_USE_AVX
@@ -0,0 +1,414 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "xCorrespPixelShiftAVX512.h"
+#include "xCorrespPixelShiftPrms.h"
+#include "xHelpersSIMD.h"
+
+#if X_SIMD_CAN_USE_AVX512
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//  asymetric Q planar
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftAVX512::CalcDistAsymmetricRow(const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels)
+{
+  assert(Tst->isCompatible(Ref));
+
+  if(Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+  return xProcessRowP<true, false>(nullptr, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//  asymetric Q interleaved
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftAVX512::CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels)
+{
+  assert(Tst->isCompatible(Ref));
+
+  if(Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+  return xProcessRow<true, false>(nullptr, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, nullptr, NumExactMatchPels);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//  asymetric Q interleaved - with mask
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftAVX512::CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels)
+{
+  assert(Tst->isCompatible(Ref));
+
+  if(Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::CalcDistAsymmetricRowM(Tst, Ref, Msk, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); }
+  return xProcessRow<true, false, true>(nullptr, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, Msk, NumExactMatchPels);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// shift-compensated picture generation
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void xCorrespPixelShiftAVX512::GenShftCompRow(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  if(Tst->getBitDepth() > 14) { xCorrespPixelShiftSTD::GenShftCompRow(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); return; }
+  xProcessRowP<false, true>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights);
+}
+void xCorrespPixelShiftAVX512::GenShftCompRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  if(Tst->getBitDepth() > 14) { xCorrespPixelShiftSTD::GenShftCompRow(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); return; }
+  xProcessRow<false, true>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights);
+}
+void xCorrespPixelShiftAVX512::GenShftCompRowM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  if(Tst->getBitDepth() > 14) { xCorrespPixelShiftSTD::GenShftCompRowM(DstRef, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); return; }
+  xProcessRow<false, true, true>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, Msk);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// fused shift-compensated picture generation and asymetric Q (single search)
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftAVX512::GenShftCompRowAndCalcDist(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+
+  if(Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+  return xProcessRowP<true, true>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights);
+}
+uint64V4 xCorrespPixelShiftAVX512::GenShftCompRowAndCalcDist(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+
+  if(Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights); }
+  return xProcessRow<true, true>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights);
+}
+uint64V4 xCorrespPixelShiftAVX512::GenShftCompRowAndCalcDistM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+
+  if(Tst->getBitDepth() > 14) { return xCorrespPixelShiftSTD::GenShftCompRowAndCalcDistM(DstRef, Ref, Tst, Msk, y, GlobalColorShift, SearchRange, CmpWeights); }
+  return xProcessRow<true, true, true>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, Msk);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// common search - planar
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template<bool CalcDist, bool GenShftComp> uint64V4 xCorrespPixelShiftAVX512::xProcessRowP(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels)
+{
+  return xCorrespPixelShiftSpec::select(SearchRange, CmpWeights, [&](auto SR, auto DCW) { return xSearchRowP<CalcDist, GenShftComp, decltype(SR)::value, decltype(DCW)::value>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, NumExactMatchPels); });
+}
+template<bool CalcDist, bool GenShftComp, int32 SR, bool DefCmpWeights> uint64V4 xCorrespPixelShiftAVX512::xSearchRowP(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels)
+{
+  const int32 Width      = Tst->getWidth ();
+  const int32 TstStride  = Tst->getStride();
+  const int32 TstOffset  = y * TstStride;
+  const int32 RefStride  = Ref->getStride();
+  const int32 RefOffset  = (y - SearchRange) * RefStride - SearchRange;
+  const int32 RefCenter  = SearchRange * RefStride + SearchRange;
+  const int32 WindowSize = xCorrespPixelShiftSpec::getWindowSize<SR>(SearchRange); //compile time constant for specialized kernels
+  const bool  ExactMatchShortcut = xCorrespPixelShiftSpec::isExactMatchShortcutValid(CmpWeights);
+
+  const __m512i GlobalColorShiftL_I32_V = _mm512_set1_epi32(GlobalColorShift[0]);
+  const __m512i GlobalColorShiftB_I32_V = _mm512_set1_epi32(GlobalColorShift[1]);
+  const __m512i GlobalColorShiftR_I32_V = _mm512_set1_epi32(GlobalColorShift[2]);
+  const __m512i CmpWeightL_I32_V        = _mm512_set1_epi32(CmpWeights[0]);
+  const __m512i CmpWeightB_I32_V        = _mm512_set1_epi32(CmpWeights[1]);
+  const __m512i CmpWeightR_I32_V        = _mm512_set1_epi32(CmpWeights[2]);
+  const __m512i Zero_V                  = _mm512_setzero_si512();
+
+  const uint16* TstPtrL = Tst->getAddr(eCmp::LM) + TstOffset;
+  const uint16* TstPtrB = Tst->getAddr(eCmp::CB) + TstOffset;
+  const uint16* TstPtrR = Tst->getAddr(eCmp::CR) + TstOffset;
+  const uint16* RefPtrL = Ref->getAddr(eCmp::LM) + RefOffset;
+  const uint16* RefPtrB = Ref->getAddr(eCmp::CB) + RefOffset;
+  const uint16* RefPtrR = Ref->getAddr(eCmp::CR) + RefOffset;
+  uint16* restrict DstPtrL = GenShftComp ? DstRef->getAddr(eCmp::LM) + TstOffset : nullptr;
+  uint16* restrict DstPtrB = GenShftComp ? DstRef->getAddr(eCmp::CB) + TstOffset : nullptr;
+  uint16* restrict DstPtrR = GenShftComp ? DstRef->getAddr(eCmp::CR) + TstOffset : nullptr;
+  const __m512i MaxValue_I32_V = _mm512_set1_epi32(GenShftComp ? DstRef->getMaxPelValue() : 0);
+
+  __m512i RowDistL_U64_V = _mm512_setzero_si512();
+  __m512i RowDistB_U64_V = _mm512_setzero_si512();
+  __m512i RowDistR_U64_V = _mm512_setzero_si512();
+  int32   NumExactMatch  = 0;
+
+  for(int32 x = 0; x < Width; x += 16)
+  {
+    const __mmask16 PelMask = (__mmask16)((1u << xMin(Width - x, 16)) - 1);
+
+    const __m512i TstL_I32_V = _mm512_add_epi32(_mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(PelMask, TstPtrL + x)), GlobalColorShiftL_I32_V); //TODO - xc_CLIP_CURR_TST_RANGE
+    const __m512i TstB_I32_V = _mm512_add_epi32(_mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(PelMask, TstPtrB + x)), GlobalColorShiftB_I32_V);
+    const __m512i TstR_I32_V = _mm512_add_epi32(_mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(PelMask, TstPtrR + x)), GlobalColorShiftR_I32_V);
+
+    __m512i BestError_I32_V = _mm512_set1_epi32(std::numeric_limits<int32>::max());
+    __m512i BestRefL_I32_V  = _mm512_setzero_si512();
+    __m512i BestRefB_I32_V  = _mm512_setzero_si512();
+    __m512i BestRefR_I32_V  = _mm512_setzero_si512();
+
+    //exact-match shortcut - all pixels equal to center candidate (zero error), remaining candidates cannot change the result
+    bool ExactMatch = false;
+    if(ExactMatchShortcut)
+    {
+      const __m512i CntrL_I32_V = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(PelMask, RefPtrL + RefCenter + x));
+      const __m512i CntrB_I32_V = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(PelMask, RefPtrB + RefCenter + x));
+      const __m512i CntrR_I32_V = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(PelMask, RefPtrR + RefCenter + x));
+      const __mmask16 Equal = _mm512_cmpeq_epi32_mask(TstL_I32_V, CntrL_I32_V) & _mm512_cmpeq_epi32_mask(TstB_I32_V, CntrB_I32_V) & _mm512_cmpeq_epi32_mask(TstR_I32_V, CntrR_I32_V);
+      if((Equal & PelMask) == PelMask)
+      {
+        BestRefL_I32_V = CntrL_I32_V;
+        BestRefB_I32_V = CntrB_I32_V;
+        BestRefR_I32_V = CntrR_I32_V;
+        NumExactMatch += _mm_popcnt_u32(PelMask);
+        ExactMatch     = true;
+      }
+    }
+
+    if(!ExactMatch)
+    {
+      for(int32 dy = 0; dy < WindowSize; dy++)
+      {
+        const int32 RefOffsetY = dy * RefStride + x;
+        for(int32 dx = 0; dx < WindowSize; dx++)
+        {
+          const __m512i RefL_I32_V = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(PelMask, RefPtrL + RefOffsetY + dx));
+          const __m512i RefB_I32_V = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(PelMask, RefPtrB + RefOffsetY + dx));
+          const __m512i RefR_I32_V = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(PelMask, RefPtrR + RefOffsetY + dx));
+          __m512i Error_I32_V  = xCalcError<DefCmpWeights>(xCalcDistP(TstL_I32_V, RefL_I32_V), xCalcDistP(TstB_I32_V, RefB_I32_V), xCalcDistP(TstR_I32_V, RefR_I32_V), CmpWeightL_I32_V, CmpWeightB_I32_V, CmpWeightR_I32_V);
+          __mmask16 Better     = _mm512_cmpgt_epi32_mask(BestError_I32_V, Error_I32_V);
+          BestError_I32_V = _mm512_mask_mov_epi32(BestError_I32_V, Better, Error_I32_V);
+          BestRefL_I32_V  = _mm512_mask_mov_epi32(BestRefL_I32_V , Better, RefL_I32_V );
+          BestRefB_I32_V  = _mm512_mask_mov_epi32(BestRefB_I32_V , Better, RefB_I32_V );
+          BestRefR_I32_V  = _mm512_mask_mov_epi32(BestRefR_I32_V , Better, RefR_I32_V );
+        } //dx
+      } //dy
+    }
+
+    if constexpr(CalcDist)
+    {
+      __m512i BestDistL_I32_V = _mm512_maskz_mov_epi32(PelMask, xCalcDistP(TstL_I32_V, BestRefL_I32_V));
+      __m512i BestDistB_I32_V = _mm512_maskz_mov_epi32(PelMask, xCalcDistP(TstB_I32_V, BestRefB_I32_V));
+      __m512i BestDistR_I32_V = _mm512_maskz_mov_epi32(PelMask, xCalcDistP(TstR_I32_V, BestRefR_I32_V));
+      RowDistL_U64_V = _mm512_add_epi64(RowDistL_U64_V, _mm512_add_epi64(_mm512_cvtepu32_epi64(_mm512_castsi512_si256(BestDistL_I32_V)), _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(BestDistL_I32_V, 1))));
+      RowDistB_U64_V = _mm512_add_epi64(RowDistB_U64_V, _mm512_add_epi64(_mm512_cvtepu32_epi64(_mm512_castsi512_si256(BestDistB_I32_V)), _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(BestDistB_I32_V, 1))));
+      RowDistR_U64_V = _mm512_add_epi64(RowDistR_U64_V, _mm512_add_epi64(_mm512_cvtepu32_epi64(_mm512_castsi512_si256(BestDistR_I32_V)), _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(BestDistR_I32_V, 1))));
+    }
+
+    if constexpr(GenShftComp)
+    {
+      _mm256_mask_storeu_epi16(DstPtrL + x, PelMask, _mm512_cvtepi32_epi16(_mm512_min_epi32(_mm512_max_epi32(_mm512_sub_epi32(BestRefL_I32_V, GlobalColorShiftL_I32_V), Zero_V), MaxValue_I32_V)));
+      _mm256_mask_storeu_epi16(DstPtrB + x, PelMask, _mm512_cvtepi32_epi16(_mm512_min_epi32(_mm512_max_epi32(_mm512_sub_epi32(BestRefB_I32_V, GlobalColorShiftB_I32_V), Zero_V), MaxValue_I32_V)));
+      _mm256_mask_storeu_epi16(DstPtrR + x, PelMask, _mm512_cvtepi32_epi16(_mm512_min_epi32(_mm512_max_epi32(_mm512_sub_epi32(BestRefR_I32_V, GlobalColorShiftR_I32_V), Zero_V), MaxValue_I32_V)));
+    }
+  } //x
+
+  if(NumExactMatchPels != nullptr) { *NumExactMatchPels = NumExactMatch; }
+  if constexpr(CalcDist)
+  {
+    uint64V4 RowDist = { (uint64)xHorVecSumI64_epi64(RowDistL_U64_V), (uint64)xHorVecSumI64_epi64(RowDistB_U64_V), (uint64)xHorVecSumI64_epi64(RowDistR_U64_V), 0 };
+    return RowDist;
+  }
+  else { return xMakeVec4<uint64>(0); }
+}
+__m512i xCorrespPixelShiftAVX512::xCalcDistP(const __m512i& Tst_I32_V, const __m512i& Ref_I32_V)
+{
+  //abs diffs fits 15 bits (upper halves are zero), so madd gives exact square
+  __m512i Diff_I32_V = _mm512_abs_epi32(_mm512_sub_epi32(Tst_I32_V, Ref_I32_V));
+  return _mm512_madd_epi16(Diff_I32_V, Diff_I32_V);
+}
+template<bool DefCmpWeights> __m512i xCorrespPixelShiftAVX512::xCalcError(const __m512i& DistL_I32_V, const __m512i& DistB_I32_V, const __m512i& DistR_I32_V, const __m512i& CmpWeightL_I32_V, const __m512i& CmpWeightB_I32_V, const __m512i& CmpWeightR_I32_V)
+{
+  if constexpr(DefCmpWeights) //4:1:1 - shift instead of multiplications
+  {
+    return _mm512_add_epi32(_mm512_add_epi32(_mm512_slli_epi32(DistL_I32_V, 2), DistB_I32_V), DistR_I32_V);
+  }
+  else
+  {
+    return _mm512_add_epi32(_mm512_add_epi32(_mm512_mullo_epi32(DistL_I32_V, CmpWeightL_I32_V), _mm512_mullo_epi32(DistB_I32_V, CmpWeightB_I32_V)), _mm512_mullo_epi32(DistR_I32_V, CmpWeightR_I32_V));
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// common search - interleaved
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template<bool CalcDist, bool GenShftComp, bool UseMask> uint64V4 xCorrespPixelShiftAVX512::xProcessRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, const xPicP* Msk, int32* NumExactMatchPels)
+{
+  return xCorrespPixelShiftSpec::select(SearchRange, CmpWeights, [&](auto SR, auto DCW) { return xSearchRow<CalcDist, GenShftComp, UseMask, decltype(SR)::value, decltype(DCW)::value>(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights, Msk, NumExactMatchPels); });
+}
+template<bool CalcDist, bool GenShftComp, bool UseMask, int32 SR, bool DefCmpWeights> uint64V4 xCorrespPixelShiftAVX512::xSearchRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, const xPicP* Msk, int32* NumExactMatchPels)
+{
+  const int32 Width      = Tst->getWidth ();
+  const int32 TstStride  = Tst->getStride();
+  const int32 TstOffset  = y * TstStride;
+  const int32 RefStride  = Ref->getStride();
+  const int32 RefCenter  = SearchRange * RefStride + SearchRange;
+  const int32 WindowSize = xCorrespPixelShiftSpec::getWindowSize<SR>(SearchRange); //compile time constant for specialized kernels
+  const bool  ExactMatchShortcut = xCorrespPixelShiftSpec::isExactMatchShortcutValid(CmpWeights);
+
+  const __m512i GlobalColorShiftLB_I16_V = _mm512_mask_mov_epi16(_mm512_set1_epi16((int16)GlobalColorShift[0]), 0xFFFF0000, _mm512_set1_epi16((int16)GlobalColorShift[1]));
+  const __m512i GlobalColorShiftRX_I16_V = _mm512_mask_mov_epi16(_mm512_set1_epi16((int16)GlobalColorShift[2]), 0xFFFF0000, _mm512_set1_epi16((int16)GlobalColorShift[3]));
+  const __m512i CmpWeightL_I32_V         = _mm512_set1_epi32(CmpWeights[0]);
+  const __m512i CmpWeightB_I32_V         = _mm512_set1_epi32(CmpWeights[1]);
+  const __m512i CmpWeightR_I32_V         = _mm512_set1_epi32(CmpWeights[2]);
+  const __m512i Zero_V                   = _mm512_setzero_si512();
+
+  const uint16V4*    TstPtr = Tst->getAddr() + TstOffset;
+  const uint16V4*    RefPtr = Ref->getAddr() + (y - SearchRange) * RefStride - SearchRange;
+  uint16V4* restrict DstPtr = GenShftComp ? DstRef->getAddr() + TstOffset : nullptr;
+  const __m512i MaxValue_I16_V = _mm512_set1_epi16(GenShftComp ? (int16)DstRef->getMaxPelValue() : 0);
+  const int32   MskStride = UseMask ? Msk->getStride() : 0;
+  const uint16* TstMskPtr = UseMask ? Msk->getAddr(eCmp::LM) + y * MskStride : nullptr;
+  const uint16* RefMskPtr = UseMask ? Msk->getAddr(eCmp::LM) + (y - SearchRange) * MskStride - SearchRange : nullptr;
+
+  __m512i RowDistL_U64_V = _mm512_setzero_si512();
+  __m512i RowDistB_U64_V = _mm512_setzero_si512();
+  __m512i RowDistR_U64_V = _mm512_setzero_si512();
+  int32   NumExactMatch  = 0;
+
+  for(int32 x = 0; x < Width; x += 16)
+  {
+    const int32    NumPels   = xMin(Width - x, 16);
+    const __mmask8 LoadMaskA = (__mmask8)((1u << xMin(NumPels, 8)) - 1);
+    const __mmask8 LoadMaskB = (__mmask8)((1u << xMax(NumPels - 8, 0)) - 1);
+    const __mmask16 PelMask  = (__mmask16)((1u << NumPels) - 1);
+
+    __m512i TstLB_I16_V, TstRX_I16_V;
+    xDeinterleave(TstLB_I16_V, TstRX_I16_V, _mm512_maskz_loadu_epi64(LoadMaskA, TstPtr + x), _mm512_maskz_loadu_epi64(LoadMaskB, TstPtr + x + 8));
+    TstLB_I16_V = _mm512_add_epi16(TstLB_I16_V, GlobalColorShiftLB_I16_V); //TODO - xc_CLIP_CURR_TST_RANGE
+    TstRX_I16_V = _mm512_add_epi16(TstRX_I16_V, GlobalColorShiftRX_I16_V);
+    const __m256i   TstMsk_U16_V = UseMask ? _mm256_maskz_loadu_epi16(PelMask, TstMskPtr + x) : _mm256_setzero_si256();
+    const __mmask16 TstUnmasked  = UseMask ? _mm256_test_epi16_mask(TstMsk_U16_V, TstMsk_U16_V) : PelMask;
+
+    __m512i BestError_I32_V = _mm512_set1_epi32(std::numeric_limits<int32>::max());
+    __m512i BestRefLB_U16_V = _mm512_setzero_si512();
+    __m512i BestRefRX_U16_V = _mm512_setzero_si512();
+
+    //exact-match shortcut - all unmasked pixels equal to center candidate (zero error), remaining candidates cannot change the result
+    bool ExactMatch = false;
+    if(ExactMatchShortcut)
+    {
+      __m512i CntrLB_U16_V, CntrRX_U16_V;
+      xDeinterleave(CntrLB_U16_V, CntrRX_U16_V, _mm512_maskz_loadu_epi64(LoadMaskA, RefPtr + RefCenter + x), _mm512_maskz_loadu_epi64(LoadMaskB, RefPtr + RefCenter + x + 8));
+      const __mmask32 EqualLB = _mm512_cmpeq_epi16_mask(TstLB_I16_V, CntrLB_U16_V);
+      const __mmask32 EqualRX = _mm512_cmpeq_epi16_mask(TstRX_I16_V, CntrRX_U16_V);
+      const __mmask16 Equal   = (__mmask16)(EqualLB & (EqualLB >> 16) & EqualRX & (EqualRX >> 16));
+      if((Equal & TstUnmasked) == TstUnmasked)
+      {
+        BestRefLB_U16_V = CntrLB_U16_V;
+        BestRefRX_U16_V = CntrRX_U16_V;
+        NumExactMatch  += _mm_popcnt_u32(TstUnmasked);
+        ExactMatch      = true;
+      }
+    }
+
+    if(!ExactMatch)
+    {
+      for(int32 dy = 0; dy < WindowSize; dy++)
+      {
+        const uint16V4* RefPtrY = RefPtr + dy * RefStride + x;
+        const uint16*   MskPtrY = UseMask ? RefMskPtr + dy * MskStride + x : nullptr;
+        for(int32 dx = 0; dx < WindowSize; dx++)
+        {
+          __m512i RefLB_U16_V, RefRX_U16_V;
+          xDeinterleave(RefLB_U16_V, RefRX_U16_V, _mm512_maskz_loadu_epi64(LoadMaskA, RefPtrY + dx), _mm512_maskz_loadu_epi64(LoadMaskB, RefPtrY + dx + 8));
+          __m512i DistL_I32_V, DistB_I32_V, DistR_I32_V;
+          xCalcDist(DistL_I32_V, DistB_I32_V, DistR_I32_V, TstLB_I16_V, TstRX_I16_V, RefLB_U16_V, RefRX_U16_V);
+          __m512i Error_I32_V  = xCalcError<DefCmpWeights>(DistL_I32_V, DistB_I32_V, DistR_I32_V, CmpWeightL_I32_V, CmpWeightB_I32_V, CmpWeightR_I32_V);
+          __mmask16 Better     = _mm512_cmpgt_epi32_mask(BestError_I32_V, Error_I32_V);
+          if constexpr(UseMask) //masked candidates are never selected
+          {
+            __m256i RefMsk_U16_V = _mm256_maskz_loadu_epi16(PelMask, MskPtrY + dx);
+            Better = _kand_mask16(Better, _mm256_test_epi16_mask(RefMsk_U16_V, RefMsk_U16_V));
+          }
+          __mmask32 Better2x   = _mm512_kunpackw(Better, Better); //matches LB and RX layout
+          BestError_I32_V = _mm512_mask_mov_epi32(BestError_I32_V, Better  , Error_I32_V);
+          BestRefLB_U16_V = _mm512_mask_mov_epi16(BestRefLB_U16_V, Better2x, RefLB_U16_V);
+          BestRefRX_U16_V = _mm512_mask_mov_epi16(BestRefRX_U16_V, Better2x, RefRX_U16_V);
+        } //dx
+      } //dy
+    }
+
+    if constexpr(CalcDist)
+    {
+      __m512i BestDistL_I32_V, BestDistB_I32_V, BestDistR_I32_V;
+      xCalcDist(BestDistL_I32_V, BestDistB_I32_V, BestDistR_I32_V, TstLB_I16_V, TstRX_I16_V, BestRefLB_U16_V, BestRefRX_U16_V);
+      BestDistL_I32_V = _mm512_maskz_mov_epi32(PelMask, BestDistL_I32_V);
+      BestDistB_I32_V = _mm512_maskz_mov_epi32(PelMask, BestDistB_I32_V);
+      BestDistR_I32_V = _mm512_maskz_mov_epi32(PelMask, BestDistR_I32_V);
+      if constexpr(UseMask) //distortion weighted by mask value (masked and tail pixels gets zero weight)
+      {
+        const __m512i TstMsk_I32_V = _mm512_cvtepu16_epi32(TstMsk_U16_V);
+        RowDistL_U64_V = _mm512_add_epi64(RowDistL_U64_V, xMulU32ToU64(BestDistL_I32_V, TstMsk_I32_V));
+        RowDistB_U64_V = _mm512_add_epi64(RowDistB_U64_V, xMulU32ToU64(BestDistB_I32_V, TstMsk_I32_V));
+        RowDistR_U64_V = _mm512_add_epi64(RowDistR_U64_V, xMulU32ToU64(BestDistR_I32_V, TstMsk_I32_V));
+      }
+      else
+      {
+        RowDistL_U64_V = _mm512_add_epi64(RowDistL_U64_V, _mm512_add_epi64(_mm512_cvtepu32_epi64(_mm512_castsi512_si256(BestDistL_I32_V)), _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(BestDistL_I32_V, 1))));
+        RowDistB_U64_V = _mm512_add_epi64(RowDistB_U64_V, _mm512_add_epi64(_mm512_cvtepu32_epi64(_mm512_castsi512_si256(BestDistB_I32_V)), _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(BestDistB_I32_V, 1))));
+        RowDistR_U64_V = _mm512_add_epi64(RowDistR_U64_V, _mm512_add_epi64(_mm512_cvtepu32_epi64(_mm512_castsi512_si256(BestDistR_I32_V)), _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(BestDistR_I32_V, 1))));
+      }
+    }
+
+    if constexpr(GenShftComp)
+    {
+      __m512i DstLB_U16_V = _mm512_min_epi16(_mm512_max_epi16(_mm512_sub_epi16(BestRefLB_U16_V, GlobalColorShiftLB_I16_V), Zero_V), MaxValue_I16_V);
+      __m512i DstRX_U16_V = _mm512_min_epi16(_mm512_max_epi16(_mm512_sub_epi16(BestRefRX_U16_V, GlobalColorShiftRX_I16_V), Zero_V), MaxValue_I16_V);
+      __m512i DstA_U16_V, DstB_U16_V;
+      xInterleave(DstA_U16_V, DstB_U16_V, DstLB_U16_V, DstRX_U16_V);
+      //masked pixels are left untouched
+      _mm512_mask_storeu_epi64(DstPtr + x    , (__mmask8)(TstUnmasked     ), DstA_U16_V);
+      _mm512_mask_storeu_epi64(DstPtr + x + 8, (__mmask8)(TstUnmasked >> 8), DstB_U16_V);
+    }
+  } //x
+
+  if(NumExactMatchPels != nullptr) { *NumExactMatchPels = NumExactMatch; }
+  if constexpr(CalcDist)
+  {
+    uint64V4 RowDist = { (uint64)xHorVecSumI64_epi64(RowDistL_U64_V), (uint64)xHorVecSumI64_epi64(RowDistB_U64_V), (uint64)xHorVecSumI64_epi64(RowDistR_U64_V), 0 };
+    return RowDist;
+  }
+  else { return xMakeVec4<uint64>(0); }
+}
+__m512i xCorrespPixelShiftAVX512::xMulU32ToU64(const __m512i& A_U32_V, const __m512i& B_U32_V)
+{
+  //products of even and odd 32-bit lanes, summed pairwise
+  __m512i Even_U64_V = _mm512_mul_epu32(A_U32_V, B_U32_V);
+  __m512i Odd_U64_V  = _mm512_mul_epu32(_mm512_srli_epi64(A_U32_V, 32), _mm512_srli_epi64(B_U32_V, 32));
+  return _mm512_add_epi64(Even_U64_V, Odd_U64_V);
+}
+void xCorrespPixelShiftAVX512::xCalcDist(__m512i& DistL_I32_V, __m512i& DistB_I32_V, __m512i& DistR_I32_V, const __m512i& TstLB_I16_V, const __m512i& TstRX_I16_V, const __m512i& RefLB_U16_V, const __m512i& RefRX_U16_V)
+{
+  //abs diffs fits 15 bits, so madd of zero extended values gives exact square
+  __m512i DiffLB_U16_V = _mm512_abs_epi16(_mm512_sub_epi16(TstLB_I16_V, RefLB_U16_V));
+  __m512i DiffRX_U16_V = _mm512_abs_epi16(_mm512_sub_epi16(TstRX_I16_V, RefRX_U16_V));
+  __m512i DiffL_I32_V  = _mm512_cvtepu16_epi32(_mm512_castsi512_si256   (DiffLB_U16_V   ));
+  __m512i DiffB_I32_V  = _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(DiffLB_U16_V, 1));
+  __m512i DiffR_I32_V  = _mm512_cvtepu16_epi32(_mm512_castsi512_si256   (DiffRX_U16_V   ));
+  DistL_I32_V = _mm512_madd_epi16(DiffL_I32_V, DiffL_I32_V);
+  DistB_I32_V = _mm512_madd_epi16(DiffB_I32_V, DiffB_I32_V);
+  DistR_I32_V = _mm512_madd_epi16(DiffR_I32_V, DiffR_I32_V);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// (de)interleaving
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void xCorrespPixelShiftAVX512::xDeinterleave(__m512i& LB_U16_V, __m512i& RX_U16_V, const __m512i& PelsA_U16_V, const __m512i& PelsB_U16_V)
+{
+  const __m512i IdxLB = _mm512_setr_epi16(0, 4, 8, 12, 16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60, 1, 5, 9, 13, 17, 21, 25, 29, 33, 37, 41, 45, 49, 53, 57, 61);
+  const __m512i IdxRX = _mm512_setr_epi16(2, 6, 10, 14, 18, 22, 26, 30, 34, 38, 42, 46, 50, 54, 58, 62, 3, 7, 11, 15, 19, 23, 27, 31, 35, 39, 43, 47, 51, 55, 59, 63);
+  LB_U16_V = _mm512_permutex2var_epi16(PelsA_U16_V, IdxLB, PelsB_U16_V);
+  RX_U16_V = _mm512_permutex2var_epi16(PelsA_U16_V, IdxRX, PelsB_U16_V);
+}
+void xCorrespPixelShiftAVX512::xInterleave(__m512i& PelsA_U16_V, __m512i& PelsB_U16_V, const __m512i& LB_U16_V, const __m512i& RX_U16_V)
+{
+  const __m512i IdxA = _mm512_setr_epi16(0, 16, 32, 48, 1, 17, 33, 49, 2, 18, 34, 50, 3, 19, 35, 51, 4, 20, 36, 52, 5, 21, 37, 53, 6, 22, 38, 54, 7, 23, 39, 55);
+  const __m512i IdxB = _mm512_setr_epi16(8, 24, 40, 56, 9, 25, 41, 57, 10, 26, 42, 58, 11, 27, 43, 59, 12, 28, 44, 60, 13, 29, 45, 61, 14, 30, 46, 62, 15, 31, 47, 63);
+  PelsA_U16_V = _mm512_permutex2var_epi16(LB_U16_V, IdxA, RX_U16_V);
+  PelsB_U16_V = _mm512_permutex2var_epi16(LB_U16_V, IdxB, RX_U16_V);
+}
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
+
+#endif //X_SIMD_CAN_USE_AVX512
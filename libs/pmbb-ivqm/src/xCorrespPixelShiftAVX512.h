@@ -0,0 +1,66 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+#include "xCommonDefIVQM.h"
+#include "xPic.h"
+#include "xCorrespPixelShiftSTD.h"
+
+#if X_SIMD_CAN_USE_AVX512
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+// processes 16 pixels at once (masked tail), valid for BitDepth <= 14 (differences fits int16), falls back to STD otherwise
+//===============================================================================================================================================================================================================
+class xCorrespPixelShiftAVX512
+{
+  //asymetric Q planar
+public:
+  static uint64V4 CalcDistAsymmetricRow(const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, nullptr); }
+  static uint64V4 CalcDistAsymmetricRow(const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels);
+
+  //asymetric Q interleaved
+public:
+  static uint64V4 CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, nullptr); }
+  static uint64V4 CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels);
+
+  //asymetric Q interleaved - with mask
+public:
+  static uint64V4 CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return CalcDistAsymmetricRowM(Tst, Ref, Msk, y, GlobalColorShift, SearchRange, CmpWeights, nullptr); }
+  static uint64V4 CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels);
+
+  //shift-compensated picture generation
+public:
+  static void GenShftCompRow (xPicP* DstRef, const xPicP* Ref, const xPicP* Tst,                   const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static void GenShftCompRow (xPicI* DstRef, const xPicI* Ref, const xPicI* Tst,                   const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static void GenShftCompRowM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+
+  //fused shift-compensated picture generation and asymetric Q (single search)
+public:
+  static uint64V4 GenShftCompRowAndCalcDist (xPicP* DstRef, const xPicP* Ref, const xPicP* Tst,                   const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static uint64V4 GenShftCompRowAndCalcDist (xPicI* DstRef, const xPicI* Ref, const xPicI* Tst,                   const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static uint64V4 GenShftCompRowAndCalcDistM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+
+protected:
+  //selects kernel specialized for search range and weights (generic one otherwise)
+  template<bool CalcDist, bool GenShftComp> static uint64V4 xProcessRowP(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels = nullptr);
+  template<bool CalcDist, bool GenShftComp, bool UseMask = false> static uint64V4 xProcessRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, const xPicP* Msk = nullptr, int32* NumExactMatchPels = nullptr);
+  template<bool CalcDist, bool GenShftComp, int32 SR, bool DefCmpWeights> static uint64V4 xSearchRowP(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels);
+  template<bool CalcDist, bool GenShftComp, bool UseMask, int32 SR, bool DefCmpWeights> static uint64V4 xSearchRow(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, const xPicP* Msk, int32* NumExactMatchPels);
+  static inline __m512i xCalcDistP  (const __m512i& Tst_I32_V, const __m512i& Ref_I32_V);
+  template<bool DefCmpWeights> static inline __m512i xCalcError(const __m512i& DistL_I32_V, const __m512i& DistB_I32_V, const __m512i& DistR_I32_V, const __m512i& CmpWeightL_I32_V, const __m512i& CmpWeightB_I32_V, const __m512i& CmpWeightR_I32_V);
+  static inline __m512i xMulU32ToU64(const __m512i& A_U32_V, const __m512i& B_U32_V);
+  static inline void xCalcDist(__m512i& DistL_I32_V, __m512i& DistB_I32_V, __m512i& DistR_I32_V, const __m512i& TstLB_I16_V, const __m512i& TstRX_I16_V, const __m512i& RefLB_U16_V, const __m512i& RefRX_U16_V);
+
+  //16 interleaved pixels (LBRX) <--> [L0...L15 B0...B15] + [R0...R15 X0...X15]
+  static inline void xDeinterleave(__m512i& LB_U16_V, __m512i& RX_U16_V, const __m512i& PelsA_U16_V, const __m512i& PelsB_U16_V);
+  static inline void xInterleave  (__m512i& PelsA_U16_V, __m512i& PelsB_U16_V, const __m512i& LB_U16_V, const __m512i& RX_U16_V);
+};
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
+
+#endif //X_SIMD_CAN_USE_AVX512
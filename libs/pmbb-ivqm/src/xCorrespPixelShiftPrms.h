@@ -32,6 +32,49 @@ public:
   void  setCmpWeightsAverage(const int32V4& CmpWeightsAverage) { m_CmpWeightsAverage = CmpWeightsAverage; }
 };
 
+//===============================================================================================================================================================================================================
+// Corresponding Pixel Shift - compile time kernel specialization
+//===============================================================================================================================================================================================================
+
+class xCorrespPixelShiftSpec
+{
+public:
+  //default (4:1:1) weights allows to replace multiplications with shift, weights are ignored if build without USE_RUNTIME_CMPWEIGHTS
+  static inline bool isDefaultCmpWeights(const int32V4& CmpWeights)
+  {
+    if constexpr(!xc_USE_RUNTIME_CMPWEIGHTS) { return true; }
+    const int32V4& D = xCorrespPixelShiftPrms::c_DefaultCmpWeights;
+    return CmpWeights[0] == D[0] && CmpWeights[1] == D[1] && CmpWeights[2] == D[2];
+  }
+
+  //with all weights positive zero error means that candidate equals tested pixel - center candidate matching exactly gives the same result as exhaustive search
+  static inline bool isExactMatchShortcutValid(const int32V4& CmpWeights) { return CmpWeights[0] > 0 && CmpWeights[1] > 0 && CmpWeights[2] > 0; }
+
+  //calls Kernel(std::integral_constant<int32, SR>, std::integral_constant<bool, DefaultCmpWeights>), specialized for SR = 1..4, SR=0 denotes generic kernel (search range known at runtime only)
+  template<class tKernel> static inline decltype(auto) select(const int32 SearchRange, const int32V4& CmpWeights, tKernel&& Kernel)
+  {
+    if(isDefaultCmpWeights(CmpWeights)) { return xSelectSearchRange<true >(SearchRange, Kernel); }
+    else                                { return xSelectSearchRange<false>(SearchRange, Kernel); }
+  }
+
+  //window size known at compile time for specialized kernels (constant trip count allows compiler to fully unroll candidate loops)
+  template<int32 SR> static constexpr int32 getWindowSize(const int32 SearchRange) { return ((SR > 0 ? SR : SearchRange) << 1) + 1; }
+
+protected:
+  template<bool DefaultCmpWeights, class tKernel> static inline decltype(auto) xSelectSearchRange(const int32 SearchRange, tKernel& Kernel)
+  {
+    using tDCW = std::integral_constant<bool, DefaultCmpWeights>;
+    switch(SearchRange)
+    {
+      case 1 : return Kernel(std::integral_constant<int32, 1>{}, tDCW{});
+      case 2 : return Kernel(std::integral_constant<int32, 2>{}, tDCW{});
+      case 3 : return Kernel(std::integral_constant<int32, 3>{}, tDCW{});
+      case 4 : return Kernel(std::integral_constant<int32, 4>{}, tDCW{});
+      default: return Kernel(std::integral_constant<int32, 0>{}, tDCW{});
+    }
+  }
+};
+
 //===============================================================================================================================================================================================================
 
 } //end of namespace PMBB
@@ -4,6 +4,7 @@
 */
 
 #include "xCorrespPixelShiftSSE.h"
+#include "xCorrespPixelShiftPrms.h"
 #include "xHelpersSIMD.h"
 
 #if X_SIMD_CAN_USE_SSE
@@ -15,7 +16,7 @@ namespace PMBB_NAMESPACE {
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 //  asymetric Q interleaved
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-uint64V4 xCorrespPixelShiftSSE::CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+uint64V4 xCorrespPixelShiftSSE::CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels)
 {
   assert(Tst->isCompatible(Ref));
 
@@ -24,17 +25,22 @@ uint64V4 xCorrespPixelShiftSSE::CalcDistAsymmetricRow(const xPicI* Tst, const xP
   const int32   TstOffset         = y * TstStride;
   const __m128i CmpWeightsV       = _mm_loadu_si128((__m128i*) &CmpWeights);
   const __m128i GlobalColorShiftV = _mm_loadu_si128((__m128i*) &GlobalColorShift);
+  const bool    ExactMatchShortcut = xCorrespPixelShiftSpec::isExactMatchShortcutValid(CmpWeights);
 
   const uint16V4* TstPtr = Tst->getAddr() + TstOffset;
-  __m128i RowDistV = _mm_setzero_si128();
+  const uint16V4* RefPtr = Ref->getAddr() + y * Ref->getStride();
+  __m128i RowDistV      = _mm_setzero_si128();
+  int32   NumExactMatch = 0;
   for (int32 x = 0; x < Width; x++)
   {
     __m128i TstU16V  = _mm_loadl_epi64((__m128i*)(TstPtr + x));
     __m128i TstV     = _mm_add_epi32(_mm_unpacklo_epi16(TstU16V, _mm_setzero_si128()), GlobalColorShiftV); //TODO - xc_CLIP_CURR_TST_RANGE
+    if(ExactMatchShortcut && _mm_movemask_epi8(_mm_cmpeq_epi32(TstV, _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)(RefPtr + x))))) == 0xFFFF) { NumExactMatch++; continue; } //zero distortion
     __m128i BestDist = xCalcDistWithinBlock(TstV, Ref, x, y, SearchRange, CmpWeightsV);
     RowDistV = _mm_add_epi32(RowDistV, BestDist);
   }//x
 
+  if(NumExactMatchPels != nullptr) { *NumExactMatchPels = NumExactMatch; }
   int32V4 RowDist;
   _mm_storeu_si128((__m128i*)&RowDist, RowDistV);
   return (uint64V4)RowDist;
@@ -69,6 +75,84 @@ __m128i xCorrespPixelShiftSSE::xCalcDistWithinBlock(const __m128i& TstPelV, cons
   return BestDistV;
 }
 
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// asymetric Q interleaved - with mask
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftSSE::CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels)
+{
+  assert(Tst->isCompatible(Ref));
+
+  const int32 Width     = Tst->getWidth ();
+  const int32 TstStride = Tst->getStride();
+  const int32 TstOffset = y * TstStride;
+  const int32 MskOffset = y * Msk->getStride();
+  const bool  ExactMatchShortcut = xCorrespPixelShiftSpec::isExactMatchShortcutValid(CmpWeights);
+
+  const __m128i CmpWeightsI32V       = _mm_loadu_si128((__m128i*)(&CmpWeights      ));
+  const __m128i GlobalColorShiftI32V = _mm_loadu_si128((__m128i*)(&GlobalColorShift));
+
+  const uint16V4* TstPtr = Tst->getAddr(        ) + TstOffset;
+  const uint16V4* RefPtr = Ref->getAddr(        ) + y * Ref->getStride();
+  const uint16*   MskPtr = Msk->getAddr(eCmp::LM) + MskOffset;
+
+  __m128i RowDistLBU64V = _mm_setzero_si128();
+  __m128i RowDistRXU64V = _mm_setzero_si128();
+  int32   NumExactMatch = 0;
+  for(int32 x = 0; x < Width; x++)
+  {
+    const int32 CurrMskValue = (int32)MskPtr[x];
+    if(CurrMskValue == 0) { continue; } //skip masked pixels
+    __m128i TstU16V  = _mm_loadl_epi64((__m128i*)(TstPtr + x));
+    __m128i TstI32V  = _mm_add_epi32(_mm_unpacklo_epi16(TstU16V, _mm_setzero_si128()), GlobalColorShiftI32V); //TODO - xc_CLIP_CURR_TST_RANGE
+    if(ExactMatchShortcut && _mm_movemask_epi8(_mm_cmpeq_epi32(TstI32V, _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)(RefPtr + x))))) == 0xFFFF) { NumExactMatch++; continue; } //zero distortion
+    __m128i RefI32V  = xFindBestPixelWithinBlockM(TstI32V, Ref, Msk, x, y, SearchRange, CmpWeightsI32V);
+    __m128i DiffI32V = _mm_sub_epi32  (TstI32V, RefI32V);
+    __m128i DistI32V = _mm_mullo_epi32(DiffI32V, DiffI32V);
+    __m128i MskU64V  = _mm_set1_epi64x(CurrMskValue);
+    RowDistLBU64V    = _mm_add_epi64  (RowDistLBU64V, _mm_mul_epu32(_mm_cvtepu32_epi64(DistI32V                    ), MskU64V));
+    RowDistRXU64V    = _mm_add_epi64  (RowDistRXU64V, _mm_mul_epu32(_mm_cvtepu32_epi64(_mm_srli_si128(DistI32V, 8)), MskU64V));
+  }//x
+
+  if(NumExactMatchPels != nullptr) { *NumExactMatchPels = NumExactMatch; }
+  uint64V4 RowDist;
+  _mm_storeu_si128((__m128i*)&RowDist[0], RowDistLBU64V);
+  _mm_storeu_si128((__m128i*)&RowDist[2], RowDistRXU64V);
+  return RowDist;
+}
+__m128i xCorrespPixelShiftSSE::xFindBestPixelWithinBlockM(const __m128i& TstPelI32V, const xPicI* Ref, const xPicP* Msk, const int32 CenterX, const int32 CenterY, const int32 SearchRange, const __m128i& CmpWeightsI32V)
+{
+  const int32 BegY = CenterY - SearchRange;
+  const int32 EndY = CenterY + SearchRange;
+  const int32 BegX = CenterX - SearchRange;
+  const int32 EndX = CenterX + SearchRange;
+
+  const uint16V4* RefPtr    = Ref->getAddr  ();
+  const int32     RefStride = Ref->getStride();
+  const uint16*   MskPtr    = Msk->getAddr  (eCmp::LM);
+  const int32     MskStride = Msk->getStride();
+
+  int32   BestError     = std::numeric_limits<int32>::max();
+  __m128i BestPixelI32V = _mm_setzero_si128();
+
+  for(int32 y = BegY; y <= EndY; y++)
+  {
+    const uint16V4* RefPtrY = RefPtr + y * RefStride;
+    const uint16*   MskPtrY = MskPtr + y * MskStride;
+    for(int32 x = BegX; x <= EndX; x++)
+    {
+      if(MskPtrY[x] == 0) { continue; }
+      __m128i RefI32V   = _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)(RefPtrY + x)));
+      __m128i DiffI32V  = _mm_sub_epi32    (TstPelI32V, RefI32V);
+      __m128i DistI32V  = _mm_mullo_epi32  (DiffI32V, DiffI32V);
+      __m128i ErrorI32V = _mm_mullo_epi32  (DistI32V, CmpWeightsI32V);
+      int32   Error     = xHorVecSumI32_epi32(ErrorI32V);
+      if (Error < BestError) { BestError = Error; BestPixelI32V = RefI32V; }
+    } //x
+  } //y
+
+  return BestPixelI32V;
+}
+
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // shift-compensated picture generation
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -96,6 +180,33 @@ void xCorrespPixelShiftSSE::GenShftCompRow(xPicI* DstRef, const xPicI* Ref, cons
     _mm_storel_epi64((__m128i*)(DstPtr + x), DstU16V);
   }//x
 }
+void xCorrespPixelShiftSSE::GenShftCompRowM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  const int32 Width     = Tst->getWidth ();
+  const int32 TstStride = Tst->getStride();
+  const int32 TstOffset = y * TstStride;
+  const int32 MskOffset = y * Msk->getStride();
+  const int32 MaxValue  = DstRef->getMaxPelValue();
+
+  const __m128i CmpWeightsI32V       = _mm_loadu_si128((__m128i*)(&CmpWeights      ));
+  const __m128i GlobalColorShiftI32V = _mm_loadu_si128((__m128i*)(&GlobalColorShift));
+  const __m128i MaxValueI32V         = _mm_set1_epi32(MaxValue);
+
+  const uint16V4*    TstPtr = Tst   ->getAddr(        ) + TstOffset;
+  const uint16*      MskPtr = Msk   ->getAddr(eCmp::LM) + MskOffset;
+  uint16V4* restrict DstPtr = DstRef->getAddr(        ) + TstOffset;
+
+  for(int32 x = 0; x < Width; x++)
+  {
+    if(MskPtr[x] == 0) { continue; } //skip masked pixels
+    __m128i TstU16V = _mm_loadl_epi64((__m128i*)(TstPtr + x));
+    __m128i TstI32V = _mm_add_epi32(_mm_unpacklo_epi16(TstU16V, _mm_setzero_si128()), GlobalColorShiftI32V);
+    __m128i RefI32V = xFindBestPixelWithinBlockM(TstI32V, Ref, Msk, x, y, SearchRange, CmpWeightsI32V);
+    __m128i DstI32V = _mm_min_epi32(_mm_sub_epi32(RefI32V, GlobalColorShiftI32V), MaxValueI32V);
+    __m128i DstU16V = _mm_packus_epi32(DstI32V, DstI32V);
+    _mm_storel_epi64((__m128i*)(DstPtr + x), DstU16V);
+  }//x
+}
 __m128i xCorrespPixelShiftSSE::xFindBestPixelWithinBlock(const __m128i& TstPelI32V, const xPicI* Ref, const int32 CenterX, const int32 CenterY, const int32 SearchRange, const __m128i& CmpWeightsI32V)
 {
   const int32 BegY = CenterY - SearchRange;
@@ -126,6 +237,90 @@ __m128i xCorrespPixelShiftSSE::xFindBestPixelWithinBlock(const __m128i& TstPelI3
   return BestPixelI32V;
 }
 
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// fused shift-compensated picture generation and asymetric Q (single search)
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftSSE::GenShftCompRowAndCalcDist(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+
+  const int32 Width     = Tst->getWidth ();
+  const int32 TstStride = Tst->getStride();
+  const int32 TstOffset = y * TstStride;
+  const int32 MaxValue  = DstRef->getMaxPelValue();
+
+  const __m128i CmpWeightsI32V       = _mm_loadu_si128((__m128i*)(&CmpWeights      ));
+  const __m128i GlobalColorShiftI32V = _mm_loadu_si128((__m128i*)(&GlobalColorShift));
+  const __m128i MaxValueI32V         = _mm_set1_epi32(MaxValue);
+
+  const uint16V4*    TstPtr = Tst   ->getAddr() + TstOffset;
+  uint16V4* restrict DstPtr = DstRef->getAddr() + TstOffset;
+
+  __m128i RowDistLBU64V = _mm_setzero_si128();
+  __m128i RowDistRXU64V = _mm_setzero_si128();
+  for(int32 x = 0; x < Width; x++)
+  {
+    __m128i TstU16V  = _mm_loadl_epi64((__m128i*)(TstPtr + x));
+    __m128i TstI32V  = _mm_add_epi32(_mm_unpacklo_epi16(TstU16V, _mm_setzero_si128()), GlobalColorShiftI32V);
+    __m128i RefI32V  = xFindBestPixelWithinBlock(TstI32V, Ref, x, y, SearchRange, CmpWeightsI32V);
+    __m128i DiffI32V = _mm_sub_epi32  (TstI32V, RefI32V);
+    __m128i DistI32V = _mm_mullo_epi32(DiffI32V, DiffI32V);
+    RowDistLBU64V    = _mm_add_epi64  (RowDistLBU64V, _mm_cvtepu32_epi64(DistI32V));
+    RowDistRXU64V    = _mm_add_epi64  (RowDistRXU64V, _mm_cvtepu32_epi64(_mm_srli_si128(DistI32V, 8)));
+    __m128i DstI32V  = _mm_min_epi32(_mm_sub_epi32(RefI32V, GlobalColorShiftI32V), MaxValueI32V);
+    __m128i DstU16V  = _mm_packus_epi32(DstI32V, DstI32V);
+    _mm_storel_epi64((__m128i*)(DstPtr + x), DstU16V);
+  }//x
+
+  uint64V4 RowDist;
+  _mm_storeu_si128((__m128i*)&RowDist[0], RowDistLBU64V);
+  _mm_storeu_si128((__m128i*)&RowDist[2], RowDistRXU64V);
+  return RowDist;
+}
+
+uint64V4 xCorrespPixelShiftSSE::GenShftCompRowAndCalcDistM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+
+  const int32 Width     = Tst->getWidth ();
+  const int32 TstStride = Tst->getStride();
+  const int32 TstOffset = y * TstStride;
+  const int32 MskOffset = y * Msk->getStride();
+  const int32 MaxValue  = DstRef->getMaxPelValue();
+
+  const __m128i CmpWeightsI32V       = _mm_loadu_si128((__m128i*)(&CmpWeights      ));
+  const __m128i GlobalColorShiftI32V = _mm_loadu_si128((__m128i*)(&GlobalColorShift));
+  const __m128i MaxValueI32V         = _mm_set1_epi32(MaxValue);
+
+  const uint16V4*    TstPtr = Tst   ->getAddr(        ) + TstOffset;
+  const uint16*      MskPtr = Msk   ->getAddr(eCmp::LM) + MskOffset;
+  uint16V4* restrict DstPtr = DstRef->getAddr(        ) + TstOffset;
+
+  __m128i RowDistLBU64V = _mm_setzero_si128();
+  __m128i RowDistRXU64V = _mm_setzero_si128();
+  for(int32 x = 0; x < Width; x++)
+  {
+    const int32 CurrMskValue = (int32)MskPtr[x];
+    if(CurrMskValue == 0) { continue; } //skip masked pixels
+    __m128i TstU16V  = _mm_loadl_epi64((__m128i*)(TstPtr + x));
+    __m128i TstI32V  = _mm_add_epi32(_mm_unpacklo_epi16(TstU16V, _mm_setzero_si128()), GlobalColorShiftI32V);
+    __m128i RefI32V  = xFindBestPixelWithinBlockM(TstI32V, Ref, Msk, x, y, SearchRange, CmpWeightsI32V);
+    __m128i DiffI32V = _mm_sub_epi32  (TstI32V, RefI32V);
+    __m128i DistI32V = _mm_mullo_epi32(DiffI32V, DiffI32V);
+    __m128i MskU64V  = _mm_set1_epi64x(CurrMskValue);
+    RowDistLBU64V    = _mm_add_epi64  (RowDistLBU64V, _mm_mul_epu32(_mm_cvtepu32_epi64(DistI32V                    ), MskU64V));
+    RowDistRXU64V    = _mm_add_epi64  (RowDistRXU64V, _mm_mul_epu32(_mm_cvtepu32_epi64(_mm_srli_si128(DistI32V, 8)), MskU64V));
+    __m128i DstI32V  = _mm_min_epi32(_mm_sub_epi32(RefI32V, GlobalColorShiftI32V), MaxValueI32V);
+    __m128i DstU16V  = _mm_packus_epi32(DstI32V, DstI32V);
+    _mm_storel_epi64((__m128i*)(DstPtr + x), DstU16V);
+  }//x
+
+  uint64V4 RowDist;
+  _mm_storeu_si128((__m128i*)&RowDist[0], RowDistLBU64V);
+  _mm_storeu_si128((__m128i*)&RowDist[2], RowDistRXU64V);
+  return RowDist;
+}
+
 //===============================================================================================================================================================================================================
 
 } //end of namespace PMBB
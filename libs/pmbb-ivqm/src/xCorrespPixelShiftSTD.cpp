@@ -16,21 +16,28 @@ namespace PMBB_NAMESPACE {
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // asymetric Q planar
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-uint64V4 xCorrespPixelShiftSTD::CalcDistAsymmetricRow(const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+uint64V4 xCorrespPixelShiftSTD::CalcDistAsymmetricRow(const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels)
 {
   const int32  Width     = Tst->getWidth ();
   const int32  TstStride = Tst->getStride();
   const int32  TstOffset = y * TstStride;
+  const int32  RefOffset = y * Ref->getStride();
+  const bool   ExactMatchShortcut = xCorrespPixelShiftSpec::isExactMatchShortcutValid(CmpWeights);
 
-  uint64V4 RowDist = { 0, 0, 0, 0 };
+  uint64V4 RowDist       = { 0, 0, 0, 0 };
+  int32    NumExactMatch = 0;
 
   const uint16* TstPtrLm = Tst->getAddr(eCmp::LM) + TstOffset;
   const uint16* TstPtrCb = Tst->getAddr(eCmp::CB) + TstOffset;
   const uint16* TstPtrCr = Tst->getAddr(eCmp::CR) + TstOffset;
+  const uint16* RefPtrLm = Ref->getAddr(eCmp::LM) + RefOffset;
+  const uint16* RefPtrCb = Ref->getAddr(eCmp::CB) + RefOffset;
+  const uint16* RefPtrCr = Ref->getAddr(eCmp::CR) + RefOffset;
 
   for(int32 x = 0; x < Width; x++)
   {
     const int32V4 CurrTstValue  = int32V4((int32)(TstPtrLm[x]), (int32)(TstPtrCb[x]), (int32)(TstPtrCr[x]), 0) + GlobalColorShift;
+    if(ExactMatchShortcut && CurrTstValue[0] == (int32)RefPtrLm[x] && CurrTstValue[1] == (int32)RefPtrCb[x] && CurrTstValue[2] == (int32)RefPtrCr[x]) { NumExactMatch++; continue; } //zero distortion
     const int32   BestRefOffset = FindBestPixelWithinBlock(CurrTstValue, Ref, x, y, SearchRange, CmpWeights);
 
     for(uint32 CmpIdx = 0; CmpIdx < 3; CmpIdx++)
@@ -42,6 +49,7 @@ uint64V4 xCorrespPixelShiftSTD::CalcDistAsymmetricRow(const xPicP* Tst, const xP
     }
   }//x
 
+  if(NumExactMatchPels != nullptr) { *NumExactMatchPels = NumExactMatch; }
   return RowDist;
 }
 int32 xCorrespPixelShiftSTD::FindBestPixelWithinBlock(const int32V4& TstPel, const xPicP* Ref, const int32 CenterX, const int32 CenterY, const int32 SearchRange, const int32V4& CmpWeights)
@@ -86,27 +94,32 @@ int32 xCorrespPixelShiftSTD::FindBestPixelWithinBlock(const int32V4& TstPel, con
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // asymetric Q interleaved
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-uint64V4 xCorrespPixelShiftSTD::CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+uint64V4 xCorrespPixelShiftSTD::CalcDistAsymmetricRow(const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels)
 {
   assert(Tst->isCompatible(Ref));
 
   const int32  Width     = Tst->getWidth ();
   const int32  TstStride = Tst->getStride();
   const int32  TstOffset = y * TstStride;
+  const bool   ExactMatchShortcut = xCorrespPixelShiftSpec::isExactMatchShortcutValid(CmpWeights);
 
-  uint64V4 RowDist = { 0, 0, 0, 0 };
+  uint64V4 RowDist       = { 0, 0, 0, 0 };
+  int32    NumExactMatch = 0;
 
   const uint16V4* TstPtr  = Tst->getAddr() + TstOffset;
+  const uint16V4* RefPtr  = Ref->getAddr() + y * Ref->getStride();
         
   for(int32 x = 0; x < Width; x++)
   {
     const int32V4 CurrTstValue  = (int32V4)(TstPtr[x]) + GlobalColorShift;
+    if(ExactMatchShortcut && CurrTstValue == (int32V4)(RefPtr[x])) { NumExactMatch++; continue; } //zero distortion
     const int32   BestRefOffset = FindBestPixelWithinBlock(CurrTstValue, Ref, x, y, SearchRange, CmpWeights);
     const int32V4 Diff = CurrTstValue - (int32V4)(Ref->getAddr()[BestRefOffset]); //TODO - xc_CLIP_CURR_TST_RANGE
     const int32V4 Dist = Diff.getVecPow2();
     RowDist += (uint64V4)Dist;
   }//x
 
+  if(NumExactMatchPels != nullptr) { *NumExactMatchPels = NumExactMatch; }
   return RowDist;
 }
 int32 xCorrespPixelShiftSTD::FindBestPixelWithinBlock(const int32V4& TstPel, const xPicI* Ref, const int32 CenterX, const int32 CenterY, const int32 SearchRange, const int32V4& CmpWeights)
@@ -148,7 +161,7 @@ int32 xCorrespPixelShiftSTD::FindBestPixelWithinBlock(const int32V4& TstPel, con
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // asymetric Q interleaved - with mask
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-uint64V4 xCorrespPixelShiftSTD::CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+uint64V4 xCorrespPixelShiftSTD::CalcDistAsymmetricRowM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels)
 {
   assert(Tst->isCompatible(Ref));
 
@@ -157,10 +170,13 @@ uint64V4 xCorrespPixelShiftSTD::CalcDistAsymmetricRowM(const xPicI* Tst, const x
   const int32  TstOffset = y * TstStride;
   const int32  MskStride = Msk->getStride();
   const int32  MskOffset = y * MskStride;
+  const bool   ExactMatchShortcut = xCorrespPixelShiftSpec::isExactMatchShortcutValid(CmpWeights);
 
-  uint64V4 RowDist = { 0, 0, 0, 0 };
+  uint64V4 RowDist       = { 0, 0, 0, 0 };
+  int32    NumExactMatch = 0;
 
   const uint16V4* TstPtr = Tst->getAddr(        ) + TstOffset;
+  const uint16V4* RefPtr = Ref->getAddr(        ) + y * Ref->getStride();
   const uint16*   MskPtr = Msk->getAddr(eCmp::LM) + MskOffset;
         
   for(int32 x = 0; x < Width; x++)
@@ -168,12 +184,14 @@ uint64V4 xCorrespPixelShiftSTD::CalcDistAsymmetricRowM(const xPicI* Tst, const x
     const int32   CurrMskValue  = (int32)MskPtr[x];
     if(CurrMskValue == 0) { continue; } //skip masked pixels
     const int32V4 CurrTstValue  = (int32V4)(TstPtr[x]) + GlobalColorShift;
+    if(ExactMatchShortcut && CurrTstValue == (int32V4)(RefPtr[x])) { NumExactMatch++; continue; } //zero distortion (center candidate shares mask value with tested pixel)
     const int32   BestRefOffset = FindBestPixelWithinBlockM(CurrTstValue, Ref, Msk, x, y, SearchRange, CmpWeights);
     const int32V4 Diff = CurrTstValue - (int32V4)(Ref->getAddr()[BestRefOffset]); //TODO - xc_CLIP_CURR_TST_RANGE
     const int32V4 Dist = Diff.getVecPow2();
     RowDist += ((uint64V4)Dist) * CurrMskValue;
   } //x
 
+  if(NumExactMatchPels != nullptr) { *NumExactMatchPels = NumExactMatch; }
   return RowDist;
 }
 int32 xCorrespPixelShiftSTD::FindBestPixelWithinBlockM(const int32V4& TstPel, const xPicI* Ref, const xPicP* Msk, const int32 CenterX, const int32 CenterY, const int32 SearchRange, const int32V4& CmpWeights)
@@ -290,6 +308,315 @@ void xCorrespPixelShiftSTD::GenShftCompRowM(xPicI* DstRef, const xPicI* Ref, con
 
 }
 
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// fused shift-compensated picture generation and asymetric Q (single search)
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftSTD::GenShftCompRowAndCalcDist(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  const int32 Width     = Tst->getWidth ();
+  const int32 TstStride = Tst->getStride();
+  const int32 TstOffset = y * TstStride;
+  const int32 MaxValue  = DstRef->getMaxPelValue();
+
+  uint64V4 RowDist = { 0, 0, 0, 0 };
+
+  const uint16*    TstPtrLm = Tst   ->getAddr(eCmp::LM) + TstOffset;
+  const uint16*    TstPtrCb = Tst   ->getAddr(eCmp::CB) + TstOffset;
+  const uint16*    TstPtrCr = Tst   ->getAddr(eCmp::CR) + TstOffset;
+  uint16* restrict DstPtrLm = DstRef->getAddr(eCmp::LM) + TstOffset;
+  uint16* restrict DstPtrCb = DstRef->getAddr(eCmp::CB) + TstOffset;
+  uint16* restrict DstPtrCr = DstRef->getAddr(eCmp::CR) + TstOffset;
+
+  for(int32 x = 0; x < Width; x++)
+  {
+    const int32V4 CurrTstValue  = int32V4((int32)(TstPtrLm[x]), (int32)(TstPtrCb[x]), (int32)(TstPtrCr[x]), 0) + GlobalColorShift;
+    const int32   BestRefOffset = FindBestPixelWithinBlock(CurrTstValue, Ref, x, y, SearchRange, CmpWeights);
+    const int32V4 RefValue      = int32V4((int32)(Ref->getAddr(eCmp::LM)[BestRefOffset]), (int32)(Ref->getAddr(eCmp::CB)[BestRefOffset]), (int32)(Ref->getAddr(eCmp::CR)[BestRefOffset]), 0);
+    for(uint32 CmpIdx = 0; CmpIdx < 3; CmpIdx++) { RowDist[CmpIdx] += xPow2(CurrTstValue[CmpIdx] - RefValue[CmpIdx]); }
+    DstPtrLm[x] = (uint16)xClipU(RefValue[0] - GlobalColorShift[0], MaxValue);
+    DstPtrCb[x] = (uint16)xClipU(RefValue[1] - GlobalColorShift[1], MaxValue);
+    DstPtrCr[x] = (uint16)xClipU(RefValue[2] - GlobalColorShift[2], MaxValue);
+  }//x
+
+  return RowDist;
+}
+uint64V4 xCorrespPixelShiftSTD::GenShftCompRowAndCalcDist(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+
+  const int32   Width     = Tst->getWidth ();
+  const int32   TstStride = Tst->getStride();
+  const int32   TstOffset = y * TstStride;
+  const int32V4 MaxValue  = xMakeVec4<int32>(DstRef->getMaxPelValue());
+
+  uint64V4 RowDist = { 0, 0, 0, 0 };
+
+  const uint16V4*    TstPtr = Tst   ->getAddr() + TstOffset;
+  uint16V4* restrict DstPtr = DstRef->getAddr() + TstOffset;
+
+  for(int32 x = 0; x < Width; x++)
+  {
+    const int32V4 CurrTstValue  = (int32V4)(TstPtr[x]) + GlobalColorShift;
+    const int32   BestRefOffset = FindBestPixelWithinBlock(CurrTstValue, Ref, x, y, SearchRange, CmpWeights);
+    const int32V4 RefValue      = (int32V4)(Ref->getAddr()[BestRefOffset]);
+    RowDist  += (uint64V4)((CurrTstValue - RefValue).getVecPow2());
+    DstPtr[x] = (uint16V4)((RefValue - GlobalColorShift).getClipU(MaxValue));
+  }//x
+
+  return RowDist;
+}
+uint64V4 xCorrespPixelShiftSTD::GenShftCompRowAndCalcDistM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+
+  const int32   Width     = Tst->getWidth ();
+  const int32   TstStride = Tst->getStride();
+  const int32   TstOffset = y * TstStride;
+  const int32   MskStride = Msk->getStride();
+  const int32   MskOffset = y * MskStride;
+  const int32V4 MaxValue  = xMakeVec4<int32>(DstRef->getMaxPelValue());
+
+  uint64V4 RowDist = { 0, 0, 0, 0 };
+
+  const uint16V4*    TstPtr = Tst   ->getAddr(        ) + TstOffset;
+  const uint16*      MskPtr = Msk   ->getAddr(eCmp::LM) + MskOffset;
+  uint16V4* restrict DstPtr = DstRef->getAddr(        ) + TstOffset;
+
+  for(int32 x = 0; x < Width; x++)
+  {
+    const int32   CurrMskValue  = (int32)MskPtr[x];
+    if(CurrMskValue == 0) { continue; } //skip masked pixels
+    const int32V4 CurrTstValue  = (int32V4)(TstPtr[x]) + GlobalColorShift;
+    const int32   BestRefOffset = FindBestPixelWithinBlockM(CurrTstValue, Ref, Msk, x, y, SearchRange, CmpWeights);
+    const int32V4 RefValue      = (int32V4)(Ref->getAddr()[BestRefOffset]);
+    RowDist  += ((uint64V4)((CurrTstValue - RefValue).getVecPow2())) * CurrMskValue;
+    DstPtr[x] = (uint16V4)((RefValue - GlobalColorShift).getClipU(MaxValue));
+  }//x
+
+  return RowDist;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// displacement map generation (asymetric Q as side product)
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftSTD::GenDispMapRowAndCalcDist(xDispMap* DispMap, const xPicP* Ref, const xPicP* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(SearchRange <= xDispMapUtils::c_MaxSearchRange);
+
+  const int32 Width     = Tst->getWidth ();
+  const int32 TstStride = Tst->getStride();
+  const int32 TstOffset = y * TstStride;
+  const int32 RefStride = Ref->getStride();
+
+  uint64V4 RowDist = { 0, 0, 0, 0 };
+
+  const uint16*  TstPtrLm = Tst    ->getAddr(eCmp::LM) + TstOffset;
+  const uint16*  TstPtrCb = Tst    ->getAddr(eCmp::CB) + TstOffset;
+  const uint16*  TstPtrCr = Tst    ->getAddr(eCmp::CR) + TstOffset;
+  int16* restrict DispPtr = DispMap->getRowAddr(y);
+
+  for(int32 x = 0; x < Width; x++)
+  {
+    const int32V4 CurrTstValue  = int32V4((int32)(TstPtrLm[x]), (int32)(TstPtrCb[x]), (int32)(TstPtrCr[x]), 0) + GlobalColorShift;
+    const int32   BestRefOffset = FindBestPixelWithinBlock(CurrTstValue, Ref, x, y, SearchRange, CmpWeights);
+    const int32V4 RefValue      = int32V4((int32)(Ref->getAddr(eCmp::LM)[BestRefOffset]), (int32)(Ref->getAddr(eCmp::CB)[BestRefOffset]), (int32)(Ref->getAddr(eCmp::CR)[BestRefOffset]), 0);
+    for(uint32 CmpIdx = 0; CmpIdx < 3; CmpIdx++) { RowDist[CmpIdx] += xPow2(CurrTstValue[CmpIdx] - RefValue[CmpIdx]); }
+    DispPtr[x] = xDispMapUtils::fromOffset(BestRefOffset, x, y, RefStride, SearchRange);
+  }//x
+
+  return RowDist;
+}
+uint64V4 xCorrespPixelShiftSTD::GenDispMapRowAndCalcDist(xDispMap* DispMap, const xPicI* Ref, const xPicI* Tst, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+  assert(SearchRange <= xDispMapUtils::c_MaxSearchRange);
+
+  const int32 Width     = Tst->getWidth ();
+  const int32 TstStride = Tst->getStride();
+  const int32 TstOffset = y * TstStride;
+  const int32 RefStride = Ref->getStride();
+
+  uint64V4 RowDist = { 0, 0, 0, 0 };
+
+  const uint16V4* TstPtr  = Tst    ->getAddr() + TstOffset;
+  int16* restrict DispPtr = DispMap->getRowAddr(y);
+
+  for(int32 x = 0; x < Width; x++)
+  {
+    const int32V4 CurrTstValue  = (int32V4)(TstPtr[x]) + GlobalColorShift;
+    const int32   BestRefOffset = FindBestPixelWithinBlock(CurrTstValue, Ref, x, y, SearchRange, CmpWeights);
+    const int32V4 RefValue      = (int32V4)(Ref->getAddr()[BestRefOffset]);
+    RowDist   += (uint64V4)((CurrTstValue - RefValue).getVecPow2());
+    DispPtr[x] = xDispMapUtils::fromOffset(BestRefOffset, x, y, RefStride, SearchRange);
+  }//x
+
+  return RowDist;
+}
+uint64V4 xCorrespPixelShiftSTD::GenDispMapRowAndCalcDistM(xDispMap* DispMap, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights)
+{
+  assert(Tst->isCompatible(Ref));
+  assert(SearchRange <= xDispMapUtils::c_MaxSearchRange);
+
+  const int32 Width     = Tst->getWidth ();
+  const int32 TstStride = Tst->getStride();
+  const int32 TstOffset = y * TstStride;
+  const int32 RefStride = Ref->getStride();
+
+  uint64V4 RowDist = { 0, 0, 0, 0 };
+
+  const uint16V4* TstPtr  = Tst    ->getAddr(        ) + TstOffset;
+  const uint16*   MskPtr  = Msk    ->getAddr(eCmp::LM) + y * Msk->getStride();
+  int16* restrict DispPtr = DispMap->getRowAddr(y);
+
+  for(int32 x = 0; x < Width; x++)
+  {
+    const int32 CurrMskValue = (int32)MskPtr[x];
+    if(CurrMskValue == 0) { DispPtr[x] = 0; continue; } //masked pixels - zero displacement
+    const int32V4 CurrTstValue  = (int32V4)(TstPtr[x]) + GlobalColorShift;
+    const int32   BestRefOffset = FindBestPixelWithinBlockM(CurrTstValue, Ref, Msk, x, y, SearchRange, CmpWeights);
+    const int32V4 RefValue      = (int32V4)(Ref->getAddr()[BestRefOffset]);
+    RowDist   += ((uint64V4)((CurrTstValue - RefValue).getVecPow2())) * CurrMskValue;
+    DispPtr[x] = xDispMapUtils::fromOffset(BestRefOffset, x, y, RefStride, SearchRange);
+  }//x
+
+  return RowDist;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// asymetric Q from displacement map (no search)
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint64V4 xCorrespPixelShiftSTD::CalcDistAsymmetricRowFromDispMap(const xDispMap* DispMap, const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift)
+{
+  const int32 Width     = Tst->getWidth ();
+  const int32 TstStride = Tst->getStride();
+  const int32 TstOffset = y * TstStride;
+  const int32 RefStride = Ref->getStride();
+
+  uint64V4 RowDist = { 0, 0, 0, 0 };
+
+  const uint16* TstPtrLm = Tst    ->getAddr(eCmp::LM) + TstOffset;
+  const uint16* TstPtrCb = Tst    ->getAddr(eCmp::CB) + TstOffset;
+  const uint16* TstPtrCr = Tst    ->getAddr(eCmp::CR) + TstOffset;
+  const uint16* RefPtrLm = Ref    ->getAddr(eCmp::LM) + y * RefStride;
+  const uint16* RefPtrCb = Ref    ->getAddr(eCmp::CB) + y * RefStride;
+  const uint16* RefPtrCr = Ref    ->getAddr(eCmp::CR) + y * RefStride;
+  const int16*  DispPtr  = DispMap->getRowAddr(y);
+
+  for(int32 x = 0; x < Width; x++)
+  {
+    const int32 RefOffset = x + xDispMapUtils::toOffset(DispPtr[x], RefStride);
+    RowDist[0] += xPow2((int32)TstPtrLm[x] + GlobalColorShift[0] - (int32)RefPtrLm[RefOffset]);
+    RowDist[1] += xPow2((int32)TstPtrCb[x] + GlobalColorShift[1] - (int32)RefPtrCb[RefOffset]);
+    RowDist[2] += xPow2((int32)TstPtrCr[x] + GlobalColorShift[2] - (int32)RefPtrCr[RefOffset]);
+  }//x
+
+  return RowDist;
+}
+uint64V4 xCorrespPixelShiftSTD::CalcDistAsymmetricRowFromDispMap(const xDispMap* DispMap, const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift)
+{
+  assert(Tst->isCompatible(Ref));
+
+  const int32 Width     = Tst->getWidth ();
+  const int32 TstStride = Tst->getStride();
+  const int32 RefStride = Ref->getStride();
+
+  uint64V4 RowDist = { 0, 0, 0, 0 };
+
+  const uint16V4* TstPtr  = Tst    ->getAddr() + y * TstStride;
+  const uint16V4* RefPtr  = Ref    ->getAddr() + y * RefStride;
+  const int16*    DispPtr = DispMap->getRowAddr(y);
+
+  for(int32 x = 0; x < Width; x++)
+  {
+    const int32V4 Diff = (int32V4)(TstPtr[x]) + GlobalColorShift - (int32V4)(RefPtr[x + xDispMapUtils::toOffset(DispPtr[x], RefStride)]);
+    RowDist += (uint64V4)(Diff.getVecPow2());
+  }//x
+
+  return RowDist;
+}
+uint64V4 xCorrespPixelShiftSTD::CalcDistAsymmetricRowFromDispMapM(const xDispMap* DispMap, const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift)
+{
+  assert(Tst->isCompatible(Ref));
+
+  const int32 Width     = Tst->getWidth ();
+  const int32 TstStride = Tst->getStride();
+  const int32 RefStride = Ref->getStride();
+
+  uint64V4 RowDist = { 0, 0, 0, 0 };
+
+  const uint16V4* TstPtr  = Tst    ->getAddr(        ) + y * TstStride;
+  const uint16V4* RefPtr  = Ref    ->getAddr(        ) + y * RefStride;
+  const uint16*   MskPtr  = Msk    ->getAddr(eCmp::LM) + y * Msk->getStride();
+  const int16*    DispPtr = DispMap->getRowAddr(y);
+
+  for(int32 x = 0; x < Width; x++)
+  {
+    const int32 CurrMskValue = (int32)MskPtr[x];
+    if(CurrMskValue == 0) { continue; } //skip masked pixels
+    const int32V4 Diff = (int32V4)(TstPtr[x]) + GlobalColorShift - (int32V4)(RefPtr[x + xDispMapUtils::toOffset(DispPtr[x], RefStride)]);
+    RowDist += ((uint64V4)(Diff.getVecPow2())) * CurrMskValue;
+  }//x
+
+  return RowDist;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// shift-compensated picture generation from displacement map (no search)
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void xCorrespPixelShiftSTD::GenShftCompRowFromDispMap(xPicP* DstRef, const xDispMap* DispMap, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift)
+{
+  const int32 Width     = Ref->getWidth ();
+  const int32 RefStride = Ref->getStride();
+  const int32 DstStride = DstRef->getStride();
+  const int32 MaxValue  = DstRef->getMaxPelValue();
+
+  const int16* DispPtr = DispMap->getRowAddr(y);
+
+  for(int32 CmpIdx = 0; CmpIdx < 3; CmpIdx++)
+  {
+    const uint16*    RefPtr = Ref   ->getAddr((eCmp)CmpIdx) + y * RefStride;
+    uint16* restrict DstPtr = DstRef->getAddr((eCmp)CmpIdx) + y * DstStride;
+    for(int32 x = 0; x < Width; x++)
+    {
+      DstPtr[x] = (uint16)xClipU((int32)RefPtr[x + xDispMapUtils::toOffset(DispPtr[x], RefStride)] - GlobalColorShift[CmpIdx], MaxValue);
+    }//x
+  }
+}
+void xCorrespPixelShiftSTD::GenShftCompRowFromDispMap(xPicI* DstRef, const xDispMap* DispMap, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift)
+{
+  const int32   Width     = Ref->getWidth ();
+  const int32   RefStride = Ref->getStride();
+  const int32V4 MaxValue  = xMakeVec4<int32>(DstRef->getMaxPelValue());
+
+  const uint16V4*    RefPtr  = Ref    ->getAddr() + y * RefStride;
+  uint16V4* restrict DstPtr  = DstRef ->getAddr() + y * DstRef->getStride();
+  const int16*       DispPtr = DispMap->getRowAddr(y);
+
+  for(int32 x = 0; x < Width; x++)
+  {
+    const int32V4 RefValue = (int32V4)(RefPtr[x + xDispMapUtils::toOffset(DispPtr[x], RefStride)]);
+    DstPtr[x] = (uint16V4)((RefValue - GlobalColorShift).getClipU(MaxValue));
+  }//x
+}
+void xCorrespPixelShiftSTD::GenShftCompRowFromDispMapM(xPicI* DstRef, const xDispMap* DispMap, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift)
+{
+  const int32   Width     = Ref->getWidth ();
+  const int32   RefStride = Ref->getStride();
+  const int32V4 MaxValue  = xMakeVec4<int32>(DstRef->getMaxPelValue());
+
+  const uint16V4*    RefPtr  = Ref    ->getAddr(        ) + y * RefStride;
+  const uint16*      MskPtr  = Msk    ->getAddr(eCmp::LM) + y * Msk->getStride();
+  uint16V4* restrict DstPtr  = DstRef ->getAddr(        ) + y * DstRef->getStride();
+  const int16*       DispPtr = DispMap->getRowAddr(y);
+
+  for(int32 x = 0; x < Width; x++)
+  {
+    if(MskPtr[x] == 0) { continue; } //skip masked pixels
+    const int32V4 RefValue = (int32V4)(RefPtr[x + xDispMapUtils::toOffset(DispPtr[x], RefStride)]);
+    DstPtr[x] = (uint16V4)((RefValue - GlobalColorShift).getClipU(MaxValue));
+  }//x
+}
+
 //===============================================================================================================================================================================================================
 
 } //end of namespace PMBB
\ No newline at end of file
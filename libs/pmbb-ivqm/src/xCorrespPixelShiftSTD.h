@@ -6,6 +6,7 @@
 #pragma once
 #include "xCommonDefIVQM.h"
 #include "xPic.h"
+#include "xDispMap.h"
 
 namespace PMBB_NAMESPACE {
 
@@ -16,16 +17,21 @@ class xCorrespPixelShiftSTD
 public:
   static constexpr bool c_UseRuntimeCmpWeights = xc_USE_RUNTIME_CMPWEIGHTS;
 
+  //CalcDistAsymmetricRow* skips search for pixels matching center candidate exactly (result stays identical), NumExactMatchPels (optional) receives number of such pixels
+
   //asymetric Q planar
-  static uint64V4 CalcDistAsymmetricRow   (const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static uint64V4 CalcDistAsymmetricRow   (const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, nullptr); }
+  static uint64V4 CalcDistAsymmetricRow   (const xPicP* Tst, const xPicP* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels);
   static int32    FindBestPixelWithinBlock(const int32V4& TstPel, const xPicP* Ref, const int32 CenterX, const int32 CenterY, const int32 SearchRange, const int32V4& CmpWeights);
 
   //asymetric Q interleaved
-  static uint64V4 CalcDistAsymmetricRow    (const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static uint64V4 CalcDistAsymmetricRow    (const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorShift, SearchRange, CmpWeights, nullptr); }
+  static uint64V4 CalcDistAsymmetricRow    (const xPicI* Tst, const xPicI* Ref, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels);
   static int32    FindBestPixelWithinBlock (const int32V4& TstPel, const xPicI* Ref, const int32 CenterX, const int32 CenterY, const int32 SearchRange, const int32V4& CmpWeights);
   
   //asymetric Q interleaved - with mask
-  static uint64V4 CalcDistAsymmetricRowM   (const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static uint64V4 CalcDistAsymmetricRowM   (const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights) { return CalcDistAsymmetricRowM(Tst, Ref, Msk, y, GlobalColorShift, SearchRange, CmpWeights, nullptr); }
+  static uint64V4 CalcDistAsymmetricRowM   (const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, int32* NumExactMatchPels);
   static int32    FindBestPixelWithinBlockM(const int32V4& TstPel, const xPicI* Ref, const xPicP* Msk, const int32 CenterX, const int32 CenterY, const int32 SearchRange, const int32V4& CmpWeights);
 
   //shift-compensated picture generation
@@ -34,6 +40,24 @@ public:
 
   //shift-compensated picture generation - with mask
   static void GenShftCompRowM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+
+  //fused shift-compensated picture generation and asymetric Q (single search)
+  static uint64V4 GenShftCompRowAndCalcDist (xPicP* DstRef, const xPicP* Ref, const xPicP* Tst,                   const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static uint64V4 GenShftCompRowAndCalcDist (xPicI* DstRef, const xPicI* Ref, const xPicI* Tst,                   const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static uint64V4 GenShftCompRowAndCalcDistM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+
+  //displacement map generation (asymetric Q as side product)
+  static uint64V4 GenDispMapRowAndCalcDist (xDispMap* DispMap, const xPicP* Ref, const xPicP* Tst,                   const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static uint64V4 GenDispMapRowAndCalcDist (xDispMap* DispMap, const xPicI* Ref, const xPicI* Tst,                   const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+  static uint64V4 GenDispMapRowAndCalcDistM(xDispMap* DispMap, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+
+  //asymetric Q and shift-compensated picture generation from displacement map (no search)
+  static uint64V4 CalcDistAsymmetricRowFromDispMap (const xDispMap* DispMap, const xPicP* Tst, const xPicP* Ref,                   const int32 y, const int32V4& GlobalColorShift);
+  static uint64V4 CalcDistAsymmetricRowFromDispMap (const xDispMap* DispMap, const xPicI* Tst, const xPicI* Ref,                   const int32 y, const int32V4& GlobalColorShift);
+  static uint64V4 CalcDistAsymmetricRowFromDispMapM(const xDispMap* DispMap, const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift);
+  static void     GenShftCompRowFromDispMap        (xPicP* DstRef, const xDispMap* DispMap, const xPicP* Ref,                   const int32 y, const int32V4& GlobalColorShift);
+  static void     GenShftCompRowFromDispMap        (xPicI* DstRef, const xDispMap* DispMap, const xPicI* Ref,                   const int32 y, const int32V4& GlobalColorShift);
+  static void     GenShftCompRowFromDispMapM       (xPicI* DstRef, const xDispMap* DispMap, const xPicI* Ref, const xPicP* Msk, const int32 y, const int32V4& GlobalColorShift);
 };
 
 //===============================================================================================================================================================================================================
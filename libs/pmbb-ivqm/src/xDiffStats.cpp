@@ -0,0 +1,73 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "xDiffStats.h"
+#include "xDistortion.h"
+#include <cassert>
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+// xDiffStats
+//===============================================================================================================================================================================================================
+void xDiffStats::calcPicDiffStats(const xPicP* Tst, const xPicP* Ref)
+{
+  assert(Ref != nullptr && Tst != nullptr && Ref->isCompatible(Tst));
+
+  m_NumCmps  = Ref->getNumCmps ();
+  m_Width    = Ref->getWidth   ();
+  m_Height   = Ref->getHeight  ();
+  m_BitDepth = Ref->getBitDepth();
+  for(int32 CmpIdx = 0; CmpIdx < 4; CmpIdx++) { m_RowSDs[CmpIdx].resize(m_Height); m_RowSSDs[CmpIdx].resize(m_Height); }
+  m_SumSD  = xMakeVec4<int64 >(0);
+  m_SumSSD = xMakeVec4<uint64>(0);
+
+  if(m_ThPI && m_ThPI->isActive())
+  {
+    for(int32 y = 0; y < m_Height; y += c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, y](int32 /*ThIdx*/) { xCalcRngDiffStats(Tst, Ref, y, xMin(y + c_NumRowsInRng, m_Height)); }); }
+    m_ThPI->executeStoredTasks();
+  }
+  else
+  {
+    xCalcRngDiffStats(Tst, Ref, 0, m_Height);
+  }
+
+  for(int32 CmpIdx = 0; CmpIdx < m_NumCmps; CmpIdx++)
+  {
+    const int64*  RowSDs  = m_RowSDs [CmpIdx].data();
+    const uint64* RowSSDs = m_RowSSDs[CmpIdx].data();
+    for(int32 y = 0; y < m_Height; y++) { m_SumSD[CmpIdx] += RowSDs[y]; m_SumSSD[CmpIdx] += RowSSDs[y]; }
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void xDiffStats::xCalcRngDiffStats(const xPicP* Tst, const xPicP* Ref, int32 BegY, int32 EndY)
+{
+  const int32 Width     = Ref->getWidth   ();
+  const int32 TstStride = Tst->getStride  ();
+  const int32 RefStride = Ref->getStride  ();
+  const int32 BitDepth  = Ref->getBitDepth();
+
+  for(int32 CmpIdx = 0; CmpIdx < m_NumCmps; CmpIdx++)
+  {
+    const uint16* TstPtr  = Tst->getAddr((eCmp)CmpIdx) + BegY * TstStride;
+    const uint16* RefPtr  = Ref->getAddr((eCmp)CmpIdx) + BegY * RefStride;
+    int64*        RowSDs  = m_RowSDs [CmpIdx].data();
+    uint64*       RowSSDs = m_RowSSDs[CmpIdx].data();
+    for(int32 y = BegY; y < EndY; y++)
+    {
+      const auto [RowSD, RowSSD] = xDistortion::CalcSDSSD(TstPtr, RefPtr, Width, BitDepth);
+      RowSDs [y] = RowSD ;
+      RowSSDs[y] = RowSSD;
+      TstPtr += TstStride;
+      RefPtr += RefStride;
+    }
+  }
+}
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
@@ -0,0 +1,52 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#pragma once
+#include "xCommonDefIVQM.h"
+#include "xPic.h"
+#include "xVec.h"
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+// Difference statistics - per row and component sum of differences (SD) and sum of squared differences (SSD) gathered in single pass over Tst and Ref
+//===============================================================================================================================================================================================================
+
+class xDiffStats : public xMultiThreaded
+{
+protected:
+  int32 m_NumCmps  = 0;
+  int32 m_Width    = 0;
+  int32 m_Height   = 0;
+  int32 m_BitDepth = 0;
+
+  std::vector<int64 > m_RowSDs [4];
+  std::vector<uint64> m_RowSSDs[4];
+
+  int64V4  m_SumSD  = xMakeVec4<int64 >(0);
+  uint64V4 m_SumSSD = xMakeVec4<uint64>(0);
+
+public:
+  void  calcPicDiffStats(const xPicP* Tst, const xPicP* Ref);
+
+  inline int32           getNumCmps  (            ) const { return m_NumCmps ; }
+  inline int32           getWidth    (            ) const { return m_Width   ; }
+  inline int32           getHeight   (            ) const { return m_Height  ; }
+  inline int32           getArea     (            ) const { return m_Width * m_Height; }
+  inline int32           getBitDepth (            ) const { return m_BitDepth; }
+  inline const int64V4&  getSumSD    (            ) const { return m_SumSD   ; } //sum of (Tst - Ref)
+  inline const uint64V4& getSumSSD   (            ) const { return m_SumSSD  ; }
+  inline const int64*    getRowSDs   (int32 CmpIdx) const { return m_RowSDs [CmpIdx].data(); }
+  inline const uint64*   getRowSSDs  (int32 CmpIdx) const { return m_RowSSDs[CmpIdx].data(); }
+  inline bool            isExactCmp  (int32 CmpIdx) const { return CmpIdx < m_NumCmps && m_SumSSD[CmpIdx] == 0; }
+  inline boolV4          getExactCmps(            ) const { return { isExactCmp(0), isExactCmp(1), isExactCmp(2), isExactCmp(3) }; }
+
+protected:
+  void  xCalcRngDiffStats(const xPicP* Tst, const xPicP* Ref, int32 BegY, int32 EndY);
+};
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
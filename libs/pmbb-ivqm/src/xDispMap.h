@@ -0,0 +1,44 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#pragma once
+#include "xCommonDefIVQM.h"
+#include "xPlane.h"
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+// Displacement map - best match (dx,dy) found by corresponding pixel shift search, one packed int16 per pixel
+//===============================================================================================================================================================================================================
+
+using xDispMap = xPlane<int16>;
+
+class xDispMapUtils
+{
+public:
+  static constexpr int32 c_MaxSearchRange = 127; //dx and dy have to fit int8
+  static constexpr int32 c_BitDepth       = 16;
+
+  static inline int16   pack  (const int32 dx, const int32 dy) { return (int16)(dy * 256 + (dx & 0xFF)); }
+  static inline int32   getDX (const int16 Disp) { return (int32)(int8)(Disp & 0xFF); }
+  static inline int32   getDY (const int16 Disp) { return (int32)(Disp >> 8); }
+  static inline int32V2 unpack(const int16 Disp) { return { getDX(Disp), getDY(Disp) }; }
+
+  //relative offset within picture with given stride
+  static inline int32 toOffset(const int16 Disp, const int32 Stride) { return getDY(Disp) * Stride + getDX(Disp); }
+
+  //absolute best match offset (as returned by FindBestPixelWithinBlock) --> packed displacement
+  static inline int16 fromOffset(const int32 BestOffset, const int32 CenterX, const int32 CenterY, const int32 Stride, const int32 SearchRange)
+  {
+    const int32 Shifted = BestOffset - (CenterY - SearchRange) * Stride - (CenterX - SearchRange); //non-negative, SearchRange < Stride
+    return pack(Shifted % Stride - SearchRange, Shifted / Stride - SearchRange);
+  }
+
+  static inline void createMap(xDispMap* Map, const int32V2 Size) { Map->create(Size, c_BitDepth, 0); }
+};
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
@@ -9,6 +9,8 @@
 
 namespace PMBB_NAMESPACE {
 
+static constexpr int32 c_NumRowsInRng = xMultiThreaded::c_NumRowsInRng;
+
 //===============================================================================================================================================================================================================
 // special rounding routines
 //===============================================================================================================================================================================================================
@@ -25,20 +27,28 @@ int32V4 xGlobClrDiff::CalcGlobalColorDiff(const xPicP* Tst, const xPicP* Ref, co
   assert(Ref->isCompatible(Tst));
 
   const int32   NumCmps  = Ref->getNumCmps();
-  const int32   MaxValue = Ref->getMaxPelValue();
-  const int32V4 MaxDiff  = xRoundVecF32ToI32(CmpUnntcbCoef * (flt32)MaxValue);
-  const flt64   Area     = Ref->getArea();
 
   int64V4 SumColorDiff = xMakeVec4<int64>(0);
   if(TPI && TPI->isActive())
   {
-    for(int32 CmpIdx = 0; CmpIdx < NumCmps; CmpIdx++)
+    //row bands, partial sums reduced in fixed order
+    const int32 Height   = Ref->getHeight();
+    const int32 NumBands = (Height + c_NumRowsInRng - 1) / c_NumRowsInRng;
+    std::vector<int64V4> BandColorDiff(NumBands, xMakeVec4<int64>(0));
+    for(int32 b = 0; b < NumBands; b++)
     {
-      TPI->storeTask([&SumColorDiff, &Tst, &Ref, CmpIdx](int32 /*ThreadIdx*/)
-        { SumColorDiff[CmpIdx] = xDistortion::CalcSD(Tst->getAddr((eCmp)CmpIdx), Ref->getAddr((eCmp)CmpIdx), Tst->getStride(), Ref->getStride(), Ref->getWidth(), Ref->getHeight(), Ref->getBitDepth()); }
-      );
+      TPI->storeTask([&BandColorDiff, &Tst, &Ref, NumCmps, Height, b](int32 /*ThreadIdx*/)
+      {
+        const int32 BegY = b * c_NumRowsInRng;
+        const int32 NumY = xMin(c_NumRowsInRng, Height - BegY);
+        for(int32 CmpIdx = 0; CmpIdx < NumCmps; CmpIdx++)
+        {
+          BandColorDiff[b][CmpIdx] = xDistortion::CalcSD(Tst->getAddr((eCmp)CmpIdx) + BegY * Tst->getStride(), Ref->getAddr((eCmp)CmpIdx) + BegY * Ref->getStride(), Tst->getStride(), Ref->getStride(), Ref->getWidth(), NumY, Ref->getBitDepth());
+        }
+      });
     }
     TPI->executeStoredTasks();
+    for(int32 b = 0; b < NumBands; b++) { SumColorDiff += BandColorDiff[b]; }
   }
   else
   {
@@ -48,7 +58,13 @@ int32V4 xGlobClrDiff::CalcGlobalColorDiff(const xPicP* Tst, const xPicP* Ref, co
     }
   }
 
-  flt64V4 AvgColorDiff     = (flt64V4)SumColorDiff / Area;
+  return CalcGlobalColorDiff(SumColorDiff, Ref->getArea(), Ref->getMaxPelValue(), CmpUnntcbCoef);
+}
+int32V4 xGlobClrDiff::CalcGlobalColorDiff(const int64V4& SumColorDiff, const int64 Area, const int32 MaxValue, const flt32V4& CmpUnntcbCoef)
+{
+  const int32V4 MaxDiff = xRoundVecF32ToI32(CmpUnntcbCoef * (flt32)MaxValue);
+
+  flt64V4 AvgColorDiff     = (flt64V4)SumColorDiff / (flt64)Area;
   int32V4 GlobalColorShift = xRoundVecF64ToI32(AvgColorDiff);
   GlobalColorShift.modClip(-MaxDiff, MaxDiff);
 
@@ -67,13 +83,24 @@ int32V4 xGlobClrDiff::CalcGlobalColorDiffM(const xPicP* Tst, const xPicP* Ref, c
 
   if(TPI && TPI->isActive())
   {
-    for(int32 CmpIdx = 0; CmpIdx < NumCmps; CmpIdx++)
+    //row bands, partial sums reduced in fixed order
+    const int32 Height   = Ref->getHeight();
+    const int32 NumBands = (Height + c_NumRowsInRng - 1) / c_NumRowsInRng;
+    std::vector<int64V4> BandColorDiff(NumBands, xMakeVec4<int64>(0));
+    for(int32 b = 0; b < NumBands; b++)
     {
-      TPI->storeTask([&SumColorDiff, &Tst, &Ref, &Msk, CmpIdx](int32 /*ThreadIdx*/)
-        { SumColorDiff[CmpIdx] = xDistortion::CalcWeightedSD(Tst->getAddr((eCmp)CmpIdx), Ref->getAddr((eCmp)CmpIdx), Msk->getAddr(eCmp::LM), Tst->getStride(), Ref->getStride(), Msk->getStride(), Ref->getWidth(), Ref->getHeight()); }
-      );
+      TPI->storeTask([&BandColorDiff, &Tst, &Ref, &Msk, NumCmps, Height, b](int32 /*ThreadIdx*/)
+      {
+        const int32 BegY = b * c_NumRowsInRng;
+        const int32 NumY = xMin(c_NumRowsInRng, Height - BegY);
+        for(int32 CmpIdx = 0; CmpIdx < NumCmps; CmpIdx++)
+        {
+          BandColorDiff[b][CmpIdx] = xDistortion::CalcWeightedSD(Tst->getAddr((eCmp)CmpIdx) + BegY * Tst->getStride(), Ref->getAddr((eCmp)CmpIdx) + BegY * Ref->getStride(), Msk->getAddr(eCmp::LM) + BegY * Msk->getStride(), Tst->getStride(), Ref->getStride(), Msk->getStride(), Ref->getWidth(), NumY);
+        }
+      });
     }
     TPI->executeStoredTasks();
+    for(int32 b = 0; b < NumBands; b++) { SumColorDiff += BandColorDiff[b]; }
   }
   else
   {
@@ -7,6 +7,7 @@
 #include "xCommonDefIVQM.h"
 #include "xPic.h"
 #include "xThreadPool.h"
+#include "xDiffStats.h"
 
 namespace PMBB_NAMESPACE {
 
@@ -31,6 +32,9 @@ class xGlobClrDiff
 public:
   static int32V4 CalcGlobalColorDiff (const xPicP* Tst, const xPicP* Ref,                   const flt32V4& CmpUnntcbCoef,                           tThPI* TPI = nullptr);
   static int32V4 CalcGlobalColorDiffM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, const flt32V4& CmpUnntcbCoef, const int32 NumNonMasked, tThPI* TPI = nullptr);
+
+  //from precalculated sum of (Tst - Ref) differences
+  static int32V4 CalcGlobalColorDiff (const int64V4& SumColorDiff, const int64 Area, const int32 MaxValue, const flt32V4& CmpUnntcbCoef);
 };
 
 //===============================================================================================================================================================================================================
@@ -40,6 +44,7 @@ class xGlobClrDiffProc : public xGlobClrDiffPrms, public xMultiThreaded
 public:
   inline int32V4 CalcGlobalColorDiff (const xPicP* Tst, const xPicP* Ref                                            ) { return xGlobClrDiff::CalcGlobalColorDiff (Ref, Tst,      m_CmpUnntcbCoef,               m_ThPI); }
   inline int32V4 CalcGlobalColorDiffM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, const int32 NumNonMasked) { return xGlobClrDiff::CalcGlobalColorDiffM(Ref, Tst, Msk, m_CmpUnntcbCoef, NumNonMasked, m_ThPI); }
+  inline int32V4 CalcGlobalColorDiff (const xDiffStats* Stats) { return xGlobClrDiff::CalcGlobalColorDiff(-Stats->getSumSD(), Stats->getArea(), xBitDepth2MaxValue(Stats->getBitDepth()), m_CmpUnntcbCoef); } //negated - Ref and Tst swapped as above
 };
 
 //===============================================================================================================================================================================================================
@@ -29,81 +29,240 @@ flt64 xIVPSNR::calcPicIVPSNR(const xPicP* Tst, const xPicP* Ref, const xPicI* Ts
   return IVPSNR;
 }
 
-flt64 xIVPSNR::calcPicIVPSNR(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiffRef2Tst)
+flt64 xIVPSNR::calcPicIVPSNR(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiffRef2Tst, xPicP* ShftCompRef, xPicP* ShftCompTst)
 {
   assert(Ref != nullptr && Tst != nullptr && Ref->isCompatible(Tst));
+  assert((ShftCompRef == nullptr) == (ShftCompTst == nullptr));
+
+  if(isApproxMode() && ShftCompRef == nullptr) { return xCalcPicIVPSNRApprox(Tst, Ref, GlobalColorDiffRef2Tst); }
 
   const int32V4 GlobalColorDiffTst2Ref = -GlobalColorDiffRef2Tst;
 
-  flt64 R2T = xCalcQualAsymmetricPic(Tst, Ref, GlobalColorDiffRef2Tst);
-  flt64 T2R = xCalcQualAsymmetricPic(Ref, Tst, GlobalColorDiffTst2Ref);  
+  flt64 R2T = xCalcQualAsymmetricPic(Tst, Ref, GlobalColorDiffRef2Tst, ShftCompRef); const int64 R2TExactMatch = m_LastNumExactMatch;
+  flt64 T2R = xCalcQualAsymmetricPic(Ref, Tst, GlobalColorDiffTst2Ref, ShftCompTst); const int64 T2RExactMatch = m_LastNumExactMatch;
   if(m_DebugCallbackQAP) { m_DebugCallbackQAP(R2T, T2R); }
+  if(m_DebugCallbackEMP) { m_DebugCallbackEMP(R2TExactMatch, T2RExactMatch); }
 
   flt64 IVPSNR = xMin(R2T, T2R);
   return IVPSNR;
 }
-flt64 xIVPSNR::calcPicIVPSNR(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiffRef2Tst)
+flt64 xIVPSNR::calcPicIVPSNR(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiffRef2Tst, xPicI* ShftCompRef, xPicI* ShftCompTst)
 {
   assert(Ref != nullptr && Tst != nullptr && Ref->isCompatible(Tst));
+  assert((ShftCompRef == nullptr) == (ShftCompTst == nullptr));
+
+  if(isApproxMode() && ShftCompRef == nullptr) { return xCalcPicIVPSNRApprox(Tst, Ref, GlobalColorDiffRef2Tst); }
 
   const int32V4 GlobalColorDiffTst2Ref = -GlobalColorDiffRef2Tst;
 
-  flt64 R2T = xCalcQualAsymmetricPic(Tst, Ref, GlobalColorDiffRef2Tst);
-  flt64 T2R = xCalcQualAsymmetricPic(Ref, Tst, GlobalColorDiffTst2Ref);  
+  flt64 R2T = xCalcQualAsymmetricPic(Tst, Ref, GlobalColorDiffRef2Tst, ShftCompRef); const int64 R2TExactMatch = m_LastNumExactMatch;
+  flt64 T2R = xCalcQualAsymmetricPic(Ref, Tst, GlobalColorDiffTst2Ref, ShftCompTst); const int64 T2RExactMatch = m_LastNumExactMatch;
   if(m_DebugCallbackQAP) { m_DebugCallbackQAP(R2T, T2R); }
+  if(m_DebugCallbackEMP) { m_DebugCallbackEMP(R2TExactMatch, T2RExactMatch); }
 
   flt64 IVPSNR = xMin(R2T, T2R);
   return IVPSNR;
 }
 
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// approximate mode
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template<class tPic> flt64 xIVPSNR::xCalcPicIVPSNRApprox(const tPic* Tst, const tPic* Ref, const int32V4& GlobalColorDiffRef2Tst)
+{
+  const int32V4 GlobalColorDiffTst2Ref = -GlobalColorDiffRef2Tst;
+
+  flt64 R2T = 0, R2TCheckApprox = 0, R2TCheckExact = 0; xCalcQualAsymmetricPicApprox(R2T, R2TCheckApprox, R2TCheckExact, Tst, Ref, GlobalColorDiffRef2Tst);
+  flt64 T2R = 0, T2RCheckApprox = 0, T2RCheckExact = 0; xCalcQualAsymmetricPicApprox(T2R, T2RCheckApprox, T2RCheckExact, Ref, Tst, GlobalColorDiffTst2Ref);
+  if(m_DebugCallbackQAP) { m_DebugCallbackQAP(R2T, T2R); }
+  if(m_DebugCallbackEMP) { m_DebugCallbackEMP(0, 0); }
+
+  //both searches evaluated over the same check rows
+  m_LastApproxDeviation = xMin(R2TCheckApprox, T2RCheckApprox) - xMin(R2TCheckExact, T2RCheckExact);
+  return xMin(R2T, T2R);
+}
+template<class tPic> void xIVPSNR::xCalcQualAsymmetricPicApprox(flt64& Approx, flt64& CheckApprox, flt64& CheckExact, const tPic* Tst, const tPic* Ref, const int32V4& GCD)
+{
+  const int32 Height            = Ref->getHeight();
+  const int32 ApproxSearchRange = m_ApproxSearchRange > 0 ? xMin(m_ApproxSearchRange, m_SearchRange) : m_SearchRange;
+  const int32 RowStep           = m_ApproxRowStep;
+  const int32 CheckPeriod       = RowStep * m_ApproxCheckStep;
+  const int32 CheckOffset       = (m_ApproxCheckStep >> 1) * RowStep < Height ? (m_ApproxCheckStep >> 1) * RowStep : 0;
+
+  //check band - RowStep rows starting at every ApproxCheckStep-th approximation row (the band is represented by its approximation row in the approximate metric)
+  auto IsApproxRow = [RowStep                          ](int32 y) { return (y % RowStep) == 0; };
+  auto IsCheckRow  = [RowStep, CheckPeriod, CheckOffset](int32 y) { const int32 BandY = y % CheckPeriod - CheckOffset; return BandY >= 0 && BandY < RowStep; };
+
+  //m_RowDistsV4    - reduced search range for approximation rows
+  //m_RowDistsAuxV4 - full search range for all rows of check bands
+  //rows not selected get zero distortion and are excluded from sampled pooling
+  for(int32 y = 0; y < Height; y += c_NumRowsInRng)
+  {
+    m_ThPI->storeTask([this, &Tst, &Ref, &GCD, y, Height, ApproxSearchRange, &IsApproxRow, &IsCheckRow](int32)
+    {
+      for(int32 i = y; i < xMin(y + c_NumRowsInRng, Height); i++)
+      {
+        m_RowDistsV4   [i] = IsApproxRow(i) ? tCPS::CalcDistAsymmetricRow(Tst, Ref, i, GCD, ApproxSearchRange, m_CmpWeightsSearch) : xMakeVec4<uint64>(0);
+        m_RowDistsAuxV4[i] = !IsCheckRow(i) ? xMakeVec4<uint64>(0) : IsApproxRow(i) && ApproxSearchRange == m_SearchRange ? m_RowDistsV4[i] : tCPS::CalcDistAsymmetricRow(Tst, Ref, i, GCD, m_SearchRange, m_CmpWeightsSearch);
+      }
+    });
+  }
+  m_ThPI->executeStoredTasks();
+
+  //approximate metric of check bands is estimated exactly the same way as for whole picture (sampled rows, reduced search range) --> deviation includes both errors
+  Approx      = xPoolQualAsymmetricSampled(Height, Tst->getArea(), Tst->getBitDepth(), IsApproxRow);
+  CheckApprox = xPoolQualAsymmetricSampled(Height, Tst->getArea(), Tst->getBitDepth(), [&IsApproxRow, &IsCheckRow](int32 y) { return IsApproxRow(y) && IsCheckRow(y); });
+  std::swap(m_RowDistsV4, m_RowDistsAuxV4); //pooling operates on m_RowDistsV4
+  CheckExact  = xPoolQualAsymmetricSampled(Height, Tst->getArea(), Tst->getBitDepth(), IsCheckRow);
+}
+
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // asymetric Q planar
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-flt64 xIVPSNR::xCalcQualAsymmetricPic(const xPicP* Tst, const xPicP* Ref, const int32V4& GCD)
+flt64 xIVPSNR::xCalcQualAsymmetricPic(const xPicP* Tst, const xPicP* Ref, const int32V4& GCD, xPicP* DstRef)
 {
   const int32 Height = Ref->getHeight();
 
-  for(int32 y = 0; y < Height; y += c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, &GCD, y, Height](int32) { xCalcQualAsymmetricRng(Tst, Ref, GCD, y, xMin(y + c_NumRowsInRng, Height)); }); }
+  for(int32 y = 0; y < Height; y += c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, &GCD, DstRef, y, Height](int32) { xCalcQualAsymmetricRng(Tst, Ref, GCD, DstRef, y, xMin(y + c_NumRowsInRng, Height)); }); }
   m_ThPI->executeStoredTasks();
+  m_LastNumExactMatch = xSumNumExactMatch(Height);
 
-  flt64V4 CmpError = xMakeVec4<flt64>(0.0);
-  if(m_UseWS)
+  return xPoolQualAsymmetric(Height, Tst->getArea(), Tst->getBitDepth());
+}
+void xIVPSNR::xCalcQualAsymmetricRng(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiff, xPicP* DstRef, int32 BegY, int32 EndY)
+{
+  if(DstRef != nullptr) //fused with SCP generation
   {
-    xKBNS4 KBNS; for(int32 y = 0; y < Height; y++) { KBNS.acc((flt64V4)m_RowDistsV4[y] * m_EquirectangularWeights[y]); }
-    CmpError = KBNS.result();
+    for(int32 y = BegY; y < EndY; y++) { m_RowDistsV4[y] = tCPS::GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorDiff, m_SearchRange, m_CmpWeightsSearch); m_RowNumExactMatch[y] = 0; }
   }
-  else //!m_UseWS
-  {    
-    CmpError = (flt64V4)std::accumulate(m_RowDistsV4.begin(), m_RowDistsV4.end(), xMakeVec4<uint64>(0));
+  else if(xIsExactMatchRng(Tst, Ref, GlobalColorDiff, BegY, EndY)) //zero distortion, no search needed
+  {
+    for(int32 y = BegY; y < EndY; y++) { m_RowDistsV4[y] = xMakeVec4<uint64>(0); m_RowNumExactMatch[y] = Tst->getWidth(); }
+  }
+  else
+  {
+    for(int32 y = BegY; y < EndY; y++) { m_RowDistsV4[y] = tCPS::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorDiff, m_SearchRange, m_CmpWeightsSearch, &m_RowNumExactMatch[y]); }
   }
-
-  flt64V4 CmpQuality  = { 0, 0, 0, 0 };
-  for(int32 c = 0; c < m_NumComponents; c++) { CmpQuality[c] = CalcPSNRfromSSD(CmpError[c] > 0 ? CmpError[c] : 1.0, Tst->getArea(), Tst->getBitDepth()); }
-
-  const int32V4 CmpWeightsAverage = m_CmpWeightsAverage;
-  const int32   SumCmpWeight      = CmpWeightsAverage.getSum();
-  const flt64   CmpWeightInvDenom = 1.0 / (flt64)SumCmpWeight;
-  const flt64   PicQuality        = (CmpQuality * (flt64V4)CmpWeightsAverage).getSum() * CmpWeightInvDenom;
-  return PicQuality;
 }
-void xIVPSNR::xCalcQualAsymmetricRng(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiff, int32 BegY, int32 EndY)
+bool xIVPSNR::xIsExactMatchRng(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiff, int32 BegY, int32 EndY) const
 {
-  for(int32 y = BegY; y < EndY; y++)
+  if(GlobalColorDiff != xMakeVec4<int32>(0) || !xCorrespPixelShiftSpec::isExactMatchShortcutValid(m_CmpWeightsSearch)) { return false; }
+
+  const int32 TstStride = Tst->getStride();
+  const int32 RefStride = Ref->getStride();
+  for(int32 CmpIdx = 0; CmpIdx < 3; CmpIdx++)
   {
-    m_RowDistsV4[y] = tCPS::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorDiff, m_SearchRange, m_CmpWeightsSearch);
+    if(!xPixelOps::CompareEqual(Tst->getAddr((eCmp)CmpIdx) + BegY * TstStride, Ref->getAddr((eCmp)CmpIdx) + BegY * RefStride, TstStride, RefStride, Tst->getWidth(), EndY - BegY)) { return false; }
   }
+  return true;
 }
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // asymetric Q interleaved
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-flt64 xIVPSNR::xCalcQualAsymmetricPic(const xPicI* Tst, const xPicI* Ref, const int32V4& GCD)
+flt64 xIVPSNR::xCalcQualAsymmetricPic(const xPicI* Tst, const xPicI* Ref, const int32V4& GCD, xPicI* DstRef)
 {
   const int32 Height = Ref->getHeight();
 
-  for(int32 y = 0; y < Height; y+=c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, &GCD, y, Height](int32) { xCalcQualAsymmetricRng(Tst, Ref, GCD, y, xMin(y + c_NumRowsInRng, Height)); }); }
+  for(int32 y = 0; y < Height; y+=c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, &GCD, DstRef, y, Height](int32) { xCalcQualAsymmetricRng(Tst, Ref, GCD, DstRef, y, xMin(y + c_NumRowsInRng, Height)); }); }
   m_ThPI->executeStoredTasks();
+  m_LastNumExactMatch = xSumNumExactMatch(Height);
 
-  flt64V4 CmpError = { 0, 0, 0, 0 };
+  return xPoolQualAsymmetric(Height, Tst->getArea(), Tst->getBitDepth());
+}
+void xIVPSNR::xCalcQualAsymmetricRng(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiff, xPicI* DstRef, int32 BegY, int32 EndY)
+{
+  if(DstRef != nullptr) //fused with SCP generation
+  {
+    for(int32 y = BegY; y < EndY; y++) { m_RowDistsV4[y] = tCPS::GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorDiff, m_SearchRange, m_CmpWeightsSearch); m_RowNumExactMatch[y] = 0; }
+  }
+  else if(xIsExactMatchRng(Tst, Ref, GlobalColorDiff, BegY, EndY)) //zero distortion, no search needed
+  {
+    for(int32 y = BegY; y < EndY; y++) { m_RowDistsV4[y] = xMakeVec4<uint64>(0); m_RowNumExactMatch[y] = Tst->getWidth(); }
+  }
+  else
+  {
+    for(int32 y = BegY; y < EndY; y++) { m_RowDistsV4[y] = tCPS::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorDiff, m_SearchRange, m_CmpWeightsSearch, &m_RowNumExactMatch[y]); }
+  }
+}
+bool xIVPSNR::xIsExactMatchRng(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiff, int32 BegY, int32 EndY) const
+{
+  if(GlobalColorDiff != xMakeVec4<int32>(0) || !xCorrespPixelShiftSpec::isExactMatchShortcutValid(m_CmpWeightsSearch)) { return false; }
+
+  //interleaved pixels compared as 4x wider planar rows
+  const int32 TstStride = Tst->getStride() * xPicI::c_MaxNumCmps;
+  const int32 RefStride = Ref->getStride() * xPicI::c_MaxNumCmps;
+  return xPixelOps::CompareEqual((const uint16*)(Tst->getAddr()) + BegY * TstStride, (const uint16*)(Ref->getAddr()) + BegY * RefStride, TstStride, RefStride, Tst->getWidth() * xPicI::c_MaxNumCmps, EndY - BegY);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// displacement maps
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+flt64 xIVPSNR::calcPicIVPSNRAndGenDispMaps(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiffRef2Tst, xDispMap* DispMapR2T, xDispMap* DispMapT2R)
+{
+  return xCalcPicIVPSNRAndGenDispMaps(Tst, Ref, GlobalColorDiffRef2Tst, DispMapR2T, DispMapT2R);
+}
+flt64 xIVPSNR::calcPicIVPSNRAndGenDispMaps(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiffRef2Tst, xDispMap* DispMapR2T, xDispMap* DispMapT2R)
+{
+  return xCalcPicIVPSNRAndGenDispMaps(Tst, Ref, GlobalColorDiffRef2Tst, DispMapR2T, DispMapT2R);
+}
+flt64 xIVPSNR::calcPicIVPSNRFromDispMaps(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiffRef2Tst, const xDispMap* DispMapR2T, const xDispMap* DispMapT2R)
+{
+  return xCalcPicIVPSNRFromDispMaps(Tst, Ref, GlobalColorDiffRef2Tst, DispMapR2T, DispMapT2R);
+}
+flt64 xIVPSNR::calcPicIVPSNRFromDispMaps(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiffRef2Tst, const xDispMap* DispMapR2T, const xDispMap* DispMapT2R)
+{
+  return xCalcPicIVPSNRFromDispMaps(Tst, Ref, GlobalColorDiffRef2Tst, DispMapR2T, DispMapT2R);
+}
+template<class tPic> flt64 xIVPSNR::xCalcPicIVPSNRAndGenDispMaps(const tPic* Tst, const tPic* Ref, const int32V4& GlobalColorDiffRef2Tst, xDispMap* DispMapR2T, xDispMap* DispMapT2R)
+{
+  assert(Ref != nullptr && Tst != nullptr && Ref->isCompatible(Tst));
+  assert(DispMapR2T != nullptr && DispMapT2R != nullptr && Ref->isSameSize(DispMapR2T) && Ref->isSameSize(DispMapT2R));
+
+  const int32V4 GlobalColorDiffTst2Ref = -GlobalColorDiffRef2Tst;
+  const int32   Height                 = Ref->getHeight();
+
+  for(int32 y = 0; y < Height; y += c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, &GlobalColorDiffRef2Tst, DispMapR2T, y, Height](int32) { for(int32 i = y; i < xMin(y + c_NumRowsInRng, Height); i++) { m_RowDistsV4[i] = tCPS::GenDispMapRowAndCalcDist(DispMapR2T, Ref, Tst, i, GlobalColorDiffRef2Tst, m_SearchRange, m_CmpWeightsSearch); } }); }
+  m_ThPI->executeStoredTasks();
+  flt64 R2T = xPoolQualAsymmetric(Height, Tst->getArea(), Tst->getBitDepth());
+
+  for(int32 y = 0; y < Height; y += c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, &GlobalColorDiffTst2Ref, DispMapT2R, y, Height](int32) { for(int32 i = y; i < xMin(y + c_NumRowsInRng, Height); i++) { m_RowDistsV4[i] = tCPS::GenDispMapRowAndCalcDist(DispMapT2R, Tst, Ref, i, GlobalColorDiffTst2Ref, m_SearchRange, m_CmpWeightsSearch); } }); }
+  m_ThPI->executeStoredTasks();
+  flt64 T2R = xPoolQualAsymmetric(Height, Ref->getArea(), Ref->getBitDepth());
+
+  if(m_DebugCallbackQAP) { m_DebugCallbackQAP(R2T, T2R); }
+  if(m_DebugCallbackEMP) { m_DebugCallbackEMP(0, 0); } //displacement map paths have no exact-match shortcut
+  return xMin(R2T, T2R);
+}
+template<class tPic> flt64 xIVPSNR::xCalcPicIVPSNRFromDispMaps(const tPic* Tst, const tPic* Ref, const int32V4& GlobalColorDiffRef2Tst, const xDispMap* DispMapR2T, const xDispMap* DispMapT2R)
+{
+  assert(Ref != nullptr && Tst != nullptr && Ref->isCompatible(Tst));
+  assert(DispMapR2T != nullptr && DispMapT2R != nullptr && Ref->isSameSize(DispMapR2T) && Ref->isSameSize(DispMapT2R));
+
+  const int32V4 GlobalColorDiffTst2Ref = -GlobalColorDiffRef2Tst;
+  const int32   Height                 = Ref->getHeight();
+
+  for(int32 y = 0; y < Height; y += c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, &GlobalColorDiffRef2Tst, DispMapR2T, y, Height](int32) { for(int32 i = y; i < xMin(y + c_NumRowsInRng, Height); i++) { m_RowDistsV4[i] = tCPS::CalcDistAsymmetricRowFromDispMap(DispMapR2T, Tst, Ref, i, GlobalColorDiffRef2Tst); } }); }
+  m_ThPI->executeStoredTasks();
+  flt64 R2T = xPoolQualAsymmetric(Height, Tst->getArea(), Tst->getBitDepth());
+
+  for(int32 y = 0; y < Height; y += c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, &GlobalColorDiffTst2Ref, DispMapT2R, y, Height](int32) { for(int32 i = y; i < xMin(y + c_NumRowsInRng, Height); i++) { m_RowDistsV4[i] = tCPS::CalcDistAsymmetricRowFromDispMap(DispMapT2R, Ref, Tst, i, GlobalColorDiffTst2Ref); } }); }
+  m_ThPI->executeStoredTasks();
+  flt64 T2R = xPoolQualAsymmetric(Height, Ref->getArea(), Ref->getBitDepth());
+
+  if(m_DebugCallbackQAP) { m_DebugCallbackQAP(R2T, T2R); }
+  if(m_DebugCallbackEMP) { m_DebugCallbackEMP(0, 0); } //displacement map paths have no exact-match shortcut
+  return xMin(R2T, T2R);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// pooling of m_RowDistsV4
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int64 xIVPSNR::xSumNumExactMatch(const int32 Height) const
+{
+  return std::accumulate(m_RowNumExactMatch.begin(), m_RowNumExactMatch.begin() + Height, (int64)0);
+}
+flt64 xIVPSNR::xPoolQualAsymmetric(const int32 Height, const int32 Area, const int32 BitDepth)
+{
+  flt64V4 CmpError = xMakeVec4<flt64>(0.0);
   if(m_UseWS)
   {
     xKBNS4 KBNS; for(int32 y = 0; y < Height; y++) { KBNS.acc((flt64V4)m_RowDistsV4[y] * m_EquirectangularWeights[y]); }
@@ -115,21 +274,38 @@ flt64 xIVPSNR::xCalcQualAsymmetricPic(const xPicI* Tst, const xPicI* Ref, const
   }
 
   flt64V4 CmpQuality  = { 0, 0, 0, 0 };
-  for(int32 c = 0; c < m_NumComponents; c++) { CmpQuality[c] = CalcPSNRfromSSD(CmpError[c] > 0 ? CmpError[c] : 1.0, Tst->getArea(), Tst->getBitDepth()); }
+  for(int32 c = 0; c < m_NumComponents; c++) { CmpQuality[c] = CalcPSNRfromSSD(CmpError[c] > 0 ? CmpError[c] : 1.0, Area, BitDepth); }
 
+  return xAverageCmpQuality(CmpQuality);
+}
+flt64 xIVPSNR::xPoolQualAsymmetricSampled(const int32 Height, const int32 Area, const int32 BitDepth, const tRowSelector& IsSampled)
+{
+  flt64 SumWeights = 0.0, SumWeightsSampled = 0.0;
+  for(int32 y = 0; y < Height; y++) { SumWeights += m_UseWS ? m_EquirectangularWeights[y] : 1.0; }
+
+  xKBNS4 KBNS;
+  for(int32 y = 0; y < Height; y++)
+  {
+    if(!IsSampled(y)) { continue; }
+    const flt64 Weight = m_UseWS ? m_EquirectangularWeights[y] : 1.0;
+    KBNS.acc((flt64V4)m_RowDistsV4[y] * Weight);
+    SumWeightsSampled += Weight;
+  }
+  const flt64V4 CmpError = KBNS.result() * (SumWeights / SumWeightsSampled);
+
+  flt64V4 CmpQuality  = { 0, 0, 0, 0 };
+  for(int32 c = 0; c < m_NumComponents; c++) { CmpQuality[c] = CalcPSNRfromSSD(CmpError[c] > 0 ? CmpError[c] : 1.0, Area, BitDepth); }
+
+  return xAverageCmpQuality(CmpQuality);
+}
+flt64 xIVPSNR::xAverageCmpQuality(const flt64V4& CmpQuality)
+{
   const int32V4 CmpWeightsAverage = m_CmpWeightsAverage;
   const int32   SumCmpWeight      = CmpWeightsAverage.getSum();
   const flt64   CmpWeightInvDenom = 1.0 / (flt64)SumCmpWeight;
   const flt64   PicQuality        = (CmpQuality * (flt64V4)CmpWeightsAverage).getSum() * CmpWeightInvDenom;
   return PicQuality;
 }
-void xIVPSNR::xCalcQualAsymmetricRng(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiff, int32 BegY, int32 EndY)
-{
-  for(int32 y = BegY; y < EndY; y++)
-  {
-    m_RowDistsV4[y] = tCPS::CalcDistAsymmetricRow(Tst, Ref, y, GlobalColorDiff, m_SearchRange, m_CmpWeightsSearch);
-  }
-}
 
 //===============================================================================================================================================================================================================
 // xIVPSNRM
@@ -150,35 +326,99 @@ flt64 xIVPSNRM::calcPicIVPSNRM(const xPicP* Tst, const xPicP* Ref, const xPicP*
   flt64 IVPSNR = calcPicIVPSNRM(TstI, RefI, Msk, NumNonMasked, GlobalColorDiffRef2Tst);
   return IVPSNR;
 }
-flt64 xIVPSNRM::calcPicIVPSNRM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, int32 NumNonMasked, const int32V4& GlobalColorDiffRef2Tst)
+flt64 xIVPSNRM::calcPicIVPSNRM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, int32 NumNonMasked, const int32V4& GlobalColorDiffRef2Tst, xPicI* ShftCompRef, xPicI* ShftCompTst)
 {
   assert(Ref != nullptr && Tst != nullptr && Msk != nullptr);
   assert(Ref->isCompatible(Tst));
   assert(Ref->isSameSizeMargin(Msk));
+  assert((ShftCompRef == nullptr) == (ShftCompTst == nullptr));
 
   const int32V4 GlobalColorDiffTst2Ref = -GlobalColorDiffRef2Tst;
 
-  flt64 R2T = xCalcQualAsymmetricPicM(Ref, Tst, Msk, GlobalColorDiffTst2Ref, NumNonMasked);
-  flt64 T2R = xCalcQualAsymmetricPicM(Tst, Ref, Msk, GlobalColorDiffRef2Tst, NumNonMasked);
+  flt64 R2T = xCalcQualAsymmetricPicM(Ref, Tst, Msk, GlobalColorDiffTst2Ref, ShftCompTst, NumNonMasked); const int64 R2TExactMatch = m_LastNumExactMatch;
+  flt64 T2R = xCalcQualAsymmetricPicM(Tst, Ref, Msk, GlobalColorDiffRef2Tst, ShftCompRef, NumNonMasked); const int64 T2RExactMatch = m_LastNumExactMatch;
   if(m_DebugCallbackQAP) { m_DebugCallbackQAP(R2T, T2R); }
+  if(m_DebugCallbackEMP) { m_DebugCallbackEMP(R2TExactMatch, T2RExactMatch); }
 
   flt64 IVPSNR = xMin(R2T, T2R);
   return IVPSNR;
 }
 
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// displacement maps
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+flt64 xIVPSNRM::calcPicIVPSNRMAndGenDispMaps(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, int32 NumNonMasked, const int32V4& GlobalColorDiffRef2Tst, xDispMap* DispMapR2T, xDispMap* DispMapT2R)
+{
+  assert(Ref != nullptr && Tst != nullptr && Msk != nullptr && Ref->isCompatible(Tst) && Ref->isSameSizeMargin(Msk));
+  assert(DispMapR2T != nullptr && DispMapT2R != nullptr && Ref->isSameSize(DispMapR2T) && Ref->isSameSize(DispMapT2R));
+
+  const int32V4 GlobalColorDiffTst2Ref = -GlobalColorDiffRef2Tst;
+  const int32   Height                 = Ref->getHeight();
+
+  //same argument order as calcPicIVPSNRM --> R2T searches Ref pixels within Tst
+  for(int32 y = 0; y < Height; y += c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, &Msk, &GlobalColorDiffTst2Ref, DispMapR2T, y, Height](int32) { for(int32 i = y; i < xMin(y + c_NumRowsInRng, Height); i++) { m_RowDistsV4[i] = tCPS::GenDispMapRowAndCalcDistM(DispMapR2T, Tst, Ref, Msk, i, GlobalColorDiffTst2Ref, m_SearchRange, m_CmpWeightsSearch); } }); }
+  m_ThPI->executeStoredTasks();
+  flt64 R2T = xPoolQualAsymmetricM(Height, NumNonMasked, Ref->getBitDepth(), Msk->getBitDepth());
+
+  for(int32 y = 0; y < Height; y += c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, &Msk, &GlobalColorDiffRef2Tst, DispMapT2R, y, Height](int32) { for(int32 i = y; i < xMin(y + c_NumRowsInRng, Height); i++) { m_RowDistsV4[i] = tCPS::GenDispMapRowAndCalcDistM(DispMapT2R, Ref, Tst, Msk, i, GlobalColorDiffRef2Tst, m_SearchRange, m_CmpWeightsSearch); } }); }
+  m_ThPI->executeStoredTasks();
+  flt64 T2R = xPoolQualAsymmetricM(Height, NumNonMasked, Tst->getBitDepth(), Msk->getBitDepth());
+
+  if(m_DebugCallbackQAP) { m_DebugCallbackQAP(R2T, T2R); }
+  if(m_DebugCallbackEMP) { m_DebugCallbackEMP(0, 0); } //displacement map paths have no exact-match shortcut
+  return xMin(R2T, T2R);
+}
+flt64 xIVPSNRM::calcPicIVPSNRMFromDispMaps(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, int32 NumNonMasked, const int32V4& GlobalColorDiffRef2Tst, const xDispMap* DispMapR2T, const xDispMap* DispMapT2R)
+{
+  assert(Ref != nullptr && Tst != nullptr && Msk != nullptr && Ref->isCompatible(Tst) && Ref->isSameSizeMargin(Msk));
+  assert(DispMapR2T != nullptr && DispMapT2R != nullptr && Ref->isSameSize(DispMapR2T) && Ref->isSameSize(DispMapT2R));
+
+  const int32V4 GlobalColorDiffTst2Ref = -GlobalColorDiffRef2Tst;
+  const int32   Height                 = Ref->getHeight();
+
+  for(int32 y = 0; y < Height; y += c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, &Msk, &GlobalColorDiffTst2Ref, DispMapR2T, y, Height](int32) { for(int32 i = y; i < xMin(y + c_NumRowsInRng, Height); i++) { m_RowDistsV4[i] = tCPS::CalcDistAsymmetricRowFromDispMapM(DispMapR2T, Ref, Tst, Msk, i, GlobalColorDiffTst2Ref); } }); }
+  m_ThPI->executeStoredTasks();
+  flt64 R2T = xPoolQualAsymmetricM(Height, NumNonMasked, Ref->getBitDepth(), Msk->getBitDepth());
+
+  for(int32 y = 0; y < Height; y += c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, &Msk, &GlobalColorDiffRef2Tst, DispMapT2R, y, Height](int32) { for(int32 i = y; i < xMin(y + c_NumRowsInRng, Height); i++) { m_RowDistsV4[i] = tCPS::CalcDistAsymmetricRowFromDispMapM(DispMapT2R, Tst, Ref, Msk, i, GlobalColorDiffRef2Tst); } }); }
+  m_ThPI->executeStoredTasks();
+  flt64 T2R = xPoolQualAsymmetricM(Height, NumNonMasked, Tst->getBitDepth(), Msk->getBitDepth());
+
+  if(m_DebugCallbackQAP) { m_DebugCallbackQAP(R2T, T2R); }
+  if(m_DebugCallbackEMP) { m_DebugCallbackEMP(0, 0); } //displacement map paths have no exact-match shortcut
+  return xMin(R2T, T2R);
+}
+
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // asymetric Q interleaved
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-flt64 xIVPSNRM::xCalcQualAsymmetricPicM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32V4& GCD, const int32 NumNonMasked)
+flt64 xIVPSNRM::xCalcQualAsymmetricPicM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32V4& GCD, xPicI* DstRef, const int32 NumNonMasked)
 {
   const int32 Height = Ref->getHeight();
 
   for(int32 y = 0; y < Height; y += c_NumRowsInRng)
   {
-    m_ThPI->storeTask([this, &Tst, &Ref, &Msk, &GCD, y, Height](int32) { xCalcQualAsymmetricRngM(Tst, Ref, Msk, GCD, y, xMin(y + c_NumRowsInRng, Height)); });
+    m_ThPI->storeTask([this, &Tst, &Ref, &Msk, &GCD, DstRef, y, Height](int32) { xCalcQualAsymmetricRngM(Tst, Ref, Msk, GCD, DstRef, y, xMin(y + c_NumRowsInRng, Height)); });
   }
   m_ThPI->executeStoredTasks();
+  m_LastNumExactMatch = xSumNumExactMatch(Height);
 
+  return xPoolQualAsymmetricM(Height, NumNonMasked, Tst->getBitDepth(), Msk->getBitDepth());
+}
+void xIVPSNRM::xCalcQualAsymmetricRngM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32V4& GlobalColorDiff, xPicI* DstRef, int32 BegY, int32 EndY)
+{
+  if(DstRef != nullptr) //fused with SCP generation
+  {
+    for(int32 y = BegY; y < EndY; y++) { m_RowDistsV4[y] = tCPS::GenShftCompRowAndCalcDistM(DstRef, Ref, Tst, Msk, y, GlobalColorDiff, m_SearchRange, m_CmpWeightsSearch); m_RowNumExactMatch[y] = 0; }
+  }
+  else
+  {
+    for(int32 y = BegY; y < EndY; y++) { m_RowDistsV4[y] = tCPS::CalcDistAsymmetricRowM(Tst, Ref, Msk, y, GlobalColorDiff, m_SearchRange, m_CmpWeightsSearch, &m_RowNumExactMatch[y]); }
+  }
+}
+
+flt64 xIVPSNRM::xPoolQualAsymmetricM(const int32 Height, const int32 NumNonMasked, const int32 BitDepth, const int32 MskBitDepth)
+{
   flt64V4 CmpError = { 0, 0, 0, 0 };
   if(m_UseWS)
   {
@@ -191,20 +431,9 @@ flt64 xIVPSNRM::xCalcQualAsymmetricPicM(const xPicI* Tst, const xPicI* Ref, cons
   }
 
   flt64V4 CmpQuality = { 0, 0, 0, 0 };
-  for(int32 c = 0; c < m_NumComponents; c++) { CmpQuality[c] = CalcPSNRfromMaskedSSD(CmpError[c] > 0 ? CmpError[c] : 1.0, NumNonMasked, Tst->getBitDepth(), Msk->getBitDepth()); }
+  for(int32 c = 0; c < m_NumComponents; c++) { CmpQuality[c] = CalcPSNRfromMaskedSSD(CmpError[c] > 0 ? CmpError[c] : 1.0, NumNonMasked, BitDepth, MskBitDepth); }
 
-  const int32V4 CmpWeightsAverage = m_CmpWeightsAverage;
-  const int32   SumCmpWeight      = CmpWeightsAverage.getSum();
-  const flt64   CmpWeightInvDenom = 1.0 / (flt64)SumCmpWeight;
-  const flt64   PicQuality        = (CmpQuality * (flt64V4)CmpWeightsAverage).getSum() * CmpWeightInvDenom;
-  return PicQuality;
-}
-void xIVPSNRM::xCalcQualAsymmetricRngM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32V4& GlobalColorDiff, int32 BegY, int32 EndY)
-{
-  for(int32 y = BegY; y < EndY; y++)
-  {
-    m_RowDistsV4[y] = tCPS::CalcDistAsymmetricRowM(Tst, Ref, Msk, y, GlobalColorDiff, m_SearchRange, m_CmpWeightsSearch);
-  }
+  return xAverageCmpQuality(CmpQuality);
 }
 
 //===============================================================================================================================================================================================================
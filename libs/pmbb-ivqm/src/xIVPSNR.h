@@ -21,26 +21,68 @@ public:
   using tCPS    = xCorrespPixelShift;
   using tDCfGCS = std::function<void(const int32V4&)>; //GCS = GlobalColorDiff
   using tDCfQAP = std::function<void(flt64, flt64)>;   //QAP = QualAsymmetricPic
+  using tDCfEMP = std::function<void(int64, int64)>;   //EMP = ExactMatchPels (number of pixels which took exact-match shortcut of search)
 protected:
   tDCfGCS m_DebugCallbackGCS;
   tDCfQAP m_DebugCallbackQAP;
+  tDCfEMP m_DebugCallbackEMP;
+  int64   m_LastNumExactMatch = 0; //number of pixels which took exact-match shortcut within last xCalcQualAsymmetricPic call
 public:
   void  setDebugCallbackGCS(tDCfGCS DebugCallbackGCS) { m_DebugCallbackGCS = DebugCallbackGCS; }
   void  setDebugCallbackQAP(tDCfQAP DebugCallbackQAP) { m_DebugCallbackQAP = DebugCallbackQAP; }
+  void  setDebugCallbackEMP(tDCfEMP DebugCallbackEMP) { m_DebugCallbackEMP = DebugCallbackEMP; }
+
+//approximate mode (opt-in) -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+public:
+  static constexpr int32 c_DefaultApproxRowStep   = 1 ; //search every row (exact metric)
+  static constexpr int32 c_DefaultApproxCheckStep = 16; //every 16th approximation row starts check band (ApproxRowStep rows searched with full search range to measure deviation)
+
+protected:
+  int32 m_ApproxRowStep       = c_DefaultApproxRowStep  ; //spatial subsampling - only every ApproxRowStep-th row is searched (SSD is scaled to picture area)
+  int32 m_ApproxSearchRange   = 0                       ; //reduced candidate set - 0 means the same as m_SearchRange
+  int32 m_ApproxCheckStep     = c_DefaultApproxCheckStep;
+  flt64 m_LastApproxDeviation = 0                       ; //approximate IVPSNR minus exact IVPSNR, both estimated over check bands (includes row subsampling and reduced search range errors)
+
+public:
+  void  setApproxMode(int32 ApproxRowStep, int32 ApproxSearchRange, int32 ApproxCheckStep = c_DefaultApproxCheckStep) { m_ApproxRowStep = ApproxRowStep; m_ApproxSearchRange = ApproxSearchRange; m_ApproxCheckStep = ApproxCheckStep; }
+  bool  isApproxMode() const { return m_ApproxRowStep > 1 || (m_ApproxSearchRange > 0 && m_ApproxSearchRange < m_SearchRange); }
+  flt64 getLastApproxDeviation() const { return m_LastApproxDeviation; }
 
 //IVPSNR 
 public:
   flt64 calcPicIVPSNR(const xPicP* Tst, const xPicP* Ref, const xPicI* TstI = nullptr, const xPicI* RefI = nullptr);
 
-  flt64 calcPicIVPSNR(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiffRef2Tst);
-  flt64 calcPicIVPSNR(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiffRef2Tst);
+  //optional ShftCompRef/ShftCompTst - shift-compensated pictures are generated within the same search (fused IVPSNR and SCP)
+  flt64 calcPicIVPSNR(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiffRef2Tst, xPicP* ShftCompRef = nullptr, xPicP* ShftCompTst = nullptr);
+  flt64 calcPicIVPSNR(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiffRef2Tst, xPicI* ShftCompRef = nullptr, xPicI* ShftCompTst = nullptr);
+
+  //displacement maps - best match offsets generated once and reused later without search (i.e. for SCP or with different CmpWeightsAverage)
+  flt64 calcPicIVPSNRAndGenDispMaps(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiffRef2Tst, xDispMap* DispMapR2T, xDispMap* DispMapT2R);
+  flt64 calcPicIVPSNRAndGenDispMaps(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiffRef2Tst, xDispMap* DispMapR2T, xDispMap* DispMapT2R);
+  flt64 calcPicIVPSNRFromDispMaps  (const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiffRef2Tst, const xDispMap* DispMapR2T, const xDispMap* DispMapT2R);
+  flt64 calcPicIVPSNRFromDispMaps  (const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiffRef2Tst, const xDispMap* DispMapR2T, const xDispMap* DispMapT2R);
 
 protected:  
-  flt64 xCalcQualAsymmetricPic(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiff); //asymetric Q planar
-  flt64 xCalcQualAsymmetricPic(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiff); //asymetric Q interleaved
+  template<class tPic> flt64 xCalcPicIVPSNRAndGenDispMaps(const tPic* Tst, const tPic* Ref, const int32V4& GlobalColorDiffRef2Tst, xDispMap* DispMapR2T, xDispMap* DispMapT2R);
+  template<class tPic> flt64 xCalcPicIVPSNRFromDispMaps  (const tPic* Tst, const tPic* Ref, const int32V4& GlobalColorDiffRef2Tst, const xDispMap* DispMapR2T, const xDispMap* DispMapT2R);
+  template<class tPic> flt64 xCalcPicIVPSNRApprox        (const tPic* Tst, const tPic* Ref, const int32V4& GlobalColorDiffRef2Tst); //no SCP
+  template<class tPic> void  xCalcQualAsymmetricPicApprox(flt64& Approx, flt64& CheckApprox, flt64& CheckExact, const tPic* Tst, const tPic* Ref, const int32V4& GlobalColorDiff);
+
+  flt64 xPoolQualAsymmetric(const int32 Height, const int32 Area, const int32 BitDepth); //pools m_RowDistsV4
+  using tRowSelector = std::function<bool(int32)>;
+  flt64 xPoolQualAsymmetricSampled(const int32 Height, const int32 Area, const int32 BitDepth, const tRowSelector& IsSampled); //pools rows of m_RowDistsV4 selected by IsSampled (scaled to whole picture)
+  int64 xSumNumExactMatch  (const int32 Height) const; //sums m_RowNumExactMatch
+  flt64 xAverageCmpQuality (const flt64V4& CmpQuality);
+
+  flt64 xCalcQualAsymmetricPic(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiff, xPicP* DstRef); //asymetric Q planar
+  flt64 xCalcQualAsymmetricPic(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiff, xPicI* DstRef); //asymetric Q interleaved
 
-  void  xCalcQualAsymmetricRng(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiff, int32 BegY, int32 EndY); //asymetric Q interleaved
-  void  xCalcQualAsymmetricRng(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiff, int32 BegY, int32 EndY); //asymetric Q interleaved
+  void  xCalcQualAsymmetricRng(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiff, xPicP* DstRef, int32 BegY, int32 EndY); //asymetric Q interleaved
+  void  xCalcQualAsymmetricRng(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiff, xPicI* DstRef, int32 BegY, int32 EndY); //asymetric Q interleaved
+
+  //tile-level exact-match shortcut - rows [BegY, EndY) of both pictures are bit-exact (and no global color shift), so every pixel matches its center candidate
+  bool  xIsExactMatchRng(const xPicP* Tst, const xPicP* Ref, const int32V4& GlobalColorDiff, int32 BegY, int32 EndY) const;
+  bool  xIsExactMatchRng(const xPicI* Tst, const xPicI* Ref, const int32V4& GlobalColorDiff, int32 BegY, int32 EndY) const;
 };
 
 //===============================================================================================================================================================================================================
@@ -50,13 +92,18 @@ class xIVPSNRM : public xIVPSNR
 public:
   flt64 calcPicIVPSNRM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, const xPicI* TstI, const xPicI* RefI);
 
-  flt64 calcPicIVPSNRM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, int32 NumNonMasked, const int32V4& GlobalColorDiffRef2Tst);
+  flt64 calcPicIVPSNRM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, int32 NumNonMasked, const int32V4& GlobalColorDiffRef2Tst, xPicI* ShftCompRef = nullptr, xPicI* ShftCompTst = nullptr);
+
+  //displacement maps (masked pixels have zero displacement)
+  flt64 calcPicIVPSNRMAndGenDispMaps(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, int32 NumNonMasked, const int32V4& GlobalColorDiffRef2Tst, xDispMap* DispMapR2T, xDispMap* DispMapT2R);
+  flt64 calcPicIVPSNRMFromDispMaps  (const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, int32 NumNonMasked, const int32V4& GlobalColorDiffRef2Tst, const xDispMap* DispMapR2T, const xDispMap* DispMapT2R);
 
 protected:
+  flt64 xPoolQualAsymmetricM(const int32 Height, const int32 NumNonMasked, const int32 BitDepth, const int32 MskBitDepth); //pools m_RowDistsV4
 
   //asymetric Q interleaved
-  flt64 xCalcQualAsymmetricPicM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32V4& GlobalColorDiff, const int32 NumNonMasked);
-  void  xCalcQualAsymmetricRngM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32V4& GlobalColorDiff, int32 BegY, int32 EndY);
+  flt64 xCalcQualAsymmetricPicM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32V4& GlobalColorDiff, xPicI* DstRef, const int32 NumNonMasked);
+  void  xCalcQualAsymmetricRngM(const xPicI* Tst, const xPicI* Ref, const xPicP* Msk, const int32V4& GlobalColorDiff, xPicI* DstRef, int32 BegY, int32 EndY);
 };
 
 //===============================================================================================================================================================================================================
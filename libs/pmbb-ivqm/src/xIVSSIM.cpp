@@ -15,6 +15,7 @@ namespace PMBB_NAMESPACE {
 void xIVSSIM::create(int32V2 Size, int32 BitDepth, int32 Margin, bool EnableMS, bool PreAllocateSCP)
 {
   xSSIM::create(Size, BitDepth, Margin, EnableMS);
+  for(int32 CmpIdx = 0; CmpIdx < 4; CmpIdx++) { m_RowSumsR2T[CmpIdx].resize(m_PicSize.getY(), 0.0); }
   if(PreAllocateSCP)
   {
     m_TstSCP = new xPicP(Size, BitDepth, Margin);
@@ -43,8 +44,8 @@ flt64 xIVSSIM::calcPicIVSSIM(const xPicP* Tst, const xPicP* Ref, const xPicP* Ts
     xShftCompPic::GenShftCompPics(m_RefSCP, m_TstSCP, Ref, Tst, GlobalColorDiffRef2Tst, m_SearchRange, m_CmpWeightsSearch, m_ThPI);
   }
 
-  flt64V4 SSIMs_T2R = xCalcPicSSIM(Tst, RefSCP, m_UseWS, true);
-  flt64V4 SSIMs_R2T = xCalcPicSSIM(Ref, TstSCP, m_UseWS, true);
+  flt64V4 SSIMs_T2R, SSIMs_R2T;
+  xCalcPicSSIMBiDir(SSIMs_T2R, SSIMs_R2T, Tst, RefSCP, Ref, TstSCP, m_UseWS, true);
 
   const int32V4 CmpWeightsAverage             = m_CmpWeightsAverage;
   const int32   SumCmpWeight                  = CmpWeightsAverage.getSum();
@@ -94,10 +95,10 @@ flt64 xIVSSIM::calcPicIVSSIMM(const xPicP* Tst, const xPicP* Ref, const xPicP* T
 {
   assert(Tst != nullptr && Ref != nullptr && Ref->isCompatible(Tst) && TstSCP != nullptr && TstSCP->isCompatible(Ref) && RefSCP != nullptr && RefSCP->isCompatible(Tst));
 
-  if(NumNonMasked < 0) { NumNonMasked = xPixelOps::CountNonZero(Msk->getAddr(eCmp::LM), Msk->getStride(), Msk->getWidth(), Msk->getHeight()); }
+  if(NumNonMasked < 0) { NumNonMasked = xCountNonMasked(Msk); }
 
-  flt64V4 SSIMs_T2R = xCalcPicSSIMM(Tst, RefSCP, Msk, NumNonMasked, m_UseWS, true);
-  flt64V4 SSIMs_R2T = xCalcPicSSIMM(Ref, TstSCP, Msk, NumNonMasked, m_UseWS, true);
+  flt64V4 SSIMs_T2R, SSIMs_R2T;
+  xCalcPicSSIMMBiDir(SSIMs_T2R, SSIMs_R2T, Tst, RefSCP, Ref, TstSCP, Msk, NumNonMasked, m_UseWS, true);
 
   const int32V4 CmpWeightsAverage             = m_CmpWeightsAverage;
   const int32   SumCmpWeight                  = CmpWeightsAverage.getSum();
@@ -138,13 +139,42 @@ flt64V4 xIVSSIM::xCalcPicSSIM(const xPicP* Tst, const xPicP* Ref, bool UseWS, bo
 flt64 xIVSSIM::xCalcCmpSSIM(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, bool UseWS, bool CalcL)
 {
   memset(m_RowSums[(int32)CmpId].data(), 0, m_RowSums[(int32)CmpId].size() * sizeof(flt64));
+  xStoreCmpTasks(Tst, Ref, CmpId, m_RowSums[(int32)CmpId].data(), CalcL);
+  m_ThPI->executeStoredTasks();
+  return xReduceCmpSSIM(m_RowSums[(int32)CmpId], (flt64)((int64)m_NumUnitY * (int64)m_NumUnitX), UseWS);
+}
+void xIVSSIM::xCalcPicSSIMBiDir(flt64V4& SSIMs_T2R, flt64V4& SSIMs_R2T, const xPicP* TstA, const xPicP* RefA, const xPicP* TstB, const xPicP* RefB, bool UseWS, bool CalcL)
+{
+  assert(RefA != nullptr && TstA != nullptr && RefA->isCompatible(TstA) && RefA->getHeight() <= m_PicSize.getY() && RefA->isSameBitDepth(m_BitDepth));
+  assert(RefB != nullptr && TstB != nullptr && RefB->isCompatible(TstB) && RefB->isCompatible(RefA));
+  xInitLoopRanges(RefA->getWidth(), RefA->getHeight());
 
-  for(int32 y = m_LoopBegY; y < m_LoopEndY; y += m_WndStride)
+  //all components of both directions are evaluated as single batch of tasks
+  const bool SharedPic = xIsPicShared(TstA, RefA, TstB, RefB);
+  for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
   {
-    m_ThPI->storeTask([this, &Tst, &Ref, CmpId, y, CalcL](int32) { m_RowSums[(int32)CmpId][y] = xCalcRowSSIM(Tst, Ref, CmpId, y, CalcL); });
+    memset(m_RowSums   [CmpIdx].data(), 0, m_RowSums   [CmpIdx].size() * sizeof(flt64));
+    memset(m_RowSumsR2T[CmpIdx].data(), 0, m_RowSumsR2T[CmpIdx].size() * sizeof(flt64));
+    xStoreCmpTasks(TstA, RefA, (eCmp)CmpIdx, m_RowSums[CmpIdx].data(), CalcL);
+  }
+  if(SharedPic) { m_ThPI->executeStoredTasks(); } //cached statistics of shared picture have to be ready before reuse
+  for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
+  {
+    xStoreCmpTasks(TstB, RefB, (eCmp)CmpIdx, m_RowSumsR2T[CmpIdx].data(), CalcL);
   }
   m_ThPI->executeStoredTasks();
 
+  const flt64 NumActive = (flt64)((int64)m_NumUnitY * (int64)m_NumUnitX);
+  SSIMs_T2R = xMakeVec4<flt64>(0.0);
+  SSIMs_R2T = xMakeVec4<flt64>(0.0);
+  for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
+  {
+    SSIMs_T2R[CmpIdx] = xReduceCmpSSIM(m_RowSums   [CmpIdx], NumActive, UseWS);
+    SSIMs_R2T[CmpIdx] = xReduceCmpSSIM(m_RowSumsR2T[CmpIdx], NumActive, UseWS);
+  }
+}
+flt64 xIVSSIM::xReduceCmpSSIM(std::vector<flt64>& RowSums, flt64 NumActive, bool UseWS)
+{
   if(UseWS)
   {
     xKBNS1 WeightsAcc;
@@ -152,25 +182,27 @@ flt64 xIVSSIM::xCalcCmpSSIM(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, bool
     {
       int32 Offset = m_IsRegular ? y : y + (m_WndSize >> 1);
       flt64 Weight = m_EquirectangularWeights[Offset];
-      m_RowSums[(int32)CmpId][y] = m_RowSums[(int32)CmpId][y] * Weight;
+      RowSums[y] = RowSums[y] * Weight;
       WeightsAcc += Weight;
     }
     flt64 WeightsSum  = WeightsAcc.result();
     flt64 WeightsCorr = WeightsSum / m_NumUnitY;
 
-    flt64 PicSumSSIM  = xKBNS::Accumulate(m_RowSums[(int32)CmpId]);
-    int64 NumActive   = (int64)m_NumUnitY * (int64)m_NumUnitX;
-    flt64 SSIM        = PicSumSSIM / ((flt64)NumActive * WeightsCorr);
+    flt64 PicSumSSIM  = xKBNS::Accumulate(RowSums);
+    flt64 SSIM        = PicSumSSIM / (NumActive * WeightsCorr);
     return SSIM;
   }
   else
   {
-    flt64 PicSumSSIM = xKBNS::Accumulate(m_RowSums[(int32)CmpId]);
-    int64 NumActive  = (int64)m_NumUnitY * (int64)m_NumUnitX;
-    flt64 SSIM       = PicSumSSIM / (flt64)NumActive;
+    flt64 PicSumSSIM = xKBNS::Accumulate(RowSums);
+    flt64 SSIM       = PicSumSSIM / NumActive;
     return SSIM;
   }  
 }
+bool xIVSSIM::xIsPicShared(const xPicP* TstA, const xPicP* RefA, const xPicP* TstB, const xPicP* RefB)
+{
+  return TstA == TstB || TstA == RefB || RefA == TstB || RefA == RefB;
+}
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -183,8 +215,8 @@ flt64V4 xIVSSIM::xCalcPicMSSSIM(const xPicP* Tst, const xPicP* Ref)
   SubScores[0] = xCalcPicSSIM(Tst, Ref, m_UseWS, m_NumScales==1);
   for(int32 i = 1; i < m_NumScales; i++)
   {
-    if(i == 1) { xDownsamplePic(m_SubPicTst[i], Tst             ); xDownsamplePic(m_SubPicRef[i], Ref             ); }
-    else       { xDownsamplePic(m_SubPicTst[i], m_SubPicTst[i-1]); xDownsamplePic(m_SubPicRef[i], m_SubPicRef[i-1]); }
+    if(i == 1) { xDownsamplePicPair(m_SubPicTst[i], m_SubPicRef[i], Tst             , Ref             ); }
+    else       { xDownsamplePicPair(m_SubPicTst[i], m_SubPicRef[i], m_SubPicTst[i-1], m_SubPicRef[i-1]); }
 
     SubScores[i] = xCalcPicSSIM(m_SubPicTst[i], m_SubPicRef[i], m_UseWS, i == m_NumScales - 1);
   }
@@ -202,52 +234,37 @@ flt64V4 xIVSSIM::xCalcPicMSSSIM(const xPicP* Tst, const xPicP* Ref)
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-flt64V4 xIVSSIM::xCalcPicSSIMM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, int32 NumNonMasked, bool UseWS, bool CalcL)
+void xIVSSIM::xCalcPicSSIMMBiDir(flt64V4& SSIMs_T2R, flt64V4& SSIMs_R2T, const xPicP* TstA, const xPicP* RefA, const xPicP* TstB, const xPicP* RefB, const xPicP* Msk, int32 NumNonMasked, bool UseWS, bool CalcL)
 {
-  assert(Ref != nullptr && Tst != nullptr && Ref->isCompatible(Tst) && Ref->getHeight() <= m_PicSize.getY() && Ref->isSameBitDepth(m_BitDepth));
+  assert(RefA != nullptr && TstA != nullptr && RefA->isCompatible(TstA) && RefA->getHeight() <= m_PicSize.getY() && RefA->isSameBitDepth(m_BitDepth));
+  assert(RefB != nullptr && TstB != nullptr && RefB->isCompatible(TstB) && RefB->isCompatible(RefA));
   assert(m_IsRegular && m_WndStride == 1);
-  xInitLoopRanges(Ref->getWidth(), Ref->getHeight());
+  xInitLoopRanges(RefA->getWidth(), RefA->getHeight());
 
-  flt64V4 SSIM = xMakeVec4<flt64>(0.0);
+  //all components of both directions are evaluated as single batch of tasks
   for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
   {
-    SSIM[CmpIdx] = xCalcCmpSSIMM(Tst, Ref, Msk, (eCmp)CmpIdx, NumNonMasked, UseWS, CalcL);
-  }
-  return SSIM;
-}
-flt64 xIVSSIM::xCalcCmpSSIMM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, eCmp CmpId, int32 NumNonMasked, bool UseWS, bool CalcL)
-{
-  memset(m_RowSums[(int32)CmpId].data(), 0, m_RowSums[(int32)CmpId].size() * sizeof(flt64));
-
-  for(int32 y = m_LoopBegY; y < m_LoopEndY; y += m_WndStride)
-  {
-    m_ThPI->storeTask([this, &Tst, &Ref,&Msk, CmpId, y, CalcL](int32) { m_RowSums[(int32)CmpId][y] = xCalcRowSSIMM(Tst, Ref, Msk, CmpId, y, CalcL); });
+    const eCmp CmpId   = (eCmp)CmpIdx;
+    flt64*     RowSumA = m_RowSums   [CmpIdx].data();
+    flt64*     RowSumB = m_RowSumsR2T[CmpIdx].data();
+    memset(RowSumA, 0, m_RowSums   [CmpIdx].size() * sizeof(flt64));
+    memset(RowSumB, 0, m_RowSumsR2T[CmpIdx].size() * sizeof(flt64));
+    for(int32 y = m_LoopBegY; y < m_LoopEndY; y += c_NumRowsInRng)
+    {
+      const int32 EndY = xMin(y + c_NumRowsInRng, m_LoopEndY);
+      m_ThPI->storeTask([this, TstA, RefA, Msk, CmpId, RowSumA, y, EndY, CalcL](int32) { for(int32 i = y; i < EndY; i++) { RowSumA[i] = xCalcRowSSIMM(TstA, RefA, Msk, CmpId, i, CalcL); } });
+      m_ThPI->storeTask([this, TstB, RefB, Msk, CmpId, RowSumB, y, EndY, CalcL](int32) { for(int32 i = y; i < EndY; i++) { RowSumB[i] = xCalcRowSSIMM(TstB, RefB, Msk, CmpId, i, CalcL); } });
+    }
   }
   m_ThPI->executeStoredTasks();
 
-  if(UseWS)
+  SSIMs_T2R = xMakeVec4<flt64>(0.0);
+  SSIMs_R2T = xMakeVec4<flt64>(0.0);
+  for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
   {
-    xKBNS1 WeightsAcc;
-    for(int32 y = m_LoopBegY; y < m_LoopEndY; y += m_WndStride)
-    {
-      int32 Offset = m_IsRegular ? y : y + (m_WndSize >> 1);
-      flt64 Weight = m_EquirectangularWeights[Offset];
-      m_RowSums[(int32)CmpId][y] = m_RowSums[(int32)CmpId][y] * Weight;
-      WeightsAcc += Weight;
-    }
-    flt64 WeightsSum  = WeightsAcc.result();
-    flt64 WeightsCorr = WeightsSum / m_NumUnitY;
-
-    flt64 PicSumSSIM  = xKBNS::Accumulate(m_RowSums[(int32)CmpId]);
-    flt64 SSIM        = PicSumSSIM / ((flt64)NumNonMasked * WeightsCorr);
-    return SSIM;
+    SSIMs_T2R[CmpIdx] = xReduceCmpSSIM(m_RowSums   [CmpIdx], (flt64)NumNonMasked, UseWS);
+    SSIMs_R2T[CmpIdx] = xReduceCmpSSIM(m_RowSumsR2T[CmpIdx], (flt64)NumNonMasked, UseWS);
   }
-  else
-  {
-    flt64 PicSumSSIM = xKBNS::Accumulate(m_RowSums[(int32)CmpId]);
-    flt64 SSIM       = PicSumSSIM / (flt64)NumNonMasked;
-    return SSIM;
-  }  
 }
 
 //===============================================================================================================================================================================================================
@@ -32,6 +32,9 @@ protected:
   xPicP* m_TstSCP = nullptr; 
   xPicP* m_RefSCP = nullptr;
 
+  //per-row partial results of second direction (first direction uses m_RowSums)
+  std::vector<flt64> m_RowSumsR2T[4];
+
 public:
   virtual void create (int32V2 Size, int32 BitDepth, int32 Margin, bool EnableMS, bool PreAllocateSCP = false);
   virtual void destroy();
@@ -40,7 +43,7 @@ public:
   flt64 calcPicIVMSSSIM(const xPicP* Tst, const xPicP* Ref, const xPicP* TstSCP = nullptr, const xPicP* RefSCP = nullptr);
 
   //mask mode
-  flt64 calcPicIVSSIMM (const xPicP* Tst, const xPicP* Ref, const xPicP* TstSCP, const xPicP* RefSCP, const xPicP* Msk, int32 NumNonMasked = NOT_VALID);
+  flt64 calcPicIVSSIMM (const xPicP* Tst, const xPicP* Ref, const xPicP* TstSCP, const xPicP* RefSCP, const xPicP* Msk, int32 NumNonMasked = NOT_VALID); //NumNonMasked - see xSSIM::calcPicSSIMM
 
   //visualization
   void  visualizeIVSSIM(xPlane<uint16>* Vis, const xPicP* Tst, const xPicP* Ref, const xPicP* TstSCP, const xPicP* RefSCP, eCmp CmpId);
@@ -51,8 +54,12 @@ protected:
 
   flt64V4 xCalcPicMSSSIM(const xPicP* Tst, const xPicP* Ref);
 
-  flt64V4 xCalcPicSSIMM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk,             int32 NumNonMasked, bool UseWS, bool CalcL);
-  flt64   xCalcCmpSSIMM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, eCmp CmpId, int32 NumNonMasked, bool UseWS, bool CalcL);
+  //both directions (TstA vs RefA and TstB vs RefB) at once
+  void    xCalcPicSSIMBiDir (flt64V4& SSIMs_T2R, flt64V4& SSIMs_R2T, const xPicP* TstA, const xPicP* RefA, const xPicP* TstB, const xPicP* RefB,                                       bool UseWS, bool CalcL);
+  void    xCalcPicSSIMMBiDir(flt64V4& SSIMs_T2R, flt64V4& SSIMs_R2T, const xPicP* TstA, const xPicP* RefA, const xPicP* TstB, const xPicP* RefB, const xPicP* Msk, int32 NumNonMasked, bool UseWS, bool CalcL);
+
+  flt64   xReduceCmpSSIM(std::vector<flt64>& RowSums, flt64 NumActive, bool UseWS);
+  static bool xIsPicShared(const xPicP* TstA, const xPicP* RefA, const xPicP* TstB, const xPicP* RefB);
 
 };
 
@@ -14,8 +14,10 @@ void xMetricCommon::initRowBuffers(int32 Height)
   for(int32 CmpIdx = 0; CmpIdx < 4; CmpIdx++) { m_RowDistortions[CmpIdx].resize(Height); }
   for(int32 CmpIdx = 0; CmpIdx < 4; CmpIdx++) { m_RowErrors     [CmpIdx].resize(Height); }
 
-  m_RowDistsV4 .resize(Height);
-  m_RowErrorsV4.resize(Height);
+  m_RowDistsV4   .resize(Height);
+  m_RowDistsAuxV4.resize(Height);
+  m_RowNumExactMatch.resize(Height);
+  m_RowErrorsV4  .resize(Height);
 }
 
 //===============================================================================================================================================================================================================
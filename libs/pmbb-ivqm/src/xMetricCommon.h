@@ -24,6 +24,8 @@ protected:
   std::vector<flt64 > m_RowErrors     [4];
 
   std::vector<uint64V4> m_RowDistsV4;
+  std::vector<uint64V4> m_RowDistsAuxV4; //auxiliary row distortions (i.e. check rows of approximate IVPSNR)
+  std::vector<int32   > m_RowNumExactMatch; //pixels which took exact-match shortcut of correspondence search
   std::vector<flt64V4 > m_RowErrorsV4;
 
 public:
@@ -34,6 +34,18 @@ flt64V4 xPSNR::calcPicPSNR(const xPicP* Tst, const xPicP* Ref)
   flt64V4  PSNRs = CalcPSNRsFromSSDs((flt64V4)SSDs, Tst->getArea(), Tst->getBitDepth());
   return PSNRs;  
 }
+flt64V4 xPSNR::calcPicMSE(const xDiffStats* Stats)
+{
+  assert(Stats != nullptr);
+  flt64V4 MSEs = CalcMSEsFromSSDs((flt64V4)Stats->getSumSSD(), Stats->getArea());
+  return MSEs;
+}
+flt64V4 xPSNR::calcPicPSNR(const xDiffStats* Stats)
+{
+  assert(Stats != nullptr);
+  flt64V4 PSNRs = CalcPSNRsFromSSDs((flt64V4)Stats->getSumSSD(), Stats->getArea(), Stats->getBitDepth());
+  return PSNRs;
+}
 uint64V4 xPSNR::calcPicSSDM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk)
 {
   assert(Ref != nullptr && Tst != nullptr && Msk != nullptr && Ref->isCompatible(Tst) && Ref->isSameSizeMargin(Msk));
@@ -71,59 +83,73 @@ uint64V4 xPSNR::xCalcPicSSD(const xPicP* Tst, const xPicP* Ref)
 {
   assert(Ref != nullptr && Tst != nullptr && Ref->isCompatible(Tst));
 
-  uint64V4 SSDs = xMakeVec4<uint64>(0);
-  for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
-  {
-    m_ThPI->storeTask([&SSDs, &Tst, &Ref, CmpIdx](int32 /*ThIdx*/) { SSDs[CmpIdx] = xCalcCmpSSD(Tst, Ref, (eCmp)CmpIdx); });
-  }
+  const int32 Height = Ref->getHeight();
+  if((int32)m_RowDistsV4.size() < Height) { initRowBuffers(Height); }
+
+  for(int32 y = 0; y < Height; y += c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, y, Height](int32 /*ThIdx*/) { xCalcRngSSD(Tst, Ref, y, xMin(y + c_NumRowsInRng, Height)); }); }
   m_ThPI->executeStoredTasks();
 
-  return SSDs;
+  return xSumRowDists(Height);
 }
 uint64V4 xPSNR::xCalcPicSSDM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk)
 {
   assert(Ref != nullptr && Tst != nullptr && Msk != nullptr && Ref->isCompatible(Tst) && Ref->isSameSizeMargin(Msk));
 
-  uint64V4 SSDMs = xMakeVec4<uint64>(0);
-  for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
-  {
-    m_ThPI->storeTask([&SSDMs, &Tst, &Ref, &Msk, CmpIdx](int32 /*ThIdx*/) { SSDMs[CmpIdx] = xCalcCmpSSDM(Tst, Ref, Msk, (eCmp)CmpIdx); });
-  }
+  const int32 Height = Ref->getHeight();
+  if((int32)m_RowDistsV4.size() < Height) { initRowBuffers(Height); }
+
+  for(int32 y = 0; y < Height; y += c_NumRowsInRng) { m_ThPI->storeTask([this, &Tst, &Ref, &Msk, y, Height](int32 /*ThIdx*/) { xCalcRngSSDM(Tst, Ref, Msk, y, xMin(y + c_NumRowsInRng, Height)); }); }
   m_ThPI->executeStoredTasks();
 
-  return SSDMs;
+  return xSumRowDists(Height);
 }
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-uint64 xPSNR::xCalcCmpSSD(const xPicP* Tst, const xPicP* Ref, eCmp CmpId)
+void xPSNR::xCalcRngSSD(const xPicP* Tst, const xPicP* Ref, int32 BegY, int32 EndY)
 {
-  const int32   Width     = Ref->getWidth   ();
-  const int32   Height    = Ref->getHeight  ();
-  const uint16* TstPtr    = Tst->getAddr    (CmpId);
-  const uint16* RefPtr    = Ref->getAddr    (CmpId);
-  const int32   TstStride = Tst->getStride  ();
-  const int32   RefStride = Ref->getStride  ();
-  const int32   BitDepth  = Ref->getBitDepth();
-
-  uint64 CmpSSD = xDistortion::CalcSSD(TstPtr, RefPtr, TstStride, RefStride, Width, Height, BitDepth);
+  const int32 Width     = Ref->getWidth   ();
+  const int32 TstStride = Tst->getStride  ();
+  const int32 RefStride = Ref->getStride  ();
+  const int32 BitDepth  = Ref->getBitDepth();
 
-  return CmpSSD;
+  for(int32 y = BegY; y < EndY; y++)
+  {
+    uint64V4 RowSSDs = xMakeVec4<uint64>(0);
+    for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
+    {
+      const uint16* TstPtr = Tst->getAddr((eCmp)CmpIdx) + y * TstStride;
+      const uint16* RefPtr = Ref->getAddr((eCmp)CmpIdx) + y * RefStride;
+      RowSSDs[CmpIdx] = xDistortion::CalcSSD(TstPtr, RefPtr, Width, BitDepth);
+    }
+    m_RowDistsV4[y] = RowSSDs;
+  }
 }
-uint64 xPSNR::xCalcCmpSSDM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, eCmp CmpId)
+void xPSNR::xCalcRngSSDM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, int32 BegY, int32 EndY)
 {
-  const int32   Width     = Ref->getWidth ();
-  const int32   Height    = Ref->getHeight();
-  const uint16* TstPtr    = Tst->getAddr  (CmpId   );
-  const uint16* RefPtr    = Ref->getAddr  (CmpId   );
-  const uint16* MskPtr    = Msk->getAddr  (eCmp::LM);
-  const int32   TstStride = Tst->getStride();
-  const int32   RefStride = Ref->getStride();
-  const int32   MskStride = Msk->getStride();
-
-  uint64 CmpSSD = xDistortion::CalcWeightedSSD(TstPtr, RefPtr, MskPtr, TstStride, RefStride, MskStride, Width, Height);
+  const int32 Width     = Ref->getWidth ();
+  const int32 TstStride = Tst->getStride();
+  const int32 RefStride = Ref->getStride();
+  const int32 MskStride = Msk->getStride();
 
-  return CmpSSD;
+  for(int32 y = BegY; y < EndY; y++)
+  {
+    const uint16* MskPtr  = Msk->getAddr(eCmp::LM) + y * MskStride;
+    uint64V4      RowSSDs = xMakeVec4<uint64>(0);
+    for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
+    {
+      const uint16* TstPtr = Tst->getAddr((eCmp)CmpIdx) + y * TstStride;
+      const uint16* RefPtr = Ref->getAddr((eCmp)CmpIdx) + y * RefStride;
+      RowSSDs[CmpIdx] = xDistortion::CalcWeightedSSD(TstPtr, RefPtr, MskPtr, Width);
+    }
+    m_RowDistsV4[y] = RowSSDs;
+  }
+}
+uint64V4 xPSNR::xSumRowDists(int32 Height) const
+{
+  uint64V4 SSDs = xMakeVec4<uint64>(0);
+  for(int32 y = 0; y < Height; y++) { SSDs += m_RowDistsV4[y]; }
+  return SSDs;
 }
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 #pragma once
 #include "xCommonDefIVQM.h"
 #include "xMetricCommon.h"
+#include "xDiffStats.h"
 #include "xPic.h"
 #include "xVec.h"
 
@@ -31,6 +32,10 @@ public:
   flt64V4  calcPicMSE   (const xPicP* Tst, const xPicP* Ref);
   flt64V4  calcPicPSNR  (const xPicP* Tst, const xPicP* Ref);
 
+  //reuses precalculated difference statistics
+  flt64V4  calcPicMSE   (const xDiffStats* Stats);
+  flt64V4  calcPicPSNR  (const xDiffStats* Stats);
+
   uint64V4 calcPicSSDM  (const xPicP* Tst, const xPicP* Ref, const xPicP* Msk);
   flt64V4  calcPicMSEM  (const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, int32 NumNonMasked = NOT_VALID);
   flt64V4  calcPicPSNRM (const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, int32 NumNonMasked = NOT_VALID);
@@ -38,8 +43,9 @@ public:
 protected:
   uint64V4      xCalcPicSSD (const xPicP* Tst, const xPicP* Ref);
   uint64V4      xCalcPicSSDM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk);
-  static uint64 xCalcCmpSSD (const xPicP* Tst, const xPicP* Ref,                   eCmp CmpId);
-  static uint64 xCalcCmpSSDM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, eCmp CmpId);
+  void          xCalcRngSSD (const xPicP* Tst, const xPicP* Ref,                   int32 BegY, int32 EndY); //all components, results in m_RowDistsV4
+  void          xCalcRngSSDM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, int32 BegY, int32 EndY); //all components, results in m_RowDistsV4
+  uint64V4      xSumRowDists(int32 Height) const;
 
 public:
   flt64V4 CalcMSEsFromSSDs       (flt64V4 SSDs , int64 Area                                                          );
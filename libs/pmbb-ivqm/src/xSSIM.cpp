@@ -65,6 +65,7 @@ void xSSIM::create(int32V2 PicSize, int32 BitDepth, int32 Margin, bool EnableMS)
       int32V2 NewSize = LastSize >> 1;
       m_SubPicTst[i] = new xPicP(NewSize, BitDepth, Margin);
       m_SubPicRef[i] = new xPicP(NewSize, BitDepth, Margin);
+      for(int32 CmpIdx = 0; CmpIdx < 4; CmpIdx++) { m_ScaleRowSums[i][CmpIdx].resize(NewSize.getY(), 0.0); }
       LastSize = NewSize;
     }
   }
@@ -93,40 +94,102 @@ void xSSIM::setStructSimParams(eMode Mode, eMrgExt MarginMode, int32 BlockSize,
 
   switch(m_StrSimMode)
   {
-  case eMode::RegularGaussianFlt: m_CalcPtr = xStructSim::CalcRglrFlt; m_CalcPtrMsk = xStructSim::CalcRglrFltM; break;
-  case eMode::RegularGaussianInt: m_CalcPtr = xStructSim::CalcRglrInt; m_CalcPtrMsk = xStructSim::CalcRglrIntM; break;
-  case eMode::RegularAveraged   : m_CalcPtr = xStructSim::CalcRglrAvg; m_CalcPtrMsk = xStructSim::CalcRglrAvgM; break;
-  case eMode::BlockGaussianInt  : m_CalcPtr = xStructSim::CalcBlckInt; m_CalcPtrMsk = nullptr                 ; break;
-  case eMode::BlockAveraged     : m_CalcPtr = xStructSim::CalcBlckAvg; m_CalcPtrMsk = nullptr                 ; break;
+  case eMode::RegularGaussianFlt: m_CalcPtr = xStructSim::CalcRglrFlt; m_CalcPtrMsk = xStructSim::CalcRglrFltM; m_CalcPtrSeparable = xStructSimSeparable::CalcRngGauss; m_CalcPtrStatsSeparable = xStructSimSeparable::CalcStatsGauss; m_CalcPtrSeparableX = xStructSimSeparable::CalcRngGaussX; break;
+  case eMode::RegularGaussianInt: m_CalcPtr = xStructSim::CalcRglrInt; m_CalcPtrMsk = xStructSim::CalcRglrIntM; m_CalcPtrSeparable = xStructSimSeparable::CalcRngGauss; m_CalcPtrStatsSeparable = xStructSimSeparable::CalcStatsGauss; m_CalcPtrSeparableX = xStructSimSeparable::CalcRngGaussX; break;
+  case eMode::RegularAveraged   : m_CalcPtr = xStructSim::CalcRglrAvg; m_CalcPtrMsk = xStructSim::CalcRglrAvgM; m_CalcPtrSeparable = xStructSimSeparable::CalcRngAvg  ; m_CalcPtrStatsSeparable = nullptr                            ; m_CalcPtrSeparableX = nullptr                           ; break;
+  case eMode::BlockGaussianInt  : m_CalcPtr = xStructSim::CalcBlckInt; m_CalcPtrMsk = nullptr                 ; m_CalcPtrSeparable = nullptr                          ; m_CalcPtrStatsSeparable = nullptr                            ; m_CalcPtrSeparableX = nullptr                           ; break;
+  case eMode::BlockAveraged     : m_CalcPtr = xStructSim::CalcBlckAvg; m_CalcPtrMsk = nullptr                 ; m_CalcPtrSeparable = nullptr                          ; m_CalcPtrStatsSeparable = nullptr                            ; m_CalcPtrSeparableX = nullptr                           ; break;
   default: assert(0); break;
   }
+  m_CalcPtrSeparableF32 = (m_StrSimMode == eMode::RegularGaussianFlt || m_StrSimMode == eMode::RegularGaussianInt) ? xStructSimSeparable::CalcRngGaussF32 : nullptr;
+  m_MomentCache.invalidate();
 
-  //Multi-Block Structural Similarity
-  if(!m_IsRegular)
-  {
-    m_MultiBlockAvgBatchSize = xStructSimMultiBlk::getMultiBlockAvgBatchSize(m_WndSize, m_WndStride);
-    if(m_MultiBlockAvgBatchSize > 0)
-    {
-      m_CalcPtrMultiBlkAvgBatch = xStructSimMultiBlk::getCalcPtrMultiBlkAvgBatch(m_WndSize, m_WndStride);
-      m_CalcPtrMultiBlkAvgTail  = xStructSimMultiBlk::getCalcPtrMultiBlkAvgTail (m_WndSize, m_WndStride);
-    }
-  }
+  //Multi-Block Structural Similarity (averaged blocks only)
+  m_MultiBlockAvgBatchSize  = m_StrSimMode == eMode::BlockAveraged ? xStructSimMultiBlk::getMultiBlockAvgBatchSize(m_WndSize, m_WndStride) : 0;
+  m_CalcPtrMultiBlkAvgBatch = m_MultiBlockAvgBatchSize > 0 ? xStructSimMultiBlk::getCalcPtrMultiBlkAvgBatch(m_WndSize, m_WndStride) : nullptr;
+}
+bool xSSIM::isSubBlockActive() const
+{
+  if(!m_UseSubBlock || m_StrSimMode != eMode::BlockAveraged || !xStructSimSubBlock::isSupported(m_WndSize, m_WndStride)) { return false; }
+  const bool HasMultiBlock = xc_USE_SSIM_MULTI_BLOCK && m_MultiBlockAvgBatchSize > 0;
+  return !HasMultiBlock || m_WndSize >= xStructSimSubBlock::c_MinSubInWndVsMB * m_WndStride;
+}
+bool xSSIM::isFlt32Active() const
+{
+  if(!m_UseFlt32) { return false; }
+  if(m_IsRegular) { return m_CalcPtrSeparableF32 != nullptr && m_WndStride == 1; }
+  return isSubBlockActive(); //multi-block kernels are faster where sub-block engine is not selected
+}
+bool xSSIM::isMomentCacheUsable() const
+{
+  if(isFlt32Active()) { return false; }
+  return (isSeparableActive() && m_CalcPtrStatsSeparable != nullptr) || isSubBlockActive();
 }
 flt64V4 xSSIM::calcPicMSSSIM(const xPicP* Tst, const xPicP* Ref)
 {
   assert(Ref != nullptr && Tst != nullptr && Ref->isCompatible(Tst) && Ref->isSameSize(m_PicSize) && Ref->isSameBitDepth(m_BitDepth));
 
-  std::array<flt64V4, c_NumMultiScales> SubScores; SubScores.fill(xMakeVec4<flt64>(0));
+  //pyramids are built first, then all scales and components are evaluated as single batch of tasks (coarse scales fill in around finest one)
+  std::array<const xPicP*, c_NumMultiScales> ScaleTst; ScaleTst.fill(nullptr); ScaleTst[0] = Tst;
+  std::array<const xPicP*, c_NumMultiScales> ScaleRef; ScaleRef.fill(nullptr); ScaleRef[0] = Ref;
+  if(m_PyramidCache != nullptr && m_PyramidCache->isCompatible(Tst, m_NumScales))
+  {
+    //scales of already seen pictures are reused, missing ones are generated (and cached)
+    xStructSimPyramidCache::xEntry* EntryT = m_PyramidCache->acquire(Tst);
+    xStructSimPyramidCache::xEntry* EntryR = m_PyramidCache->acquire(Ref);
+    for(int32 i = 1; i < m_NumScales; i++)
+    {
+      const bool CalcT = !EntryT->m_Valid[i];
+      const bool CalcR = !EntryR->m_Valid[i] && EntryR != EntryT;
+      if(CalcT || CalcR)
+      {
+        const xPicP* SrcT = i == 1 ? Tst : EntryT->m_Scales[i-1];
+        const xPicP* SrcR = i == 1 ? Ref : EntryR->m_Scales[i-1];
+        xDownsamplePicPair(CalcT ? EntryT->m_Scales[i] : nullptr, CalcR ? EntryR->m_Scales[i] : nullptr, SrcT, SrcR);
+        EntryT->m_Valid[i] = true;
+        EntryR->m_Valid[i] = true;
+      }
+      ScaleTst[i] = EntryT->m_Scales[i];
+      ScaleRef[i] = EntryR->m_Scales[i];
+    }
+  }
+  else
+  {
+    for(int32 i = 1; i < m_NumScales; i++)
+    {
+      if(i == 1) { xDownsamplePicPair(m_SubPicTst[i], m_SubPicRef[i], Tst             , Ref             ); }
+      else       { xDownsamplePicPair(m_SubPicTst[i], m_SubPicRef[i], m_SubPicTst[i-1], m_SubPicRef[i-1]); }
+      ScaleTst[i] = m_SubPicTst[i];
+      ScaleRef[i] = m_SubPicRef[i];
+    }
+  }
 
-  SubScores[0] = xCalcPicSSIM(Tst, Ref, m_NumScales==1);
-  for(int32 i = 1; i < m_NumScales; i++)
+  std::array<flt64, c_NumMultiScales> NumActive; NumActive.fill(0);
+  int32 NumPendingRngs = 0;
+  for(int32 i = 0; i < m_NumScales; i++)
   {
-    if(i == 1) { xDownsamplePic(m_SubPicTst[i], Tst             ); xDownsamplePic(m_SubPicRef[i], Ref             ); }
-    else       { xDownsamplePic(m_SubPicTst[i], m_SubPicTst[i-1]); xDownsamplePic(m_SubPicRef[i], m_SubPicRef[i-1]); }
+    const int32 NumRngs = m_NumComponents * ((ScaleRef[i]->getHeight() + c_NumRowsInRng - 1) / c_NumRowsInRng); //upper bound of number of tasks
+    if(NumPendingRngs + NumRngs > m_PicSize.getY()) { m_ThPI->executeStoredTasks(); NumPendingRngs = 0; } //keeps number of tasks below completed queue size
+    NumPendingRngs += NumRngs;
 
-    if(m_UseMargin) { m_SubPicTst[i]->extend(m_MrgExtMode); m_SubPicRef[i]->extend(m_MrgExtMode); }
+    xInitLoopRanges(ScaleRef[i]->getWidth(), ScaleRef[i]->getHeight());
+    NumActive[i] = (flt64)((int64)m_NumUnitY * (int64)m_NumUnitX);
+    for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
+    {
+      std::vector<flt64>& RowSums = xGetScaleRowSums(i, CmpIdx);
+      memset(RowSums.data(), 0, RowSums.size() * sizeof(flt64));
+      xStoreCmpTasks(ScaleTst[i], ScaleRef[i], (eCmp)CmpIdx, RowSums.data(), i == m_NumScales - 1);
+    }
+  }
+  m_ThPI->executeStoredTasks();
 
-    SubScores[i] = xCalcPicSSIM(m_SubPicTst[i], m_SubPicRef[i], i == m_NumScales - 1);
+  std::array<flt64V4, c_NumMultiScales> SubScores; SubScores.fill(xMakeVec4<flt64>(0));
+  for(int32 i = 0; i < m_NumScales; i++)
+  {
+    for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
+    {
+      SubScores[i][CmpIdx] = xKBNS::Accumulate(xGetScaleRowSums(i, CmpIdx)) / NumActive[i];
+    }
   }
 
   //hint: sometimes SubScore can be negative, so do the same as pytorch - use ReLU to avoid (-0.sth)^Scale
@@ -143,9 +206,9 @@ flt64V4 xSSIM::calcPicSSIMM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk
 {
   assert(Ref != nullptr && Tst != nullptr && Msk != nullptr && Ref->isCompatible(Tst) && Ref->isSameSize(m_PicSize) && Ref->isSameBitDepth(m_BitDepth) && Msk->isSameSize(m_PicSize));
 
-  if(NumNonMasked < 0) { NumNonMasked = xPixelOps::CountNonZero(Msk->getAddr(eCmp::LM), Msk->getStride(), Msk->getWidth(), Msk->getHeight()); }
+  if(NumNonMasked < 0) { NumNonMasked = xCountNonMasked(Msk); }
 
-  flt64V4 SSIM = xCalcPicSSIMM(Tst, Ref, Msk, NumNonMasked, false);
+  flt64V4 SSIM = xCalcPicSSIMM(Tst, Ref, Msk, NumNonMasked, true);
   return SSIM;
 }
 void xSSIM::visualizeSSIM(xPlane<uint16>* Vis, const xPicP* Tst, const xPicP* Ref, eCmp CmpId)
@@ -194,6 +257,12 @@ void xSSIM::xInitLoopRanges(int32 Width, int32 Height)
     }
   }
 }
+int32 xSSIM::xCountNonMasked(const xPicP* Msk)
+{
+  xInitLoopRanges(Msk->getWidth(), Msk->getHeight());
+  //without margin extension only windows fully inside picture are evaluated
+  return xPixelOps::CountNonZero(Msk->getAddr(eCmp::LM) + m_LoopBegY * Msk->getStride() + m_LoopBegX, Msk->getStride(), m_LoopEndX - m_LoopBegX, m_LoopEndY - m_LoopBegY);
+}
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -213,29 +282,51 @@ flt64V4 xSSIM::xCalcPicSSIM(const xPicP* Tst, const xPicP* Ref, bool CalcL)
 flt64 xSSIM::xCalcCmpSSIM(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, bool CalcL)
 {
   memset(m_RowSums[(int32)CmpId].data(), 0, m_RowSums[(int32)CmpId].size() * sizeof(flt64));
+  xStoreCmpTasks(Tst, Ref, CmpId, m_RowSums[(int32)CmpId].data(), CalcL);
+  m_ThPI->executeStoredTasks();
 
-  if(xc_USE_SSIM_MULTI_BLOCK && m_MultiBlockAvgBatchSize > 0)
+  flt64 PicSumSSIM = xKBNS::Accumulate(m_RowSums[(int32)CmpId]);
+  int64 NumActive  = (int64)m_NumUnitY * (int64)m_NumUnitX;
+  flt64 SSIM       = PicSumSSIM / (flt64)NumActive;
+  return SSIM;
+}
+void xSSIM::xStoreCmpTasks(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, flt64* RowSums, bool CalcL)
+{
+  const int32 RngHeight = m_WndStride * c_NumRowsInRng; //ranges of rows - keeps number of tasks below completed queue size when several components are batched
+  const int32 BegX      = m_LoopBegX; //loop ranges are captured by value - batches may span several picture sizes (MS-SSIM scales)
+  const int32 EndX      = m_LoopEndX;
+  if(isFlt32Active())
+  {
+    if(m_IsRegular) { xStoreRngTasksSeparable(Tst, Ref, CmpId, RowSums, CalcL); }
+    else            { xStoreRngTasksSubBlock (Tst, Ref, CmpId, RowSums, CalcL); }
+  }
+  else if(isSeparableActive())
+  {
+    xStoreRngTasksSeparable(Tst, Ref, CmpId, RowSums, CalcL);
+  }
+  else if(isSubBlockActive())
+  {
+    xStoreRngTasksSubBlock(Tst, Ref, CmpId, RowSums, CalcL);
+  }
+  else if(xc_USE_SSIM_MULTI_BLOCK && m_MultiBlockAvgBatchSize > 0)
   {
-    for(int32 y = m_LoopBegY; y < m_LoopEndY; y += m_WndStride)
+    for(int32 y = m_LoopBegY; y < m_LoopEndY; y += RngHeight)
     {
-      m_ThPI->storeTask([this, &Tst, &Ref, CmpId, y, CalcL](int32) { m_RowSums[(int32)CmpId][y] = xCalcRowSSIM_MB(Tst, Ref, CmpId, y, CalcL); });
+      const int32 EndY      = xMin(y + RngHeight, m_LoopEndY);
+      const int32 BatchEndX = m_MultiBlockAvgBatchEndX;
+      m_ThPI->storeTask([this, Tst, Ref, CmpId, RowSums, y, EndY, BegX, BatchEndX, EndX, CalcL](int32) { for(int32 i = y; i < EndY; i += m_WndStride) { RowSums[i] = xCalcRowSSIM_MB(Tst, Ref, CmpId, i, BegX, BatchEndX, EndX, CalcL); } });
     }
   }
   else
   {
-    for(int32 y = m_LoopBegY; y < m_LoopEndY; y += m_WndStride)
+    for(int32 y = m_LoopBegY; y < m_LoopEndY; y += RngHeight)
     {
-      m_ThPI->storeTask([this, &Tst, &Ref, CmpId, y, CalcL](int32) { m_RowSums[(int32)CmpId][y] = xCalcRowSSIM(Tst, Ref, CmpId, y, CalcL); });
+      const int32 EndY = xMin(y + RngHeight, m_LoopEndY);
+      m_ThPI->storeTask([this, Tst, Ref, CmpId, RowSums, y, EndY, BegX, EndX, CalcL](int32) { for(int32 i = y; i < EndY; i += m_WndStride) { RowSums[i] = xCalcRowSSIM(Tst, Ref, CmpId, i, BegX, EndX, CalcL); } });
     }
   }
-  m_ThPI->executeStoredTasks();
-
-  flt64 PicSumSSIM = xKBNS::Accumulate(m_RowSums[(int32)CmpId]);
-  int64 NumActive  = (int64)m_NumUnitY * (int64)m_NumUnitX;
-  flt64 SSIM       = PicSumSSIM / (flt64)NumActive;
-  return SSIM;
 }
-flt64 xSSIM::xCalcRowSSIM(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, const int32 y, bool CalcL) const
+flt64 xSSIM::xCalcRowSSIM(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, const int32 y, const int32 BegX, const int32 EndX, bool CalcL) const
 {
   const int32   TstStride = Tst->getStride();
   const int32   RefStride = Ref->getStride();
@@ -244,7 +335,7 @@ flt64 xSSIM::xCalcRowSSIM(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, const
   
   xKBNS1 RowAccSSIM;
 
-  for(int32 x = m_LoopBegX; x < m_LoopEndX; x += m_WndStride)
+  for(int32 x = BegX; x < EndX; x += m_WndStride)
   {
     RowAccSSIM += m_CalcPtr(TstPtr + x, RefPtr + x, TstStride, RefStride, m_WndSize, m_C1, m_C2, CalcL);
   }
@@ -252,7 +343,7 @@ flt64 xSSIM::xCalcRowSSIM(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, const
   flt64 RowSumSSIM = RowAccSSIM.result();
   return RowSumSSIM;
 }
-flt64 xSSIM::xCalcRowSSIM_MB(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, const int32 y, bool CalcL) const
+flt64 xSSIM::xCalcRowSSIM_MB(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, const int32 y, const int32 BegX, const int32 BatchEndX, const int32 EndX, bool CalcL) const
 {
   const int32   TstStride = Tst->getStride();
   const int32   RefStride = Ref->getStride();
@@ -264,7 +355,7 @@ flt64 xSSIM::xCalcRowSSIM_MB(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, con
   std::array<flt64, xStructSimMultiBlk::c_MaxBatchSize> BatchSSIMs;
 
   const int32 BatchWidth = m_WndStride * m_MultiBlockAvgBatchSize;
-  for(int32 x = m_LoopBegX; x < m_MultiBlockAvgBatchEndX; x += BatchWidth)
+  for(int32 x = BegX; x < BatchEndX; x += BatchWidth)
   {
     m_CalcPtrMultiBlkAvgBatch(BatchSSIMs.data(), TstPtr + x, RefPtr + x, TstStride, RefStride, m_C1, m_C2, CalcL);
     for(int32 i = 0; i < m_MultiBlockAvgBatchSize; i++)
@@ -272,14 +363,110 @@ flt64 xSSIM::xCalcRowSSIM_MB(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, con
       RowAccSSIM += BatchSSIMs[i];
     }
   }
-  for(int32 x = m_MultiBlockAvgBatchEndX; x < m_LoopEndX; x += m_WndStride)
+  for(int32 x = BatchEndX; x < EndX; x += m_WndStride)
   {
-    RowAccSSIM += m_CalcPtrMultiBlkAvgTail(TstPtr + x, RefPtr + x, TstStride, RefStride, m_C1, m_C2, CalcL);
+    RowAccSSIM += m_CalcPtr(TstPtr + x, RefPtr + x, TstStride, RefStride, m_WndSize, m_C1, m_C2, CalcL);
   }
 
   flt64 RowSumSSIM = RowAccSSIM.result();
   return RowSumSSIM;
 }
+void xSSIM::xStoreRngTasksSeparable(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, flt64* RowSums, bool CalcL)
+{
+  const int32 BegX     = m_LoopBegX;
+  const int32 EndX     = m_LoopEndX;
+  const bool  UseFlt32 = isFlt32Active();
+
+  if(!UseFlt32 && m_CalcPtrStatsSeparable != nullptr && xIsCacheable(Tst) && xIsCacheable(Ref))
+  {
+    //single picture statistics are evaluated within the same band tasks (if not cached yet), only cross term is evaluated for every pair
+    m_MomentCache.setPlaneSize(m_PicSize.getX(), m_PicSize.getY());
+    const int32 StrideS = m_MomentCache.getPlaneStride();
+    xStructSimMomentCache::xEntry* EntryT = m_MomentCache.acquire(Tst, CmpId);
+    xStructSimMomentCache::xEntry* EntryR = m_MomentCache.acquire(Ref, CmpId);
+    const bool CalcT = !EntryT->m_Valid[(int32)CmpId];
+    const bool CalcR = !EntryR->m_Valid[(int32)CmpId] && EntryR != EntryT;
+    EntryT->m_Valid[(int32)CmpId] = true;
+    EntryR->m_Valid[(int32)CmpId] = true;
+
+    flt64* SumT = EntryT->m_Sum[(int32)CmpId].data(); flt64* SumSqT = EntryT->m_SumSq[(int32)CmpId].data();
+    flt64* SumR = EntryR->m_Sum[(int32)CmpId].data(); flt64* SumSqR = EntryR->m_SumSq[(int32)CmpId].data();
+
+    for(int32 y = m_LoopBegY; y < m_LoopEndY; y += xStructSimSeparable::c_NumRowsInBand)
+    {
+      const int32 EndY = xMin(y + xStructSimSeparable::c_NumRowsInBand, m_LoopEndY);
+      m_ThPI->storeTask([this, Tst, Ref, CmpId, RowSums, y, EndY, BegX, EndX, CalcL, CalcT, CalcR, SumT, SumSqT, SumR, SumSqR, StrideS](int32)
+      {
+        if(CalcT) { m_CalcPtrStatsSeparable(SumT, SumSqT, StrideS, Tst->getAddr(CmpId), Tst->getStride(), BegX, EndX, y, EndY); }
+        if(CalcR) { m_CalcPtrStatsSeparable(SumR, SumSqR, StrideS, Ref->getAddr(CmpId), Ref->getStride(), BegX, EndX, y, EndY); }
+        m_CalcPtrSeparableX(RowSums, Tst->getAddr(CmpId), Ref->getAddr(CmpId), Tst->getStride(), Ref->getStride(), SumT, SumSqT, SumR, SumSqR, StrideS, BegX, EndX, y, EndY, m_C1, m_C2, CalcL);
+      });
+    }
+    return;
+  }
+
+  xStructSimSeparable::tCalcRngPtr* CalcPtr = UseFlt32 ? m_CalcPtrSeparableF32 : m_CalcPtrSeparable;
+  for(int32 y = m_LoopBegY; y < m_LoopEndY; y += xStructSimSeparable::c_NumRowsInBand)
+  {
+    const int32 EndY = xMin(y + xStructSimSeparable::c_NumRowsInBand, m_LoopEndY);
+    m_ThPI->storeTask([this, Tst, Ref, CmpId, RowSums, y, EndY, BegX, EndX, CalcL, CalcPtr](int32) { CalcPtr(RowSums, Tst->getAddr(CmpId), Ref->getAddr(CmpId), Tst->getStride(), Ref->getStride(), BegX, EndX, y, EndY, m_C1, m_C2, CalcL); });
+  }
+}
+void xSSIM::xStoreRngTasksSubBlock(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, flt64* RowSums, bool CalcL)
+{
+  const int32 BandHeight = m_WndStride * xStructSimSubBlock::c_NumBlockRowsInBand;
+  const int32 EndX       = m_LoopEndX;
+
+  if(isFlt32Active())
+  {
+    for(int32 y = m_LoopBegY; y < m_LoopEndY; y += BandHeight)
+    {
+      const int32 EndY = xMin(y + BandHeight, m_LoopEndY);
+      m_ThPI->storeTask([this, Tst, Ref, CmpId, RowSums, y, EndY, EndX, CalcL](int32) { xStructSimSubBlock::CalcRngAvgF32(RowSums, Tst->getAddr(CmpId), Ref->getAddr(CmpId), Tst->getStride(), Ref->getStride(), m_WndSize, m_WndStride, EndX, y, EndY, m_C1, m_C2, CalcL); });
+    }
+    return;
+  }
+
+  if(xIsCacheable(Tst) && xIsCacheable(Ref))
+  {
+    //single picture statistics are evaluated within the same band tasks (if not cached yet), only cross term is evaluated for every pair
+    m_MomentCache.setPlaneSize((m_LoopEndX - 1) / m_WndStride + 1, (m_LoopEndY - 1) / m_WndStride + 1);
+    const int32 StrideS = m_MomentCache.getPlaneStride();
+    xStructSimMomentCache::xEntry* EntryT = m_MomentCache.acquire(Tst, CmpId);
+    xStructSimMomentCache::xEntry* EntryR = m_MomentCache.acquire(Ref, CmpId);
+    const bool CalcT = !EntryT->m_Valid[(int32)CmpId];
+    const bool CalcR = !EntryR->m_Valid[(int32)CmpId] && EntryR != EntryT;
+    EntryT->m_Valid[(int32)CmpId] = true;
+    EntryR->m_Valid[(int32)CmpId] = true;
+
+    flt64* SumT = EntryT->m_Sum[(int32)CmpId].data(); flt64* SumSqT = EntryT->m_SumSq[(int32)CmpId].data();
+    flt64* SumR = EntryR->m_Sum[(int32)CmpId].data(); flt64* SumSqR = EntryR->m_SumSq[(int32)CmpId].data();
+
+    for(int32 y = m_LoopBegY; y < m_LoopEndY; y += BandHeight)
+    {
+      const int32 EndY = xMin(y + BandHeight, m_LoopEndY);
+      m_ThPI->storeTask([this, Tst, Ref, CmpId, RowSums, y, EndY, EndX, CalcL, CalcT, CalcR, SumT, SumSqT, SumR, SumSqR, StrideS](int32)
+      {
+        if(CalcT) { xStructSimSubBlock::CalcStatsAvg(SumT, SumSqT, StrideS, Tst->getAddr(CmpId), Tst->getStride(), m_WndSize, m_WndStride, EndX, y, EndY); }
+        if(CalcR) { xStructSimSubBlock::CalcStatsAvg(SumR, SumSqR, StrideS, Ref->getAddr(CmpId), Ref->getStride(), m_WndSize, m_WndStride, EndX, y, EndY); }
+        xStructSimSubBlock::CalcRngAvgX(RowSums, Tst->getAddr(CmpId), Ref->getAddr(CmpId), Tst->getStride(), Ref->getStride(), SumT, SumSqT, SumR, SumSqR, StrideS, m_WndSize, m_WndStride, EndX, y, EndY, m_C1, m_C2, CalcL);
+      });
+    }
+    return;
+  }
+
+  for(int32 y = m_LoopBegY; y < m_LoopEndY; y += BandHeight)
+  {
+    const int32 EndY = xMin(y + BandHeight, m_LoopEndY);
+    m_ThPI->storeTask([this, Tst, Ref, CmpId, RowSums, y, EndY, EndX, CalcL](int32) { xStructSimSubBlock::CalcRngAvg(RowSums, Tst->getAddr(CmpId), Ref->getAddr(CmpId), Tst->getStride(), Ref->getStride(), m_WndSize, m_WndStride, EndX, y, EndY, m_C1, m_C2, CalcL); });
+  }
+}
+bool xSSIM::xIsCacheable(const xPicP* Pic) const
+{
+  if(!m_UseMomentCache || !Pic->isSameSize(m_PicSize)) { return false; }
+  for(int32 i = 1; i < c_NumMultiScales; i++) { if(Pic == m_SubPicTst[i] || Pic == m_SubPicRef[i]) { return false; } } //MS-SSIM scales are overwritten by every call
+  return true;
+}
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -322,7 +509,7 @@ flt64 xSSIM::xCalcRowSSIMM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk,
   
   xKBNS1 RowAccSSIM;
 
-  for(int32 x = 0; x < m_LoopEndX; x += m_WndStride)
+  for(int32 x = m_LoopBegX; x < m_LoopEndX; x += m_WndStride)
   {
     if(MskPtr[x])
     {
@@ -422,6 +609,37 @@ void xSSIM::xDownsamplePic(xPicP* Dst, const xPicP* Src)
     xPixelOps::DownsampleHV(Dst->getAddr((eCmp)CmpIdx), Src->getAddr((eCmp)CmpIdx), Dst->getStride(), Src->getStride(), Dst->getWidth(), Dst->getHeight());
   }
 }
+void xSSIM::xDownsamplePicPair(xPicP* DstT, xPicP* DstR, const xPicP* SrcT, const xPicP* SrcR)
+{
+  assert(DstT != nullptr || DstR != nullptr);
+  assert(SrcT->isCompatible(SrcR));
+
+  //both pyramids at once - row bands of all components
+  for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
+  {
+    if(DstT != nullptr) { xStoreDownsampleTasks(DstT, SrcT, (eCmp)CmpIdx); }
+    if(DstR != nullptr) { xStoreDownsampleTasks(DstR, SrcR, (eCmp)CmpIdx); }
+  }
+  m_ThPI->executeStoredTasks();
+
+  if(m_UseMargin)
+  {
+    if(DstT != nullptr) { m_ThPI->storeTask([this, DstT](int32) { DstT->extend(m_MrgExtMode); }); }
+    if(DstR != nullptr) { m_ThPI->storeTask([this, DstR](int32) { DstR->extend(m_MrgExtMode); }); }
+    m_ThPI->executeStoredTasks();
+  }
+}
+void xSSIM::xStoreDownsampleTasks(xPicP* Dst, const xPicP* Src, eCmp CmpId)
+{
+  assert(Dst->getHeight() <= (Src->getHeight() >> 1) && Dst->getWidth() <= (Src->getWidth() >> 1));
+
+  const int32 DstHeight = Dst->getHeight();
+  for(int32 y = 0; y < DstHeight; y += c_NumRowsInDownsampleRng)
+  {
+    const int32 NumRows = xMin(c_NumRowsInDownsampleRng, DstHeight - y);
+    m_ThPI->storeTask([Dst, Src, CmpId, y, NumRows](int32) { xPixelOps::DownsampleHV(Dst->getAddr(CmpId) + y * Dst->getStride(), Src->getAddr(CmpId) + 2 * y * Src->getStride(), Dst->getStride(), Src->getStride(), Dst->getWidth(), NumRows); });
+  }
+}
 
 //===============================================================================================================================================================================================================
 
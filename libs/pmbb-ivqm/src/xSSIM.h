@@ -11,6 +11,10 @@
 #include "xMetricCommon.h"
 #include "xStructSim.h"
 #include "xStructSimConsts.h"
+#include "xStructSimSeparable.h"
+#include "xStructSimSubBlock.h"
+#include "xStructSimMomentCache.h"
+#include "xStructSimPyramidCache.h"
 #include "xWeightedSpherically.h"
 
 namespace PMBB_NAMESPACE {
@@ -64,7 +68,23 @@ protected:
   int32 m_MultiBlockAvgBatchSize = NOT_VALID;
   int32 m_MultiBlockAvgBatchEndX = NOT_VALID;
   xStructSimMultiBlk::tCalcPtrMultiBlkAvgBatch* m_CalcPtrMultiBlkAvgBatch = nullptr;
-  xStructSimMultiBlk::tCalcPtrMultiBlkAvgTail * m_CalcPtrMultiBlkAvgTail  = nullptr;
+
+  //separable/sliding-window engine (regular modes, stride 1)
+  bool m_UseSeparable = false;
+  xStructSimSeparable::tCalcRngPtr* m_CalcPtrSeparable = nullptr;
+
+  //sub-block moment reuse (overlapping averaged blocks)
+  bool m_UseSubBlock = true; //used when faster than multi-block kernels
+
+  //per-frame cache of single picture window statistics (consumed by separable and sub-block engines)
+  bool m_UseMomentCache = false;
+  xStructSimMomentCache m_MomentCache;
+  xStructSimSeparable::tCalcStatsPtr* m_CalcPtrStatsSeparable = nullptr;
+  xStructSimSeparable::tCalcRngXPtr*  m_CalcPtrSeparableX     = nullptr;
+
+  //single precision engine (opt-in, gaussian regular modes with stride 1 and averaged block modes handled by sub-block engine)
+  bool m_UseFlt32 = false;
+  xStructSimSeparable::tCalcRngPtr* m_CalcPtrSeparableF32 = nullptr;
 
   //per-row partial results
   std::vector<flt64> m_RowSums[4];
@@ -73,16 +93,30 @@ protected: //MSSSIM
   int32  m_NumScales = NOT_VALID;
   xPicP* m_SubPicTst[c_NumMultiScales] = { nullptr };
   xPicP* m_SubPicRef[c_NumMultiScales] = { nullptr };
+  xStructSimPyramidCache* m_PyramidCache = nullptr; //optional, not owned - pyramids of source pictures shared between metrics
+  std::vector<flt64> m_ScaleRowSums[c_NumMultiScales][4]; //per-row partial results of scales 1..N (scale 0 uses m_RowSums), all scales are evaluated as single batch
 
 public:
   virtual void create (int32V2 PicSize, int32 BitDepth, int32 Margin, bool EnableMS);
   virtual void destroy();
 
   void setStructSimParams(eMode Mode, eMrgExt MarginMode, int32 BlockSize, int32 WndStride);
+  void setUseSeparable    (bool UseSeparable) { m_UseSeparable = UseSeparable; } //ignored for block modes and stride other than 1
+  bool isSeparableActive  () const { return m_UseSeparable && m_CalcPtrSeparable != nullptr && m_WndStride == 1; }
+  void setUseSubBlock     (bool UseSubBlock ) { m_UseSubBlock  = UseSubBlock;  } //ignored for modes other than BlockAveraged and window size not being a multiple of stride
+  bool isSubBlockActive   () const;
+  void setUseMomentCache  (bool UseMomentCache) { m_UseMomentCache = UseMomentCache; m_MomentCache.invalidate(); } //caller has to invalidate cache whenever content of pictures changes
+  void invalidateMomentCache() { m_MomentCache.invalidate(); }
+  bool isMomentCacheUsable  () const; //cache is consumed by double precision separable (gaussian) and sub-block engines only - window and multi-block kernels (i.e. default BlockAveraged 8x8/4) and RegularAveraged mode compute statistics directly
+  bool isMomentCacheActive  () const { return m_UseMomentCache && isMomentCacheUsable(); }
+  int64 getNumMomentCacheHits() const { return m_MomentCache.getNumHits(); }
+  void setUseFlt32        (bool UseFlt32) { m_UseFlt32 = UseFlt32; } //results differ from flt64 engine within documented tolerance, unsupported configurations stay in flt64
+  bool isFlt32Active      () const;
+  void setPyramidCache    (xStructSimPyramidCache* PyramidCache) { m_PyramidCache = PyramidCache; } //caller owns the cache and has to invalidate it whenever content of pictures changes
 
   flt64V4 calcPicSSIM  (const xPicP* Tst, const xPicP* Ref) { return xCalcPicSSIM(Tst, Ref, true); }
   flt64V4 calcPicMSSSIM(const xPicP* Tst, const xPicP* Ref);
-  flt64V4 calcPicSSIMM (const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, int32 NumNonMasked = NOT_VALID);
+  flt64V4 calcPicSSIMM (const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, int32 NumNonMasked = NOT_VALID); //NumNonMasked - non-masked pixels within evaluated area (without margin extension only windows fully inside picture), counted if NOT_VALID
 
   void    visualizeSSIM(xPlane<uint16>* Vis, const xPicP* Tst, const xPicP* Ref, eCmp CmpId);
 
@@ -92,11 +126,17 @@ public:
 
 protected:  
   void    xInitLoopRanges(int32 Width, int32 Height);
+  int32   xCountNonMasked(const xPicP* Msk); //non-masked pixels within evaluated area
 
   flt64V4 xCalcPicSSIM(const xPicP* Tst, const xPicP* Ref,                            bool CalcL);
   flt64   xCalcCmpSSIM(const xPicP* Tst, const xPicP* Ref, eCmp CmpId,                bool CalcL);
-  flt64   xCalcRowSSIM(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, const int32 y, bool CalcL) const;
-  flt64   xCalcRowSSIM_MB(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, const int32 y, bool CalcL) const;
+  flt64   xCalcRowSSIM   (const xPicP* Tst, const xPicP* Ref, eCmp CmpId, const int32 y, const int32 BegX,                        const int32 EndX, bool CalcL) const;
+  flt64   xCalcRowSSIM_MB(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, const int32 y, const int32 BegX, const int32 BatchEndX, const int32 EndX, bool CalcL) const;
+  void    xStoreCmpTasks         (const xPicP* Tst, const xPicP* Ref, eCmp CmpId, flt64* RowSums, bool CalcL); //per-row sums in RowSums, tasks are executed by caller
+  void    xStoreRngTasksSeparable(const xPicP* Tst, const xPicP* Ref, eCmp CmpId, flt64* RowSums, bool CalcL);
+  void    xStoreRngTasksSubBlock (const xPicP* Tst, const xPicP* Ref, eCmp CmpId, flt64* RowSums, bool CalcL);
+  bool    xIsCacheable(const xPicP* Pic) const;
+  std::vector<flt64>& xGetScaleRowSums(int32 ScaleIdx, int32 CmpIdx) { return ScaleIdx == 0 ? m_RowSums[CmpIdx] : m_ScaleRowSums[ScaleIdx][CmpIdx]; }
 
   flt64V4 xCalcPicSSIMM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk,             int32 NumNonMasked, bool CalcL);
   flt64   xCalcCmpSSIMM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, eCmp CmpId, int32 NumNonMasked, bool CalcL);
@@ -104,6 +144,10 @@ protected:
 
   void    xVisPicSSIM(xPlane<uint16>* Vis, const xPicP* Tst, const xPicP* Ref, eCmp CmpId, bool UseMin);
 
+  static constexpr int32 c_NumRowsInDownsampleRng = 16; //destination rows per downsampling task
+  void    xDownsamplePicPair(xPicP* DstT, xPicP* DstR, const xPicP* SrcT, const xPicP* SrcR); //next scale of both MS-SSIM pyramids (multithreaded, margins extended if used), nullptr Dst is skipped
+  void    xStoreDownsampleTasks(xPicP* Dst, const xPicP* Src, eCmp CmpId); //row bands of single component
+
 public:
   static int32 xCalcNumBlocks(int32 Length, int32 BlockSize, int32 BlockStride);
   static int32 xNumOverlappingBlocksInSize(int32 Length, int32 Log2BlockSize) { return (Length >> Log2BlockSize) + ((Length - xLog2SizeToSize(Log2BlockSize - 1)) >> Log2BlockSize); }
@@ -41,6 +41,40 @@ void xShftCompPic::GenShftCompPicsM(xPicI* DstRef, xPicI* DstTst, const xPicI* S
   xGenShftCompPicM(DstTst, SrcTst, SrcRef, Msk, GlobalColorDiffTst2Ref, SearchRange, CmpWeights, TPI);
 }
 
+void xShftCompPic::GenShftCompPicsFromDispMaps(xPicP* DstRef, xPicP* DstTst, const xPicP* SrcRef, const xPicP* SrcTst, const xDispMap* DispMapRef, const xDispMap* DispMapTst, const int32V4& GlobalColorDiffRef2Tst, tThPI* TPI)
+{
+  assert(DstRef != nullptr && DstTst != nullptr && SrcRef != nullptr && SrcTst != nullptr && DispMapRef != nullptr && DispMapTst != nullptr);
+  assert(DstRef->isCompatible(DstTst) && DstRef->isCompatible(SrcRef) && DstRef->isCompatible(SrcTst));
+  assert(DstRef->isSameSize(DispMapRef) && DstRef->isSameSize(DispMapTst));
+
+  const int32V4 GlobalColorDiffTst2Ref = -GlobalColorDiffRef2Tst;
+
+  xGenShftCompPicFromDispMap(DstRef, SrcRef, nullptr, DispMapRef, GlobalColorDiffRef2Tst, TPI);
+  xGenShftCompPicFromDispMap(DstTst, SrcTst, nullptr, DispMapTst, GlobalColorDiffTst2Ref, TPI);
+}
+void xShftCompPic::GenShftCompPicsFromDispMaps(xPicI* DstRef, xPicI* DstTst, const xPicI* SrcRef, const xPicI* SrcTst, const xDispMap* DispMapRef, const xDispMap* DispMapTst, const int32V4& GlobalColorDiffRef2Tst, tThPI* TPI)
+{
+  assert(DstRef != nullptr && DstTst != nullptr && SrcRef != nullptr && SrcTst != nullptr && DispMapRef != nullptr && DispMapTst != nullptr);
+  assert(DstRef->isCompatible(DstTst) && DstRef->isCompatible(SrcRef) && DstRef->isCompatible(SrcTst));
+  assert(DstRef->isSameSize(DispMapRef) && DstRef->isSameSize(DispMapTst));
+
+  const int32V4 GlobalColorDiffTst2Ref = -GlobalColorDiffRef2Tst;
+
+  xGenShftCompPicFromDispMap(DstRef, SrcRef, nullptr, DispMapRef, GlobalColorDiffRef2Tst, TPI);
+  xGenShftCompPicFromDispMap(DstTst, SrcTst, nullptr, DispMapTst, GlobalColorDiffTst2Ref, TPI);
+}
+void xShftCompPic::GenShftCompPicsFromDispMapsM(xPicI* DstRef, xPicI* DstTst, const xPicI* SrcRef, const xPicI* SrcTst, const xPicP* Msk, const xDispMap* DispMapRef, const xDispMap* DispMapTst, const int32V4& GlobalColorDiffRef2Tst, tThPI* TPI)
+{
+  assert(DstRef != nullptr && DstTst != nullptr && SrcRef != nullptr && SrcTst != nullptr && Msk != nullptr && DispMapRef != nullptr && DispMapTst != nullptr);
+  assert(DstRef->isCompatible(DstTst) && DstRef->isCompatible(SrcRef) && DstRef->isCompatible(SrcTst));
+  assert(DstRef->isSameSize(Msk) && DstRef->isSameSize(DispMapRef) && DstRef->isSameSize(DispMapTst));
+
+  const int32V4 GlobalColorDiffTst2Ref = -GlobalColorDiffRef2Tst;
+
+  xGenShftCompPicFromDispMap(DstRef, SrcRef, Msk, DispMapRef, GlobalColorDiffRef2Tst, TPI);
+  xGenShftCompPicFromDispMap(DstTst, SrcTst, Msk, DispMapTst, GlobalColorDiffTst2Ref, TPI);
+}
+
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 void xShftCompPic::xGenShftCompPic(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, tThPI* TPI)
@@ -116,6 +150,33 @@ void xShftCompPic::xGenShftCompRngM(xPicI* DstRef, const xPicI* Ref, const xPicI
   }
 }
 
+template<class tPic> void xShftCompPic::xGenShftCompPicFromDispMap(tPic* DstRef, const tPic* Ref, const xPicP* Msk, const xDispMap* DispMap, const int32V4& GlobalColorShift, tThPI* TPI)
+{
+  const int32 Height = Ref->getHeight();
+
+  auto GenRng = [&DstRef, &Ref, &Msk, &DispMap, &GlobalColorShift](int32 BegY, int32 EndY)
+  {
+    for(int32 y = BegY; y < EndY; y++)
+    {
+      if constexpr(std::is_same_v<tPic, xPicI>) { if(Msk != nullptr) { xCorrespPixelShift::GenShftCompRowFromDispMapM(DstRef, DispMap, Ref, Msk, y, GlobalColorShift); continue; } }
+      xCorrespPixelShift::GenShftCompRowFromDispMap(DstRef, DispMap, Ref, y, GlobalColorShift);
+    }
+  };
+
+  if(TPI != nullptr && TPI->isActive())
+  {
+    for(int32 y = 0; y < Height; y += xMultiThreaded::c_NumRowsInRng)
+    {
+      TPI->storeTask([&GenRng, y, Height](int32 /*ThreadIdx*/) { GenRng(y, xMin(y + xMultiThreaded::c_NumRowsInRng, Height)); });
+    }
+    TPI->executeStoredTasks();
+  }
+  else
+  {
+    GenRng(0, Height);
+  }
+}
+
 //===============================================================================================================================================================================================================
 
 } //end of namespace PMBB
\ No newline at end of file
@@ -22,6 +22,11 @@ public:
   static void GenShftCompPics (xPicI* DstRef, xPicI* DstTst, const xPicI* SrcRef, const xPicI* SrcTst,                   const int32V4& GlobalColorDiffRef2Tst, const int32 SearchRange, const int32V4& CmpWeights, tThPI* TPI = nullptr);
   static void GenShftCompPicsM(xPicI* DstRef, xPicI* DstTst, const xPicI* SrcRef, const xPicI* SrcTst, const xPicP* Msk, const int32V4& GlobalColorDiffRef2Tst, const int32 SearchRange, const int32V4& CmpWeights, tThPI* TPI = nullptr);
 
+  //from displacement maps (no search), DispMapRef/DispMapTst are maps of SrcTst/SrcRef pixels searched within SrcRef/SrcTst
+  static void GenShftCompPicsFromDispMaps (xPicP* DstRef, xPicP* DstTst, const xPicP* SrcRef, const xPicP* SrcTst,                   const xDispMap* DispMapRef, const xDispMap* DispMapTst, const int32V4& GlobalColorDiffRef2Tst, tThPI* TPI = nullptr);
+  static void GenShftCompPicsFromDispMaps (xPicI* DstRef, xPicI* DstTst, const xPicI* SrcRef, const xPicI* SrcTst,                   const xDispMap* DispMapRef, const xDispMap* DispMapTst, const int32V4& GlobalColorDiffRef2Tst, tThPI* TPI = nullptr);
+  static void GenShftCompPicsFromDispMapsM(xPicI* DstRef, xPicI* DstTst, const xPicI* SrcRef, const xPicI* SrcTst, const xPicP* Msk, const xDispMap* DispMapRef, const xDispMap* DispMapTst, const int32V4& GlobalColorDiffRef2Tst, tThPI* TPI = nullptr);
+
 protected:
   static void xGenShftCompPic (xPicP* DstRef, const xPicP* Ref, const xPicP* Tst,                   const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, tThPI* TPI);
   static void xGenShftCompPic (xPicI* DstRef, const xPicI* Ref, const xPicI* Tst,                   const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, tThPI* TPI);
@@ -30,6 +35,8 @@ protected:
   static void xGenShftCompRng (xPicP* DstRef, const xPicP* Ref, const xPicP* Tst,                   const int32 BegY, const int32 EndY, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
   static void xGenShftCompRng (xPicI* DstRef, const xPicI* Ref, const xPicI* Tst,                   const int32 BegY, const int32 EndY, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
   static void xGenShftCompRngM(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const xPicP* Msk, const int32 BegY, const int32 EndY, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights);
+
+  template<class tPic> static void xGenShftCompPicFromDispMap(tPic* DstRef, const tPic* Ref, const xPicP* Msk, const xDispMap* DispMap, const int32V4& GlobalColorShift, tThPI* TPI);
 };
 
 //===============================================================================================================================================================================================================
@@ -49,6 +56,18 @@ public:
   {
     xShftCompPic::GenShftCompPicsM(DstRef, DstTst, SrcRef, SrcTst, Msk, GlobalColorDiffRef2Tst, m_SearchRange, m_CmpWeightsSearch, m_ThPI);
   }
+  inline void GenShftCompPicsFromDispMaps(xPicP* DstRef, xPicP* DstTst, const xPicP* SrcRef, const xPicP* SrcTst, const xDispMap* DispMapRef, const xDispMap* DispMapTst, const int32V4& GlobalColorDiffRef2Tst)
+  {
+    xShftCompPic::GenShftCompPicsFromDispMaps(DstRef, DstTst, SrcRef, SrcTst, DispMapRef, DispMapTst, GlobalColorDiffRef2Tst, m_ThPI);
+  }
+  inline void GenShftCompPicsFromDispMaps(xPicI* DstRef, xPicI* DstTst, const xPicI* SrcRef, const xPicI* SrcTst, const xDispMap* DispMapRef, const xDispMap* DispMapTst, const int32V4& GlobalColorDiffRef2Tst)
+  {
+    xShftCompPic::GenShftCompPicsFromDispMaps(DstRef, DstTst, SrcRef, SrcTst, DispMapRef, DispMapTst, GlobalColorDiffRef2Tst, m_ThPI);
+  }
+  inline void GenShftCompPicsFromDispMapsM(xPicI* DstRef, xPicI* DstTst, const xPicI* SrcRef, const xPicI* SrcTst, const xPicP* Msk, const xDispMap* DispMapRef, const xDispMap* DispMapTst, const int32V4& GlobalColorDiffRef2Tst)
+  {
+    xShftCompPic::GenShftCompPicsFromDispMapsM(DstRef, DstTst, SrcRef, SrcTst, Msk, DispMapRef, DispMapTst, GlobalColorDiffRef2Tst, m_ThPI);
+  }
 };
 
 //===============================================================================================================================================================================================================
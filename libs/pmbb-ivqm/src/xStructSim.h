@@ -52,9 +52,15 @@ class xStructSim //Structural Similarity
 
 public:
   //Regular Structural Similarity
-#if X_STRUCTSIM_CAN_USE_AVX512
+#if   X_STRUCTSIM_CAN_USE_AVX512
   static flt64 CalcRglrFlt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimAVX512::CalcRglrFlt(Tst, Ref, StrideT, StrideR, WndSize, C1, C2, CalcL); } //uses gaussian window
   static flt64 CalcRglrInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimAVX512::CalcRglrInt(Tst, Ref, StrideT, StrideR, WndSize, C1, C2, CalcL); } //uses gaussian window
+#elif X_STRUCTSIM_CAN_USE_AVX
+  static flt64 CalcRglrFlt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimAVX::CalcRglrFlt(Tst, Ref, StrideT, StrideR, WndSize, C1, C2, CalcL); } //uses gaussian window
+  static flt64 CalcRglrInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimAVX::CalcRglrInt(Tst, Ref, StrideT, StrideR, WndSize, C1, C2, CalcL); } //uses gaussian window
+#elif X_STRUCTSIM_CAN_USE_SSE
+  static flt64 CalcRglrFlt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimSSE::CalcRglrFlt(Tst, Ref, StrideT, StrideR, WndSize, C1, C2, CalcL); } //uses gaussian window
+  static flt64 CalcRglrInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimSSE::CalcRglrInt(Tst, Ref, StrideT, StrideR, WndSize, C1, C2, CalcL); } //uses gaussian window
 #else
   static flt64 CalcRglrFlt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimSTD::CalcRglrFlt(Tst, Ref, StrideT, StrideR, WndSize, C1, C2, CalcL); } //uses gaussian window
   static flt64 CalcRglrInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimSTD::CalcRglrInt(Tst, Ref, StrideT, StrideR, WndSize, C1, C2, CalcL); } //uses gaussian window
@@ -71,12 +77,34 @@ public:
 #endif
 
   //Regular Structural Similarity - with mask
+#if   X_STRUCTSIM_CAN_USE_AVX512
+  static flt64 CalcRglrFltM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimAVX512::CalcRglrFltM(Tst, Ref, Msk, StrideT, StrideR, StrideM, WndSize, C1, C2, CalcL); } //uses gaussian window
+  static flt64 CalcRglrIntM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimAVX512::CalcRglrIntM(Tst, Ref, Msk, StrideT, StrideR, StrideM, WndSize, C1, C2, CalcL); } //uses gaussian window
+  static flt64 CalcRglrAvgM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimAVX512::CalcRglrAvgM(Tst, Ref, Msk, StrideT, StrideR, StrideM, WndSize, C1, C2, CalcL); } //uses averaging
+#elif X_STRUCTSIM_CAN_USE_AVX
+  static flt64 CalcRglrFltM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimAVX::CalcRglrFltM(Tst, Ref, Msk, StrideT, StrideR, StrideM, WndSize, C1, C2, CalcL); } //uses gaussian window
+  static flt64 CalcRglrIntM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimAVX::CalcRglrIntM(Tst, Ref, Msk, StrideT, StrideR, StrideM, WndSize, C1, C2, CalcL); } //uses gaussian window
+  static flt64 CalcRglrAvgM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimAVX::CalcRglrAvgM(Tst, Ref, Msk, StrideT, StrideR, StrideM, WndSize, C1, C2, CalcL); } //uses averaging
+#elif X_STRUCTSIM_CAN_USE_SSE
+  static flt64 CalcRglrFltM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimSSE::CalcRglrFltM(Tst, Ref, Msk, StrideT, StrideR, StrideM, WndSize, C1, C2, CalcL); } //uses gaussian window
+  static flt64 CalcRglrIntM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimSSE::CalcRglrIntM(Tst, Ref, Msk, StrideT, StrideR, StrideM, WndSize, C1, C2, CalcL); } //uses gaussian window
+  static flt64 CalcRglrAvgM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimSSE::CalcRglrAvgM(Tst, Ref, Msk, StrideT, StrideR, StrideM, WndSize, C1, C2, CalcL); } //uses averaging
+#else
   static flt64 CalcRglrFltM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimSTD::CalcRglrFltM(Tst, Ref, Msk, StrideT, StrideR, StrideM, WndSize, C1, C2, CalcL); } //uses gaussian window
   static flt64 CalcRglrIntM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimSTD::CalcRglrIntM(Tst, Ref, Msk, StrideT, StrideR, StrideM, WndSize, C1, C2, CalcL); } //uses gaussian window
   static flt64 CalcRglrAvgM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { CHKW11; return xStructSimSTD::CalcRglrAvgM(Tst, Ref, Msk, StrideT, StrideR, StrideM, WndSize, C1, C2, CalcL); } //uses averaging
+#endif
 
   //Block Structural Similarity
+#if   X_STRUCTSIM_CAN_USE_AVX512
+  static inline flt64 CalcBlckInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { return xStructSimAVX512::CalcBlckInt(Tst, Ref, StrideT, StrideR, WndSize, C1, C2, CalcL); }
+#elif X_STRUCTSIM_CAN_USE_AVX
+  static inline flt64 CalcBlckInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { return xStructSimAVX::CalcBlckInt(Tst, Ref, StrideT, StrideR, WndSize, C1, C2, CalcL); }
+#elif X_STRUCTSIM_CAN_USE_SSE
+  static inline flt64 CalcBlckInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { return xStructSimSSE::CalcBlckInt(Tst, Ref, StrideT, StrideR, WndSize, C1, C2, CalcL); }
+#else
   static inline flt64 CalcBlckInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { return xStructSimSTD::CalcBlckInt(Tst, Ref, StrideT, StrideR, WndSize, C1, C2, CalcL); }
+#endif
 
 #if   X_STRUCTSIM_CAN_USE_AVX512
   static inline flt64 CalcBlckAvg(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL) { return xStructSimAVX512::CalcBlckAvg(Tst, Ref, StrideT, StrideR, WndSize, C1, C2, CalcL); }
@@ -101,7 +129,6 @@ public:
   //Multi-Block Structural Similarity
   static constexpr int32 c_MaxBatchSize = 8;
 
-  using tCalcPtrMultiBlkAvgTail  = flt64(                       const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, flt64 C1, flt64 C2, bool CalcL);
   using tCalcPtrMultiBlkAvgBatch = void (flt64* restrict SSIMs, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, flt64 C1, flt64 C2, bool CalcL);
 
 #if X_STRUCTSIM_CAN_USE_AVX512
@@ -109,23 +136,23 @@ public:
   {
     if     (WndSize == 8 && WndStride == 4) { return 7; }
     else if(WndSize == 8 && WndStride == 8) { return 4; }
-    else                                    { return 0; }
+    else                                    { return xStructSimAVX::getCalcPtrMultiBlckAvg(WndSize, WndStride) ? xStructSimAVX::c_MultiBlckBatchSize : 0; }
   }
   static tCalcPtrMultiBlkAvgBatch* getCalcPtrMultiBlkAvgBatch(int32 WndSize, int32 WndStride)
   {
     if     (WndSize == 8 && WndStride == 4) { return xStructSimAVX512::CalcMultiBlckAvg8S4; }
     else if(WndSize == 8 && WndStride == 8) { return xStructSimAVX512::CalcMultiBlckAvg8S8; }
-    else                                    { return nullptr                              ; }
-  }
-  static tCalcPtrMultiBlkAvgTail* getCalcPtrMultiBlkAvgTail(int32 WndSize, int32 /*WndStride*/)
-  {
-    if  (WndSize == 8) { return xStructSimAVX512::CalcBlckAvg8; }
-    else               { return nullptr                       ; }
+    else                                    { return xStructSimAVX::getCalcPtrMultiBlckAvg(WndSize, WndStride); }
   }
+#elif X_STRUCTSIM_CAN_USE_AVX
+  static int32                     getMultiBlockAvgBatchSize (int32 WndSize, int32 WndStride) { return xStructSimAVX::getCalcPtrMultiBlckAvg(WndSize, WndStride) ? xStructSimAVX::c_MultiBlckBatchSize : 0; }
+  static tCalcPtrMultiBlkAvgBatch* getCalcPtrMultiBlkAvgBatch(int32 WndSize, int32 WndStride) { return xStructSimAVX::getCalcPtrMultiBlckAvg(WndSize, WndStride); }
+#elif X_STRUCTSIM_CAN_USE_SSE
+  static int32                     getMultiBlockAvgBatchSize (int32 WndSize, int32 WndStride) { return xStructSimSSE::getCalcPtrMultiBlckAvg(WndSize, WndStride) ? xStructSimSSE::c_MultiBlckBatchSize : 0; }
+  static tCalcPtrMultiBlkAvgBatch* getCalcPtrMultiBlkAvgBatch(int32 WndSize, int32 WndStride) { return xStructSimSSE::getCalcPtrMultiBlckAvg(WndSize, WndStride); }
 #else
   static int32                     getMultiBlockAvgBatchSize (int32 /*WndSize*/, int32 /*WndStride*/) { return 0      ; }
   static tCalcPtrMultiBlkAvgBatch* getCalcPtrMultiBlkAvgBatch(int32 /*WndSize*/, int32 /*WndStride*/) { return nullptr; }
-  static tCalcPtrMultiBlkAvgTail*  getCalcPtrMultiBlkAvgTail (int32 /*WndSize*/, int32 /*WndStride*/) { return nullptr; }
 #endif
 };
 
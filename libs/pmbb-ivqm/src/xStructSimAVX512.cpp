@@ -634,6 +634,245 @@ void xStructSimAVX512::CalcMultiBlckAvg8S8(flt64* restrict SSIMs, const uint16*
   }
 }
 
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Block based (8x8, 16x16) structural similarity with integer gaussian weights - exact 32x32-->64 bit products, bit-exact with xStructSimSTD::CalcBlckInt
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+__m512i xStructSimAVX512::xMulU32ToU64(const __m512i& A_U32_V, const __m512i& CffE_U32_V, const __m512i& CffO_U32_V)
+{
+  return _mm512_add_epi64(_mm512_mul_epu32(A_U32_V, CffE_U32_V), _mm512_mul_epu32(_mm512_srli_epi64(A_U32_V, 32), CffO_U32_V));
+}
+template<int32 BlockSize> flt64 xStructSimAVX512::xCalcBlckInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, const int16* Cff, flt64 C1, flt64 C2, bool CalcL)
+{
+  __m512i SumR_I64_V  = _mm512_setzero_si512();
+  __m512i SumT_I64_V  = _mm512_setzero_si512();
+  __m512i SumRR_I64_V = _mm512_setzero_si512();
+  __m512i SumTT_I64_V = _mm512_setzero_si512();
+  __m512i SumRT_I64_V = _mm512_setzero_si512();
+
+  //8x8 block - two rows per iteration, 16x16 block - one row per iteration
+  constexpr int32 c_RowsPerIter = BlockSize < 16 ? 2 : 1;
+
+  for(int32 y = 0; y < BlockSize; y += c_RowsPerIter)
+  {
+    for(int32 x = 0; x < BlockSize; x += 16 / c_RowsPerIter)
+    {
+      __m256i Tst_U16_V, Ref_U16_V;
+      if constexpr(c_RowsPerIter == 2)
+      {
+        Tst_U16_V = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i*)(Tst + x))), _mm_loadu_si128((__m128i*)(Tst + StrideT + x)), 1);
+        Ref_U16_V = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i*)(Ref + x))), _mm_loadu_si128((__m128i*)(Ref + StrideR + x)), 1);
+      }
+      else
+      {
+        Tst_U16_V = _mm256_loadu_si256((__m256i*)(Tst + x));
+        Ref_U16_V = _mm256_loadu_si256((__m256i*)(Ref + x));
+      }
+      __m512i Tst_U32_V  = _mm512_cvtepu16_epi32(Tst_U16_V);
+      __m512i Ref_U32_V  = _mm512_cvtepu16_epi32(Ref_U16_V);
+      __m512i CffE_U32_V = _mm512_cvtepu16_epi32(_mm256_loadu_si256((__m256i*)(Cff + x))); //coefficient rows are contiguous
+
+      __m512i TT_U32_V = _mm512_mullo_epi32(Tst_U32_V, Tst_U32_V); //fits uint32 for any bit depth
+      __m512i RR_U32_V = _mm512_mullo_epi32(Ref_U32_V, Ref_U32_V);
+      __m512i RT_U32_V = _mm512_mullo_epi32(Ref_U32_V, Tst_U32_V);
+      __m512i CffO_U32_V = _mm512_srli_epi64(CffE_U32_V, 32);
+
+      SumT_I64_V  = _mm512_add_epi64(SumT_I64_V , xMulU32ToU64(Tst_U32_V, CffE_U32_V, CffO_U32_V)); //SumT  += T     * C;
+      SumR_I64_V  = _mm512_add_epi64(SumR_I64_V , xMulU32ToU64(Ref_U32_V, CffE_U32_V, CffO_U32_V)); //SumR  += R     * C;
+      SumTT_I64_V = _mm512_add_epi64(SumTT_I64_V, xMulU32ToU64(TT_U32_V , CffE_U32_V, CffO_U32_V)); //SumT2 += T * T * C;
+      SumRR_I64_V = _mm512_add_epi64(SumRR_I64_V, xMulU32ToU64(RR_U32_V , CffE_U32_V, CffO_U32_V)); //SumR2 += R * R * C;
+      SumRT_I64_V = _mm512_add_epi64(SumRT_I64_V, xMulU32ToU64(RT_U32_V , CffE_U32_V, CffO_U32_V)); //SumRT += R * T * C;
+    }
+    Ref += StrideR * c_RowsPerIter;
+    Tst += StrideT * c_RowsPerIter;
+    Cff += BlockSize * c_RowsPerIter;
+  }
+
+  int64 SumR  = xHorVecSumI64_epi64(SumR_I64_V );
+  int64 SumT  = xHorVecSumI64_epi64(SumT_I64_V );
+  int64 SumR2 = xHorVecSumI64_epi64(SumRR_I64_V);
+  int64 SumT2 = xHorVecSumI64_epi64(SumTT_I64_V);
+  int64 SumRT = xHorVecSumI64_epi64(SumRT_I64_V);
+
+  flt64 AvgR  = ((flt64)SumR  * xStructSimConsts::c_InvFltrIntMul);
+  flt64 AvgT  = ((flt64)SumT  * xStructSimConsts::c_InvFltrIntMul);
+  flt64 VarR2 = ((flt64)SumR2 * xStructSimConsts::c_InvFltrIntMul) - xPow2(AvgR);
+  flt64 VarT2 = ((flt64)SumT2 * xStructSimConsts::c_InvFltrIntMul) - xPow2(AvgT);
+  flt64 CovRT = ((flt64)SumRT * xStructSimConsts::c_InvFltrIntMul) - AvgR*AvgT;
+
+  if (CalcL)
+  {
+    flt64 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
+    flt64 CS   = (2 * CovRT       + C2) / (VarR2       + VarT2       + C2); //"Contrast"*"Similarity"
+    flt64 SSIM = L * CS;
+    return SSIM;
+  }
+  else
+  {
+    flt64 CS = (2 * CovRT + C2) / (VarR2 + VarT2 + C2); //"Contrast"*"Similarity"
+    return CS;
+  }
+}
+flt64 xStructSimAVX512::CalcBlckInt8(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, flt64 C1, flt64 C2, bool CalcL)
+{
+  return xCalcBlckInt<xStructSimConsts::c_Block8Size>(Tst, Ref, StrideT, StrideR, &xStructSimConsts::c_FilterBlckGaussInt8[0][0], C1, C2, CalcL);
+}
+flt64 xStructSimAVX512::CalcBlckInt16(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, flt64 C1, flt64 C2, bool CalcL)
+{
+  return xCalcBlckInt<xStructSimConsts::c_Block16Size>(Tst, Ref, StrideT, StrideR, &xStructSimConsts::c_FilterBlckGaussInt16[0][0], C1, C2, CalcL);
+}
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Regular (11x11) structural similarity - with mask (masked samples get zero weight)
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template<bool Gaussian> flt64 xStructSimAVX512::xCalcRglrM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, flt64 C1, flt64 C2, bool CalcL)
+{
+  constexpr int32 c_BlockSize = xStructSimConsts::c_FilterSize;
+
+  Tst -= (5 * StrideT + 5);
+  Ref -= (5 * StrideR + 5);
+  Msk -= (5 * StrideM + 5);
+
+  const int16* Cff = &xStructSimConsts::c_FilterRglrGaussIntPad[0][0];
+
+  __m512i SumR_I64_V  = _mm512_setzero_si512();
+  __m512i SumT_I64_V  = _mm512_setzero_si512();
+  __m512i SumRR_I64_V = _mm512_setzero_si512();
+  __m512i SumTT_I64_V = _mm512_setzero_si512();
+  __m512i SumRT_I64_V = _mm512_setzero_si512();
+  __m512i SumC_I32_V  = _mm512_setzero_si512();
+
+  constexpr __mmask16 LoadMask = (1 << c_BlockSize) - 1;
+  for(int32 y = 0; y < c_BlockSize; y++)
+  {
+    __m256i   Msk_U16_V = _mm256_maskz_loadu_epi16(LoadMask, Msk);
+    __mmask16 Valid     = _mm256_test_epi16_mask(Msk_U16_V, Msk_U16_V);
+
+    __m512i Tst_U32_V  = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(LoadMask, Tst));
+    __m512i Ref_U32_V  = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(LoadMask, Ref));
+    __m512i CffE_U32_V = Gaussian ? _mm512_maskz_cvtepu16_epi32(Valid, _mm256_loadu_si256((__m256i*)Cff)) : _mm512_maskz_set1_epi32(Valid, 1); //zero weights of masked samples
+    __m512i CffO_U32_V = _mm512_srli_epi64(CffE_U32_V, 32);
+    __m512i TT_U32_V   = _mm512_mullo_epi32(Tst_U32_V, Tst_U32_V); //fits uint32 for any bit depth
+    __m512i RR_U32_V   = _mm512_mullo_epi32(Ref_U32_V, Ref_U32_V);
+    __m512i RT_U32_V   = _mm512_mullo_epi32(Ref_U32_V, Tst_U32_V);
+
+    SumC_I32_V  = _mm512_add_epi32(SumC_I32_V , CffE_U32_V); //SumC  += C;
+    SumT_I64_V  = _mm512_add_epi64(SumT_I64_V , xMulU32ToU64(Tst_U32_V, CffE_U32_V, CffO_U32_V)); //SumT  += T     * C;
+    SumR_I64_V  = _mm512_add_epi64(SumR_I64_V , xMulU32ToU64(Ref_U32_V, CffE_U32_V, CffO_U32_V)); //SumR  += R     * C;
+    SumTT_I64_V = _mm512_add_epi64(SumTT_I64_V, xMulU32ToU64(TT_U32_V , CffE_U32_V, CffO_U32_V)); //SumT2 += T * T * C;
+    SumRR_I64_V = _mm512_add_epi64(SumRR_I64_V, xMulU32ToU64(RR_U32_V , CffE_U32_V, CffO_U32_V)); //SumR2 += R * R * C;
+    SumRT_I64_V = _mm512_add_epi64(SumRT_I64_V, xMulU32ToU64(RT_U32_V , CffE_U32_V, CffO_U32_V)); //SumRT += R * T * C;
+    Ref += StrideR;
+    Tst += StrideT;
+    Msk += StrideM;
+    Cff += xStructSimConsts::c_FilterRglrGaussIntPad[0].size();
+  }
+
+  int64 SumR  = xHorVecSumI64_epi64(SumR_I64_V );
+  int64 SumT  = xHorVecSumI64_epi64(SumT_I64_V );
+  int64 SumR2 = xHorVecSumI64_epi64(SumRR_I64_V);
+  int64 SumT2 = xHorVecSumI64_epi64(SumTT_I64_V);
+  int64 SumRT = xHorVecSumI64_epi64(SumRT_I64_V);
+  int64 SumC  = xHorVecSumI32_epi32(SumC_I32_V );
+
+  //normalize by sum of non-masked weights
+  flt64 InvC  = 1.0 / (flt64)SumC;
+  flt64 AvgR  = (flt64)SumR  * InvC;
+  flt64 AvgT  = (flt64)SumT  * InvC;
+  flt64 VarR2 = (flt64)SumR2 * InvC - xPow2(AvgR);
+  flt64 VarT2 = (flt64)SumT2 * InvC - xPow2(AvgT);
+  flt64 CovRT = (flt64)SumRT * InvC - AvgR*AvgT;
+
+  if (CalcL)
+  {
+    flt64 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
+    flt64 CS   = (2 * CovRT       + C2) / (VarR2       + VarT2       + C2); //"Contrast"*"Similarity"
+    flt64 SSIM = L * CS;
+    return SSIM;
+  }
+  else
+  {
+    flt64 CS = (2 * CovRT + C2) / (VarR2 + VarT2 + C2); //"Contrast"*"Similarity"
+    return CS;
+  }
+}
+flt64 xStructSimAVX512::CalcRglrFltM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL)
+{
+  constexpr int32 c_BlockSize = xStructSimConsts::c_FilterSize;
+
+  Tst -= (5 * StrideT + 5);
+  Ref -= (5 * StrideR + 5);
+  Msk -= (5 * StrideM + 5);
+
+  const flt32* Cff = &xStructSimConsts::c_FilterRglrGaussFlt32[0][0];
+
+  __m512d SumR_F64_V  = _mm512_setzero_pd();
+  __m512d SumT_F64_V  = _mm512_setzero_pd();
+  __m512d SumRR_F64_V = _mm512_setzero_pd();
+  __m512d SumTT_F64_V = _mm512_setzero_pd();
+  __m512d SumRT_F64_V = _mm512_setzero_pd();
+  __m512d SumC_F64_V  = _mm512_setzero_pd();
+
+  for(int32 y = 0; y < c_BlockSize; y++)
+  {
+    for(int32 x = 0; x < 16; x += 8)
+    {
+      const __mmask8 LoadMask = x == 0 ? 0xFF : 0x07; //lanes 11-15 are outside of window
+
+      __m128i  Msk_U16_V = _mm_maskz_loadu_epi16(LoadMask, Msk + x);
+      __mmask8 Valid     = _mm_test_epi16_mask(Msk_U16_V, Msk_U16_V);
+
+      __m512d Cff_F64_V = _mm512_cvtps_pd(_mm256_maskz_loadu_ps(Valid, Cff + x)); //zero weights of masked samples
+      __m512d Tst_F64_V = _mm512_cvtepi32_pd(_mm256_cvtepu16_epi32(_mm_maskz_loadu_epi16(LoadMask, Tst + x)));
+      __m512d Ref_F64_V = _mm512_cvtepi32_pd(_mm256_cvtepu16_epi32(_mm_maskz_loadu_epi16(LoadMask, Ref + x)));
+
+      SumC_F64_V  = _mm512_add_pd(SumC_F64_V , Cff_F64_V); //SumC  += C;
+      SumT_F64_V  = _mm512_add_pd(SumT_F64_V , _mm512_mul_pd(Tst_F64_V, Cff_F64_V)); //SumT  += T*C;
+      SumR_F64_V  = _mm512_add_pd(SumR_F64_V , _mm512_mul_pd(Ref_F64_V, Cff_F64_V)); //SumR  += R*C;
+      SumTT_F64_V = _mm512_add_pd(SumTT_F64_V, _mm512_mul_pd(_mm512_mul_pd(Tst_F64_V, Tst_F64_V), Cff_F64_V)); //SumT2 += T*T*C;
+      SumRR_F64_V = _mm512_add_pd(SumRR_F64_V, _mm512_mul_pd(_mm512_mul_pd(Ref_F64_V, Ref_F64_V), Cff_F64_V)); //SumR2 += R*R*C;
+      SumRT_F64_V = _mm512_add_pd(SumRT_F64_V, _mm512_mul_pd(_mm512_mul_pd(Tst_F64_V, Ref_F64_V), Cff_F64_V)); //SumRT += R*T*C;
+    }
+    Ref += StrideR;
+    Tst += StrideT;
+    Msk += StrideM;
+    Cff += c_BlockSize;
+  }
+
+  flt64 SumR  = xHorVecSum_pd(SumR_F64_V );
+  flt64 SumT  = xHorVecSum_pd(SumT_F64_V );
+  flt64 SumR2 = xHorVecSum_pd(SumRR_F64_V);
+  flt64 SumT2 = xHorVecSum_pd(SumTT_F64_V);
+  flt64 SumRT = xHorVecSum_pd(SumRT_F64_V);
+  flt64 SumC  = xHorVecSum_pd(SumC_F64_V );
+
+  //normalize by sum of non-masked weights
+  flt64 InvC  = 1.0 / SumC;
+  flt64 AvgR  = SumR  * InvC;
+  flt64 AvgT  = SumT  * InvC;
+  flt64 VarR2 = SumR2 * InvC - xPow2(AvgR);
+  flt64 VarT2 = SumT2 * InvC - xPow2(AvgT);
+  flt64 CovRT = SumRT * InvC - AvgR*AvgT;
+
+  if (CalcL)
+  {
+    flt64 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
+    flt64 CS   = (2 * CovRT       + C2) / (VarR2       + VarT2       + C2); //"Contrast"*"Similarity"
+    flt64 SSIM = L * CS;
+    return SSIM;
+  }
+  else
+  {
+    flt64 CS = (2 * CovRT + C2) / (VarR2 + VarT2 + C2); //"Contrast"*"Similarity"
+    return CS;
+  }
+}
+flt64 xStructSimAVX512::CalcRglrIntM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL)
+{
+  return xCalcRglrM<true>(Tst, Ref, Msk, StrideT, StrideR, StrideM, C1, C2, CalcL);
+}
+flt64 xStructSimAVX512::CalcRglrAvgM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL)
+{
+  return xCalcRglrM<false>(Tst, Ref, Msk, StrideT, StrideR, StrideM, C1, C2, CalcL);
+}
 //===============================================================================================================================================================================================================
 
 } //end of namespace PMBB
@@ -82,6 +82,20 @@ public:
     { 0.00000105756559815326, 0.00000781441153305360, 0.00003702247708274889, 0.00011246435511667909, 0.00021905065286601736, 0.00027356116008580585, 0.00021905065286601736, 0.00011246435511667909, 0.00003702247708274889, 0.00000781441153305360, 0.00000105756559815326, },
   } };
 
+  //separable gaussian filter - c_FilterRglrGaussFlt64 is an outer product of this 1D kernel
+  using tFltrSprbFlt32 = std::array<flt32, c_FilterSize>;
+  using tFltrSprbFlt64 = std::array<flt64, c_FilterSize>;
+
+  PMBB_ALIGN_CACHE static constexpr tFltrSprbFlt32 c_FilterSprbGaussFlt32 =
+  {
+    0.00102838008447911008f, 0.00759875813523918503f, 0.03600077212843082880f, 0.10936068950970001534f, 0.21300553771125368963f, 0.26601172486179436305f, 0.21300553771125368963f, 0.10936068950970001534f, 0.03600077212843082880f, 0.00759875813523918503f, 0.00102838008447911008f,
+  };
+
+  PMBB_ALIGN_CACHE static constexpr tFltrSprbFlt64 c_FilterSprbGaussFlt64 =
+  {
+    0.00102838008447911008, 0.00759875813523918503, 0.03600077212843082880, 0.10936068950970001534, 0.21300553771125368963, 0.26601172486179436305, 0.21300553771125368963, 0.10936068950970001534, 0.03600077212843082880, 0.00759875813523918503, 0.00102838008447911008,
+  };
+
   //it`s stupid approach but still usefull for debuging purposes
   //static constexpr tFltrRglrFlt32 c_FilterGrlrAvgFlt32 =
   //{ {
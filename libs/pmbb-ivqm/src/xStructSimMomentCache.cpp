@@ -0,0 +1,53 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "xStructSimMomentCache.h"
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+// xStructSimMomentCache
+//===============================================================================================================================================================================================================
+void xStructSimMomentCache::setPlaneSize(int32 PlaneStride, int32 PlaneHeight)
+{
+  const int32 PlaneArea = PlaneStride * PlaneHeight;
+  if(PlaneStride == m_PlaneStride && PlaneArea == m_PlaneArea) { return; }
+
+  m_PlaneStride = PlaneStride;
+  m_PlaneArea   = PlaneArea;
+  invalidate();
+}
+void xStructSimMomentCache::invalidate()
+{
+  for(std::unique_ptr<xEntry>& Entry : m_Entries)
+  {
+    Entry->m_Pic = nullptr;
+    for(int32 CmpIdx = 0; CmpIdx < c_MaxNumCmps; CmpIdx++) { Entry->m_Valid[CmpIdx] = false; }
+  }
+}
+xStructSimMomentCache::xEntry* xStructSimMomentCache::acquire(const xPicP* Pic, eCmp CmpId)
+{
+  xEntry* Entry = nullptr;
+  for(std::unique_ptr<xEntry>& E : m_Entries) { if(E->m_Pic == Pic    ) { Entry = E.get(); break; } }
+  if(Entry == nullptr)
+  {
+    for(std::unique_ptr<xEntry>& E : m_Entries) { if(E->m_Pic == nullptr) { Entry = E.get(); break; } }
+    if(Entry == nullptr) { m_Entries.push_back(std::make_unique<xEntry>()); Entry = m_Entries.back().get(); }
+    Entry->m_Pic = Pic;
+  }
+
+  const int32 CmpIdx = (int32)CmpId;
+  if(Entry->m_Valid[CmpIdx]) { m_NumHits++; }
+  if(!Entry->m_Valid[CmpIdx] && (int32)Entry->m_Sum[CmpIdx].size() < m_PlaneArea)
+  {
+    Entry->m_Sum  [CmpIdx].resize(m_PlaneArea);
+    Entry->m_SumSq[CmpIdx].resize(m_PlaneArea);
+  }
+  return Entry;
+}
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
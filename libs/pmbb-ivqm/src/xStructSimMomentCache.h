@@ -0,0 +1,52 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#pragma once
+#include "xCommonDefIVQM.h"
+#include "xPic.h"
+#include <vector>
+#include <memory>
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+
+class xStructSimMomentCache //per-frame cache of single picture window statistics (window sum and sum of squares), keyed by picture
+{
+public:
+  static constexpr int32 c_MaxNumCmps = 4;
+
+  class xEntry
+  {
+  public:
+    const xPicP*       m_Pic = nullptr;
+    std::vector<flt64> m_Sum  [c_MaxNumCmps];
+    std::vector<flt64> m_SumSq[c_MaxNumCmps];
+    bool               m_Valid[c_MaxNumCmps] = { false, false, false, false };
+  };
+
+protected:
+  std::vector<std::unique_ptr<xEntry>> m_Entries;
+  int32 m_PlaneStride = 0;
+  int32 m_PlaneArea   = 0;
+  int64 m_NumHits     = 0; //number of acquired components already filled after last invalidate()
+
+public:
+  //planes have to be able to hold PlaneStride * PlaneHeight values - changing geometry invalidates all entries
+  void    setPlaneSize(int32 PlaneStride, int32 PlaneHeight);
+  int32   getPlaneStride() const { return m_PlaneStride; }
+
+  //has to be called whenever content of cached pictures changes (i.e. for every frame)
+  void    invalidate();
+
+  //returns entry for given picture (existing or reused/allocated one) with planes of CmpId allocated, component is valid only if filled after last invalidate()
+  xEntry* acquire(const xPicP* Pic, eCmp CmpId);
+
+  int64   getNumHits() const { return m_NumHits; }
+};
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
@@ -0,0 +1,67 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "xStructSimPyramidCache.h"
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+// xStructSimPyramidCache
+//===============================================================================================================================================================================================================
+void xStructSimPyramidCache::create(int32V2 PicSize, int32 BitDepth, int32 Margin, int32 NumScales)
+{
+  m_PicSize   = PicSize;
+  m_BitDepth  = BitDepth;
+  m_Margin    = Margin;
+  m_NumScales = NumScales;
+}
+void xStructSimPyramidCache::destroy()
+{
+  for(std::unique_ptr<xEntry>& Entry : m_Entries)
+  {
+    for(int32 i = 1; i < c_NumMultiScales; i++)
+    {
+      if(Entry->m_Scales[i]) { Entry->m_Scales[i]->destroy(); delete Entry->m_Scales[i]; Entry->m_Scales[i] = nullptr; }
+    }
+  }
+  m_Entries.clear();
+  m_PicSize   = { NOT_VALID, NOT_VALID };
+  m_BitDepth  = NOT_VALID;
+  m_Margin    = NOT_VALID;
+  m_NumScales = NOT_VALID;
+}
+void xStructSimPyramidCache::invalidate()
+{
+  for(std::unique_ptr<xEntry>& Entry : m_Entries)
+  {
+    Entry->m_Pic = nullptr;
+    for(int32 i = 0; i < c_NumMultiScales; i++) { Entry->m_Valid[i] = false; }
+  }
+}
+xStructSimPyramidCache::xEntry* xStructSimPyramidCache::acquire(const xPicP* Pic)
+{
+  for(std::unique_ptr<xEntry>& E : m_Entries) { if(E->m_Pic == Pic) { return E.get(); } }
+
+  xEntry* Entry = nullptr;
+  for(std::unique_ptr<xEntry>& E : m_Entries) { if(E->m_Pic == nullptr) { Entry = E.get(); break; } }
+  if(Entry == nullptr)
+  {
+    m_Entries.push_back(std::make_unique<xEntry>());
+    Entry = m_Entries.back().get();
+    int32V2 LastSize = m_PicSize;
+    for(int32 i = 1; i < m_NumScales; i++)
+    {
+      int32V2 NewSize = LastSize >> 1;
+      Entry->m_Scales[i] = new xPicP(NewSize, m_BitDepth, m_Margin);
+      LastSize = NewSize;
+    }
+  }
+  Entry->m_Pic = Pic;
+  return Entry;
+}
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
@@ -0,0 +1,52 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#pragma once
+#include "xCommonDefIVQM.h"
+#include "xStructSimConsts.h"
+#include "xPic.h"
+#include <vector>
+#include <memory>
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+
+class xStructSimPyramidCache //per-frame cache of MS-SSIM pyramids (downsampled scales), keyed by source picture - owned by application, shared by metrics
+{
+public:
+  static constexpr int32 c_NumMultiScales = xStructSimConsts::c_NumMultiScales;
+
+  class xEntry
+  {
+  public:
+    const xPicP* m_Pic = nullptr;
+    xPicP*       m_Scales[c_NumMultiScales] = { nullptr }; //scale 0 is the source picture itself (not stored)
+    bool         m_Valid [c_NumMultiScales] = { false };
+  };
+
+protected:
+  std::vector<std::unique_ptr<xEntry>> m_Entries;
+  int32V2 m_PicSize   = { NOT_VALID, NOT_VALID };
+  int32   m_BitDepth  = NOT_VALID;
+  int32   m_Margin    = NOT_VALID;
+  int32   m_NumScales = NOT_VALID;
+
+public:
+  void    create (int32V2 PicSize, int32 BitDepth, int32 Margin, int32 NumScales);
+  void    destroy();
+
+  //has to be called whenever content of cached pictures changes (i.e. for every frame)
+  void    invalidate();
+
+  //returns entry for given picture (existing or reused/allocated one), scale is valid only if filled after last invalidate()
+  xEntry* acquire(const xPicP* Pic);
+
+  bool    isCompatible(const xPicP* Pic, int32 NumScales) const { return Pic->isSameSize(m_PicSize) && Pic->isSameBitDepth(m_BitDepth) && NumScales <= m_NumScales; }
+};
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
@@ -221,6 +221,522 @@ flt64 xStructSimSSE::CalcBlckAvg11(const uint16* Tst, const uint16* Ref, int32 S
 
 }
 
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+template<int32 WndSize, int32 WndStride> void xStructSimSSE::CalcMultiBlckAvg(flt64* restrict SSIMs, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, flt64 C1, flt64 C2, bool CalcL)
+{
+  constexpr int32 c_BatchSize    = c_MultiBlckBatchSize;
+  constexpr int32 c_StripWidth   = WndStride * (c_BatchSize - 1) + WndSize;
+  constexpr int32 c_BlockArea    = WndSize * WndSize;
+  constexpr flt64 c_InvBlockArea = (flt64)1.0 / (flt64)c_BlockArea;
+  static_assert(c_StripWidth >= 4, "strip narrower than single vector");
+
+  //column sums (products widened to 64bit - valid for any bit depth)
+  int32 ColR [c_StripWidth];
+  int32 ColT [c_StripWidth];
+  int64 ColRR[c_StripWidth];
+  int64 ColTT[c_StripWidth];
+  int64 ColRT[c_StripWidth];
+
+  //even and odd columns --> consecutive columns
+  auto StoreI64 = [](int64* Dst, const __m128i& Even_I64V, const __m128i& Odd_I64V)
+  {
+    _mm_storeu_si128((__m128i*)(Dst    ), _mm_unpacklo_epi64(Even_I64V, Odd_I64V)); //0 1
+    _mm_storeu_si128((__m128i*)(Dst + 2), _mm_unpackhi_epi64(Even_I64V, Odd_I64V)); //2 3
+  };
+
+  for(int32 c = 0; c < c_StripWidth; c += 4)
+  {
+    const int32 x = xMin(c, c_StripWidth - 4); //last chunk aligned to strip end (overlaps previous one) - never reads beyond strip
+    const uint16* TstPtr = Tst + x;
+    const uint16* RefPtr = Ref + x;
+
+    __m128i SumR_I32V   = _mm_setzero_si128();
+    __m128i SumT_I32V   = _mm_setzero_si128();
+    __m128i SumRRE_I64V = _mm_setzero_si128();
+    __m128i SumRRO_I64V = _mm_setzero_si128();
+    __m128i SumTTE_I64V = _mm_setzero_si128();
+    __m128i SumTTO_I64V = _mm_setzero_si128();
+    __m128i SumRTE_I64V = _mm_setzero_si128();
+    __m128i SumRTO_I64V = _mm_setzero_si128();
+
+    for(int32 y = 0; y < WndSize; y++)
+    {
+      __m128i Tst_I32V  = _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)TstPtr));
+      __m128i Ref_I32V  = _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)RefPtr));
+      __m128i TstO_I32V = _mm_srli_epi64(Tst_I32V, 32);
+      __m128i RefO_I32V = _mm_srli_epi64(Ref_I32V, 32);
+      SumT_I32V   = _mm_add_epi32(SumT_I32V  , Tst_I32V); //SumT  += T;
+      SumR_I32V   = _mm_add_epi32(SumR_I32V  , Ref_I32V); //SumR  += R;
+      SumTTE_I64V = _mm_add_epi64(SumTTE_I64V, _mm_mul_epu32(Tst_I32V , Tst_I32V )); //SumT2 += T*T;
+      SumTTO_I64V = _mm_add_epi64(SumTTO_I64V, _mm_mul_epu32(TstO_I32V, TstO_I32V));
+      SumRRE_I64V = _mm_add_epi64(SumRRE_I64V, _mm_mul_epu32(Ref_I32V , Ref_I32V )); //SumR2 += R*R;
+      SumRRO_I64V = _mm_add_epi64(SumRRO_I64V, _mm_mul_epu32(RefO_I32V, RefO_I32V));
+      SumRTE_I64V = _mm_add_epi64(SumRTE_I64V, _mm_mul_epu32(Ref_I32V , Tst_I32V )); //SumRT += R*T;
+      SumRTO_I64V = _mm_add_epi64(SumRTO_I64V, _mm_mul_epu32(RefO_I32V, TstO_I32V));
+      TstPtr += StrideT;
+      RefPtr += StrideR;
+    }
+
+    _mm_storeu_si128((__m128i*)(ColR + x), SumR_I32V);
+    _mm_storeu_si128((__m128i*)(ColT + x), SumT_I32V);
+    StoreI64(ColRR + x, SumRRE_I64V, SumRRO_I64V);
+    StoreI64(ColTT + x, SumTTE_I64V, SumTTO_I64V);
+    StoreI64(ColRT + x, SumRTE_I64V, SumRTO_I64V);
+  }
+
+  //block sums
+  flt64 BlkR [c_BatchSize];
+  flt64 BlkT [c_BatchSize];
+  flt64 BlkRR[c_BatchSize];
+  flt64 BlkTT[c_BatchSize];
+  flt64 BlkRT[c_BatchSize];
+
+  for(int32 b = 0; b < c_BatchSize; b++)
+  {
+    int64 SumR = 0, SumT = 0, SumRR = 0, SumTT = 0, SumRT = 0;
+    for(int32 x = b * WndStride; x < b * WndStride + WndSize; x++)
+    {
+      SumR  += ColR [x];
+      SumT  += ColT [x];
+      SumRR += ColRR[x];
+      SumTT += ColTT[x];
+      SumRT += ColRT[x];
+    }
+    BlkR [b] = (flt64)SumR ;
+    BlkT [b] = (flt64)SumT ;
+    BlkRR[b] = (flt64)SumRR;
+    BlkTT[b] = (flt64)SumTT;
+    BlkRT[b] = (flt64)SumRT;
+  }
+
+  //power of 2 block area - all products are exact, so vectorized evaluation gives results identical to xStructSimSTD::CalcBlckAvg
+  constexpr bool c_ExactProducts = (c_BlockArea & (c_BlockArea - 1)) == 0;
+
+  if constexpr(c_ExactProducts)
+  {
+    const __m128d InvBlockArea_F64V = _mm_set1_pd(c_InvBlockArea);
+    const __m128d C1_F64V           = _mm_set1_pd(C1 );
+    const __m128d C2_F64V           = _mm_set1_pd(C2 );
+    const __m128d Const2_F64V       = _mm_set1_pd(2.0);
+
+    for(int32 b = 0; b < c_BatchSize; b += 2)
+    {
+      __m128d AvgR_F64V     = _mm_mul_pd(_mm_loadu_pd(BlkR + b), InvBlockArea_F64V);
+      __m128d AvgT_F64V     = _mm_mul_pd(_mm_loadu_pd(BlkT + b), InvBlockArea_F64V);
+      __m128d Pow2AvgR_F64V = _mm_mul_pd(AvgR_F64V, AvgR_F64V);
+      __m128d Pow2AvgT_F64V = _mm_mul_pd(AvgT_F64V, AvgT_F64V);
+      __m128d VarR2_F64V    = _mm_sub_pd(_mm_mul_pd(_mm_loadu_pd(BlkRR + b), InvBlockArea_F64V), Pow2AvgR_F64V);
+      __m128d VarT2_F64V    = _mm_sub_pd(_mm_mul_pd(_mm_loadu_pd(BlkTT + b), InvBlockArea_F64V), Pow2AvgT_F64V);
+      __m128d CovRT_F64V    = _mm_sub_pd(_mm_mul_pd(_mm_loadu_pd(BlkRT + b), InvBlockArea_F64V), _mm_mul_pd(AvgR_F64V, AvgT_F64V));
+
+      __m128d CS_F64V = _mm_div_pd(_mm_add_pd(_mm_mul_pd(Const2_F64V, CovRT_F64V), C2_F64V), _mm_add_pd(_mm_add_pd(VarR2_F64V, VarT2_F64V), C2_F64V)); //"Contrast"*"Similarity"
+      if(CalcL)
+      {
+        __m128d L_F64V    = _mm_div_pd(_mm_add_pd(_mm_mul_pd(Const2_F64V, _mm_mul_pd(AvgR_F64V, AvgT_F64V)), C1_F64V), _mm_add_pd(_mm_add_pd(Pow2AvgR_F64V, Pow2AvgT_F64V), C1_F64V)); //"Luminance"
+        __m128d SSIM_F64V = _mm_mul_pd(L_F64V, CS_F64V);
+        _mm_storeu_pd(SSIMs + b, SSIM_F64V);
+      }
+      else
+      {
+        _mm_storeu_pd(SSIMs + b, CS_F64V);
+      }
+    }
+  }
+  else
+  {
+    //same expressions as xStructSimSTD::CalcBlckAvg - keeps identical rounding (including compiler FMA contraction)
+    for(int32 b = 0; b < c_BatchSize; b++)
+    {
+      flt64 AvgR  = BlkR [b] * c_InvBlockArea;
+      flt64 AvgT  = BlkT [b] * c_InvBlockArea;
+      flt64 VarR2 = BlkRR[b] * c_InvBlockArea - xPow2(AvgR);
+      flt64 VarT2 = BlkTT[b] * c_InvBlockArea - xPow2(AvgT);
+      flt64 CovRT = BlkRT[b] * c_InvBlockArea - AvgR*AvgT;
+
+      if(CalcL)
+      {
+        flt64 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
+        flt64 CS   = (2 * CovRT       + C2) / (VarR2       + VarT2       + C2); //"Contrast"*"Similarity"
+        SSIMs[b] = L * CS;
+      }
+      else
+      {
+        SSIMs[b] = (2 * CovRT + C2) / (VarR2 + VarT2 + C2); //"Contrast"*"Similarity"
+      }
+    }
+  }
+}
+xStructSimSSE::tCalcPtrMultiBlckAvg* xStructSimSSE::getCalcPtrMultiBlckAvg(int32 WndSize, int32 WndStride)
+{
+  //block sizes supported by xStructSim with default stride (4), half-block stride and non-overlapping blocks
+  switch(WndSize)
+  {
+    case  4: switch(WndStride) { case 2: return CalcMultiBlckAvg< 4, 2>; case  4: return CalcMultiBlckAvg< 4,  4>;                                                default: return nullptr; }
+    case  8: switch(WndStride) { case 4: return CalcMultiBlckAvg< 8, 4>; case  8: return CalcMultiBlckAvg< 8,  8>;                                                default: return nullptr; }
+    case 11: switch(WndStride) { case 4: return CalcMultiBlckAvg<11, 4>; case 11: return CalcMultiBlckAvg<11, 11>;                                                default: return nullptr; }
+    case 16: switch(WndStride) { case 4: return CalcMultiBlckAvg<16, 4>; case  8: return CalcMultiBlckAvg<16,  8>; case 16: return CalcMultiBlckAvg<16, 16>; default: return nullptr; }
+    case 32: switch(WndStride) { case 4: return CalcMultiBlckAvg<32, 4>; case 16: return CalcMultiBlckAvg<32, 16>; case 32: return CalcMultiBlckAvg<32, 32>; default: return nullptr; }
+    default: return nullptr;
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Block based (8x8, 16x16) structural similarity with integer gaussian weights - exact 32x32-->64 bit products, bit-exact with xStructSimSTD::CalcBlckInt
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+__m128i xStructSimSSE::xMulU32ToU64(const __m128i& A_U32_V, const __m128i& CffE_U32_V, const __m128i& CffO_U32_V)
+{
+  return _mm_add_epi64(_mm_mul_epu32(A_U32_V, CffE_U32_V), _mm_mul_epu32(_mm_srli_epi64(A_U32_V, 32), CffO_U32_V));
+}
+template<int32 BlockSize> flt64 xStructSimSSE::xCalcBlckInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, const int16* Cff, flt64 C1, flt64 C2, bool CalcL)
+{
+  __m128i SumR_I64_V  = _mm_setzero_si128();
+  __m128i SumT_I64_V  = _mm_setzero_si128();
+  __m128i SumRR_I64_V = _mm_setzero_si128();
+  __m128i SumTT_I64_V = _mm_setzero_si128();
+  __m128i SumRT_I64_V = _mm_setzero_si128();
+
+  for(int32 y = 0; y < BlockSize; y++)
+  {
+    for(int32 x = 0; x < BlockSize; x += 4)
+    {
+      __m128i Tst_U32_V  = _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)(Tst + x)));
+      __m128i Ref_U32_V  = _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)(Ref + x)));
+      __m128i CffE_U32_V = _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)(Cff + x)));
+
+      __m128i TT_U32_V = _mm_mullo_epi32(Tst_U32_V, Tst_U32_V); //fits uint32 for any bit depth
+      __m128i RR_U32_V = _mm_mullo_epi32(Ref_U32_V, Ref_U32_V);
+      __m128i RT_U32_V = _mm_mullo_epi32(Ref_U32_V, Tst_U32_V);
+      __m128i CffO_U32_V = _mm_srli_epi64(CffE_U32_V, 32);
+
+      SumT_I64_V  = _mm_add_epi64(SumT_I64_V , xMulU32ToU64(Tst_U32_V, CffE_U32_V, CffO_U32_V)); //SumT  += T     * C;
+      SumR_I64_V  = _mm_add_epi64(SumR_I64_V , xMulU32ToU64(Ref_U32_V, CffE_U32_V, CffO_U32_V)); //SumR  += R     * C;
+      SumTT_I64_V = _mm_add_epi64(SumTT_I64_V, xMulU32ToU64(TT_U32_V , CffE_U32_V, CffO_U32_V)); //SumT2 += T * T * C;
+      SumRR_I64_V = _mm_add_epi64(SumRR_I64_V, xMulU32ToU64(RR_U32_V , CffE_U32_V, CffO_U32_V)); //SumR2 += R * R * C;
+      SumRT_I64_V = _mm_add_epi64(SumRT_I64_V, xMulU32ToU64(RT_U32_V , CffE_U32_V, CffO_U32_V)); //SumRT += R * T * C;
+    }
+    Ref += StrideR;
+    Tst += StrideT;
+    Cff += BlockSize;
+  }
+
+  int64 SumR  = xHorVecSumI64_epi64(SumR_I64_V );
+  int64 SumT  = xHorVecSumI64_epi64(SumT_I64_V );
+  int64 SumR2 = xHorVecSumI64_epi64(SumRR_I64_V);
+  int64 SumT2 = xHorVecSumI64_epi64(SumTT_I64_V);
+  int64 SumRT = xHorVecSumI64_epi64(SumRT_I64_V);
+
+  flt64 AvgR  = ((flt64)SumR  * xStructSimConsts::c_InvFltrIntMul);
+  flt64 AvgT  = ((flt64)SumT  * xStructSimConsts::c_InvFltrIntMul);
+  flt64 VarR2 = ((flt64)SumR2 * xStructSimConsts::c_InvFltrIntMul) - xPow2(AvgR);
+  flt64 VarT2 = ((flt64)SumT2 * xStructSimConsts::c_InvFltrIntMul) - xPow2(AvgT);
+  flt64 CovRT = ((flt64)SumRT * xStructSimConsts::c_InvFltrIntMul) - AvgR*AvgT;
+
+  if (CalcL)
+  {
+    flt64 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
+    flt64 CS   = (2 * CovRT       + C2) / (VarR2       + VarT2       + C2); //"Contrast"*"Similarity"
+    flt64 SSIM = L * CS;
+    return SSIM;
+  }
+  else
+  {
+    flt64 CS = (2 * CovRT + C2) / (VarR2 + VarT2 + C2); //"Contrast"*"Similarity"
+    return CS;
+  }
+}
+flt64 xStructSimSSE::CalcBlckInt8(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, flt64 C1, flt64 C2, bool CalcL)
+{
+  return xCalcBlckInt<xStructSimConsts::c_Block8Size>(Tst, Ref, StrideT, StrideR, &xStructSimConsts::c_FilterBlckGaussInt8[0][0], C1, C2, CalcL);
+}
+flt64 xStructSimSSE::CalcBlckInt16(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, flt64 C1, flt64 C2, bool CalcL)
+{
+  return xCalcBlckInt<xStructSimConsts::c_Block16Size>(Tst, Ref, StrideT, StrideR, &xStructSimConsts::c_FilterBlckGaussInt16[0][0], C1, C2, CalcL);
+}
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Regular (11x11) structural similarity
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+flt64 xStructSimSSE::CalcRglrFlt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL)
+{
+  constexpr int32 c_BlockSize = xStructSimConsts::c_FilterSize;
+
+  Tst -= (5 * StrideT + 5);
+  Ref -= (5 * StrideR + 5);
+
+  const flt32* Cff = &xStructSimConsts::c_FilterRglrGaussFlt32[0][0];
+
+  __m128d SumR_F64_V  = _mm_setzero_pd();
+  __m128d SumT_F64_V  = _mm_setzero_pd();
+  __m128d SumRR_F64_V = _mm_setzero_pd();
+  __m128d SumTT_F64_V = _mm_setzero_pd();
+  __m128d SumRT_F64_V = _mm_setzero_pd();
+
+  for(int32 y = 0; y < c_BlockSize; y++)
+  {
+    for(int32 x = 0; x < 12; x += 2)
+    {
+      //lane 11 is outside of window - load single coefficient
+      __m128  Cff_F32_V = x < 10 ? _mm_castpd_ps(_mm_load_sd((const flt64*)(Cff + x))) : _mm_load_ss(Cff + x);
+      __m128d Cff_F64_V = _mm_cvtps_pd(Cff_F32_V);
+      __m128d Tst_F64_V = _mm_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_loadu_si32(Tst + x)));
+      __m128d Ref_F64_V = _mm_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_loadu_si32(Ref + x)));
+
+      SumT_F64_V  = _mm_add_pd(SumT_F64_V , _mm_mul_pd(Tst_F64_V, Cff_F64_V)); //SumT  += T*C;
+      SumR_F64_V  = _mm_add_pd(SumR_F64_V , _mm_mul_pd(Ref_F64_V, Cff_F64_V)); //SumR  += R*C;
+      SumTT_F64_V = _mm_add_pd(SumTT_F64_V, _mm_mul_pd(_mm_mul_pd(Tst_F64_V, Tst_F64_V), Cff_F64_V)); //SumT2 += T*T*C;
+      SumRR_F64_V = _mm_add_pd(SumRR_F64_V, _mm_mul_pd(_mm_mul_pd(Ref_F64_V, Ref_F64_V), Cff_F64_V)); //SumR2 += R*R*C;
+      SumRT_F64_V = _mm_add_pd(SumRT_F64_V, _mm_mul_pd(_mm_mul_pd(Tst_F64_V, Ref_F64_V), Cff_F64_V)); //SumRT += R*T*C;
+    }
+    Ref += StrideR;
+    Tst += StrideT;
+    Cff += c_BlockSize;
+  }
+
+  flt64 SumR  = xHorVecSum_pd(SumR_F64_V );
+  flt64 SumT  = xHorVecSum_pd(SumT_F64_V );
+  flt64 SumR2 = xHorVecSum_pd(SumRR_F64_V);
+  flt64 SumT2 = xHorVecSum_pd(SumTT_F64_V);
+  flt64 SumRT = xHorVecSum_pd(SumRT_F64_V);
+
+  flt64 AvgR  = SumR ;
+  flt64 AvgT  = SumT ;
+  flt64 VarR2 = SumR2 - xPow2(AvgR);
+  flt64 VarT2 = SumT2 - xPow2(AvgT);
+  flt64 CovRT = SumRT - AvgR*AvgT;
+
+  if (CalcL)
+  {
+    flt64 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
+    flt64 CS   = (2 * CovRT       + C2) / (VarR2       + VarT2       + C2); //"Contrast"*"Similarity"
+    flt64 SSIM = L * CS;
+    return SSIM;
+  }
+  else
+  {
+    flt64 CS = (2 * CovRT + C2) / (VarR2 + VarT2 + C2); //"Contrast"*"Similarity"
+    return CS;
+  }
+}
+flt64 xStructSimSSE::CalcRglrInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL)
+{
+  constexpr int32 c_BlockSize = xStructSimConsts::c_FilterSize;
+
+  Tst -= (5 * StrideT + 5);
+  Ref -= (5 * StrideR + 5);
+
+  const int16* Cff = &xStructSimConsts::c_FilterRglrGaussIntPad[0][0];
+
+  __m128i SumR_I64_V  = _mm_setzero_si128();
+  __m128i SumT_I64_V  = _mm_setzero_si128();
+  __m128i SumRR_I64_V = _mm_setzero_si128();
+  __m128i SumTT_I64_V = _mm_setzero_si128();
+  __m128i SumRT_I64_V = _mm_setzero_si128();
+
+  for(int32 y = 0; y < c_BlockSize; y++)
+  {
+    for(int32 x = 0; x < 12; x += 4)
+    {
+      __m128i Tst_U32_V  = _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)(Tst + x)));
+      __m128i Ref_U32_V  = _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)(Ref + x)));
+      __m128i CffE_U32_V = _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)(Cff + x))); //lane 11 has zero weight
+      __m128i CffO_U32_V = _mm_srli_epi64(CffE_U32_V, 32);
+      __m128i TT_U32_V   = _mm_mullo_epi32(Tst_U32_V, Tst_U32_V); //fits uint32 for any bit depth
+      __m128i RR_U32_V   = _mm_mullo_epi32(Ref_U32_V, Ref_U32_V);
+      __m128i RT_U32_V   = _mm_mullo_epi32(Ref_U32_V, Tst_U32_V);
+
+      SumT_I64_V  = _mm_add_epi64(SumT_I64_V , xMulU32ToU64(Tst_U32_V, CffE_U32_V, CffO_U32_V)); //SumT  += T     * C;
+      SumR_I64_V  = _mm_add_epi64(SumR_I64_V , xMulU32ToU64(Ref_U32_V, CffE_U32_V, CffO_U32_V)); //SumR  += R     * C;
+      SumTT_I64_V = _mm_add_epi64(SumTT_I64_V, xMulU32ToU64(TT_U32_V , CffE_U32_V, CffO_U32_V)); //SumT2 += T * T * C;
+      SumRR_I64_V = _mm_add_epi64(SumRR_I64_V, xMulU32ToU64(RR_U32_V , CffE_U32_V, CffO_U32_V)); //SumR2 += R * R * C;
+      SumRT_I64_V = _mm_add_epi64(SumRT_I64_V, xMulU32ToU64(RT_U32_V , CffE_U32_V, CffO_U32_V)); //SumRT += R * T * C;
+    }
+    Ref += StrideR;
+    Tst += StrideT;
+    Cff += xStructSimConsts::c_FilterRglrGaussIntPad[0].size();
+  }
+
+  int64 SumR  = xHorVecSumI64_epi64(SumR_I64_V );
+  int64 SumT  = xHorVecSumI64_epi64(SumT_I64_V );
+  int64 SumR2 = xHorVecSumI64_epi64(SumRR_I64_V);
+  int64 SumT2 = xHorVecSumI64_epi64(SumTT_I64_V);
+  int64 SumRT = xHorVecSumI64_epi64(SumRT_I64_V);
+
+  //same expressions as xStructSimSTD::CalcRglrInt - integer sums are exact, results are bit-exact
+  flt64 AvgR  = ((flt64)SumR  * xStructSimConsts::c_InvFltrIntMul);
+  flt64 AvgT  = ((flt64)SumT  * xStructSimConsts::c_InvFltrIntMul);
+  flt64 VarR2 = ((flt64)SumR2 * xStructSimConsts::c_InvFltrIntMul) - xPow2(AvgR);
+  flt64 VarT2 = ((flt64)SumT2 * xStructSimConsts::c_InvFltrIntMul) - xPow2(AvgT);
+  flt64 CovRT = ((flt64)SumRT * xStructSimConsts::c_InvFltrIntMul) - AvgR*AvgT;
+
+  if (CalcL)
+  {
+    flt64 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
+    flt64 CS   = (2 * CovRT       + C2) / (VarR2       + VarT2       + C2); //"Contrast"*"Similarity"
+    flt64 SSIM = L * CS;
+    return SSIM;
+  }
+  else
+  {
+    flt64 CS = (2 * CovRT + C2) / (VarR2 + VarT2 + C2); //"Contrast"*"Similarity"
+    return CS;
+  }
+}
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Regular (11x11) structural similarity - with mask (masked samples get zero weight)
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template<bool Gaussian> flt64 xStructSimSSE::xCalcRglrM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, flt64 C1, flt64 C2, bool CalcL)
+{
+  constexpr int32 c_BlockSize = xStructSimConsts::c_FilterSize;
+
+  Tst -= (5 * StrideT + 5);
+  Ref -= (5 * StrideR + 5);
+  Msk -= (5 * StrideM + 5);
+
+  const int16* Cff = &xStructSimConsts::c_FilterRglrGaussIntPad[0][0];
+
+  //uniform weights for lanes 0-3, 4-7 and 8-11 (lane 11 is outside of window)
+  const __m128i OnesA_U32_V = _mm_set1_epi32(1);
+  const __m128i OnesB_U32_V = _mm_setr_epi32(1, 1, 1, 0);
+
+  __m128i SumR_I64_V  = _mm_setzero_si128();
+  __m128i SumT_I64_V  = _mm_setzero_si128();
+  __m128i SumRR_I64_V = _mm_setzero_si128();
+  __m128i SumTT_I64_V = _mm_setzero_si128();
+  __m128i SumRT_I64_V = _mm_setzero_si128();
+  __m128i SumC_I32_V  = _mm_setzero_si128();
+
+  for(int32 y = 0; y < c_BlockSize; y++)
+  {
+    for(int32 x = 0; x < 12; x += 4)
+    {
+      __m128i Tst_U32_V  = _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)(Tst + x)));
+      __m128i Ref_U32_V  = _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)(Ref + x)));
+      __m128i Msk_U32_V  = _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)(Msk + x)));
+      __m128i Cff_U32_V  = Gaussian ? _mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)(Cff + x))) : (x < 8 ? OnesA_U32_V : OnesB_U32_V);
+      __m128i CffE_U32_V = _mm_andnot_si128(_mm_cmpeq_epi32(Msk_U32_V, _mm_setzero_si128()), Cff_U32_V); //zero weights of masked samples
+      __m128i CffO_U32_V = _mm_srli_epi64(CffE_U32_V, 32);
+      __m128i TT_U32_V   = _mm_mullo_epi32(Tst_U32_V, Tst_U32_V); //fits uint32 for any bit depth
+      __m128i RR_U32_V   = _mm_mullo_epi32(Ref_U32_V, Ref_U32_V);
+      __m128i RT_U32_V   = _mm_mullo_epi32(Ref_U32_V, Tst_U32_V);
+
+      SumC_I32_V  = _mm_add_epi32(SumC_I32_V , CffE_U32_V); //SumC  += C;
+      SumT_I64_V  = _mm_add_epi64(SumT_I64_V , xMulU32ToU64(Tst_U32_V, CffE_U32_V, CffO_U32_V)); //SumT  += T     * C;
+      SumR_I64_V  = _mm_add_epi64(SumR_I64_V , xMulU32ToU64(Ref_U32_V, CffE_U32_V, CffO_U32_V)); //SumR  += R     * C;
+      SumTT_I64_V = _mm_add_epi64(SumTT_I64_V, xMulU32ToU64(TT_U32_V , CffE_U32_V, CffO_U32_V)); //SumT2 += T * T * C;
+      SumRR_I64_V = _mm_add_epi64(SumRR_I64_V, xMulU32ToU64(RR_U32_V , CffE_U32_V, CffO_U32_V)); //SumR2 += R * R * C;
+      SumRT_I64_V = _mm_add_epi64(SumRT_I64_V, xMulU32ToU64(RT_U32_V , CffE_U32_V, CffO_U32_V)); //SumRT += R * T * C;
+    }
+    Ref += StrideR;
+    Tst += StrideT;
+    Msk += StrideM;
+    Cff += xStructSimConsts::c_FilterRglrGaussIntPad[0].size();
+  }
+
+  int64 SumR  = xHorVecSumI64_epi64(SumR_I64_V );
+  int64 SumT  = xHorVecSumI64_epi64(SumT_I64_V );
+  int64 SumR2 = xHorVecSumI64_epi64(SumRR_I64_V);
+  int64 SumT2 = xHorVecSumI64_epi64(SumTT_I64_V);
+  int64 SumRT = xHorVecSumI64_epi64(SumRT_I64_V);
+  int64 SumC  = xHorVecSumI32_epi32(SumC_I32_V );
+
+  //normalize by sum of non-masked weights
+  flt64 InvC  = 1.0 / (flt64)SumC;
+  flt64 AvgR  = (flt64)SumR  * InvC;
+  flt64 AvgT  = (flt64)SumT  * InvC;
+  flt64 VarR2 = (flt64)SumR2 * InvC - xPow2(AvgR);
+  flt64 VarT2 = (flt64)SumT2 * InvC - xPow2(AvgT);
+  flt64 CovRT = (flt64)SumRT * InvC - AvgR*AvgT;
+
+  if (CalcL)
+  {
+    flt64 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
+    flt64 CS   = (2 * CovRT       + C2) / (VarR2       + VarT2       + C2); //"Contrast"*"Similarity"
+    flt64 SSIM = L * CS;
+    return SSIM;
+  }
+  else
+  {
+    flt64 CS = (2 * CovRT + C2) / (VarR2 + VarT2 + C2); //"Contrast"*"Similarity"
+    return CS;
+  }
+}
+flt64 xStructSimSSE::CalcRglrFltM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL)
+{
+  constexpr int32 c_BlockSize = xStructSimConsts::c_FilterSize;
+
+  Tst -= (5 * StrideT + 5);
+  Ref -= (5 * StrideR + 5);
+  Msk -= (5 * StrideM + 5);
+
+  const flt32* Cff = &xStructSimConsts::c_FilterRglrGaussFlt32[0][0];
+
+  __m128d SumR_F64_V  = _mm_setzero_pd();
+  __m128d SumT_F64_V  = _mm_setzero_pd();
+  __m128d SumRR_F64_V = _mm_setzero_pd();
+  __m128d SumTT_F64_V = _mm_setzero_pd();
+  __m128d SumRT_F64_V = _mm_setzero_pd();
+  __m128d SumC_F64_V  = _mm_setzero_pd();
+
+  for(int32 y = 0; y < c_BlockSize; y++)
+  {
+    for(int32 x = 0; x < 12; x += 2)
+    {
+      //lane 11 is outside of window - load single coefficient
+      __m128  Cff_F32_V = x < 10 ? _mm_castpd_ps(_mm_load_sd((const flt64*)(Cff + x))) : _mm_load_ss(Cff + x);
+      __m128i Msk_I64_V = _mm_cvtepi16_epi64(_mm_cmpeq_epi16(_mm_loadu_si32(Msk + x), _mm_setzero_si128()));
+      __m128d Cff_F64_V = _mm_andnot_pd(_mm_castsi128_pd(Msk_I64_V), _mm_cvtps_pd(Cff_F32_V)); //zero weights of masked samples
+      __m128d Tst_F64_V = _mm_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_loadu_si32(Tst + x)));
+      __m128d Ref_F64_V = _mm_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_loadu_si32(Ref + x)));
+
+      SumC_F64_V  = _mm_add_pd(SumC_F64_V , Cff_F64_V); //SumC  += C;
+      SumT_F64_V  = _mm_add_pd(SumT_F64_V , _mm_mul_pd(Tst_F64_V, Cff_F64_V)); //SumT  += T*C;
+      SumR_F64_V  = _mm_add_pd(SumR_F64_V , _mm_mul_pd(Ref_F64_V, Cff_F64_V)); //SumR  += R*C;
+      SumTT_F64_V = _mm_add_pd(SumTT_F64_V, _mm_mul_pd(_mm_mul_pd(Tst_F64_V, Tst_F64_V), Cff_F64_V)); //SumT2 += T*T*C;
+      SumRR_F64_V = _mm_add_pd(SumRR_F64_V, _mm_mul_pd(_mm_mul_pd(Ref_F64_V, Ref_F64_V), Cff_F64_V)); //SumR2 += R*R*C;
+      SumRT_F64_V = _mm_add_pd(SumRT_F64_V, _mm_mul_pd(_mm_mul_pd(Tst_F64_V, Ref_F64_V), Cff_F64_V)); //SumRT += R*T*C;
+    }
+    Ref += StrideR;
+    Tst += StrideT;
+    Msk += StrideM;
+    Cff += c_BlockSize;
+  }
+
+  flt64 SumR  = xHorVecSum_pd(SumR_F64_V );
+  flt64 SumT  = xHorVecSum_pd(SumT_F64_V );
+  flt64 SumR2 = xHorVecSum_pd(SumRR_F64_V);
+  flt64 SumT2 = xHorVecSum_pd(SumTT_F64_V);
+  flt64 SumRT = xHorVecSum_pd(SumRT_F64_V);
+  flt64 SumC  = xHorVecSum_pd(SumC_F64_V );
+
+  //normalize by sum of non-masked weights
+  flt64 InvC  = 1.0 / SumC;
+  flt64 AvgR  = SumR  * InvC;
+  flt64 AvgT  = SumT  * InvC;
+  flt64 VarR2 = SumR2 * InvC - xPow2(AvgR);
+  flt64 VarT2 = SumT2 * InvC - xPow2(AvgT);
+  flt64 CovRT = SumRT * InvC - AvgR*AvgT;
+
+  if (CalcL)
+  {
+    flt64 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
+    flt64 CS   = (2 * CovRT       + C2) / (VarR2       + VarT2       + C2); //"Contrast"*"Similarity"
+    flt64 SSIM = L * CS;
+    return SSIM;
+  }
+  else
+  {
+    flt64 CS = (2 * CovRT + C2) / (VarR2 + VarT2 + C2); //"Contrast"*"Similarity"
+    return CS;
+  }
+}
+flt64 xStructSimSSE::CalcRglrIntM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL)
+{
+  return xCalcRglrM<true>(Tst, Ref, Msk, StrideT, StrideR, StrideM, C1, C2, CalcL);
+}
+flt64 xStructSimSSE::CalcRglrAvgM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL)
+{
+  return xCalcRglrM<false>(Tst, Ref, Msk, StrideT, StrideR, StrideM, C1, C2, CalcL);
+}
 //===============================================================================================================================================================================================================
 
 } //end of namespace PMBB
@@ -16,11 +16,19 @@ namespace PMBB_NAMESPACE {
 class xStructSimSSE
 {
 public:
+  //Regular Structural Similarity
+  static flt64 CalcRglrFlt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL); //uses gaussian window
+  static flt64 CalcRglrInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL); //uses gaussian window
   static flt64 CalcRglrAvg(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL)
   {
     return CalcBlckAvg11(Tst - (5 * StrideT + 5), Ref - (5 * StrideR + 5), StrideT, StrideR, C1, C2, CalcL);
   }
 
+  //Regular Structural Similarity - with mask
+  static flt64 CalcRglrFltM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL); //uses gaussian window - with mask
+  static flt64 CalcRglrIntM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL); //uses gaussian window - with mask
+  static flt64 CalcRglrAvgM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL); //uses averaging       - with mask
+
   static flt64 CalcBlckAvg(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 BlockSize, flt64 C1, flt64 C2, bool CalcL)
   {
     if     (BlockSize == 8 || BlockSize == 16 || BlockSize == 32) { return CalcBlckAvgM8(Tst, Ref, StrideT, StrideR, BlockSize, C1, C2, CalcL); }
@@ -32,6 +40,27 @@ public:
   static flt64 CalcBlckAvg4 (const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR,                  flt64 C1, flt64 C2, bool CalcL);
   static flt64 CalcBlckAvgM8(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 BlockSize, flt64 C1, flt64 C2, bool CalcL);
   static flt64 CalcBlckAvg11(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR,                  flt64 C1, flt64 C2, bool CalcL);
+
+  static flt64 CalcBlckInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 BlockSize, flt64 C1, flt64 C2, bool CalcL)
+  {
+    if     (BlockSize == 8 ) { return CalcBlckInt8 (Tst, Ref, StrideT, StrideR, C1, C2, CalcL); }
+    else if(BlockSize == 16) { return CalcBlckInt16(Tst, Ref, StrideT, StrideR, C1, C2, CalcL); }
+    else                     { return xStructSimSTD::CalcBlckInt(Tst, Ref, StrideT, StrideR, BlockSize, C1, C2, CalcL); }
+  }
+
+  static flt64 CalcBlckInt8 (const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, flt64 C1, flt64 C2, bool CalcL);
+  static flt64 CalcBlckInt16(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, flt64 C1, flt64 C2, bool CalcL);
+
+  //Multi-Block Structural Similarity - c_MultiBlckBatchSize blocks spaced by WndStride (nullptr for unsupported combinations)
+  static constexpr int32 c_MultiBlckBatchSize = 4;
+  using tCalcPtrMultiBlckAvg = void(flt64* restrict SSIMs, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, flt64 C1, flt64 C2, bool CalcL);
+  static tCalcPtrMultiBlckAvg* getCalcPtrMultiBlckAvg(int32 WndSize, int32 WndStride);
+  template<int32 WndSize, int32 WndStride> static void CalcMultiBlckAvg(flt64* restrict SSIMs, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, flt64 C1, flt64 C2, bool CalcL);
+
+protected:
+  template<bool Gaussian> static flt64 xCalcRglrM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, flt64 C1, flt64 C2, bool CalcL); //integer moments, gaussian (Int) or uniform (Avg) weights
+  template<int32 BlockSize> static flt64 xCalcBlckInt(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, const int16* Cff, flt64 C1, flt64 C2, bool CalcL);
+  static inline __m128i xMulU32ToU64(const __m128i& A_U32_V, const __m128i& CffE_U32_V, const __m128i& CffO_U32_V); //4 x uint32 * weights --> 2 x uint64 sums of even/odd products
 };
 
 //===============================================================================================================================================================================================================
@@ -195,22 +195,21 @@ flt64 xStructSimSTD::CalcRglrAvg(const uint16* Tst, const uint16* Ref, int32 Str
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Regular (11x11) structural similarity - with mask
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-#if X_PMBB_BROKEN
 flt64 xStructSimSTD::CalcRglrFltM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL)
 {
   assert(*Msk != 0);
   constexpr int32 FilterRange = xStructSimConsts::c_FilterRange;
 
-  flt64 SumR = 0, SumT = 0, SumR2 = 0, SumT2 = 0, SumRT = 0, SumC = 0.0;
+  flt64 SumR = 0, SumT = 0, SumR2 = 0, SumT2 = 0, SumRT = 0, SumC = 0;
   
   for(int32 dy = -FilterRange; dy <= FilterRange; dy++)
   {
     for(int32 dx = -FilterRange; dx <= FilterRange; dx++)
     {
       if(Msk[dy * StrideM + dx] == 0) { continue; }
-      flt64  R = Ref[dy * StrideR + dx];
-      flt64  T = Tst[dy * StrideT + dx];
-      flt64  C = xStructSimConsts::c_FilterRglrGaussFlt32[dy + FilterRange][dx + FilterRange];
+      flt64 R = Ref[dy * StrideR + dx];
+      flt64 T = Tst[dy * StrideT + dx];
+      flt64 C = xStructSimConsts::c_FilterRglrGaussFlt32[dy + FilterRange][dx + FilterRange];
       SumR  += R        * C;
       SumT  += T        * C;
       SumR2 += xPow2(R) * C;
@@ -220,6 +219,7 @@ flt64 xStructSimSTD::CalcRglrFltM(const uint16* Tst, const uint16* Ref, const ui
     }
   }
 
+  //normalize by sum of non-masked weights
   flt64 InvC  = 1.0 / SumC;
   flt64 AvgR  = SumR  * InvC;
   flt64 AvgT  = SumT  * InvC;
@@ -242,6 +242,7 @@ flt64 xStructSimSTD::CalcRglrFltM(const uint16* Tst, const uint16* Ref, const ui
 }
 flt64 xStructSimSTD::CalcRglrIntM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL)
 {
+  assert(*Msk != 0);
   constexpr int32 FilterRange = xStructSimConsts::c_FilterRange;
 
   int64 SumR = 0, SumT = 0, SumR2 = 0, SumT2 = 0, SumRT = 0, SumC = 0;
@@ -263,15 +264,13 @@ flt64 xStructSimSTD::CalcRglrIntM(const uint16* Tst, const uint16* Ref, const ui
     }
   }  
 
-  assert(0);
-
-  flt64 InvC  = (flt64)1.0 / ((flt64)xStructSimConsts::c_FltrIntMul );
- 
-  flt64 AvgR  = ((flt64)SumR  * xStructSimConsts::c_InvFltrIntMul);
-  flt64 AvgT  = ((flt64)SumT  * xStructSimConsts::c_InvFltrIntMul);
-  flt64 VarR2 = ((flt64)SumR2 * xStructSimConsts::c_InvFltrIntMul) - xPow2(AvgR);
-  flt64 VarT2 = ((flt64)SumT2 * xStructSimConsts::c_InvFltrIntMul) - xPow2(AvgT);
-  flt64 CovRT = ((flt64)SumRT * xStructSimConsts::c_InvFltrIntMul) - AvgR*AvgT;
+  //normalize by sum of non-masked weights (equals c_FltrIntMul if nothing is masked)
+  flt64 InvC  = 1.0 / (flt64)SumC;
+  flt64 AvgR  = (flt64)SumR  * InvC;
+  flt64 AvgT  = (flt64)SumT  * InvC;
+  flt64 VarR2 = (flt64)SumR2 * InvC - xPow2(AvgR);
+  flt64 VarT2 = (flt64)SumT2 * InvC - xPow2(AvgT);
+  flt64 CovRT = (flt64)SumRT * InvC - AvgR*AvgT;
 
   if (CalcL)
   {
@@ -288,6 +287,7 @@ flt64 xStructSimSTD::CalcRglrIntM(const uint16* Tst, const uint16* Ref, const ui
 }
 flt64 xStructSimSTD::CalcRglrAvgM(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 /*WndSize*/, flt64 C1, flt64 C2, bool CalcL)
 {
+  assert(*Msk != 0);
   constexpr int32 FilterRange = xStructSimConsts::c_FilterRange;
 
   int64 SumR = 0, SumT = 0, SumR2 = 0, SumT2 = 0, SumRT = 0;
@@ -298,8 +298,8 @@ flt64 xStructSimSTD::CalcRglrAvgM(const uint16* Tst, const uint16* Ref, const ui
     for(int32 dx = -FilterRange; dx <= FilterRange; dx++)
     {
       if(Msk[dy * StrideM + dx] == 0) { continue; }
-      int32 R = Ref[dy * StrideR + dx];
-      int32 T = Tst[dy * StrideT + dx];
+      int64 R = Ref[dy * StrideR + dx];
+      int64 T = Tst[dy * StrideT + dx];
       SumR  += R;
       SumT  += T;
       SumR2 += xPow2(R);
@@ -309,13 +309,14 @@ flt64 xStructSimSTD::CalcRglrAvgM(const uint16* Tst, const uint16* Ref, const ui
     }
   }
 
+  //normalize by number of non-masked samples
   flt64 InvN  = 1.0 / (flt64)Num;
   flt64 AvgR  = (flt64)SumR  * InvN;
   flt64 AvgT  = (flt64)SumT  * InvN;
   flt64 VarR2 = (flt64)SumR2 * InvN - xPow2(AvgR);
   flt64 VarT2 = (flt64)SumT2 * InvN - xPow2(AvgT);
   flt64 CovRT = (flt64)SumRT * InvN - AvgR*AvgT;
-  
+
   if (CalcL)
   {
     flt64 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
@@ -329,23 +330,6 @@ flt64 xStructSimSTD::CalcRglrAvgM(const uint16* Tst, const uint16* Ref, const ui
     return CS;
   }
 }
-#else //X_PMBB_BROKEN
-flt64 xStructSimSTD::CalcRglrFltM(const uint16*, const uint16*, const uint16*, int32, int32, int32, int32, flt64, flt64, bool)
-{
-  assert(0);
-  return std::numeric_limits<flt64>::signaling_NaN();
-}
-flt64 xStructSimSTD::CalcRglrIntM(const uint16*, const uint16*, const uint16*, int32, int32, int32, int32, flt64, flt64, bool)
-{
-  assert(0);
-  return std::numeric_limits<flt64>::signaling_NaN();
-}
-flt64 xStructSimSTD::CalcRglrAvgM(const uint16*, const uint16*, const uint16*, int32, int32, int32, int32, flt64, flt64, bool)
-{
-  assert(0);
-  return std::numeric_limits<flt64>::signaling_NaN();
-}
-#endif //X_PMBB_BROKEN
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Block based (8x8, 16x16) structural similarity
@@ -360,8 +344,8 @@ flt64 xStructSimSTD::CalcBlckInt(const uint16* Tst, const uint16* Ref, int32 Str
     {
       for(int32 x = 0; x < WndSize; x++)
       {
-        int32 R = Ref[x];
-        int32 T = Tst[x];
+        int64 R = Ref[x];
+        int64 T = Tst[x];
         int64 C = xStructSimConsts::c_FilterBlckGaussInt8[y][x];
         SumR  += R     * C;
         SumT  += T     * C;
@@ -379,8 +363,8 @@ flt64 xStructSimSTD::CalcBlckInt(const uint16* Tst, const uint16* Ref, int32 Str
     {
       for(int32 x = 0; x < WndSize; x++)
       {
-        int32 R = Ref[x];
-        int32 T = Tst[x];
+        int64 R = Ref[x];
+        int64 T = Tst[x];
         int64 C = xStructSimConsts::c_FilterBlckGaussInt16[y][x];
         SumR  += R     * C;
         SumT  += T     * C;
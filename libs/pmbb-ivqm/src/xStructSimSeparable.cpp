@@ -0,0 +1,303 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "xStructSimSeparable.h"
+#include "xKBNS.h"
+#include <vector>
+#include <algorithm>
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Separable gaussian window - vertical 11-tap pass over extended row, horizontal 11-tap pass, per-pixel SSIM
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void xStructSimSeparable::CalcRngGauss(flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 BegX, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL)
+{
+  const int32 Width  = EndX - BegX;
+  const int32 WidthV = Width + 2 * c_FilterRange; //vertically filtered row has to cover horizontal window
+
+  //vertical (V*) and horizontal (H*) moments of single row
+  std::vector<flt64> Buffer(5 * WidthV + 5 * Width);
+  flt64* restrict VT  = Buffer.data();
+  flt64* restrict VR  = VT  + WidthV;
+  flt64* restrict VTT = VR  + WidthV;
+  flt64* restrict VRR = VTT + WidthV;
+  flt64* restrict VRT = VRR + WidthV;
+  flt64* restrict HT  = VRT + WidthV;
+  flt64* restrict HR  = HT  + Width;
+  flt64* restrict HTT = HR  + Width;
+  flt64* restrict HRR = HTT + Width;
+  flt64* restrict HRT = HRR + Width;
+
+  for(int32 y = BegY; y < EndY; y++)
+  {
+    //vertical pass
+    std::fill(Buffer.begin(), Buffer.end(), 0.0);
+    for(int32 k = 0; k < c_FilterSize; k++)
+    {
+      const flt64   C      = c_FilterSprbGaussFlt64[k];
+      const uint16* TstRow = Tst + (y - c_FilterRange + k) * StrideT + BegX - c_FilterRange;
+      const uint16* RefRow = Ref + (y - c_FilterRange + k) * StrideR + BegX - c_FilterRange;
+      for(int32 x = 0; x < WidthV; x++)
+      {
+        const flt64 T = TstRow[x];
+        const flt64 R = RefRow[x];
+        VT [x] += T        * C;
+        VR [x] += R        * C;
+        VTT[x] += xPow2(T) * C;
+        VRR[x] += xPow2(R) * C;
+        VRT[x] += R*T      * C;
+      }
+    }
+
+    //horizontal pass
+    for(int32 k = 0; k < c_FilterSize; k++)
+    {
+      const flt64 C = c_FilterSprbGaussFlt64[k];
+      for(int32 x = 0; x < Width; x++)
+      {
+        HT [x] += VT [x + k] * C;
+        HR [x] += VR [x + k] * C;
+        HTT[x] += VTT[x + k] * C;
+        HRR[x] += VRR[x + k] * C;
+        HRT[x] += VRT[x + k] * C;
+      }
+    }
+
+    //SSIM
+    xKBNS1 RowAccSSIM;
+    for(int32 x = 0; x < Width; x++)
+    {
+      flt64 AvgR  = HR [x];
+      flt64 AvgT  = HT [x];
+      flt64 VarR2 = HRR[x] - xPow2(AvgR);
+      flt64 VarT2 = HTT[x] - xPow2(AvgT);
+      flt64 CovRT = HRT[x] - AvgR*AvgT;
+      RowAccSSIM += xCalcSSIM(AvgR, AvgT, VarR2, VarT2, CovRT, C1, C2, CalcL);
+    }
+    RowSums[y] = RowAccSSIM.result();
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Averaging window - column sums slide down by one row, window sums slide right by one column
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void xStructSimSeparable::CalcRngAvg(flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 BegX, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL)
+{
+  const int32 Width  = EndX - BegX;
+  const int32 WidthV = Width + 2 * c_FilterRange; //column sums have to cover horizontal window
+
+  //column sums (exact integer arithmetic)
+  std::vector<int64> Buffer(5 * WidthV, 0);
+  int64* restrict VT  = Buffer.data();
+  int64* restrict VR  = VT  + WidthV;
+  int64* restrict VTT = VR  + WidthV;
+  int64* restrict VRR = VTT + WidthV;
+  int64* restrict VRT = VRR + WidthV;
+
+  auto AccRow = [&](int32 y, int64 Sign)
+  {
+    const uint16* TstRow = Tst + y * StrideT + BegX - c_FilterRange;
+    const uint16* RefRow = Ref + y * StrideR + BegX - c_FilterRange;
+    for(int32 x = 0; x < WidthV; x++)
+    {
+      const uint32 T = TstRow[x];
+      const uint32 R = RefRow[x];
+      VT [x] += Sign * (int64)(T    );
+      VR [x] += Sign * (int64)(R    );
+      VTT[x] += Sign * (int64)(T * T);
+      VRR[x] += Sign * (int64)(R * R);
+      VRT[x] += Sign * (int64)(R * T);
+    }
+  };
+
+  for(int32 dy = -c_FilterRange; dy <= c_FilterRange; dy++) { AccRow(BegY + dy, 1); }
+
+  for(int32 y = BegY; y < EndY; y++)
+  {
+    if(y != BegY) { AccRow(y + c_FilterRange, 1); AccRow(y - c_FilterRange - 1, -1); }
+
+    int64 SumT = 0, SumR = 0, SumT2 = 0, SumR2 = 0, SumRT = 0;
+    for(int32 k = 0; k < c_FilterSize - 1; k++) { SumT += VT[k]; SumR += VR[k]; SumT2 += VTT[k]; SumR2 += VRR[k]; SumRT += VRT[k]; }
+
+    xKBNS1 RowAccSSIM;
+    for(int32 x = 0; x < Width; x++)
+    {
+      const int32 xA = x + c_FilterSize - 1; //entering column
+      SumT += VT[xA]; SumR += VR[xA]; SumT2 += VTT[xA]; SumR2 += VRR[xA]; SumRT += VRT[xA];
+
+      flt64 AvgR  = (flt64)SumR  * c_InvFltrArea;
+      flt64 AvgT  = (flt64)SumT  * c_InvFltrArea;
+      flt64 VarR2 = (flt64)SumR2 * c_InvFltrArea - xPow2(AvgR);
+      flt64 VarT2 = (flt64)SumT2 * c_InvFltrArea - xPow2(AvgT);
+      flt64 CovRT = (flt64)SumRT * c_InvFltrArea - AvgR*AvgT;
+      RowAccSSIM += xCalcSSIM(AvgR, AvgT, VarR2, VarT2, CovRT, C1, C2, CalcL);
+
+      SumT -= VT[x]; SumR -= VR[x]; SumT2 -= VTT[x]; SumR2 -= VRR[x]; SumRT -= VRT[x]; //leaving column
+    }
+    RowSums[y] = RowAccSSIM.result();
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Moment-plane cache support - single picture window sums and cross term, same per-moment arithmetic as CalcRngGauss
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template<xStructSimSeparable::eMoment Moment> void xStructSimSeparable::xFltrRowGauss(flt64* restrict Dst, flt64* restrict Tmp, const uint16* A, const uint16* B, int32 StrideA, int32 StrideB, int32 BegX, int32 Width, int32 y)
+{
+  const int32 WidthV = Width + 2 * c_FilterRange;
+
+  //vertical pass
+  std::fill_n(Tmp, WidthV, 0.0);
+  for(int32 k = 0; k < c_FilterSize; k++)
+  {
+    const flt64   C    = c_FilterSprbGaussFlt64[k];
+    const uint16* RowA = A + (y - c_FilterRange + k) * StrideA + BegX - c_FilterRange;
+    const uint16* RowB = B + (y - c_FilterRange + k) * StrideB + BegX - c_FilterRange;
+    for(int32 x = 0; x < WidthV; x++)
+    {
+      const flt64 VA = RowA[x];
+      if     constexpr(Moment == eMoment::A ) { Tmp[x] += VA        * C; }
+      else if constexpr(Moment == eMoment::AA) { Tmp[x] += xPow2(VA) * C; }
+      else                                     { const flt64 VB = RowB[x]; Tmp[x] += VB*VA * C; }
+    }
+  }
+
+  //horizontal pass
+  std::fill_n(Dst, Width, 0.0);
+  for(int32 k = 0; k < c_FilterSize; k++)
+  {
+    const flt64 C = c_FilterSprbGaussFlt64[k];
+    for(int32 x = 0; x < Width; x++) { Dst[x] += Tmp[x + k] * C; }
+  }
+}
+void xStructSimSeparable::CalcStatsGauss(flt64* Sum, flt64* SumSq, int32 StrideS, const uint16* Pic, int32 StrideP, int32 BegX, int32 EndX, int32 BegY, int32 EndY)
+{
+  const int32 Width = EndX - BegX;
+  std::vector<flt64> Tmp(Width + 2 * c_FilterRange);
+
+  for(int32 y = BegY; y < EndY; y++)
+  {
+    xFltrRowGauss<eMoment::A >(Sum   + y * StrideS + BegX, Tmp.data(), Pic, Pic, StrideP, StrideP, BegX, Width, y);
+    xFltrRowGauss<eMoment::AA>(SumSq + y * StrideS + BegX, Tmp.data(), Pic, Pic, StrideP, StrideP, BegX, Width, y);
+  }
+}
+void xStructSimSeparable::CalcRngGaussX(flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, const flt64* SumT, const flt64* SumSqT, const flt64* SumR, const flt64* SumSqR, int32 StrideS, int32 BegX, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL)
+{
+  const int32 Width = EndX - BegX;
+  std::vector<flt64> Buffer(2 * Width + 2 * c_FilterRange);
+  flt64* HRT = Buffer.data();
+  flt64* Tmp = HRT + Width;
+
+  for(int32 y = BegY; y < EndY; y++)
+  {
+    xFltrRowGauss<eMoment::AB>(HRT, Tmp, Tst, Ref, StrideT, StrideR, BegX, Width, y);
+
+    const int32 Offset = y * StrideS + BegX;
+    xKBNS1 RowAccSSIM;
+    for(int32 x = 0; x < Width; x++)
+    {
+      flt64 AvgR  = SumR  [Offset + x];
+      flt64 AvgT  = SumT  [Offset + x];
+      flt64 VarR2 = SumSqR[Offset + x] - xPow2(AvgR);
+      flt64 VarT2 = SumSqT[Offset + x] - xPow2(AvgT);
+      flt64 CovRT = HRT[x] - AvgR*AvgT;
+      RowAccSSIM += xCalcSSIM(AvgR, AvgT, VarR2, VarT2, CovRT, C1, C2, CalcL);
+    }
+    RowSums[y] = RowAccSSIM.result();
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Single precision engine
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void xStructSimSeparable::CalcRngGaussF32(flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 BegX, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL)
+{
+  const int32 Width  = EndX - BegX;
+  const int32 WidthV = Width + 2 * c_FilterRange; //vertically filtered row has to cover horizontal window
+  const flt32 C1F    = (flt32)C1;
+  const flt32 C2F    = (flt32)C2;
+
+  //vertical (V*) and horizontal (H*) moments of single row, per-pixel SSIM (S)
+  std::vector<flt32> Buffer(5 * WidthV + 6 * Width);
+  flt32* restrict VT  = Buffer.data();
+  flt32* restrict VR  = VT  + WidthV;
+  flt32* restrict VTT = VR  + WidthV;
+  flt32* restrict VRR = VTT + WidthV;
+  flt32* restrict VRT = VRR + WidthV;
+  flt32* restrict HT  = VRT + WidthV;
+  flt32* restrict HR  = HT  + Width;
+  flt32* restrict HTT = HR  + Width;
+  flt32* restrict HRR = HTT + Width;
+  flt32* restrict HRT = HRR + Width;
+  flt32* restrict S   = HRT + Width;
+
+  for(int32 y = BegY; y < EndY; y++)
+  {
+    //samples are centered - keeps second order moments small (variance is a difference of two of them)
+    const int32 OffT = xCalcRowMean(Tst + y * StrideT + BegX - c_FilterRange, WidthV);
+    const int32 OffR = xCalcRowMean(Ref + y * StrideR + BegX - c_FilterRange, WidthV);
+
+    //vertical pass
+    std::fill(Buffer.begin(), Buffer.end(), 0.0f);
+    for(int32 k = 0; k < c_FilterSize; k++)
+    {
+      const flt32   C      = c_FilterSprbGaussFlt32[k];
+      const uint16* TstRow = Tst + (y - c_FilterRange + k) * StrideT + BegX - c_FilterRange;
+      const uint16* RefRow = Ref + (y - c_FilterRange + k) * StrideR + BegX - c_FilterRange;
+      for(int32 x = 0; x < WidthV; x++)
+      {
+        const flt32 T = (flt32)((int32)TstRow[x] - OffT);
+        const flt32 R = (flt32)((int32)RefRow[x] - OffR);
+        VT [x] += T        * C;
+        VR [x] += R        * C;
+        VTT[x] += xPow2(T) * C;
+        VRR[x] += xPow2(R) * C;
+        VRT[x] += R*T      * C;
+      }
+    }
+
+    //horizontal pass
+    for(int32 k = 0; k < c_FilterSize; k++)
+    {
+      const flt32 C = c_FilterSprbGaussFlt32[k];
+      for(int32 x = 0; x < Width; x++)
+      {
+        HT [x] += VT [x + k] * C;
+        HR [x] += VR [x + k] * C;
+        HTT[x] += VTT[x + k] * C;
+        HRR[x] += VRR[x + k] * C;
+        HRT[x] += VRT[x + k] * C;
+      }
+    }
+
+    //SSIM
+    for(int32 x = 0; x < Width; x++)
+    {
+      flt32 VarR2 = HRR[x] - xPow2(HR[x]);
+      flt32 VarT2 = HTT[x] - xPow2(HT[x]);
+      flt32 CovRT = HRT[x] - HR[x]*HT[x];
+      S[x] = xCalcSSIM(HR[x] + (flt32)OffR, HT[x] + (flt32)OffT, VarR2, VarT2, CovRT, C1F, C2F, CalcL);
+    }
+    RowSums[y] = xAccumulateRow(S, Width);
+  }
+}
+int32 xStructSimSeparable::xCalcRowMean(const uint16* Row, int32 Width)
+{
+  int64 Sum = 0;
+  for(int32 x = 0; x < Width; x++) { Sum += Row[x]; }
+  return (int32)(Sum / Width);
+}
+flt64 xStructSimSeparable::xAccumulateRow(const flt32* SSIMs, int32 Width)
+{
+  xKBNS1 RowAccSSIM;
+  for(int32 x = 0; x < Width; x++) { RowAccSSIM += (flt64)SSIMs[x]; }
+  return RowAccSSIM.result();
+}
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
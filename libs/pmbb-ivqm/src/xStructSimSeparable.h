@@ -0,0 +1,80 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#pragma once
+#include "xCommonDefIVQM.h"
+#include "xStructSimConsts.h"
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+
+class xStructSimSeparable : public xStructSimConsts //Regular (11x11, stride 1) Structural Similarity evaluated from moment rows
+{
+public:
+  static constexpr int32 c_NumRowsInBand = 32; //rows per band - amortizes setup of vertical window
+
+  using tCalcRngPtr = void (flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 BegX, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL);
+
+  //Calculates SSIM for every pixel in rows [BegY, EndY) and columns [BegX, EndX), stores per-row sums in RowSums[y].
+  //Tst and Ref point to component origin, c_FilterRange samples around processed area have to be accessible.
+  static void CalcRngGauss(flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 BegX, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL); //separable gaussian window (flt64)
+  static void CalcRngAvg  (flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 BegX, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL); //running box sums (integer)
+
+  //Moment-plane cache support - single picture window sums (Sum, SumSq) at [y * StrideS + x] are evaluated once per picture, only cross term is evaluated per picture pair.
+  //Results are bit-exact with CalcRngGauss (per-moment arithmetic is identical). Not provided for running box sums - reading cached planes costs more than recomputing them.
+  using tCalcStatsPtr = void (flt64* Sum, flt64* SumSq, int32 StrideS, const uint16* Pic, int32 StrideP, int32 BegX, int32 EndX, int32 BegY, int32 EndY);
+  using tCalcRngXPtr  = void (flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, const flt64* SumT, const flt64* SumSqT, const flt64* SumR, const flt64* SumSqR, int32 StrideS, int32 BegX, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL);
+
+  static void CalcStatsGauss(flt64* Sum, flt64* SumSq, int32 StrideS, const uint16* Pic, int32 StrideP, int32 BegX, int32 EndX, int32 BegY, int32 EndY);
+  static void CalcRngGaussX(flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, const flt64* SumT, const flt64* SumSqT, const flt64* SumR, const flt64* SumSqR, int32 StrideS, int32 BegX, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL);
+
+  //Single precision engine (opt-in) - window statistics and SSIM expression in flt32, per-row pooling in flt64 (compensated).
+  //Moments are evaluated on samples centered around central row mean (keeps variance terms away from cancellation). Not provided for running box sums - integer sums are not faster in flt32.
+  //Pooled picture SSIM differs from CalcRngGauss by less than c_TolFlt32 (absolute).
+  static constexpr flt64 c_TolFlt32 = 0.00001;
+  static void CalcRngGaussF32(flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 BegX, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL);
+
+protected:
+  enum class eMoment { A, AA, AB }; //A, A*A, A*B
+  template<eMoment Moment> static void xFltrRowGauss(flt64* restrict Dst, flt64* restrict Tmp, const uint16* A, const uint16* B, int32 StrideA, int32 StrideB, int32 BegX, int32 Width, int32 y);
+
+  static inline flt64 xCalcSSIM(flt64 AvgR, flt64 AvgT, flt64 VarR2, flt64 VarT2, flt64 CovRT, flt64 C1, flt64 C2, bool CalcL)
+  {
+    if(CalcL)
+    {
+      flt64 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
+      flt64 CS   = (2 * CovRT       + C2) / (VarR2       + VarT2       + C2); //"Contrast"*"Similarity"
+      flt64 SSIM = L * CS;
+      return SSIM;
+    }
+    else
+    {
+      flt64 CS = (2 * CovRT + C2) / (VarR2 + VarT2 + C2); //"Contrast"*"Similarity"
+      return CS;
+    }
+  }
+  static inline flt32 xCalcSSIM(flt32 AvgR, flt32 AvgT, flt32 VarR2, flt32 VarT2, flt32 CovRT, flt32 C1, flt32 C2, bool CalcL)
+  {
+    if(CalcL)
+    {
+      flt32 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
+      flt32 CS   = (2 * CovRT       + C2) / (VarR2       + VarT2       + C2); //"Contrast"*"Similarity"
+      flt32 SSIM = L * CS;
+      return SSIM;
+    }
+    else
+    {
+      flt32 CS = (2 * CovRT + C2) / (VarR2 + VarT2 + C2); //"Contrast"*"Similarity"
+      return CS;
+    }
+  }
+  static int32 xCalcRowMean(const uint16* Row, int32 Width);
+  static flt64 xAccumulateRow(const flt32* SSIMs, int32 Width);
+};
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
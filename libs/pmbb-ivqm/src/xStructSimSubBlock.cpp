@@ -0,0 +1,235 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "xStructSimSubBlock.h"
+#include "xKBNS.h"
+#include <vector>
+#include <algorithm>
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Sub-block sums - one pass over samples, horizontal window sums kept in ring of WndSize/WndStride sub-block rows
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template<int32 NumMoments, class tLoadRow, class tProcRow> void xStructSimSubBlock::xCalcRngSums(int32 WndSize, int32 WndStride, int32 EndX, int32 BegY, int32 EndY, tLoadRow LoadRow, tProcRow ProcRow)
+{
+  assert(isSupported(WndSize, WndStride));
+
+  const int32 NumSubInWnd   = WndSize / WndStride;
+  const int32 NumBlkX       = (EndX - 1) / WndStride + 1;
+  const int32 NumBlkY       = (EndY - BegY - 1) / WndStride + 1;
+  const int32 NumSubX       = NumBlkX + NumSubInWnd - 1;
+  const int32 NumSubY       = NumBlkY + NumSubInWnd - 1;
+  const int32 NumSubInChunk = xMax(c_ChunkWidth / WndStride, 1);
+  const int32 ChunkWidth    = NumSubInChunk * WndStride;
+
+  //per moment: column sums of chunk (C), sub-block sums (S), ring of horizontal window sums (H), window sums of block row (B)
+  const int32 NumPerMoment = ChunkWidth + NumSubX + NumSubInWnd * NumBlkX + NumBlkX;
+  std::vector<int64> Buffer(NumMoments * NumPerMoment);
+  int64* C[NumMoments]; int64* S[NumMoments]; int64* H[NumMoments]; int64* B[NumMoments];
+  for(int32 m = 0; m < NumMoments; m++)
+  {
+    C[m] = Buffer.data() + m * NumPerMoment;
+    S[m] = C[m] + ChunkWidth;
+    H[m] = S[m] + NumSubX;
+    B[m] = H[m] + NumSubInWnd * NumBlkX;
+  }
+
+  for(int32 r = 0; r < NumSubY; r++)
+  {
+    //sub-block sums - column sums of sub-block row are evaluated in L1 sized chunks
+    for(int32 s0 = 0; s0 < NumSubX; s0 += NumSubInChunk)
+    {
+      const int32 NumSubCur = xMin(NumSubInChunk, NumSubX - s0);
+      const int32 NumColCur = NumSubCur * WndStride;
+      for(int32 m = 0; m < NumMoments; m++) { std::fill_n(C[m], ChunkWidth, (int64)0); }
+      for(int32 y = 0; y < WndStride; y++) { LoadRow(C, BegY + r * WndStride + y, s0 * WndStride, NumColCur); }
+      for(int32 m = 0; m < NumMoments; m++)
+      {
+        const int64* restrict Cm = C[m];
+        int64*       restrict Sm = S[m] + s0;
+        for(int32 s = 0; s < NumSubCur; s++)
+        {
+          int64 Sum = 0;
+          for(int32 x = s * WndStride; x < (s + 1) * WndStride; x++) { Sum += Cm[x]; }
+          Sm[s] = Sum;
+        }
+      }
+    }
+
+    //horizontal window sums - stored in ring slot
+    const int32 Slot = (r % NumSubInWnd) * NumBlkX;
+    for(int32 m = 0; m < NumMoments; m++)
+    {
+      const int64* restrict Sm = S[m];
+      int64*       restrict Hm = H[m] + Slot;
+      int64 Sum = 0;
+      for(int32 s = 0; s < NumSubInWnd - 1; s++) { Sum += Sm[s]; }
+      for(int32 b = 0; b < NumBlkX; b++)
+      {
+        Sum  += Sm[b + NumSubInWnd - 1]; //entering sub-block
+        Hm[b] = Sum;
+        Sum  -= Sm[b]; //leaving sub-block
+      }
+    }
+
+    if(r < NumSubInWnd - 1) { continue; } //vertical window not complete yet
+
+    //vertical window sums
+    for(int32 m = 0; m < NumMoments; m++)
+    {
+      const int64* restrict Hm = H[m];
+      int64*       restrict Bm = B[m];
+      std::copy_n(Hm, NumBlkX, Bm);
+      for(int32 k = 1; k < NumSubInWnd; k++) { for(int32 b = 0; b < NumBlkX; b++) { Bm[b] += Hm[k * NumBlkX + b]; } }
+    }
+    ProcRow(BegY + (r - NumSubInWnd + 1) * WndStride, B, NumBlkX);
+  }
+}
+void xStructSimSubBlock::CalcRngAvg(flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, int32 WndStride, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL)
+{
+  const flt64 c_InvBlockArea = (flt64)1.0 / (flt64)(WndSize * WndSize);
+
+  auto LoadRow = [&](int64* const* Col, int32 y, int32 x0, int32 NumCols)
+  {
+    const uint16* TstRow = Tst + y * StrideT + x0;
+    const uint16* RefRow = Ref + y * StrideR + x0;
+    int64* restrict CT  = Col[0];
+    int64* restrict CR  = Col[1];
+    int64* restrict CTT = Col[2];
+    int64* restrict CRR = Col[3];
+    int64* restrict CRT = Col[4];
+    for(int32 x = 0; x < NumCols; x++)
+    {
+      const uint32 T = TstRow[x];
+      const uint32 R = RefRow[x];
+      CT [x] += (int64)(T    );
+      CR [x] += (int64)(R    );
+      CTT[x] += (int64)(T * T);
+      CRR[x] += (int64)(R * R);
+      CRT[x] += (int64)(R * T);
+    }
+  };
+  auto ProcRow = [&](int32 y, int64* const* Blk, int32 NumBlkX)
+  {
+    xKBNS1 RowAccSSIM;
+    for(int32 b = 0; b < NumBlkX; b++)
+    {
+      RowAccSSIM += xCalcSSIM((flt64)Blk[0][b], (flt64)Blk[1][b], (flt64)Blk[2][b], (flt64)Blk[3][b], (flt64)Blk[4][b], c_InvBlockArea, C1, C2, CalcL);
+    }
+    RowSums[y] = RowAccSSIM.result();
+  };
+
+  xCalcRngSums<5>(WndSize, WndStride, EndX, BegY, EndY, LoadRow, ProcRow);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Moment-plane cache support - single picture block sums and cross term
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void xStructSimSubBlock::CalcStatsAvg(flt64* Sum, flt64* SumSq, int32 StrideS, const uint16* Pic, int32 StrideP, int32 WndSize, int32 WndStride, int32 EndX, int32 BegY, int32 EndY)
+{
+  auto LoadRow = [&](int64* const* Col, int32 y, int32 x0, int32 NumCols)
+  {
+    const uint16* PicRow = Pic + y * StrideP + x0;
+    int64* restrict CA  = Col[0];
+    int64* restrict CAA = Col[1];
+    for(int32 x = 0; x < NumCols; x++)
+    {
+      const uint32 A = PicRow[x];
+      CA [x] += (int64)(A    );
+      CAA[x] += (int64)(A * A);
+    }
+  };
+  auto ProcRow = [&](int32 y, int64* const* Blk, int32 NumBlkX)
+  {
+    flt64* restrict SumRow   = Sum   + (y / WndStride) * StrideS;
+    flt64* restrict SumSqRow = SumSq + (y / WndStride) * StrideS;
+    for(int32 b = 0; b < NumBlkX; b++) { SumRow[b] = (flt64)Blk[0][b]; SumSqRow[b] = (flt64)Blk[1][b]; }
+  };
+
+  xCalcRngSums<2>(WndSize, WndStride, EndX, BegY, EndY, LoadRow, ProcRow);
+}
+void xStructSimSubBlock::CalcRngAvgX(flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, const flt64* SumT, const flt64* SumSqT, const flt64* SumR, const flt64* SumSqR, int32 StrideS, int32 WndSize, int32 WndStride, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL)
+{
+  const flt64 c_InvBlockArea = (flt64)1.0 / (flt64)(WndSize * WndSize);
+
+  auto LoadRow = [&](int64* const* Col, int32 y, int32 x0, int32 NumCols)
+  {
+    const uint16* TstRow = Tst + y * StrideT + x0;
+    const uint16* RefRow = Ref + y * StrideR + x0;
+    int64* restrict CRT = Col[0];
+    for(int32 x = 0; x < NumCols; x++)
+    {
+      const uint32 T = TstRow[x];
+      const uint32 R = RefRow[x];
+      CRT[x] += (int64)(R * T);
+    }
+  };
+  auto ProcRow = [&](int32 y, int64* const* Blk, int32 NumBlkX)
+  {
+    const int32 Offset = (y / WndStride) * StrideS;
+    xKBNS1 RowAccSSIM;
+    for(int32 b = 0; b < NumBlkX; b++)
+    {
+      RowAccSSIM += xCalcSSIM(SumT[Offset + b], SumR[Offset + b], SumSqT[Offset + b], SumSqR[Offset + b], (flt64)Blk[0][b], c_InvBlockArea, C1, C2, CalcL);
+    }
+    RowSums[y] = RowAccSSIM.result();
+  };
+
+  xCalcRngSums<1>(WndSize, WndStride, EndX, BegY, EndY, LoadRow, ProcRow);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Single precision engine
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void xStructSimSubBlock::CalcRngAvgF32(flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, int32 WndStride, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL)
+{
+  const int64 c_BlockArea     = (int64)WndSize * (int64)WndSize;
+  const flt32 c_InvBlockArea  = (flt32)(1.0 / (flt64)c_BlockArea);
+  const flt32 c_InvBlockArea2 = (flt32)(1.0 / ((flt64)c_BlockArea * (flt64)c_BlockArea));
+  const flt32 C1F             = (flt32)C1;
+  const flt32 C2F             = (flt32)C2;
+  std::vector<flt32> SSIMs((EndX - 1) / WndStride + 1);
+
+  auto LoadRow = [&](int64* const* Col, int32 y, int32 x0, int32 NumCols)
+  {
+    const uint16* TstRow = Tst + y * StrideT + x0;
+    const uint16* RefRow = Ref + y * StrideR + x0;
+    int64* restrict CT  = Col[0];
+    int64* restrict CR  = Col[1];
+    int64* restrict CTT = Col[2];
+    int64* restrict CRR = Col[3];
+    int64* restrict CRT = Col[4];
+    for(int32 x = 0; x < NumCols; x++)
+    {
+      const uint32 T = TstRow[x];
+      const uint32 R = RefRow[x];
+      CT [x] += (int64)(T    );
+      CR [x] += (int64)(R    );
+      CTT[x] += (int64)(T * T);
+      CRR[x] += (int64)(R * R);
+      CRT[x] += (int64)(R * T);
+    }
+  };
+  auto ProcRow = [&](int32 y, int64* const* Blk, int32 NumBlkX)
+  {
+    flt32* restrict S = SSIMs.data();
+    for(int32 b = 0; b < NumBlkX; b++)
+    {
+      S[b] = xCalcSSIM(Blk[0][b], Blk[1][b], Blk[2][b], Blk[3][b], Blk[4][b], c_BlockArea, c_InvBlockArea, c_InvBlockArea2, C1F, C2F, CalcL);
+    }
+    xKBNS1 RowAccSSIM;
+    for(int32 b = 0; b < NumBlkX; b++) { RowAccSSIM += (flt64)S[b]; }
+    RowSums[y] = RowAccSSIM.result();
+  };
+
+  xCalcRngSums<5>(WndSize, WndStride, EndX, BegY, EndY, LoadRow, ProcRow);
+}
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
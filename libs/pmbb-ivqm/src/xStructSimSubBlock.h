@@ -0,0 +1,86 @@
+/*
+    SPDX-FileCopyrightText: 2019-2026 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#pragma once
+#include "xCommonDefIVQM.h"
+#include "xStructSimConsts.h"
+
+namespace PMBB_NAMESPACE {
+
+//===============================================================================================================================================================================================================
+
+class xStructSimSubBlock : public xStructSimConsts //Overlapping block (averaged) Structural Similarity assembled from stride-sized sub-block sums
+{
+public:
+  static constexpr int32 c_NumBlockRowsInBand = 16;  //block rows per band - amortizes setup of vertical window
+  static constexpr int32 c_ChunkWidth         = 256; //preferred columns of single chunk - keeps column sums in L1
+  static constexpr int32 c_MinSubInWndVsMB    = 4;   //for lower overlap (WndSize/WndStride) SIMD multi-block kernels are faster
+
+  static bool isSupported(int32 WndSize, int32 WndStride) { return WndStride > 0 && WndSize > WndStride && WndSize % WndStride == 0; } //overlapping blocks, window is a multiple of stride
+
+  //Calculates SSIM for blocks with origins at (x, y), x in [0, EndX), y in [BegY, EndY), both stepped by WndStride, stores per-row sums in RowSums[y].
+  //Moment sums are computed once per WndStride x WndStride sub-block, window sums are exact (integer) sums of sub-block sums - bit-exact with CalcBlckAvg.
+  static void CalcRngAvg(flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, int32 WndStride, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL);
+
+  //Moment-plane cache support - single picture block sums (Sum, SumSq) at [(y / WndStride) * StrideS + (x / WndStride)] are evaluated once per picture, only cross term is evaluated per picture pair.
+  static void CalcStatsAvg(flt64* Sum, flt64* SumSq, int32 StrideS, const uint16* Pic, int32 StrideP, int32 WndSize, int32 WndStride, int32 EndX, int32 BegY, int32 EndY);
+  static void CalcRngAvgX (flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, const flt64* SumT, const flt64* SumSqT, const flt64* SumR, const flt64* SumSqR, int32 StrideS, int32 WndSize, int32 WndStride, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL);
+
+  //Single precision engine (opt-in) - centered moments are exact (integer), SSIM expression in flt32, per-row pooling in flt64 (compensated).
+  //Pooled picture SSIM differs from CalcRngAvg by less than c_TolFlt32 (absolute).
+  static constexpr flt64 c_TolFlt32 = 0.000001;
+  static void CalcRngAvgF32(flt64* RowSums, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, int32 WndStride, int32 EndX, int32 BegY, int32 EndY, flt64 C1, flt64 C2, bool CalcL);
+
+protected:
+  template<int32 NumMoments, class tLoadRow, class tProcRow> static void xCalcRngSums(int32 WndSize, int32 WndStride, int32 EndX, int32 BegY, int32 EndY, tLoadRow LoadRow, tProcRow ProcRow);
+
+  //same expressions as xStructSimSTD::CalcBlckAvg
+  static inline flt64 xCalcSSIM(flt64 SumT, flt64 SumR, flt64 SumTT, flt64 SumRR, flt64 SumRT, flt64 InvBlockArea, flt64 C1, flt64 C2, bool CalcL)
+  {
+    flt64 AvgR  = SumR  * InvBlockArea;
+    flt64 AvgT  = SumT  * InvBlockArea;
+    flt64 VarR2 = SumRR * InvBlockArea - xPow2(AvgR);
+    flt64 VarT2 = SumTT * InvBlockArea - xPow2(AvgT);
+    flt64 CovRT = SumRT * InvBlockArea - AvgR*AvgT;
+
+    if(CalcL)
+    {
+      flt64 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
+      flt64 CS   = (2 * CovRT       + C2) / (VarR2       + VarT2       + C2); //"Contrast"*"Similarity"
+      flt64 SSIM = L * CS;
+      return SSIM;
+    }
+    else
+    {
+      flt64 CS = (2 * CovRT + C2) / (VarR2 + VarT2 + C2); //"Contrast"*"Similarity"
+      return CS;
+    }
+  }
+  static inline flt32 xCalcSSIM(int64 SumT, int64 SumR, int64 SumTT, int64 SumRR, int64 SumRT, int64 BlockArea, flt32 InvBlockArea, flt32 InvBlockArea2, flt32 C1, flt32 C2, bool CalcL)
+  {
+    flt32 AvgR  = (flt32)SumR * InvBlockArea;
+    flt32 AvgT  = (flt32)SumT * InvBlockArea;
+    flt32 VarR2 = (flt32)(BlockArea * SumRR - SumR * SumR) * InvBlockArea2; //exact before conversion
+    flt32 VarT2 = (flt32)(BlockArea * SumTT - SumT * SumT) * InvBlockArea2;
+    flt32 CovRT = (flt32)(BlockArea * SumRT - SumR * SumT) * InvBlockArea2;
+
+    if(CalcL)
+    {
+      flt32 L    = (2 * AvgR * AvgT + C1) / (xPow2(AvgR) + xPow2(AvgT) + C1); //"Luminance"
+      flt32 CS   = (2 * CovRT       + C2) / (VarR2       + VarT2       + C2); //"Contrast"*"Similarity"
+      flt32 SSIM = L * CS;
+      return SSIM;
+    }
+    else
+    {
+      flt32 CS = (2 * CovRT + C2) / (VarR2 + VarT2 + C2); //"Contrast"*"Similarity"
+      return CS;
+    }
+  }
+};
+
+//===============================================================================================================================================================================================================
+
+} //end of namespace PMBB
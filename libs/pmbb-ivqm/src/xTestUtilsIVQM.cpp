@@ -156,6 +156,24 @@ void xTestGenShftCompPicI(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, con
     GenShftCompRow(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights);
   }
 }
+uint64V4 xTestGenShftCompAndCalcDistPicP(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, fGenShftCompRowAndCalcDistP GenShftCompRowAndCalcDist)
+{
+  uint64V4 DistsV4 = xMakeVec4<uint64>(0);
+  for(int32 y = 0; y < Ref->getHeight(); y++)
+  {
+    DistsV4 += GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights);
+  }
+  return DistsV4;
+}
+uint64V4 xTestGenShftCompAndCalcDistPicI(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, fGenShftCompRowAndCalcDistI GenShftCompRowAndCalcDist)
+{
+  uint64V4 DistsV4 = xMakeVec4<uint64>(0);
+  for(int32 y = 0; y < Ref->getHeight(); y++)
+  {
+    DistsV4 += GenShftCompRowAndCalcDist(DstRef, Ref, Tst, y, GlobalColorShift, SearchRange, CmpWeights);
+  }
+  return DistsV4;
+}
 
 //===============================================================================================================================================================================================================
 
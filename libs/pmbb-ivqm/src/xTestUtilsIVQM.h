@@ -5,6 +5,7 @@
 #pragma once
 #include "xCommonDefIVQM.h"
 #include "xPic.h"
+#include "xDispMap.h"
 
 namespace PMBB_NAMESPACE {
 
@@ -32,6 +33,10 @@ using pCalcDistAsymmetricRowI = uint64V4(*)(const xPicI*, const xPicI*, const in
 
 uint64V4 xTestCalcDistAsymmetricPicI(const xPicI* Tst, const xPicI* OrgP, const int32V4& GlobalColorDiff, int32 SearchRange, const int32V4& CmpWeightsSearch, fCalcDistAsymmetricRowI CalcDistAsymmetricRow);
 
+//variants reporting number of pixels handled by exact-match shortcut
+using pCalcDistAsymmetricRowEP = uint64V4(*)(const xPicP*, const xPicP*, const int32, const int32V4&, const int32, const int32V4&, int32*);
+using pCalcDistAsymmetricRowEI = uint64V4(*)(const xPicI*, const xPicI*, const int32, const int32V4&, const int32, const int32V4&, int32*);
+
 using fGenShftCompRowP = std::function<void(xPicP*, const xPicP*, const xPicP*, const int32, const int32V4&, const int32, const int32V4&)>;
 using pGenShftCompRowP = void(*)(xPicP*, const xPicP*, const xPicP*, const int32, const int32V4&, const int32, const int32V4&);
 
@@ -42,6 +47,31 @@ using pGenShftCompRowI = void(*)(xPicI*, const xPicI*, const xPicI*, const int32
 
 void xTestGenShftCompPicI(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, fGenShftCompRowI GenShftCompRow);
 
+using fGenShftCompRowAndCalcDistP = std::function<uint64V4(xPicP*, const xPicP*, const xPicP*, const int32, const int32V4&, const int32, const int32V4&)>;
+using pGenShftCompRowAndCalcDistP = uint64V4(*)(xPicP*, const xPicP*, const xPicP*, const int32, const int32V4&, const int32, const int32V4&);
+
+uint64V4 xTestGenShftCompAndCalcDistPicP(xPicP* DstRef, const xPicP* Ref, const xPicP* Tst, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, fGenShftCompRowAndCalcDistP GenShftCompRowAndCalcDist);
+
+using fGenShftCompRowAndCalcDistI = std::function<uint64V4(xPicI*, const xPicI*, const xPicI*, const int32, const int32V4&, const int32, const int32V4&)>;
+using pGenShftCompRowAndCalcDistI = uint64V4(*)(xPicI*, const xPicI*, const xPicI*, const int32, const int32V4&, const int32, const int32V4&);
+
+uint64V4 xTestGenShftCompAndCalcDistPicI(xPicI* DstRef, const xPicI* Ref, const xPicI* Tst, const int32V4& GlobalColorShift, const int32 SearchRange, const int32V4& CmpWeights, fGenShftCompRowAndCalcDistI GenShftCompRowAndCalcDist);
+
+using fGenDispMapRowAndCalcDistP = std::function<uint64V4(xDispMap*, const xPicP*, const xPicP*, const int32, const int32V4&, const int32, const int32V4&)>;
+using pGenDispMapRowAndCalcDistP = uint64V4(*)(xDispMap*, const xPicP*, const xPicP*, const int32, const int32V4&, const int32, const int32V4&);
+
+using fGenDispMapRowAndCalcDistI = std::function<uint64V4(xDispMap*, const xPicI*, const xPicI*, const int32, const int32V4&, const int32, const int32V4&)>;
+using pGenDispMapRowAndCalcDistI = uint64V4(*)(xDispMap*, const xPicI*, const xPicI*, const int32, const int32V4&, const int32, const int32V4&);
+
+using fCalcDistAsymmetricRowMI = std::function<uint64V4(const xPicI*, const xPicI*, const xPicP*, const int32, const int32V4&, const int32, const int32V4&)>;
+using pCalcDistAsymmetricRowMI = uint64V4(*)(const xPicI*, const xPicI*, const xPicP*, const int32, const int32V4&, const int32, const int32V4&);
+
+using fGenShftCompRowMI = std::function<void(xPicI*, const xPicI*, const xPicI*, const xPicP*, const int32, const int32V4&, const int32, const int32V4&)>;
+using pGenShftCompRowMI = void(*)(xPicI*, const xPicI*, const xPicI*, const xPicP*, const int32, const int32V4&, const int32, const int32V4&);
+
+using fGenShftCompRowAndCalcDistMI = std::function<uint64V4(xPicI*, const xPicI*, const xPicI*, const xPicP*, const int32, const int32V4&, const int32, const int32V4&)>;
+using pGenShftCompRowAndCalcDistMI = uint64V4(*)(xPicI*, const xPicI*, const xPicI*, const xPicP*, const int32, const int32V4&, const int32, const int32V4&);
+
 //===============================================================================================================================================================================================================
 
 } //end of namespace PMBB
\ No newline at end of file
@@ -27,25 +27,61 @@ flt64V4 xWSPSNR::calcPicWSPSNR(const xPicP* Tst, const xPicP* Ref)
   }
   else
   {
-    for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
+    const int32 Height = Ref->getHeight();
+    for(int32 y = 0; y < Height; y += c_NumRowsInRng)
     {
-      m_ThPI->storeTask([this, &WSPSNR, &Tst, &Ref, CmpIdx](int32 /*ThreadIdx*/) { WSPSNR[CmpIdx] = xCalcCmpWSPSNR(Tst, Ref, (eCmp)CmpIdx); });
+      m_ThPI->storeTask([this, &Tst, &Ref, y, Height](int32 /*ThreadIdx*/)
+      {
+        const int32 EndY = xMin(y + c_NumRowsInRng, Height);
+        xCalcRngSSD          (Tst, Ref, y, EndY);
+        xCalcRngWeightedError(          y, EndY);
+      });
     }
     m_ThPI->executeStoredTasks();
+
+    const flt64V4 WSSSDs = xSumRowErrors(Height);
+    for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++) { WSPSNR[CmpIdx] = xCalcCmpWSPSNR(WSSSDs[CmpIdx], Tst->getArea(), Tst->getBitDepth()); }
   }
 
-  if(m_LegacyPeakValue8bitEmulation) //emulates behavior of original WS-PSNR software for 10bit content converted from 8 bit source
+  if(m_LegacyPeakValue8bitEmulation) { xApplyLegacyPeakValue8bitEmulation(WSPSNR, Tst->getBitDepth()); }
+
+  return WSPSNR;
+}
+flt64V4 xWSPSNR::calcPicWSPSNR(const xDiffStats* Stats)
+{
+  assert(Stats != nullptr);
+
+  flt64V4 WSPSNR = xMakeVec4(std::numeric_limits<flt64>::max());
+
+  if(!m_UseWS)
   {
-    const int32 RealBitDepth = Tst->getBitDepth();
-    if(RealBitDepth == 10)
+    WSPSNR = calcPicPSNR(Stats);
+  }
+  else
+  {
+    const int32 Height = Stats->getHeight();
+    for(int32 y = 0; y < Height; y += c_NumRowsInRng)
     {
-      const int32 RealMaxValue = xBitDepth2MaxValue(RealBitDepth);
-      const int32 FakeMaxValue = xBitDepth2MaxValue(8) << (RealBitDepth - 8);
-      const flt64 ModifierPSNR = 10 * (log10(xPow2(RealMaxValue)) - log10(xPow2(FakeMaxValue)));
-      for(int32 CmpIdx = 0; CmpIdx < 3; CmpIdx++) { WSPSNR[CmpIdx] -= ModifierPSNR; }
+      m_ThPI->storeTask([this, &Stats, y, Height](int32 /*ThreadIdx*/)
+      {
+        const int32 EndY = xMin(y + c_NumRowsInRng, Height);
+        for(int32 i = y; i < EndY; i++)
+        {
+          uint64V4 RowSSDs = xMakeVec4<uint64>(0);
+          for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++) { RowSSDs[CmpIdx] = Stats->getRowSSDs(CmpIdx)[i]; }
+          m_RowDistsV4[i] = RowSSDs;
+        }
+        xCalcRngWeightedError(y, EndY);
+      });
     }
+    m_ThPI->executeStoredTasks();
+
+    const flt64V4 WSSSDs = xSumRowErrors(Height);
+    for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++) { WSPSNR[CmpIdx] = xCalcCmpWSPSNR(WSSSDs[CmpIdx], Stats->getArea(), Stats->getBitDepth()); }
   }
 
+  if(m_LegacyPeakValue8bitEmulation) { xApplyLegacyPeakValue8bitEmulation(WSPSNR, Stats->getBitDepth()); }
+
   return WSPSNR;
 }
 flt64V4 xWSPSNR::calcPicWSPSNRM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, int32 NumNonMasked)
@@ -64,11 +100,20 @@ flt64V4 xWSPSNR::calcPicWSPSNRM(const xPicP* Tst, const xPicP* Ref, const xPicP*
   }
   else
   {
-    for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++)
+    const int32 Height = Ref->getHeight();
+    for(int32 y = 0; y < Height; y += c_NumRowsInRng)
     {
-      m_ThPI->storeTask([this, &WSPSNR, &Tst, &Ref, &Msk, &NumNonMasked, CmpIdx](int32 /*ThreadIdx*/) { WSPSNR[CmpIdx] = xCalcCmpWSPSNRM(Tst, Ref, Msk, NumNonMasked, (eCmp)CmpIdx); });
+      m_ThPI->storeTask([this, &Tst, &Ref, &Msk, y, Height](int32 /*ThreadIdx*/)
+      {
+        const int32 EndY = xMin(y + c_NumRowsInRng, Height);
+        xCalcRngSSDM         (Tst, Ref, Msk, y, EndY);
+        xCalcRngWeightedError(               y, EndY);
+      });
     }
     m_ThPI->executeStoredTasks();
+
+    const flt64V4 WSSSDs = xSumRowErrors(Height);
+    for(int32 CmpIdx = 0; CmpIdx < m_NumComponents; CmpIdx++) { WSPSNR[CmpIdx] = xCalcCmpWSPSNRM(WSSSDs[CmpIdx], NumNonMasked, Tst->getArea(), Tst->getBitDepth(), Msk->getBitDepth()); }
   }
 
   if(m_DebugCallbackMSK) { m_DebugCallbackMSK(NumNonMasked); }
@@ -78,63 +123,46 @@ flt64V4 xWSPSNR::calcPicWSPSNRM(const xPicP* Tst, const xPicP* Ref, const xPicP*
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-flt64 xWSPSNR::xCalcCmpWSPSNR(const xPicP* Tst, const xPicP* Ref, eCmp CmpId)
+void xWSPSNR::xCalcRngWeightedError(int32 BegY, int32 EndY)
 {
-  const int32   Width     = Ref->getWidth   ();
-  const int32   Height    = Ref->getHeight  ();
-  const uint16* TstPtr    = Tst->getAddr    (CmpId);
-  const uint16* RefPtr    = Ref->getAddr    (CmpId);
-  const int32   TstStride = Tst->getStride  ();
-  const int32   RefStride = Ref->getStride  ();
-  const int32   BitDepth  = Ref->getBitDepth();
-
-  uint64* RowSSDs = m_RowDistortions[(int32)CmpId].data();
-  for(int32 y = 0; y < Height; y++)
-  {
-    uint64 RowSSD = xDistortion::CalcSSD(RefPtr, TstPtr, Width, BitDepth);
-    RowSSDs[y] = RowSSD;
-    TstPtr += TstStride;
-    RefPtr += RefStride;
-  }
+  for(int32 y = BegY; y < EndY; y++) { m_RowErrorsV4[y] = (flt64V4)m_RowDistsV4[y] * m_EquirectangularWeights[y]; }
+}
+flt64V4 xWSPSNR::xSumRowErrors(int32 Height) const
+{
+  //fixed summation order - results does not depend on number of threads
+  return xKBNS4::Accumulate(m_RowErrorsV4.data(), Height) * m_DistortionCorrection;
+}
+flt64 xWSPSNR::xCalcCmpWSPSNR(flt64 CmpError, int32 Area, int32 BitDepth)
+{
+  flt64 WSPSNR = CalcPSNRfromSSD(CmpError, Area, BitDepth);
 
-  xKBNS1 KBNS; for(int32 y = 0; y < Height; y++) { KBNS.acc((flt64)RowSSDs[y] * m_EquirectangularWeights[y]); }
-  flt64  CmpError = KBNS.result() * m_DistortionCorrection;
-  flt64  WSPSNR   = CalcPSNRfromSSD(CmpError, Tst->getArea(), Tst->getBitDepth());
-  
-  if(m_FakeValsForExact && CmpError == 0) { WSPSNR = CalcPSNRfromSSD(1, Tst->getArea(), Tst->getBitDepth()); } //fake WSPSNR to avoid returning flt64_max
+  if(m_FakeValsForExact && CmpError == 0) { WSPSNR = CalcPSNRfromSSD(1, Area, BitDepth); } //fake WSPSNR to avoid returning flt64_max
   
   return WSPSNR;
 }
-flt64 xWSPSNR::xCalcCmpWSPSNRM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, const int32 NumNonMasked, eCmp CmpId)
+flt64 xWSPSNR::xCalcCmpWSPSNRM(flt64 CmpError, int32 NumNonMasked, int32 Area, int32 BitDepthPic, int32 BitDepthMsk)
 {
-  const int32   Width     = Ref->getWidth ();
-  const int32   Height    = Ref->getHeight();
-  const uint16* TstPtr    = Tst->getAddr  (CmpId   );
-  const uint16* RefPtr    = Ref->getAddr  (CmpId   );
-  const uint16* MskPtr    = Msk->getAddr  (eCmp::LM);
-  const int32   TstStride = Tst->getStride();
-  const int32   RefStride = Ref->getStride();
-  const int32   MskStride = Msk->getStride();
-
-  uint64* RowSSDs = m_RowDistortions[(int32)CmpId].data();
-  for(int32 y = 0; y < Height; y++)
-  {
-    uint64 RowSSD = xDistortion::CalcWeightedSSD(RefPtr, TstPtr, MskPtr, Width);
-    RowSSDs[y] = RowSSD;
-    TstPtr += TstStride;
-    RefPtr += RefStride;
-    MskPtr += MskStride;
-  }
+  flt64 WSPSNR = CalcPSNRfromMaskedSSD(CmpError, NumNonMasked, BitDepthPic, BitDepthMsk);
 
-  xKBNS1 KBNS; for(int32 y = 0; y < Height; y++) { KBNS.acc((flt64)RowSSDs[y] * m_EquirectangularWeights[y]); }
-  flt64  CmpError = KBNS.result() * m_DistortionCorrection;
-  flt64  WSPSNR   = CalcPSNRfromMaskedSSD(CmpError, NumNonMasked, Tst->getBitDepth(), Msk->getBitDepth());
-
-  if(m_FakeValsForExact && CmpError == 0) { WSPSNR = CalcPSNRfromSSD(1, Tst->getArea(), Tst->getBitDepth()); } //fake WSPSNR to avoid returning flt64_max
+  if(m_FakeValsForExact && CmpError == 0) { WSPSNR = CalcPSNRfromSSD(1, Area, BitDepthPic); } //fake WSPSNR to avoid returning flt64_max
 
   return WSPSNR;
 }
 
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void xWSPSNR::xApplyLegacyPeakValue8bitEmulation(flt64V4& WSPSNR, int32 BitDepth) //emulates behavior of original WS-PSNR software for 10bit content converted from 8 bit source
+{
+  const int32 RealBitDepth = BitDepth;
+  if(RealBitDepth == 10)
+  {
+    const int32 RealMaxValue = xBitDepth2MaxValue(RealBitDepth);
+    const int32 FakeMaxValue = xBitDepth2MaxValue(8) << (RealBitDepth - 8);
+    const flt64 ModifierPSNR = 10 * (log10(xPow2(RealMaxValue)) - log10(xPow2(FakeMaxValue)));
+    for(int32 CmpIdx = 0; CmpIdx < 3; CmpIdx++) { WSPSNR[CmpIdx] -= ModifierPSNR; }
+  }
+}
+
 //===============================================================================================================================================================================================================
 
 } //end of namespace PMBB
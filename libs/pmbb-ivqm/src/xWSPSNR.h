@@ -20,11 +20,15 @@ public:
   void  setLegacyWS8bit(bool LegacyPeakValue8bitEmulation) { m_LegacyPeakValue8bitEmulation = LegacyPeakValue8bitEmulation; }
 
   flt64V4 calcPicWSPSNR  (const xPicP* Tst, const xPicP* Ref);
+  flt64V4 calcPicWSPSNR  (const xDiffStats* Stats); //reuses precalculated row SSDs
   flt64V4 calcPicWSPSNRM (const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, int32 NumNonMasked = NOT_VALID);
 
 protected:
-  flt64 xCalcCmpWSPSNR (const xPicP* Tst, const xPicP* Ref,                                             eCmp CmpId);
-  flt64 xCalcCmpWSPSNRM(const xPicP* Tst, const xPicP* Ref, const xPicP* Msk, const int32 NumNonMasked, eCmp CmpId);
+  void    xCalcRngWeightedError(int32 BegY, int32 EndY); //m_RowDistsV4 --> m_RowErrorsV4
+  flt64V4 xSumRowErrors        (int32 Height) const;
+  flt64   xCalcCmpWSPSNR       (flt64 CmpError,                     int32 Area, int32 BitDepth);
+  flt64   xCalcCmpWSPSNRM      (flt64 CmpError, int32 NumNonMasked, int32 Area, int32 BitDepthPic, int32 BitDepthMsk);
+  void    xApplyLegacyPeakValue8bitEmulation(flt64V4& WSPSNR, int32 BitDepth);
 };
 
 //===============================================================================================================================================================================================================
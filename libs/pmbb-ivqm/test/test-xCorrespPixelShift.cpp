@@ -12,6 +12,7 @@
 #include <functional>
 #include <utility>
 #include <array>
+#include <algorithm>
 #include "xTestUtils.h"
 #include "xTestUtilsIVQM.h"
 #include "xPlane.h"
@@ -23,7 +24,7 @@ using namespace PMBB_NAMESPACE;
 
 //===============================================================================================================================================================================================================
 
-static const std::vector<int32> c_Dimms = { 64, 96, 128 };
+static const std::vector<int32> c_Dimms = { 64, 96, 100, 128 };
 static const std::vector<int32> c_BitDs = { 8, 10, 14 };
 constexpr int32 c_Margin   = 8;
 constexpr int32 c_NumIters = 2;
@@ -198,10 +199,566 @@ void testGenShftCompPic(fGenShftCompRowP GenShftCompRowP, fGenShftCompRowI GenSh
 
 //===============================================================================================================================================================================================================
 
+void testGenShftCompAndCalcDist(fGenShftCompRowAndCalcDistP GenShftCompRowAndCalcDistP, fGenShftCompRowAndCalcDistI GenShftCompRowAndCalcDistI)
+{
+  uint32 State = xTestUtils::c_XorShiftSeed;
+
+  for(const int32 y : c_Dimms)
+  {
+    for(const int32 x : c_Dimms)
+    {
+      int32V2 Size = { x, y };
+
+      for(const int32 b : c_BitDs)
+      {
+        xPicP* OrgP = new xPicP(Size, b, c_Margin);
+        xPicP* ModP = new xPicP(Size, b, c_Margin);
+        xPicI* OrgI = new xPicI(Size, b, c_Margin);
+        xPicI* ModI = new xPicI(Size, b, c_Margin);
+
+        xPicP* OrgP_SCP = new xPicP(Size, b, c_Margin);
+        xPicP* ModP_SCP = new xPicP(Size, b, c_Margin);
+        xPicI* OrgI_SCP = new xPicI(Size, b, c_Margin);
+        xPicI* ModI_SCP = new xPicI(Size, b, c_Margin);
+
+        xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C0), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+        xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C1), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+        xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C2), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+
+        OrgP->extend();
+
+        for(int32 Iter = 0; Iter < c_NumIters; Iter++)
+        {
+          xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C0), OrgP->getAddr(eCmp::C0), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+          if(Iter == 0)
+          {
+            ModP->copy(OrgP, eCmp::C1);
+            ModP->copy(OrgP, eCmp::C2);
+          }
+          else
+          {
+            xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C1), OrgP->getAddr(eCmp::C1), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+            xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C2), OrgP->getAddr(eCmp::C2), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+          }
+          ModP->extend();
+          OrgI->rearrangeFromPlanar(OrgP);
+          ModI->rearrangeFromPlanar(ModP);
+
+          for(int32V4 GCD : c_GCDs)
+          {
+            uint64V4 RefSSDsA = xTestCalcDistAsymmetricPicP(ModP, OrgP, GCD, 2, { 4,1,1,0 }, static_cast<pCalcDistAsymmetricRowP>(xCorrespPixelShiftSTD::CalcDistAsymmetricRow));
+            uint64V4 RefSSDsB = xTestCalcDistAsymmetricPicP(OrgP, ModP, GCD, 2, { 4,1,1,0 }, static_cast<pCalcDistAsymmetricRowP>(xCorrespPixelShiftSTD::CalcDistAsymmetricRow));
+
+            if(GenShftCompRowAndCalcDistP)
+            {
+              uint64V4 TstDistsA = xTestGenShftCompAndCalcDistPicP(OrgP_SCP, OrgP, ModP, GCD, 2, { 4,1,1,0 }, GenShftCompRowAndCalcDistP);
+              uint64V4 TstDistsB = xTestGenShftCompAndCalcDistPicP(ModP_SCP, ModP, OrgP, GCD, 2, { 4,1,1,0 }, GenShftCompRowAndCalcDistP);
+
+              uint64V4 TstSSDsA = xTestUtilsIVQM::calcPicSSD(ModP, OrgP_SCP);
+              uint64V4 TstSSDsB = xTestUtilsIVQM::calcPicSSD(OrgP, ModP_SCP);
+
+              CHECK(RefSSDsA == TstDistsA);
+              CHECK(RefSSDsB == TstDistsB);
+              CHECK(RefSSDsA == TstSSDsA);
+              CHECK(RefSSDsB == TstSSDsB);
+            }
+
+            if(GenShftCompRowAndCalcDistI)
+            {
+              uint64V4 TstDistsA = xTestGenShftCompAndCalcDistPicI(OrgI_SCP, OrgI, ModI, GCD, 2, { 4,1,1,0 }, GenShftCompRowAndCalcDistI);
+              uint64V4 TstDistsB = xTestGenShftCompAndCalcDistPicI(ModI_SCP, ModI, OrgI, GCD, 2, { 4,1,1,0 }, GenShftCompRowAndCalcDistI);
+
+              uint64V4 TstSSDsA = xTestUtilsIVQM::calcPicSSD(ModI, OrgI_SCP);
+              uint64V4 TstSSDsB = xTestUtilsIVQM::calcPicSSD(OrgI, ModI_SCP);
+
+              CHECK(RefSSDsA == TstDistsA);
+              CHECK(RefSSDsB == TstDistsB);
+              CHECK(RefSSDsA == TstSSDsA);
+              CHECK(RefSSDsB == TstSSDsB);
+            }
+          }
+        }
+
+        delete OrgP; OrgP = nullptr;
+        delete ModP; ModP = nullptr;
+        delete OrgI; OrgI = nullptr;
+        delete ModI; ModI = nullptr;
+
+        delete OrgP_SCP; OrgP_SCP = nullptr;
+        delete ModP_SCP; ModP_SCP = nullptr;
+        delete OrgI_SCP; OrgI_SCP = nullptr;
+        delete ModI_SCP; ModI_SCP = nullptr;
+      }
+    }
+  }
+
+}
+
+//===============================================================================================================================================================================================================
+
+void testDispMap(fGenDispMapRowAndCalcDistP GenDispMapRowAndCalcDistP, fGenDispMapRowAndCalcDistI GenDispMapRowAndCalcDistI)
+{
+  uint32 State = xTestUtils::c_XorShiftSeed;
+
+  for(const int32 y : c_Dimms)
+  {
+    for(const int32 x : c_Dimms)
+    {
+      int32V2 Size = { x, y };
+
+      for(const int32 b : c_BitDs)
+      {
+        xPicP* OrgP = new xPicP(Size, b, c_Margin);
+        xPicP* ModP = new xPicP(Size, b, c_Margin);
+        xPicI* OrgI = new xPicI(Size, b, c_Margin);
+        xPicI* ModI = new xPicI(Size, b, c_Margin);
+
+        xPicP* OrgP_SCP = new xPicP(Size, b, c_Margin);
+        xPicI* OrgI_SCP = new xPicI(Size, b, c_Margin);
+
+        xDispMap* DispMapP = new xDispMap; xDispMapUtils::createMap(DispMapP, Size);
+        xDispMap* DispMapI = new xDispMap; xDispMapUtils::createMap(DispMapI, Size);
+        xDispMap* DispMapT = new xDispMap; xDispMapUtils::createMap(DispMapT, Size);
+
+        xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C0), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+        xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C1), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+        xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C2), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+
+        OrgP->extend();
+
+        for(int32 Iter = 0; Iter < c_NumIters; Iter++)
+        {
+          xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C0), OrgP->getAddr(eCmp::C0), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+          if(Iter == 0)
+          {
+            ModP->copy(OrgP, eCmp::C1);
+            ModP->copy(OrgP, eCmp::C2);
+          }
+          else
+          {
+            xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C1), OrgP->getAddr(eCmp::C1), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+            xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C2), OrgP->getAddr(eCmp::C2), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+          }
+          ModP->extend();
+          OrgI->rearrangeFromPlanar(OrgP);
+          ModI->rearrangeFromPlanar(ModP);
+
+          for(int32V4 GCD : c_GCDs)
+          {
+            uint64V4 RefSSDs = xTestCalcDistAsymmetricPicP(ModP, OrgP, GCD, 2, { 4,1,1,0 }, static_cast<pCalcDistAsymmetricRowP>(xCorrespPixelShiftSTD::CalcDistAsymmetricRow));
+
+            //reference map from planar STD implementation
+            uint64V4 GenSSDsP = xMakeVec4<uint64>(0);
+            uint64V4 MapSSDsP = xMakeVec4<uint64>(0);
+            for(int32 r = 0; r < y; r++) { GenSSDsP += xCorrespPixelShiftSTD::GenDispMapRowAndCalcDist(DispMapP, OrgP, ModP, r, GCD, 2, { 4,1,1,0 }); }
+            for(int32 r = 0; r < y; r++) { MapSSDsP += xCorrespPixelShiftSTD::CalcDistAsymmetricRowFromDispMap(DispMapP, ModP, OrgP, r, GCD); }
+            for(int32 r = 0; r < y; r++) { xCorrespPixelShiftSTD::GenShftCompRowFromDispMap(OrgP_SCP, DispMapP, OrgP, r, GCD); }
+            CHECK(RefSSDs == GenSSDsP);
+            CHECK(RefSSDs == MapSSDsP);
+            CHECK(RefSSDs == xTestUtilsIVQM::calcPicSSD(ModP, OrgP_SCP));
+
+            //tested implementations has to produce the same map
+            if(GenDispMapRowAndCalcDistP)
+            {
+              uint64V4 GenSSDsT = xMakeVec4<uint64>(0);
+              for(int32 r = 0; r < y; r++) { GenSSDsT += GenDispMapRowAndCalcDistP(DispMapT, OrgP, ModP, r, GCD, 2, { 4,1,1,0 }); }
+              CHECK(RefSSDs == GenSSDsT);
+              bool MapsEqual = true;
+              for(int32 r = 0; r < y; r++) { MapsEqual &= std::equal(DispMapP->getRowAddr(r), DispMapP->getRowAddr(r) + x, DispMapT->getRowAddr(r)); }
+              CHECK(MapsEqual);
+            }
+
+            if(GenDispMapRowAndCalcDistI)
+            {
+              uint64V4 GenSSDsI = xMakeVec4<uint64>(0);
+              uint64V4 MapSSDsI = xMakeVec4<uint64>(0);
+              for(int32 r = 0; r < y; r++) { GenSSDsI += GenDispMapRowAndCalcDistI(DispMapI, OrgI, ModI, r, GCD, 2, { 4,1,1,0 }); }
+              for(int32 r = 0; r < y; r++) { MapSSDsI += xCorrespPixelShiftSTD::CalcDistAsymmetricRowFromDispMap(DispMapI, ModI, OrgI, r, GCD); }
+              for(int32 r = 0; r < y; r++) { xCorrespPixelShiftSTD::GenShftCompRowFromDispMap(OrgI_SCP, DispMapI, OrgI, r, GCD); }
+              CHECK(RefSSDs == GenSSDsI);
+              CHECK(RefSSDs == MapSSDsI);
+              CHECK(RefSSDs == xTestUtilsIVQM::calcPicSSD(ModI, OrgI_SCP));
+              bool MapsEqual = true;
+              for(int32 r = 0; r < y; r++) { MapsEqual &= std::equal(DispMapP->getRowAddr(r), DispMapP->getRowAddr(r) + x, DispMapI->getRowAddr(r)); }
+              CHECK(MapsEqual);
+            }
+          }
+        }
+
+        delete OrgP; OrgP = nullptr;
+        delete ModP; ModP = nullptr;
+        delete OrgI; OrgI = nullptr;
+        delete ModI; ModI = nullptr;
+
+        delete OrgP_SCP; OrgP_SCP = nullptr;
+        delete OrgI_SCP; OrgI_SCP = nullptr;
+
+        delete DispMapP; DispMapP = nullptr;
+        delete DispMapI; DispMapI = nullptr;
+        delete DispMapT; DispMapT = nullptr;
+      }
+    }
+  }
+}
+
+//===============================================================================================================================================================================================================
+
+void testMasked(fCalcDistAsymmetricRowMI CalcDistAsymmetricRowM, fGenShftCompRowMI GenShftCompRowM, fGenShftCompRowAndCalcDistMI GenShftCompRowAndCalcDistM)
+{
+  uint32 State = xTestUtils::c_XorShiftSeed;
+
+  for(const int32 y : c_Dimms)
+  {
+    for(const int32 x : c_Dimms)
+    {
+      int32V2 Size = { x, y };
+
+      for(const int32 b : c_BitDs)
+      {
+        xPicP* OrgP = new xPicP(Size, b, c_Margin);
+        xPicP* ModP = new xPicP(Size, b, c_Margin);
+        xPicI* OrgI = new xPicI(Size, b, c_Margin);
+        xPicI* ModI = new xPicI(Size, b, c_Margin);
+        xPicP* MskP = new xPicP(Size, 8, c_Margin);
+        xPicP* OneP = new xPicP(Size, 8, c_Margin);
+
+        xPicI* RefI_SCP = new xPicI(Size, b, c_Margin);
+        xPicI* TstI_SCP = new xPicI(Size, b, c_Margin);
+
+        xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C0), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+        xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C1), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+        xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C2), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+
+        OrgP->extend();
+
+        //blocky mask with zeros, ones, max and random weights
+        MskP->fill(0);
+        for(int32 by = 0; by < y; by += 4)
+        {
+          for(int32 bx = 0; bx < x; bx += 3)
+          {
+            State = xTestUtils::xXorShift32(State);
+            const uint32 Mode  = State & 3;
+            const uint16 Value = Mode == 0 ? 0 : Mode == 1 ? 1 : Mode == 2 ? 255 : (uint16)((State >> 8) & 0xFF);
+            for(int32 r = by; r < xMin(by + 4, y); r++) { for(int32 c = bx; c < xMin(bx + 3, x); c++) { MskP->accessPel({ c, r }, eCmp::LM) = Value; } }
+          }
+        }
+        MskP->extend();
+        OneP->fill(1);
+
+        for(int32 Iter = 0; Iter < c_NumIters; Iter++)
+        {
+          xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C0), OrgP->getAddr(eCmp::C0), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+          if(Iter == 0)
+          {
+            ModP->copy(OrgP, eCmp::C1);
+            ModP->copy(OrgP, eCmp::C2);
+          }
+          else
+          {
+            xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C1), OrgP->getAddr(eCmp::C1), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+            xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C2), OrgP->getAddr(eCmp::C2), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+          }
+          ModP->extend();
+          OrgI->rearrangeFromPlanar(OrgP);
+          ModI->rearrangeFromPlanar(ModP);
+
+          for(int32V4 GCD : c_GCDs)
+          {
+            //reference from STD implementation
+            uint64V4 RefDists = xMakeVec4<uint64>(0);
+            for(int32 r = 0; r < y; r++) { RefDists += xCorrespPixelShiftSTD::CalcDistAsymmetricRowM(ModI, OrgI, MskP, r, GCD, 2, { 4,1,1,0 }); }
+            RefI_SCP->fill(0);
+            for(int32 r = 0; r < y; r++) { xCorrespPixelShiftSTD::GenShftCompRowM(RefI_SCP, OrgI, ModI, MskP, r, GCD, 2, { 4,1,1,0 }); }
+
+            if(CalcDistAsymmetricRowM)
+            {
+              uint64V4 TstDists = xMakeVec4<uint64>(0);
+              uint64V4 OneDists = xMakeVec4<uint64>(0);
+              for(int32 r = 0; r < y; r++) { TstDists += CalcDistAsymmetricRowM(ModI, OrgI, MskP, r, GCD, 2, { 4,1,1,0 }); }
+              for(int32 r = 0; r < y; r++) { OneDists += CalcDistAsymmetricRowM(ModI, OrgI, OneP, r, GCD, 2, { 4,1,1,0 }); }
+              CHECK(RefDists == TstDists);
+              CHECK(xTestCalcDistAsymmetricPicI(ModI, OrgI, GCD, 2, { 4,1,1,0 }, static_cast<pCalcDistAsymmetricRowI>(xCorrespPixelShiftSTD::CalcDistAsymmetricRow)) == OneDists); //mask of ones == no mask
+            }
+
+            if(GenShftCompRowM)
+            {
+              TstI_SCP->fill(0);
+              for(int32 r = 0; r < y; r++) { GenShftCompRowM(TstI_SCP, OrgI, ModI, MskP, r, GCD, 2, { 4,1,1,0 }); }
+              bool PicsEqual = true;
+              for(int32 r = 0; r < y; r++) { PicsEqual &= std::equal(RefI_SCP->getAddr() + r * RefI_SCP->getStride(), RefI_SCP->getAddr() + r * RefI_SCP->getStride() + x, TstI_SCP->getAddr() + r * TstI_SCP->getStride()); }
+              CHECK(PicsEqual);
+            }
+
+            if(GenShftCompRowAndCalcDistM)
+            {
+              TstI_SCP->fill(0);
+              uint64V4 TstDists = xMakeVec4<uint64>(0);
+              for(int32 r = 0; r < y; r++) { TstDists += GenShftCompRowAndCalcDistM(TstI_SCP, OrgI, ModI, MskP, r, GCD, 2, { 4,1,1,0 }); }
+              bool PicsEqual = true;
+              for(int32 r = 0; r < y; r++) { PicsEqual &= std::equal(RefI_SCP->getAddr() + r * RefI_SCP->getStride(), RefI_SCP->getAddr() + r * RefI_SCP->getStride() + x, TstI_SCP->getAddr() + r * TstI_SCP->getStride()); }
+              CHECK(RefDists == TstDists);
+              CHECK(PicsEqual);
+            }
+          }
+        }
+
+        delete OrgP; OrgP = nullptr;
+        delete ModP; ModP = nullptr;
+        delete OrgI; OrgI = nullptr;
+        delete ModI; ModI = nullptr;
+        delete MskP; MskP = nullptr;
+        delete OneP; OneP = nullptr;
+
+        delete RefI_SCP; RefI_SCP = nullptr;
+        delete TstI_SCP; TstI_SCP = nullptr;
+      }
+    }
+  }
+}
+
+//===============================================================================================================================================================================================================
+
+void testSearchRangesAndWeights(fCalcDistAsymmetricRowP CalcDistAsymmetricRowP, fCalcDistAsymmetricRowI CalcDistAsymmetricRowI)
+{
+  //covers specialized (SR=1..4, 4:1:1 weights) and generic kernels
+  static const std::vector<int32>   SearchRanges = { 1, 2, 3, 4, 5 };
+  static const std::vector<int32V4> CmpWeightsS  = { {4,1,1,0}, {1,1,1,0}, {2,3,1,0} };
+
+  uint32 State = xTestUtils::c_XorShiftSeed;
+
+  for(const int32 x : { 64, 100 })
+  {
+    int32V2 Size = { x, 64 };
+
+    for(const int32 b : { 8, 10 })
+    {
+      xPicP* OrgP = new xPicP(Size, b, c_Margin);
+      xPicP* ModP = new xPicP(Size, b, c_Margin);
+      xPicI* OrgI = new xPicI(Size, b, c_Margin);
+      xPicI* ModI = new xPicI(Size, b, c_Margin);
+
+      xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C0), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+      xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C1), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+      xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C2), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+      OrgP->extend();
+
+      xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C0), OrgP->getAddr(eCmp::C0), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+      xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C1), OrgP->getAddr(eCmp::C1), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+      xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C2), OrgP->getAddr(eCmp::C2), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+      ModP->extend();
+      OrgI->rearrangeFromPlanar(OrgP);
+      ModI->rearrangeFromPlanar(ModP);
+
+      for(const int32 SearchRange : SearchRanges)
+      {
+        for(const int32V4& CmpWeights : CmpWeightsS)
+        {
+          for(int32V4 GCD : c_GCDs)
+          {
+            uint64V4 RefSSDs = xTestCalcDistAsymmetricPicP(ModP, OrgP, GCD, SearchRange, CmpWeights, static_cast<pCalcDistAsymmetricRowP>(xCorrespPixelShiftSTD::CalcDistAsymmetricRow));
+            if(CalcDistAsymmetricRowP)
+            {
+              uint64V4 TstSSDs = xTestCalcDistAsymmetricPicP(ModP, OrgP, GCD, SearchRange, CmpWeights, CalcDistAsymmetricRowP);
+              CHECK(RefSSDs == TstSSDs);
+            }
+            if(CalcDistAsymmetricRowI)
+            {
+              uint64V4 TstSSDs = xTestCalcDistAsymmetricPicI(ModI, OrgI, GCD, SearchRange, CmpWeights, CalcDistAsymmetricRowI);
+              CHECK(RefSSDs == TstSSDs);
+            }
+          }
+        }
+      }
+
+      delete OrgP; OrgP = nullptr;
+      delete ModP; ModP = nullptr;
+      delete OrgI; OrgI = nullptr;
+      delete ModI; ModI = nullptr;
+    }
+  }
+}
+
+//===============================================================================================================================================================================================================
+
+void testSpecializedVsGeneric(fCalcDistAsymmetricRowP CalcDistAsymmetricRowP, fCalcDistAsymmetricRowI CalcDistAsymmetricRowI, fGenShftCompRowP GenShftCompRowP, fGenShftCompRowI GenShftCompRowI)
+{
+  //widths not multiple of vector width (last block overlaps previous one)
+  //8:2:2 weights select the same candidates as 4:1:1 but go through generic-weights kernel, SR=5 goes through generic search range kernel
+  static const std::vector<int32>   Widths       = { 17, 23, 37, 100, 127 };
+  static const std::vector<int32>   SearchRanges = { 1, 2, 3, 4, 5 };
+  static const int32V4              SpecWeights  = { 4,1,1,0 };
+  static const int32V4              GenrWeights  = { 8,2,2,0 };
+
+  uint32 State = xTestUtils::c_XorShiftSeed;
+
+  for(const int32 x : Widths)
+  {
+    int32V2 Size = { x, 32 };
+
+    for(const int32 b : { 8, 10 })
+    {
+      xPicP* OrgP = new xPicP(Size, b, c_Margin);
+      xPicP* ModP = new xPicP(Size, b, c_Margin);
+      xPicI* OrgI = new xPicI(Size, b, c_Margin);
+      xPicI* ModI = new xPicI(Size, b, c_Margin);
+
+      xPicP* SpecP_SCP = new xPicP(Size, b, c_Margin);
+      xPicP* GenrP_SCP = new xPicP(Size, b, c_Margin);
+      xPicI* SpecI_SCP = new xPicI(Size, b, c_Margin);
+      xPicI* GenrI_SCP = new xPicI(Size, b, c_Margin);
+
+      xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C0), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+      xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C1), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+      xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C2), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+      OrgP->extend();
+
+      xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C0), OrgP->getAddr(eCmp::C0), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+      xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C1), OrgP->getAddr(eCmp::C1), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+      xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C2), OrgP->getAddr(eCmp::C2), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+      ModP->extend();
+      OrgI->rearrangeFromPlanar(OrgP);
+      ModI->rearrangeFromPlanar(ModP);
+
+      for(const int32 SearchRange : SearchRanges)
+      {
+        for(int32V4 GCD : c_GCDs)
+        {
+          uint64V4 RefSSDs = xTestCalcDistAsymmetricPicP(ModP, OrgP, GCD, SearchRange, SpecWeights, static_cast<pCalcDistAsymmetricRowP>(xCorrespPixelShiftSTD::CalcDistAsymmetricRow));
+          if(CalcDistAsymmetricRowP)
+          {
+            uint64V4 SpecSSDs = xTestCalcDistAsymmetricPicP(ModP, OrgP, GCD, SearchRange, SpecWeights, CalcDistAsymmetricRowP);
+            uint64V4 GenrSSDs = xTestCalcDistAsymmetricPicP(ModP, OrgP, GCD, SearchRange, GenrWeights, CalcDistAsymmetricRowP);
+            CHECK(SpecSSDs == GenrSSDs);
+            CHECK(RefSSDs  == SpecSSDs);
+          }
+          if(CalcDistAsymmetricRowI)
+          {
+            uint64V4 SpecSSDs = xTestCalcDistAsymmetricPicI(ModI, OrgI, GCD, SearchRange, SpecWeights, CalcDistAsymmetricRowI);
+            uint64V4 GenrSSDs = xTestCalcDistAsymmetricPicI(ModI, OrgI, GCD, SearchRange, GenrWeights, CalcDistAsymmetricRowI);
+            CHECK(SpecSSDs == GenrSSDs);
+            CHECK(RefSSDs  == SpecSSDs);
+          }
+          if(GenShftCompRowP)
+          {
+            xTestGenShftCompPicP(SpecP_SCP, OrgP, ModP, GCD, SearchRange, SpecWeights, GenShftCompRowP);
+            xTestGenShftCompPicP(GenrP_SCP, OrgP, ModP, GCD, SearchRange, GenrWeights, GenShftCompRowP);
+            CHECK(xTestUtilsIVQM::calcPicSSD(SpecP_SCP, GenrP_SCP) == xMakeVec4<uint64>(0));
+            CHECK(xTestUtilsIVQM::calcPicSSD(ModP     , SpecP_SCP) == RefSSDs);
+          }
+          if(GenShftCompRowI)
+          {
+            xTestGenShftCompPicI(SpecI_SCP, OrgI, ModI, GCD, SearchRange, SpecWeights, GenShftCompRowI);
+            xTestGenShftCompPicI(GenrI_SCP, OrgI, ModI, GCD, SearchRange, GenrWeights, GenShftCompRowI);
+            CHECK(xTestUtilsIVQM::calcPicSSD(SpecI_SCP, GenrI_SCP) == xMakeVec4<uint64>(0));
+            CHECK(xTestUtilsIVQM::calcPicSSD(ModI     , SpecI_SCP) == RefSSDs);
+          }
+        }
+      }
+
+      delete OrgP; OrgP = nullptr;
+      delete ModP; ModP = nullptr;
+      delete OrgI; OrgI = nullptr;
+      delete ModI; ModI = nullptr;
+
+      delete SpecP_SCP; SpecP_SCP = nullptr;
+      delete GenrP_SCP; GenrP_SCP = nullptr;
+      delete SpecI_SCP; SpecI_SCP = nullptr;
+      delete GenrI_SCP; GenrI_SCP = nullptr;
+    }
+  }
+}
+
+//===============================================================================================================================================================================================================
+
+void testExactMatch(pCalcDistAsymmetricRowEP CalcDistAsymmetricRowP, pCalcDistAsymmetricRowEI CalcDistAsymmetricRowI)
+{
+  //exact-match shortcut must not change result, identical pictures are expected to be fully covered by shortcut
+  static const std::vector<int32V4> CmpWeightsS = { {4,1,1,0}, {2,3,1,0} };
+
+  uint32 State = xTestUtils::c_XorShiftSeed;
+
+  for(const int32 x : { 64, 100 })
+  {
+    int32V2 Size = { x, 64 };
+
+    for(const int32 b : { 8, 10 })
+    {
+      xPicP* OrgP = new xPicP(Size, b, c_Margin);
+      xPicP* ModP = new xPicP(Size, b, c_Margin);
+      xPicI* OrgI = new xPicI(Size, b, c_Margin);
+      xPicI* ModI = new xPicI(Size, b, c_Margin);
+
+      xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C0), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+      xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C1), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+      xPerlinNoise::fillPerlinNoiseI(OrgP->getAddr(eCmp::C2), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+      OrgP->extend();
+
+      xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C0), OrgP->getAddr(eCmp::C0), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+      xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C1), OrgP->getAddr(eCmp::C1), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+      xTestUtilsIVQM::addBlockNoise(ModP->getAddr(eCmp::C2), OrgP->getAddr(eCmp::C2), ModP->getStride(), OrgP->getStride(), OrgP->getWidth(), OrgP->getHeight(), OrgP->getBitDepth(), State);
+      ModP->extend();
+      OrgI->rearrangeFromPlanar(OrgP);
+      ModI->rearrangeFromPlanar(ModP);
+
+      for(const int32V4& CmpWeights : CmpWeightsS)
+      {
+        for(int32V4 GCD : c_GCDs)
+        {
+          const bool Identical = GCD == 0;
+          uint64V4 RefSSDs = xTestCalcDistAsymmetricPicP(ModP, OrgP, GCD, c_SearchRange, CmpWeights, static_cast<pCalcDistAsymmetricRowP>(xCorrespPixelShiftSTD::CalcDistAsymmetricRow));
+
+          if(CalcDistAsymmetricRowP)
+          {
+            uint64V4 TstSSDs = xMakeVec4<uint64>(0);
+            int64    NumSame = 0;
+            int64    NumMod  = 0;
+            for(int32 y = 0; y < Size.getY(); y++)
+            {
+              int32 NumExactMatchPels = -1;
+              CalcDistAsymmetricRowP(OrgP, OrgP, y, GCD, c_SearchRange, CmpWeights, &NumExactMatchPels); NumSame += NumExactMatchPels;
+              TstSSDs += CalcDistAsymmetricRowP(ModP, OrgP, y, GCD, c_SearchRange, CmpWeights, &NumExactMatchPels); NumMod += NumExactMatchPels;
+            }
+            CHECK(RefSSDs == TstSSDs);
+            CHECK(NumSame == (Identical ? Size.getMul() : 0));
+            CHECK((NumMod >= 0 && NumMod <= Size.getMul()));
+          }
+          if(CalcDistAsymmetricRowI)
+          {
+            uint64V4 TstSSDs = xMakeVec4<uint64>(0);
+            int64    NumSame = 0;
+            int64    NumMod  = 0;
+            for(int32 y = 0; y < Size.getY(); y++)
+            {
+              int32 NumExactMatchPels = -1;
+              CalcDistAsymmetricRowI(OrgI, OrgI, y, GCD, c_SearchRange, CmpWeights, &NumExactMatchPels); NumSame += NumExactMatchPels;
+              TstSSDs += CalcDistAsymmetricRowI(ModI, OrgI, y, GCD, c_SearchRange, CmpWeights, &NumExactMatchPels); NumMod += NumExactMatchPels;
+            }
+            CHECK(RefSSDs == TstSSDs);
+            CHECK(NumSame == (Identical ? Size.getMul() : 0));
+            CHECK((NumMod >= 0 && NumMod <= Size.getMul()));
+          }
+        }
+      }
+
+      delete OrgP; OrgP = nullptr;
+      delete ModP; ModP = nullptr;
+      delete OrgI; OrgI = nullptr;
+      delete ModI; ModI = nullptr;
+    }
+  }
+}
+
+//===============================================================================================================================================================================================================
+
 TEST_CASE("xCorrespPixelShiftSTD")
 {
   testCalcDistAsymmetricRow(static_cast<pCalcDistAsymmetricRowP>(xCorrespPixelShiftSTD::CalcDistAsymmetricRow), static_cast<pCalcDistAsymmetricRowI>(xCorrespPixelShiftSTD::CalcDistAsymmetricRow));
   testGenShftCompPic       (static_cast<pGenShftCompRowP       >(xCorrespPixelShiftSTD::GenShftCompRow       ), static_cast<pGenShftCompRowI       >(xCorrespPixelShiftSTD::GenShftCompRow       ));
+  testGenShftCompAndCalcDist(static_cast<pGenShftCompRowAndCalcDistP>(xCorrespPixelShiftSTD::GenShftCompRowAndCalcDist), static_cast<pGenShftCompRowAndCalcDistI>(xCorrespPixelShiftSTD::GenShftCompRowAndCalcDist));
+  testMasked               (static_cast<pCalcDistAsymmetricRowMI>(xCorrespPixelShiftSTD::CalcDistAsymmetricRowM), static_cast<pGenShftCompRowMI>(xCorrespPixelShiftSTD::GenShftCompRowM), static_cast<pGenShftCompRowAndCalcDistMI>(xCorrespPixelShiftSTD::GenShftCompRowAndCalcDistM));
+  testDispMap              (static_cast<pGenDispMapRowAndCalcDistP >(xCorrespPixelShiftSTD::GenDispMapRowAndCalcDist), static_cast<pGenDispMapRowAndCalcDistI>(xCorrespPixelShiftSTD::GenDispMapRowAndCalcDist));
+  testExactMatch           (static_cast<pCalcDistAsymmetricRowEP>(xCorrespPixelShiftSTD::CalcDistAsymmetricRow), static_cast<pCalcDistAsymmetricRowEI>(xCorrespPixelShiftSTD::CalcDistAsymmetricRow));
 }
 
 #if X_SIMD_CAN_USE_SSE
@@ -209,9 +766,39 @@ TEST_CASE("xCorrespPixelShiftSSE")
 {
   testCalcDistAsymmetricRow(nullptr, static_cast<pCalcDistAsymmetricRowI>(xCorrespPixelShiftSSE::CalcDistAsymmetricRow));
   testGenShftCompPic       (nullptr, static_cast<pGenShftCompRowI       >(xCorrespPixelShiftSSE::GenShftCompRow       ));
+  testGenShftCompAndCalcDist(nullptr, static_cast<pGenShftCompRowAndCalcDistI>(xCorrespPixelShiftSSE::GenShftCompRowAndCalcDist));
+  testMasked               (static_cast<pCalcDistAsymmetricRowMI>(xCorrespPixelShiftSSE::CalcDistAsymmetricRowM), static_cast<pGenShftCompRowMI>(xCorrespPixelShiftSSE::GenShftCompRowM), static_cast<pGenShftCompRowAndCalcDistMI>(xCorrespPixelShiftSSE::GenShftCompRowAndCalcDistM));
+  testExactMatch           (nullptr, static_cast<pCalcDistAsymmetricRowEI>(xCorrespPixelShiftSSE::CalcDistAsymmetricRow));
 }
 #endif //X_SIMD_CAN_USE_SSE
 
+#if X_SIMD_CAN_USE_AVX
+TEST_CASE("xCorrespPixelShiftAVX")
+{
+  testCalcDistAsymmetricRow(static_cast<pCalcDistAsymmetricRowP>(xCorrespPixelShiftAVX::CalcDistAsymmetricRow), static_cast<pCalcDistAsymmetricRowI>(xCorrespPixelShiftAVX::CalcDistAsymmetricRow));
+  testSearchRangesAndWeights(static_cast<pCalcDistAsymmetricRowP>(xCorrespPixelShiftAVX::CalcDistAsymmetricRow), static_cast<pCalcDistAsymmetricRowI>(xCorrespPixelShiftAVX::CalcDistAsymmetricRow));
+  testSpecializedVsGeneric (static_cast<pCalcDistAsymmetricRowP>(xCorrespPixelShiftAVX::CalcDistAsymmetricRow), static_cast<pCalcDistAsymmetricRowI>(xCorrespPixelShiftAVX::CalcDistAsymmetricRow), static_cast<pGenShftCompRowP>(xCorrespPixelShiftAVX::GenShftCompRow), static_cast<pGenShftCompRowI>(xCorrespPixelShiftAVX::GenShftCompRow));
+  testGenShftCompPic       (static_cast<pGenShftCompRowP       >(xCorrespPixelShiftAVX::GenShftCompRow       ), static_cast<pGenShftCompRowI       >(xCorrespPixelShiftAVX::GenShftCompRow       ));
+  testGenShftCompAndCalcDist(static_cast<pGenShftCompRowAndCalcDistP>(xCorrespPixelShiftAVX::GenShftCompRowAndCalcDist), static_cast<pGenShftCompRowAndCalcDistI>(xCorrespPixelShiftAVX::GenShftCompRowAndCalcDist));
+  testMasked               (static_cast<pCalcDistAsymmetricRowMI>(xCorrespPixelShiftAVX::CalcDistAsymmetricRowM), static_cast<pGenShftCompRowMI>(xCorrespPixelShiftAVX::GenShftCompRowM), static_cast<pGenShftCompRowAndCalcDistMI>(xCorrespPixelShiftAVX::GenShftCompRowAndCalcDistM));
+  testDispMap              (static_cast<pGenDispMapRowAndCalcDistP >(xCorrespPixelShiftAVX::GenDispMapRowAndCalcDist), static_cast<pGenDispMapRowAndCalcDistI>(xCorrespPixelShiftAVX::GenDispMapRowAndCalcDist));
+  testExactMatch           (static_cast<pCalcDistAsymmetricRowEP>(xCorrespPixelShiftAVX::CalcDistAsymmetricRow), static_cast<pCalcDistAsymmetricRowEI>(xCorrespPixelShiftAVX::CalcDistAsymmetricRow));
+}
+#endif //X_SIMD_CAN_USE_AVX
+
+#if X_SIMD_CAN_USE_AVX512
+TEST_CASE("xCorrespPixelShiftAVX512")
+{
+  testCalcDistAsymmetricRow(static_cast<pCalcDistAsymmetricRowP>(xCorrespPixelShiftAVX512::CalcDistAsymmetricRow), static_cast<pCalcDistAsymmetricRowI>(xCorrespPixelShiftAVX512::CalcDistAsymmetricRow));
+  testSearchRangesAndWeights(static_cast<pCalcDistAsymmetricRowP>(xCorrespPixelShiftAVX512::CalcDistAsymmetricRow), static_cast<pCalcDistAsymmetricRowI>(xCorrespPixelShiftAVX512::CalcDistAsymmetricRow));
+  testSpecializedVsGeneric (static_cast<pCalcDistAsymmetricRowP>(xCorrespPixelShiftAVX512::CalcDistAsymmetricRow), static_cast<pCalcDistAsymmetricRowI>(xCorrespPixelShiftAVX512::CalcDistAsymmetricRow), static_cast<pGenShftCompRowP>(xCorrespPixelShiftAVX512::GenShftCompRow), static_cast<pGenShftCompRowI>(xCorrespPixelShiftAVX512::GenShftCompRow));
+  testGenShftCompPic       (static_cast<pGenShftCompRowP       >(xCorrespPixelShiftAVX512::GenShftCompRow       ), static_cast<pGenShftCompRowI       >(xCorrespPixelShiftAVX512::GenShftCompRow       ));
+  testGenShftCompAndCalcDist(static_cast<pGenShftCompRowAndCalcDistP>(xCorrespPixelShiftAVX512::GenShftCompRowAndCalcDist), static_cast<pGenShftCompRowAndCalcDistI>(xCorrespPixelShiftAVX512::GenShftCompRowAndCalcDist));
+  testMasked               (static_cast<pCalcDistAsymmetricRowMI>(xCorrespPixelShiftAVX512::CalcDistAsymmetricRowM), static_cast<pGenShftCompRowMI>(xCorrespPixelShiftAVX512::GenShftCompRowM), static_cast<pGenShftCompRowAndCalcDistMI>(xCorrespPixelShiftAVX512::GenShftCompRowAndCalcDistM));
+  testExactMatch           (static_cast<pCalcDistAsymmetricRowEP>(xCorrespPixelShiftAVX512::CalcDistAsymmetricRow), static_cast<pCalcDistAsymmetricRowEI>(xCorrespPixelShiftAVX512::CalcDistAsymmetricRow));
+}
+#endif //X_SIMD_CAN_USE_AVX512
+
 #if X_SIMD_CAN_USE_NEON
 TEST_CASE("xCorrespPixelShiftNEON")
 {
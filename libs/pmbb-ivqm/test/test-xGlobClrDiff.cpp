@@ -86,6 +86,17 @@ void testGlobClrDiff()
         GCD = xGlobClrDiff::CalcGlobalColorDiff(Ref, Mod, { 1.0f, 1.0f, 1.0f, 1.0f }, nullptr);
         CHECK(GCD == int32V4(-4, -3, -2, 0));
 
+        //from precalculated difference statistics
+        xDiffStats DiffStats;
+        DiffStats.calcPicDiffStats(Mod, Ref);
+        CHECK(DiffStats.getExactCmps() == boolV4(false, false, false, false));
+        GCD = xGlobClrDiff::CalcGlobalColorDiff(DiffStats.getSumSD(), DiffStats.getArea(), xBitDepth2MaxValue(b), { 1.0f, 1.0f, 1.0f, 1.0f });
+        CHECK(GCD == int32V4(4, 3, 2, 0));
+        GCD = xGlobClrDiff::CalcGlobalColorDiff(-DiffStats.getSumSD(), DiffStats.getArea(), xBitDepth2MaxValue(b), { 1.0f, 1.0f, 1.0f, 1.0f });
+        CHECK(GCD == int32V4(-4, -3, -2, 0));
+        DiffStats.calcPicDiffStats(Ref, Ref);
+        CHECK(DiffStats.getExactCmps() == boolV4(true, true, true, false));
+
         Ref->destroy(); Ref = nullptr;
         Mod->destroy(); Mod = nullptr;
       }
@@ -0,0 +1,125 @@
+/*
+    SPDX-FileCopyrightText: 2019-2025 Jakub Stankowski <jakub.stankowski@put.poznan.pl>
+    SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include "xTestUtils.h"
+#include "xPic.h"
+#include "xIVPSNR.h"
+
+using namespace PMBB_NAMESPACE;
+
+//===============================================================================================================================================================================================================
+
+static const int32V2 c_Size     = { 128, 96 };
+constexpr int32      c_BitDepth = 10;
+constexpr int32      c_Margin   = 8;
+constexpr int32      c_Shift    = 2; //reachable with SearchRange=2, unreachable with SearchRange=1
+
+//Tst is Ref shifted horizontally by c_Shift with +-1 noise
+void fillShiftedPicPair(xPicP* Tst, xPicP* Ref, uint32 State)
+{
+  for(int32 CmpIdx = 0; CmpIdx < xMetricCommon::c_NumComponents; CmpIdx++)
+  {
+    xPerlinNoise::fillPerlinNoiseI(Ref->getAddr((eCmp)CmpIdx), Ref->getStride(), Ref->getWidth(), Ref->getHeight(), Ref->getBitDepth(), 8, State); State = xTestUtils::xXorShift32(State);
+  }
+  Ref->extend();
+
+  for(int32 CmpIdx = 0; CmpIdx < xMetricCommon::c_NumComponents; CmpIdx++)
+  {
+    const uint16* RefPtr = Ref->getAddr((eCmp)CmpIdx);
+    uint16*       TstPtr = Tst->getAddr((eCmp)CmpIdx);
+    for(int32 y = 0; y < Tst->getHeight(); y++)
+    {
+      for(int32 x = 0; x < Tst->getWidth(); x++)
+      {
+        State = xTestUtils::xXorShift32(State);
+        const int32 Noise = (int32)(State % 3) - 1;
+        TstPtr[y * Tst->getStride() + x] = (uint16)xClipU<int32>(RefPtr[y * Ref->getStride() + x + c_Shift] + Noise, Tst->getMaxPelValue());
+      }
+    }
+  }
+  Tst->extend();
+}
+
+flt64 calcIVPSNR(const xPicP* Tst, const xPicP* Ref, int32 SearchRange, int32 ApproxRowStep, int32 ApproxSearchRange, int32 ApproxCheckStep, flt64* Deviation = nullptr)
+{
+  xIVPSNR IVPSNR;
+  IVPSNR.setSearchRange(SearchRange);
+  IVPSNR.setApproxMode (ApproxRowStep, ApproxSearchRange, ApproxCheckStep);
+  IVPSNR.createThrdPoolIntf(nullptr, Ref->getHeight());
+  IVPSNR.initRowBuffers(Ref->getHeight());
+  flt64 Result = IVPSNR.calcPicIVPSNR(Tst, Ref, xMakeVec4<int32>(0));
+  if(Deviation) { *Deviation = IVPSNR.getLastApproxDeviation(); }
+  IVPSNR.destroyThrdPoolIntf();
+  return Result;
+}
+
+//===============================================================================================================================================================================================================
+
+TEST_CASE("xIVPSNR_Approx")
+{
+  xPicP Tst(c_Size, c_BitDepth, c_Margin);
+  xPicP Ref(c_Size, c_BitDepth, c_Margin);
+  fillShiftedPicPair(&Tst, &Ref, xTestUtils::c_XorShiftSeed);
+
+  const flt64 Exact   = calcIVPSNR(&Tst, &Ref, 2, 1, 0, xIVPSNR::c_DefaultApproxCheckStep);
+  const flt64 Reduced = calcIVPSNR(&Tst, &Ref, 1, 1, 0, xIVPSNR::c_DefaultApproxCheckStep);
+  REQUIRE(Reduced < Exact - 1.0); //shift can be compensated with full search range only
+
+  SUBCASE("ReducedSearchRange_CheckAllRows")
+  {
+    //every row is check row --> approximate value and deviation are known exactly
+    flt64 Deviation = 0;
+    const flt64 Approx = calcIVPSNR(&Tst, &Ref, 2, 1, 1, 1, &Deviation);
+    CHECK(xIsApproximatelyEqual(Approx   , Reduced        , 1e-9));
+    CHECK(xIsApproximatelyEqual(Deviation, Reduced - Exact, 1e-9));
+    CHECK(Deviation < 0);
+  }
+
+  SUBCASE("RowStepOnly")
+  {
+    //every row belongs to check band --> approximate and exact metric of check bands are the ones of whole picture
+    flt64 Deviation = 0;
+    const flt64 Approx = calcIVPSNR(&Tst, &Ref, 2, 4, 0, 1, &Deviation);
+    CHECK(xAbs(Approx - Exact) < 0.1);
+    CHECK(Deviation != 0); //row sampling error is measured even with full search range
+    CHECK(xIsApproximatelyEqual(Deviation, Approx - Exact, 1e-9));
+  }
+
+  SUBCASE("RowStepOnly_DefaultCheckStep")
+  {
+    //single check band in test picture --> deviation is nonzero but only roughly estimates (Approx - Exact)
+    flt64 Deviation = 0;
+    const flt64 Approx = calcIVPSNR(&Tst, &Ref, 2, 4, 0, xIVPSNR::c_DefaultApproxCheckStep, &Deviation);
+    CHECK(xAbs(Approx - Exact) < 0.1);
+    CHECK(Deviation != 0);
+  }
+
+  SUBCASE("RowStepAndReducedSearchRange")
+  {
+    //every row belongs to check band --> deviation equals (Approx - Exact)
+    flt64 Deviation = 0;
+    const flt64 Approx = calcIVPSNR(&Tst, &Ref, 2, 4, 1, 1, &Deviation);
+    CHECK(xAbs(Approx - Reduced) < 0.1);
+    CHECK(xIsApproximatelyEqual(Deviation, Approx - Exact, 1e-9));
+  }
+
+  SUBCASE("RowStepAndReducedSearchRange_DefaultCheckStep")
+  {
+    //single check band in test picture --> deviation roughly estimates (Approx - Exact)
+    flt64 Deviation = 0;
+    const flt64 Approx = calcIVPSNR(&Tst, &Ref, 2, 4, 1, xIVPSNR::c_DefaultApproxCheckStep, &Deviation);
+    CHECK(xAbs(Approx - Reduced) < 0.1);
+    CHECK(Deviation < 0);
+    CHECK(xAbs(Deviation - (Approx - Exact)) < 0.5 * xAbs(Approx - Exact));
+  }
+}
+
+//===============================================================================================================================================================================================================
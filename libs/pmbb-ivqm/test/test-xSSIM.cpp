@@ -12,18 +12,30 @@
 #include <functional>
 #include <utility>
 #include <array>
+#include <tuple>
 #include "xTestUtils.h"
+#include "xTimeUtils.h"
 #include "xMemory.h"
+#include "xPixelOps.h"
 #include "xSSIM.h"
+#include "xIVSSIM.h"
 
 using namespace PMBB_NAMESPACE;
 
+static constexpr flt64 c_ToleranceSeparable_Averaged = 0.0000000001; //exact integer moments, differences come from final SSIM expression only
+static constexpr flt64 c_ToleranceSeparable_GaussFlt = 0.0000001;    //flt64 separable kernel vs 2D flt32 coefficients
+static constexpr flt64 c_ToleranceSeparable_GaussInt = 0.00001;      //flt64 separable kernel vs 2D int16 coefficients
+static constexpr flt64 c_ToleranceMaskFlat            = 0.0000000001; //flat non-masked content, differences come from rounding of moments only
+
 //===============================================================================================================================================================================================================
 
 class xSSIM_Test : public xSSIM
 {
 public:
   static int32 calcNumBlocks(int32 Length, int32 BlockSize, int32 BlockStride) { return xCalcNumBlocks(Length, BlockSize, BlockStride); }
+  static void  downsamplePic    (xPicP* Dst, const xPicP* Src) { xDownsamplePic(Dst, Src); }
+  void         downsamplePicPair(xPicP* DstT, xPicP* DstR, const xPicP* SrcT, const xPicP* SrcR) { xDownsamplePicPair(DstT, DstR, SrcT, SrcR); }
+  flt64V4      calcPicSSIM      (const xPicP* Tst, const xPicP* Ref, bool CalcL) { return xCalcPicSSIM(Tst, Ref, CalcL); }
 };
 
 void testCalcNumBlocks()
@@ -76,6 +88,457 @@ void testCalcNumPoints()
   }
 }
 
+void fillPicPair(xPicP* Tst, xPicP* Ref, bool Gradient, uint32& State)
+{
+  for(int32 CmpIdx = 0; CmpIdx < xMetricCommon::c_NumComponents; CmpIdx++)
+  {
+    uint16* T = Tst->getAddr((eCmp)CmpIdx);
+    uint16* R = Ref->getAddr((eCmp)CmpIdx);
+    if(Gradient)
+    {
+      xTestUtils::fillGradientXY(R, Ref->getStride(), Ref->getWidth(), Ref->getHeight(), Ref->getBitDepth(), 0         );
+      xTestUtils::fillGradientXY(T, Tst->getStride(), Tst->getWidth(), Tst->getHeight(), Tst->getBitDepth(), CmpIdx + 1);
+    }
+    else
+    {
+      State = xTestUtils::fillRandom  (R, Ref->getStride(), Ref->getWidth(), Ref->getHeight(), Ref->getBitDepth(),    State);
+      State = xTestUtils::fillMidNoise(T, Tst->getStride(), Tst->getWidth(), Tst->getHeight(), Tst->getBitDepth(), 0, State);
+    }
+  }
+}
+
+//P0/P1 - random pair, P2/P3 - gradient pair (like shift compensated pictures in IV-SSIM), P4 - random binary mask
+using tPics = std::array<xPicP, 5>;
+
+void fillTestPics(tPics& P, eMrgExt MrgExt, uint32& State)
+{
+  fillPicPair(&P[0], &P[1], false, State);
+  fillPicPair(&P[2], &P[3], true , State);
+  P[4].fill(0);
+  State = xTestUtils::fillRandom01(P[4].getAddr(eCmp::LM), P[4].getStride(), P[4].getWidth(), P[4].getHeight(), State);
+  if(MrgExt != eMrgExt::None) { for(xPicP& Pic : P) { Pic.extend(MrgExt); } }
+}
+
+void appendCmps(std::vector<flt64>& Results, const flt64V4& SSIMs)
+{
+  for(int32 CmpIdx = 0; CmpIdx < xMetricCommon::c_NumComponents; CmpIdx++) { Results.push_back(SSIMs[CmpIdx]); }
+}
+
+class xTestCfg
+{
+public:
+  xSSIM::eMode Mode;
+  int32        WndSize;
+  int32        WndStride;
+  eMrgExt      MrgExt     = eMrgExt::None;
+  int32        BitDepth   = 10;
+  flt64        Tolerance  = 0; //0 --> bit-exact
+  bool         EnableMS   = false;
+  int32        NumFrames  = 1;
+  int32        NumThreads = 0;
+  int32V2      Size       = { 203, 117 };
+};
+
+template<class tSSIM> using tConfigureFun = std::function<void(tSSIM& SSIM, bool Tested)>;
+template<class tSSIM> using tCalcFun      = std::function<std::vector<flt64>(tSSIM& SSIM, tPics& P, bool Tested)>;
+
+//evaluates the same set of metrics with reference and tested configuration - tested one twice (second pass may use cached data)
+template<class tSSIM> void testVsReference(const xTestCfg& Cfg, const tConfigureFun<tSSIM>& Configure, const tCalcFun<tSSIM>& Calc)
+{
+  constexpr int32 Margin = 8;
+
+  uint32 State = xTestUtils::c_XorShiftSeed;
+  tPics P = { xPicP(Cfg.Size, Cfg.BitDepth, Margin), xPicP(Cfg.Size, Cfg.BitDepth, Margin), xPicP(Cfg.Size, Cfg.BitDepth, Margin), xPicP(Cfg.Size, Cfg.BitDepth, Margin), xPicP(Cfg.Size, Cfg.BitDepth, Margin) };
+  fillTestPics(P, Cfg.MrgExt, State);
+
+  xThreadPool ThreadPool;
+  if(Cfg.NumThreads > 0) { ThreadPool.create(Cfg.NumThreads, Cfg.Size.getY()); }
+
+  tSSIM SSIM;
+  SSIM.create(Cfg.Size, Cfg.BitDepth, Margin, Cfg.EnableMS);
+  SSIM.setStructSimParams(Cfg.Mode, Cfg.MrgExt, Cfg.WndSize, Cfg.WndStride);
+  SSIM.createThrdPoolIntf(Cfg.NumThreads > 0 ? &ThreadPool : nullptr, Cfg.Size.getY());
+
+  for(int32 Frame = 0; Frame < Cfg.NumFrames; Frame++)
+  {
+    CAPTURE(fmt::format("Mode={} WndSize={} WndStride={} MrgExt={} BitDepth={} NumThreads={} Frame={}", xSSIM::xModeToStr(Cfg.Mode), Cfg.WndSize, Cfg.WndStride, (int32)Cfg.MrgExt, Cfg.BitDepth, Cfg.NumThreads, Frame));
+    if(Frame > 0) //new frame - content of pictures changes
+    {
+      fillPicPair(&P[0], &P[3], false, State);
+      if(Cfg.MrgExt != eMrgExt::None) { P[0].extend(Cfg.MrgExt); P[3].extend(Cfg.MrgExt); }
+    }
+
+    Configure(SSIM, false); std::vector<flt64> A = Calc(SSIM, P, false);
+    Configure(SSIM, true ); std::vector<flt64> B = Calc(SSIM, P, true ); std::vector<flt64> C = Calc(SSIM, P, true);
+    REQUIRE(A.size() == B.size());
+    for(int32 i = 0; i < (int32)A.size(); i++)
+    {
+      if(Cfg.Tolerance == 0) { CHECK(A[i] == B[i]); CHECK(A[i] == C[i]); }
+      else                   { CHECK(xIsApproximatelyEqual(A[i], B[i], Cfg.Tolerance)); CHECK(xIsApproximatelyEqual(A[i], C[i], Cfg.Tolerance)); }
+    }
+  }
+
+  SSIM.destroyThrdPoolIntf();
+  SSIM.destroy();
+  if(Cfg.NumThreads > 0) { ThreadPool.destroy(); }
+}
+
+//SSIM (and MS-SSIM if enabled) of both picture pairs
+std::vector<flt64> calcPairsSSIM(xSSIM& SSIM, tPics& P, bool CalcMS)
+{
+  std::vector<flt64> Results;
+  appendCmps(Results, SSIM.calcPicSSIM(&P[0], &P[1]));
+  appendCmps(Results, SSIM.calcPicSSIM(&P[2], &P[3]));
+  if(CalcMS)
+  {
+    appendCmps(Results, SSIM.calcPicMSSSIM(&P[0], &P[1]));
+    appendCmps(Results, SSIM.calcPicMSSSIM(&P[2], &P[3]));
+  }
+  return Results;
+}
+
+//===============================================================================================================================================================================================================
+
+void testSeparable(xSSIM::eMode Mode, flt64 Tolerance)
+{
+  for(const eMrgExt MrgExt : { eMrgExt::None, eMrgExt::Nearest })
+  {
+    for(const int32 BitDepth : { 8, 10, 14 })
+    {
+      testVsReference<xSSIM>({ Mode, xStructSimConsts::c_FilterSize, 1, MrgExt, BitDepth, Tolerance },
+        [](xSSIM& SSIM, bool Tested) { SSIM.setUseSeparable(Tested); CHECK(SSIM.isSeparableActive() == Tested); },
+        [](xSSIM& SSIM, tPics& P, bool) { return calcPairsSSIM(SSIM, P, false); });
+    }
+  }
+}
+
+void testFlt32(xSSIM::eMode Mode, int32 WndSize, int32 WndStride, flt64 Tolerance)
+{
+  for(const eMrgExt MrgExt : { eMrgExt::None, eMrgExt::Nearest })
+  {
+    if(!xSSIM::isRegularMode(Mode) && MrgExt != eMrgExt::None) { continue; }
+    for(const int32 BitDepth : { 8, 10, 14 })
+    {
+      testVsReference<xSSIM>({ Mode, WndSize, WndStride, MrgExt, BitDepth, Tolerance, true },
+        [](xSSIM& SSIM, bool Tested) { SSIM.setUseSeparable(true); SSIM.setUseFlt32(Tested); CHECK(SSIM.isFlt32Active() == Tested); },
+        [](xSSIM& SSIM, tPics& P, bool) { return calcPairsSSIM(SSIM, P, true); });
+    }
+  }
+}
+
+void testSubBlock(int32 WndSize, int32 WndStride)
+{
+  for(const int32 BitDepth : { 8, 10, 14 })
+  {
+    testVsReference<xSSIM>({ xSSIM::eMode::BlockAveraged, WndSize, WndStride, eMrgExt::None, BitDepth, 0, true },
+      [](xSSIM& SSIM, bool Tested) { SSIM.setUseSubBlock(Tested); CHECK(SSIM.isSubBlockActive() == Tested); },
+      [](xSSIM& SSIM, tPics& P, bool) { return calcPairsSSIM(SSIM, P, true); });
+  }
+}
+
+void testMomentCache(xSSIM::eMode Mode, int32 WndSize, int32 WndStride, eMrgExt MrgExt)
+{
+  testVsReference<xSSIM>({ Mode, WndSize, WndStride, MrgExt, 10, 0, true, 2 },
+    [](xSSIM& SSIM, bool Tested) { SSIM.setUseSeparable(true); SSIM.setUseMomentCache(Tested); CHECK((SSIM.isSeparableActive() || SSIM.isSubBlockActive())); }, //enabling cache invalidates it
+    [](xSSIM& SSIM, tPics& P, bool)
+    {
+      std::vector<flt64> Results;
+      appendCmps(Results, SSIM.calcPicSSIM  (&P[0], &P[1]));
+      appendCmps(Results, SSIM.calcPicMSSSIM(&P[0], &P[1]));
+      appendCmps(Results, SSIM.calcPicSSIM  (&P[0], &P[3]));
+      appendCmps(Results, SSIM.calcPicSSIM  (&P[1], &P[2]));
+      appendCmps(Results, SSIM.calcPicMSSSIM(&P[0], &P[3]));
+      appendCmps(Results, SSIM.calcPicSSIM  (&P[1], &P[1]));
+      return Results;
+    });
+}
+
+//same engine setup and call sequence as QMIV with SSIM and IVSSIM metrics enabled
+void testMomentCacheAppCfg(xSSIM::eMode Mode, int32 WndSize, int32 WndStride, bool UseSeparable, bool UseFlt32, bool ExpectUsable)
+{
+  const int32V2 Size     = { 203, 117 };
+  const int32   Margin   = 8;
+  const int32   BitDepth = 10;
+
+  uint32 State = xTestUtils::c_XorShiftSeed;
+
+  //P0/P1 - source pair, P2/P3 - shift compensated pictures
+  std::array<xPicP, 4> P = { xPicP(Size, BitDepth, Margin), xPicP(Size, BitDepth, Margin), xPicP(Size, BitDepth, Margin), xPicP(Size, BitDepth, Margin) };
+  fillPicPair(&P[0], &P[1], false, State);
+  fillPicPair(&P[2], &P[3], true , State);
+
+  xIVSSIM IVSSIM;
+  IVSSIM.create(Size, BitDepth, Margin, false);
+  IVSSIM.setStructSimParams(Mode, eMrgExt::None, WndSize, WndStride);
+  IVSSIM.setUseSeparable(UseSeparable);
+  IVSSIM.setUseFlt32(UseFlt32);
+  IVSSIM.setUseMomentCache(IVSSIM.isMomentCacheUsable());
+  IVSSIM.createThrdPoolIntf(nullptr, Size.getY());
+
+  CAPTURE(fmt::format("Mode={} WndSize={} WndStride={} UseSeparable={} UseFlt32={}", xSSIM::xModeToStr(Mode), WndSize, WndStride, UseSeparable, UseFlt32));
+  CHECK(IVSSIM.isMomentCacheUsable() == ExpectUsable);
+
+  IVSSIM.invalidateMomentCache(); //new frame
+  IVSSIM.calcPicSSIM  (&P[0], &P[1]);
+  IVSSIM.calcPicIVSSIM(&P[0], &P[1], &P[2], &P[3]);
+  if(ExpectUsable) { CHECK(IVSSIM.getNumMomentCacheHits() == 2 * xMetricCommon::c_NumComponents); } //Tst and Ref statistics reused by IVSSIM
+  else             { CHECK(IVSSIM.getNumMomentCacheHits() == 0); }
+
+  IVSSIM.destroyThrdPoolIntf();
+  IVSSIM.destroy();
+}
+
+
+void testMaskPartial(xSSIM::eMode Mode, eMrgExt MrgExt)
+{
+  //non-masked samples are flat (Tst=ValT, Ref=ValR) and masked ones stay random --> within every evaluated window contrast-structure term is 1 and SSIM equals luminance term of ValT and ValR
+  //catches masked samples leaking into moments as well as normalization by full window instead of sum of non-masked weights
+  constexpr int32 BitDepth = 10;
+  constexpr flt64 ValT     = 300;
+  constexpr flt64 ValR     = 340;
+
+  testVsReference<xSSIM>({ Mode, xStructSimConsts::c_FilterSize, 1, MrgExt, BitDepth, c_ToleranceMaskFlat },
+    [ ](xSSIM&, bool) {},
+    [&](xSSIM& SSIM, tPics& P, bool Tested)
+    {
+      std::vector<flt64> Results;
+      if(!Tested)
+      {
+        const flt64 C1 = xPow2(xStructSimConsts::c_K1<flt64> * (flt64)xBitDepth2MaxValue(BitDepth));
+        const flt64 L  = (2 * ValT * ValR + C1) / (xPow2(ValT) + xPow2(ValR) + C1);
+        appendCmps(Results, xMakeVec4<flt64>(L));
+        return Results;
+      }
+
+      for(int32 CmpIdx = 0; CmpIdx < xMetricCommon::c_NumComponents; CmpIdx++)
+      {
+        for(int32 y = 0; y < P[4].getHeight(); y++)
+        {
+          for(int32 x = 0; x < P[4].getWidth(); x++)
+          {
+            if(P[4].accessPel({ x, y }, eCmp::LM) == 0) { continue; }
+            P[0].accessPel({ x, y }, (eCmp)CmpIdx) = (uint16)ValT;
+            P[1].accessPel({ x, y }, (eCmp)CmpIdx) = (uint16)ValR;
+          }
+        }
+      }
+      if(MrgExt != eMrgExt::None) { P[0].extend(MrgExt); P[1].extend(MrgExt); }
+
+      appendCmps(Results, SSIM.calcPicSSIMM(&P[0], &P[1], &P[4]));
+      return Results;
+    });
+}
+
+void testMaskNumNonMasked(xSSIM::eMode Mode, eMrgExt MrgExt)
+{
+  //reference - number of non-masked pixels counted internally, tested - provided by caller (doubled count has to halve the result)
+  testVsReference<xIVSSIM>({ Mode, xStructSimConsts::c_FilterSize, 1, MrgExt },
+    [ ](xIVSSIM&, bool) {},
+    [&](xIVSSIM& IVSSIM, tPics& P, bool Tested)
+    {
+      const int32 Rng          = MrgExt == eMrgExt::None ? xStructSimConsts::c_FilterRange : 0; //without margin extension only windows fully inside picture are evaluated
+      const int32 NumNonMasked = xPixelOps::CountNonZero(P[4].getAddr(eCmp::LM) + Rng * P[4].getStride() + Rng, P[4].getStride(), P[4].getWidth() - 2 * Rng, P[4].getHeight() - 2 * Rng);
+
+      std::vector<flt64> Results;
+      if(Tested)
+      {
+        appendCmps(Results, IVSSIM.calcPicSSIMM(&P[0], &P[1], &P[4], NumNonMasked));
+        appendCmps(Results, IVSSIM.calcPicSSIMM(&P[0], &P[1], &P[4], 2 * NumNonMasked));
+        Results.push_back(IVSSIM.calcPicIVSSIMM(&P[0], &P[1], &P[2], &P[3], &P[4], 2 * NumNonMasked));
+      }
+      else
+      {
+        const flt64V4 SSIM = IVSSIM.calcPicSSIMM(&P[0], &P[1], &P[4]);
+        appendCmps(Results, SSIM);
+        appendCmps(Results, SSIM * 0.5);
+        Results.push_back(IVSSIM.calcPicIVSSIMM(&P[0], &P[1], &P[2], &P[3], &P[4]) * 0.5);
+      }
+      return Results;
+    });
+}
+
+void testIVSSIMBatched(xSSIM::eMode Mode, int32 WndSize, int32 WndStride, bool UseMomentCache)
+{
+  const int32V4 CmpWghts = { 4, 1, 1, 0 };
+
+  //reference - IV-SSIM composed from SSIM of both directions, tested - batched IV-SSIM
+  testVsReference<xIVSSIM>({ Mode, WndSize, WndStride },
+    [&](xIVSSIM& IVSSIM, bool Tested) { IVSSIM.setUseSeparable(true); IVSSIM.setUseMomentCache(Tested && UseMomentCache); IVSSIM.setCmpWeightsAverage(CmpWghts); },
+    [&](xIVSSIM& IVSSIM, tPics& P, bool Tested)
+    {
+      auto CalcCmpAvg = [&](const flt64V4& SSIMs) { return (SSIMs * (flt64V4)CmpWghts).getSum() * (1.0 / (flt64)CmpWghts.getSum()); }; //same expression as xIVSSIM
+      const bool  CalcMsk = xSSIM::isRegularMode(Mode) && WndStride == 1;
+      const xPicP* Msk    = &P[4];
+
+      std::vector<flt64> Results;
+      //Tst, Ref, TstSCP, RefSCP - second set shares picture between directions
+      for(const std::array<int32, 4>& Idx : { std::array<int32, 4>{ 0, 1, 2, 3 }, std::array<int32, 4>{ 0, 0, 2, 3 } })
+      {
+        const xPicP* Tst = &P[Idx[0]]; const xPicP* Ref = &P[Idx[1]]; const xPicP* TstSCP = &P[Idx[2]]; const xPicP* RefSCP = &P[Idx[3]];
+        if(Tested)
+        {
+          IVSSIM.invalidateMomentCache();
+          Results.push_back(IVSSIM.calcPicIVSSIM(Tst, Ref, TstSCP, RefSCP));
+          if(CalcMsk) { Results.push_back(IVSSIM.calcPicIVSSIMM(Tst, Ref, TstSCP, RefSCP, Msk)); }
+        }
+        else
+        {
+          Results.push_back(xMin(CalcCmpAvg(IVSSIM.calcPicSSIM(Tst, RefSCP)), CalcCmpAvg(IVSSIM.calcPicSSIM(Ref, TstSCP))));
+          if(CalcMsk) { Results.push_back(xMin(CalcCmpAvg(IVSSIM.calcPicSSIMM(Tst, RefSCP, Msk)), CalcCmpAvg(IVSSIM.calcPicSSIMM(Ref, TstSCP, Msk)))); }
+        }
+      }
+      return Results;
+    });
+}
+
+void testMaskAllOnes(xSSIM::eMode Mode, eMrgExt MrgExt)
+{
+  for(const bool UseSeparable : { false, true })
+  {
+    //masked path always uses window kernels (CalcRglr*M accumulate flt32 gaussian coefficients in flt64) - unmasked engines differ by rounding only
+    testVsReference<xSSIM>({ Mode, xStructSimConsts::c_FilterSize, 1, MrgExt, 10, c_ToleranceSeparable_GaussFlt },
+      [&](xSSIM& SSIM, bool) { SSIM.setUseSeparable(UseSeparable); },
+      [ ](xSSIM& SSIM, tPics& P, bool Tested)
+      {
+        P[4].fill(1);
+        std::vector<flt64> Results;
+        appendCmps(Results, Tested ? SSIM.calcPicSSIMM(&P[0], &P[1], &P[4]) : SSIM.calcPicSSIM(&P[0], &P[1]));
+        return Results;
+      });
+  }
+}
+
+void testDownsamplePicPair(int32 NumThreads)
+{
+  const int32V2 Size     = { 203, 117 };
+  const int32   Margin   = 8;
+  const int32   BitDepth = 10;
+
+  uint32 State = xTestUtils::c_XorShiftSeed;
+  xPicP SrcT(Size     , BitDepth, Margin), SrcR(Size     , BitDepth, Margin);
+  xPicP DstT(Size >> 1, BitDepth, Margin), DstR(Size >> 1, BitDepth, Margin);
+  xPicP RefT(Size >> 1, BitDepth, Margin), RefR(Size >> 1, BitDepth, Margin);
+  fillPicPair(&SrcT, &SrcR, false, State);
+
+  xThreadPool ThreadPool;
+  if(NumThreads > 0) { ThreadPool.create(NumThreads, Size.getY()); }
+
+  xSSIM_Test SSIM;
+  SSIM.create(Size, BitDepth, Margin, true);
+  SSIM.setStructSimParams(xSSIM::eMode::RegularGaussianFlt, eMrgExt::None, xStructSimConsts::c_FilterSize, 1);
+  SSIM.createThrdPoolIntf(NumThreads > 0 ? &ThreadPool : nullptr, Size.getY());
+
+  xSSIM_Test::downsamplePic(&RefT, &SrcT);
+  xSSIM_Test::downsamplePic(&RefR, &SrcR);
+  SSIM.downsamplePicPair(&DstT, &DstR, &SrcT, &SrcR);
+  for(int32 CmpIdx = 0; CmpIdx < xMetricCommon::c_NumComponents; CmpIdx++)
+  {
+    CAPTURE(fmt::format("NumThreads={} CmpIdx={}", NumThreads, CmpIdx));
+    CHECK(xTestUtils::isSameBuffer(RefT.getAddr((eCmp)CmpIdx), RefT.getStride(), DstT.getAddr((eCmp)CmpIdx), DstT.getStride(), DstT.getWidth(), DstT.getHeight()));
+    CHECK(xTestUtils::isSameBuffer(RefR.getAddr((eCmp)CmpIdx), RefR.getStride(), DstR.getAddr((eCmp)CmpIdx), DstR.getStride(), DstR.getWidth(), DstR.getHeight()));
+  }
+
+  SSIM.destroyThrdPoolIntf();
+  SSIM.destroy();
+  if(NumThreads > 0) { ThreadPool.destroy(); }
+}
+
+
+void testPyramidCache(xSSIM::eMode Mode, int32 WndSize, int32 WndStride, eMrgExt MrgExt)
+{
+  const int32V2 Size     = { 403, 217 };
+  const int32   Margin   = 8;
+  const int32   BitDepth = 10;
+
+  xStructSimPyramidCache PyramidCache;
+  PyramidCache.create(Size, BitDepth, Margin, xSSIM::xCalcNumScales(Size));
+
+  testVsReference<xIVSSIM>({ Mode, WndSize, WndStride, MrgExt, BitDepth, 0, true, 2, 0, Size },
+    [&](xIVSSIM& IVSSIM, bool Tested) { PyramidCache.invalidate(); IVSSIM.setPyramidCache(Tested ? &PyramidCache : nullptr); },
+    [ ](xIVSSIM& IVSSIM, tPics& P, bool)
+    {
+      std::vector<flt64> Results;
+      appendCmps(Results, IVSSIM.calcPicMSSSIM(&P[0], &P[1]));
+      Results.push_back(IVSSIM.calcPicIVMSSSIM(&P[0], &P[1], &P[2], &P[3]));
+      appendCmps(Results, IVSSIM.calcPicMSSSIM(&P[1], &P[1]));
+      return Results;
+    });
+
+  PyramidCache.destroy();
+}
+
+void testMultiScaleBatched(xSSIM::eMode Mode, int32 WndSize, int32 WndStride, bool UseSeparable, int32 NumThreads)
+{
+  const int32V2 Size     = { 331, 197 };
+  const int32   Margin   = 8;
+  const int32   BitDepth = 10;
+
+  //reference - scales evaluated one by one, tested - all scales evaluated as single batch
+  testVsReference<xSSIM_Test>({ Mode, WndSize, WndStride, eMrgExt::None, BitDepth, 0, true, 1, NumThreads, Size },
+    [&](xSSIM_Test& SSIM, bool) { SSIM.setUseSeparable(UseSeparable); },
+    [&](xSSIM_Test& SSIM, tPics& P, bool Tested)
+    {
+      std::vector<flt64> Results;
+      if(Tested) { appendCmps(Results, SSIM.calcPicMSSSIM(&P[2], &P[3])); return Results; }
+
+      const int32 NumScales = xSSIM::xCalcNumScales(Size);
+      std::vector<xPicP*> ScaleTst = { &P[2] };
+      std::vector<xPicP*> ScaleRef = { &P[3] };
+      for(int32 i = 1; i < NumScales; i++)
+      {
+        ScaleTst.push_back(new xPicP(ScaleTst.back()->getSize() >> 1, BitDepth, Margin)); xSSIM_Test::downsamplePic(ScaleTst.back(), ScaleTst[i-1]);
+        ScaleRef.push_back(new xPicP(ScaleRef.back()->getSize() >> 1, BitDepth, Margin)); xSSIM_Test::downsamplePic(ScaleRef.back(), ScaleRef[i-1]);
+      }
+      const std::array<flt64, xStructSimConsts::c_NumMultiScales> Exponents = xStructSimConsts::c_MultiScaleExponentWeights<flt64>[NumScales - 1];
+      flt64V4 Expected = xMakeVec4<flt64>(1);
+      for(int32 i = 0; i < NumScales; i++) { Expected *= SSIM.calcPicSSIM(ScaleTst[i], ScaleRef[i], i == NumScales - 1).getVecReLU().getVecPow1(Exponents[i]); }
+      for(int32 i = 1; i < NumScales; i++) { ScaleTst[i]->destroy(); delete ScaleTst[i]; ScaleRef[i]->destroy(); delete ScaleRef[i]; }
+
+      appendCmps(Results, Expected);
+      return Results;
+    });
+}
+
+//1080p benchmark - per-frame pattern of QMIV with SSIM + IV-SSIM + scale 0 of MS-SSIM and IV-MS-SSIM
+flt64 testSSIMPerf(xSSIM::eMode Mode, int32 WndSize, int32 WndStride, const tConfigureFun<xSSIM>& Configure, bool Tested)
+{
+  const int32V2 Size       = { 1920, 1080 };
+  const int32   Margin     = 32;
+  const int32   BitDepth   = 10;
+  const int32   NumRepeats = 4;
+
+  uint32 State = xTestUtils::c_XorShiftSeed;
+  std::array<xPicP, 4> P = { xPicP(Size, BitDepth, Margin), xPicP(Size, BitDepth, Margin), xPicP(Size, BitDepth, Margin), xPicP(Size, BitDepth, Margin) };
+  fillPicPair(&P[0], &P[1], false, State);
+  fillPicPair(&P[2], &P[3], false, State);
+
+  xSSIM SSIM;
+  SSIM.create(Size, BitDepth, Margin, false);
+  SSIM.setStructSimParams(Mode, eMrgExt::None, WndSize, WndStride);
+  Configure(SSIM, Tested);
+  SSIM.createThrdPoolIntf(nullptr, Size.getY());
+
+  flt64V4 Acc = xMakeVec4<flt64>(0);
+  tTimePoint T0 = tClock::now();
+  for(int32 r = 0; r < NumRepeats; r++)
+  {
+    SSIM.invalidateMomentCache();
+    Acc += SSIM.calcPicSSIM(&P[0], &P[1]);
+    Acc += SSIM.calcPicSSIM(&P[0], &P[1]);
+    Acc += SSIM.calcPicSSIM(&P[0], &P[3]);
+    Acc += SSIM.calcPicSSIM(&P[1], &P[2]);
+    Acc += SSIM.calcPicSSIM(&P[0], &P[3]);
+    Acc += SSIM.calcPicSSIM(&P[1], &P[2]);
+  }
+  tTimePoint T1 = tClock::now();
+  CHECK(std::isfinite(Acc.getSum()));
+
+  SSIM.destroyThrdPoolIntf();
+  SSIM.destroy();
+
+  return std::chrono::duration_cast<tDurationS>(T1 - T0).count();
+}
+
 //===============================================================================================================================================================================================================
 
 TEST_CASE("xCalcNumBlocks")
@@ -87,3 +550,153 @@ TEST_CASE("testCalcNumPoints")
 {
   testCalcNumPoints();
 }
+
+TEST_CASE("xSSIM_Separable")
+{
+  testSeparable(xSSIM::eMode::RegularGaussianFlt, c_ToleranceSeparable_GaussFlt);
+  testSeparable(xSSIM::eMode::RegularGaussianInt, c_ToleranceSeparable_GaussInt);
+  testSeparable(xSSIM::eMode::RegularAveraged   , c_ToleranceSeparable_Averaged);
+}
+
+TEST_CASE("xSSIM_SubBlock")
+{
+  //high overlap or no multi-block kernel - sub-block engine is selected regardless of ISA
+  for(const int32V2 WndSizeStride : { int32V2(4, 1), int32V2(6, 2), int32V2(8, 2), int32V2(12, 3), int32V2(12, 4), int32V2(16, 2), int32V2(16, 4), int32V2(32, 4), int32V2(32, 8) })
+  {
+    testSubBlock(WndSizeStride.getX(), WndSizeStride.getY());
+  }
+}
+
+TEST_CASE("xSSIM_MomentCache")
+{
+  for(const eMrgExt MrgExt : { eMrgExt::None, eMrgExt::Nearest })
+  {
+    testMomentCache(xSSIM::eMode::RegularGaussianFlt, xStructSimConsts::c_FilterSize, 1, MrgExt);
+    testMomentCache(xSSIM::eMode::RegularGaussianInt, xStructSimConsts::c_FilterSize, 1, MrgExt);
+    testMomentCache(xSSIM::eMode::RegularAveraged   , xStructSimConsts::c_FilterSize, 1, MrgExt); //not cached - fallback to CalcRngAvg
+  }
+  testMomentCache(xSSIM::eMode::BlockAveraged, 16, 4, eMrgExt::None);
+  testMomentCache(xSSIM::eMode::BlockAveraged, 12, 4, eMrgExt::None);
+  testMomentCache(xSSIM::eMode::BlockAveraged,  8, 2, eMrgExt::None);
+}
+
+TEST_CASE("xSSIM_MomentCacheAppCfg")
+{
+  testMomentCacheAppCfg(xSSIM::eMode::RegularGaussianFlt, xStructSimConsts::c_FilterSize, 1, true , false, true ); //separable engine
+  testMomentCacheAppCfg(xSSIM::eMode::RegularGaussianInt, xStructSimConsts::c_FilterSize, 1, true , false, true ); //separable engine
+  testMomentCacheAppCfg(xSSIM::eMode::BlockAveraged     , 16, 4, false, false, true ); //sub-block engine
+  testMomentCacheAppCfg(xSSIM::eMode::RegularGaussianFlt, xStructSimConsts::c_FilterSize, 1, false, false, false); //window engine
+  testMomentCacheAppCfg(xSSIM::eMode::RegularAveraged   , xStructSimConsts::c_FilterSize, 1, true , false, false); //separable engine without statistics kernel
+  testMomentCacheAppCfg(xSSIM::eMode::RegularGaussianFlt, xStructSimConsts::c_FilterSize, 1, true , true , false); //single precision engine
+}
+
+TEST_CASE("xIVSSIM_Batched")
+{
+  for(const bool UseMomentCache : { false, true })
+  {
+    testIVSSIMBatched(xSSIM::eMode::RegularGaussianFlt, xStructSimConsts::c_FilterSize, 1, UseMomentCache);
+    testIVSSIMBatched(xSSIM::eMode::RegularAveraged   , xStructSimConsts::c_FilterSize, 1, UseMomentCache);
+    testIVSSIMBatched(xSSIM::eMode::BlockGaussianInt  ,  8, 4, UseMomentCache);
+    testIVSSIMBatched(xSSIM::eMode::BlockAveraged     ,  8, 4, UseMomentCache); //multi-block kernels
+    testIVSSIMBatched(xSSIM::eMode::BlockAveraged     , 16, 4, UseMomentCache); //sub-block engine
+  }
+}
+
+TEST_CASE("xSSIM_MaskAllOnes")
+{
+  //mask covering whole picture --> masked SSIM reduces to unmasked SSIM
+  testMaskAllOnes(xSSIM::eMode::RegularGaussianFlt, eMrgExt::None   );
+  testMaskAllOnes(xSSIM::eMode::RegularGaussianFlt, eMrgExt::Nearest);
+}
+
+TEST_CASE("xSSIM_MaskPartial")
+{
+  for(const eMrgExt MrgExt : { eMrgExt::None, eMrgExt::Nearest })
+  {
+    testMaskPartial(xSSIM::eMode::RegularGaussianFlt, MrgExt);
+    testMaskPartial(xSSIM::eMode::RegularGaussianInt, MrgExt);
+    testMaskPartial(xSSIM::eMode::RegularAveraged   , MrgExt);
+  }
+}
+
+TEST_CASE("xSSIM_MaskNumNonMasked")
+{
+  testMaskNumNonMasked(xSSIM::eMode::RegularGaussianInt, eMrgExt::None   );
+  testMaskNumNonMasked(xSSIM::eMode::RegularGaussianInt, eMrgExt::Nearest);
+}
+
+TEST_CASE("xSSIM_DownsamplePicPair")
+{
+  testDownsamplePicPair(0);
+  testDownsamplePicPair(4);
+}
+
+TEST_CASE("xSSIM_PyramidCache")
+{
+  testPyramidCache(xSSIM::eMode::BlockAveraged     , 8, 4, eMrgExt::None   );
+  testPyramidCache(xSSIM::eMode::RegularGaussianFlt, xStructSimConsts::c_FilterSize, 1, eMrgExt::Nearest);
+}
+
+TEST_CASE("xSSIM_MultiScaleBatched")
+{
+  for(int32 NumThreads : { 0, 4 })
+  {
+    testMultiScaleBatched(xSSIM::eMode::BlockAveraged     , 8, 4, false, NumThreads);
+    testMultiScaleBatched(xSSIM::eMode::BlockAveraged     , 8, 8, false, NumThreads);
+    testMultiScaleBatched(xSSIM::eMode::BlockGaussianInt  , 8, 4, false, NumThreads);
+    testMultiScaleBatched(xSSIM::eMode::RegularGaussianFlt, xStructSimConsts::c_FilterSize, 1, true , NumThreads);
+    testMultiScaleBatched(xSSIM::eMode::RegularAveraged   , xStructSimConsts::c_FilterSize, 1, false, NumThreads);
+  }
+}
+
+TEST_CASE("xSSIM_Flt32")
+{
+  testFlt32(xSSIM::eMode::RegularGaussianFlt, xStructSimConsts::c_FilterSize, 1, xStructSimSeparable::c_TolFlt32);
+  testFlt32(xSSIM::eMode::RegularGaussianInt, xStructSimConsts::c_FilterSize, 1, xStructSimSeparable::c_TolFlt32);
+  testFlt32(xSSIM::eMode::BlockAveraged     , 16, 4, xStructSimSubBlock::c_TolFlt32);
+  testFlt32(xSSIM::eMode::BlockAveraged     , 32, 8, xStructSimSubBlock::c_TolFlt32);
+
+  { //configurations without single precision kernels stay in flt64
+    xSSIM SSIM;
+    SSIM.create({ 64, 64 }, 8, 0, false);
+    SSIM.setUseFlt32(true);
+    SSIM.setStructSimParams(xSSIM::eMode::RegularGaussianFlt, eMrgExt::None, xStructSimConsts::c_FilterSize, 4); CHECK(!SSIM.isFlt32Active());
+    SSIM.setStructSimParams(xSSIM::eMode::RegularAveraged   , eMrgExt::None, xStructSimConsts::c_FilterSize, 1); CHECK(!SSIM.isFlt32Active());
+    SSIM.setStructSimParams(xSSIM::eMode::BlockGaussianInt  , eMrgExt::None, 8, 4); CHECK(!SSIM.isFlt32Active());
+    SSIM.setStructSimParams(xSSIM::eMode::BlockAveraged     , eMrgExt::None, 8, 8); CHECK(!SSIM.isFlt32Active());
+    SSIM.destroy();
+  }
+}
+
+//1080p benchmark of optional engines (reference configuration vs tested one), skipped by default (run with --no-skip)
+TEST_CASE("xSSIM_Perf" * doctest::skip())
+{
+  const tConfigureFun<xSSIM> Separable   = [](xSSIM& SSIM, bool Tested) { SSIM.setUseSeparable(Tested); };
+  const tConfigureFun<xSSIM> SubBlock    = [](xSSIM& SSIM, bool Tested) { SSIM.setUseSubBlock (Tested); };
+  const tConfigureFun<xSSIM> MomentCache = [](xSSIM& SSIM, bool Tested) { SSIM.setUseSeparable(true); SSIM.setUseMomentCache(Tested); };
+  const tConfigureFun<xSSIM> Flt32       = [](xSSIM& SSIM, bool Tested) { SSIM.setUseSeparable(true); SSIM.setUseFlt32      (Tested); };
+
+  constexpr int32 FS = xStructSimConsts::c_FilterSize;
+  const std::vector<std::tuple<std::string, xSSIM::eMode, int32, int32, tConfigureFun<xSSIM>>> Engines =
+  {
+    { "separable"   , xSSIM::eMode::RegularGaussianFlt, FS, 1, Separable   },
+    { "separable"   , xSSIM::eMode::RegularGaussianInt, FS, 1, Separable   },
+    { "separable"   , xSSIM::eMode::RegularAveraged   , FS, 1, Separable   },
+    { "sub-block"   , xSSIM::eMode::BlockAveraged     ,  8, 2, SubBlock    },
+    { "sub-block"   , xSSIM::eMode::BlockAveraged     , 12, 4, SubBlock    },
+    { "sub-block"   , xSSIM::eMode::BlockAveraged     , 16, 4, SubBlock    },
+    { "sub-block"   , xSSIM::eMode::BlockAveraged     , 32, 4, SubBlock    },
+    { "moment cache", xSSIM::eMode::RegularGaussianFlt, FS, 1, MomentCache },
+    { "moment cache", xSSIM::eMode::RegularGaussianInt, FS, 1, MomentCache },
+    { "moment cache", xSSIM::eMode::BlockAveraged     , 16, 4, MomentCache },
+    { "flt32"       , xSSIM::eMode::RegularGaussianFlt, FS, 1, Flt32       },
+    { "flt32"       , xSSIM::eMode::BlockAveraged     , 16, 4, Flt32       },
+  };
+
+  for(const auto& [Name, Mode, WndSize, WndStride, Configure] : Engines)
+  {
+    flt64 TimeR = testSSIMPerf(Mode, WndSize, WndStride, Configure, false);
+    flt64 TimeT = testSSIMPerf(Mode, WndSize, WndStride, Configure, true );
+    fmt::print("TIME(xSSIM {} {}x{} reference) = {}s  TIME(xSSIM {} {}x{} {}) = {}s  SPEEDUP = {:.2f}x\n", xSSIM::xModeToStr(Mode), WndSize, WndStride, TimeR, xSSIM::xModeToStr(Mode), WndSize, WndStride, Name, TimeT, TimeR / TimeT);
+  }
+}
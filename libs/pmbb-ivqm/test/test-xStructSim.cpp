@@ -26,14 +26,17 @@ using namespace PMBB_NAMESPACE;
 //===============================================================================================================================================================================================================
 
 static const std::vector<int32> c_Dimms = { 4, 8, 11, 16, 32 };
+static const std::vector<int32> c_DimmsGaussInt = { 8, 16 };
 static const std::vector<int32> c_BitDs = { 8, 14 };
 static const std::vector<int32> c_Margs = { 0, 4, 32 };
+static const std::vector<int32V2> c_MultiBlckWndStrides = { {4,2}, {4,4}, {8,4}, {8,8}, {11,4}, {11,11}, {16,4}, {16,8}, {16,16}, {32,4}, {32,16}, {32,32} };
 static constexpr int32          c_NumRandomTests = 256;
 static constexpr flt64          c_ToleranceSSIM_Gaussian = 0.00001;
 static constexpr flt64          c_ToleranceSSIM_Averaged = 0.00000001;
 
 //===============================================================================================================================================================================================================
-using fCalcSS = std::function<flt64(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL)>;
+using fCalcSS  = std::function<flt64(const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL)>;
+using fCalcSSM = std::function<flt64(const uint16* Tst, const uint16* Ref, const uint16* Msk, int32 StrideT, int32 StrideR, int32 StrideM, int32 WndSize, flt64 C1, flt64 C2, bool CalcL)>;
 
 void testGaussionCoeffs()
 {
@@ -62,6 +65,16 @@ void testGaussionCoeffs()
     flt64 Sum = Acc.result();
     CHECK(xIsApproximatelyEqual(Sum, 1.0));
   }
+
+  //separable kernel
+  for(int32 y = 0; y < xStructSimConsts::c_FilterSize; y++)
+  {
+    for(int32 x = 0; x < xStructSimConsts::c_FilterSize; x++)
+    {
+      flt64 Outer = xStructSimConsts::c_FilterSprbGaussFlt64[y] * xStructSimConsts::c_FilterSprbGaussFlt64[x];
+      CHECK(xIsApproximatelyEqual(Outer, xStructSimConsts::c_FilterRglrGaussFlt64[y][x], 1e-15));
+    }
+  }
 }
 
 void testCalcRglr(fCalcSS CalcRglrTst, fCalcSS CalcRglrRef, bool CalcL, flt64 Tolerance)
@@ -133,7 +146,138 @@ void testCalcRglr(fCalcSS CalcRglrTst, fCalcSS CalcRglrRef, bool CalcL, flt64 To
     }
   }
 }
-void testCalcBlckAvg(fCalcSS CalcBlckAvg, int32 WndSize, bool CalcL)
+void testCalcRglrM(fCalcSSM CalcRglrTst, fCalcSSM CalcRglrRef, bool CalcL, flt64 Tolerance)
+{
+  uint32 State = xTestUtils::c_XorShiftSeed;
+
+  int32V2 Size = { xStructSimConsts::c_FilterSize, xStructSimConsts::c_FilterSize };
+
+  for(const int32 m : c_Margs)
+  {
+    for(const int32 b : c_BitDs)
+    {
+      const std::string Description = fmt::format("SizeXxY={}x{} Margin={} BitDepth={}", Size.getX(), Size.getY(), m, b);
+
+      //buffers create
+      xPlane<uint16>* Ref = new xPlane<uint16>(Size, b, m);
+      xPlane<uint16>* Tst = new xPlane<uint16>(Size, b, m);
+      xPlane<uint16>* Msk = new xPlane<uint16>(Size, b, m);
+
+      int32 OffT = (5 * Tst->getStride() + 5);
+      int32 OffR = (5 * Ref->getStride() + 5);
+      int32 OffM = (5 * Msk->getStride() + 5);
+
+      uint16 Max = (uint16)xBitDepth2MaxValue(b);
+      flt64  C1  = xPow2(xStructSimConsts::c_K1<flt64> * (flt64)Max);
+      flt64  C2  = xPow2(xStructSimConsts::c_K2<flt64> * (flt64)Max);
+
+      //random tests - full mask
+      CAPTURE(Description + fmt::format(" RandomFullMask"));
+      Ref->zero(true);
+      Tst->zero(true);
+      Msk->fill(1, true);
+      for(int32 n = 0; n < c_NumRandomTests; n++)
+      {
+        State = xTestUtils::fillMidNoise(Ref->getAddr(), Ref->getStride(), Ref->getWidth(), Ref->getHeight(), b, 0, State);
+        State = xTestUtils::fillMidNoise(Tst->getAddr(), Tst->getStride(), Tst->getWidth(), Tst->getHeight(), b, 0, State);
+
+        flt64 A = CalcRglrRef(Tst->getAddr() + OffT, Ref->getAddr() + OffR, Msk->getAddr() + OffM, Tst->getStride(), Ref->getStride(), Msk->getStride(), xStructSimConsts::c_FilterSize, C1, C2, CalcL);
+        flt64 B = CalcRglrTst(Tst->getAddr() + OffT, Ref->getAddr() + OffR, Msk->getAddr() + OffM, Tst->getStride(), Ref->getStride(), Msk->getStride(), xStructSimConsts::c_FilterSize, C1, C2, CalcL);
+        CHECK(xIsApproximatelyEqual(A, B, Tolerance));
+      }
+
+      //random tests - random mask (central sample always valid, margin masked out)
+      CAPTURE(Description + fmt::format(" RandomMask"));
+      Msk->zero(true);
+      for(int32 n = 0; n < c_NumRandomTests; n++)
+      {
+        State = xTestUtils::fillMidNoise(Ref->getAddr(), Ref->getStride(), Ref->getWidth(), Ref->getHeight(), b, 0, State);
+        State = xTestUtils::fillMidNoise(Tst->getAddr(), Tst->getStride(), Tst->getWidth(), Tst->getHeight(), b, 0, State);
+        State = xTestUtils::fillRandom01(Msk->getAddr(), Msk->getStride(), Msk->getWidth(), Msk->getHeight(), State);
+        Msk->getAddr()[OffM] = 1;
+
+        flt64 A = CalcRglrRef(Tst->getAddr() + OffT, Ref->getAddr() + OffR, Msk->getAddr() + OffM, Tst->getStride(), Ref->getStride(), Msk->getStride(), xStructSimConsts::c_FilterSize, C1, C2, CalcL);
+        flt64 B = CalcRglrTst(Tst->getAddr() + OffT, Ref->getAddr() + OffR, Msk->getAddr() + OffM, Tst->getStride(), Ref->getStride(), Msk->getStride(), xStructSimConsts::c_FilterSize, C1, C2, CalcL);
+        CHECK(xIsApproximatelyEqual(A, B, Tolerance));
+      }
+
+      //buffers destroy
+      delete Ref;
+      delete Tst;
+      delete Msk;
+    }
+  }
+}
+fCalcSS bindFullMask(fCalcSSM CalcRglrM) //masked kernel with all samples valid - should match regular kernel
+{
+  static const std::vector<uint16> FullMask(xStructSimConsts::c_FilterArea, 1);
+  return [CalcRglrM](const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, int32 WndSize, flt64 C1, flt64 C2, bool CalcL)
+  {
+    return CalcRglrM(Tst, Ref, FullMask.data() + 5 * xStructSimConsts::c_FilterSize + 5, StrideT, StrideR, xStructSimConsts::c_FilterSize, WndSize, C1, C2, CalcL);
+  };
+}
+void testCalcRglrMFlat(fCalcSSM CalcRglrM, bool CalcL, flt64 Tolerance) //non-masked samples are flat, masked ones random --> reference value is known analytically
+{
+  uint32 State = xTestUtils::c_XorShiftSeed;
+
+  int32V2 Size = { xStructSimConsts::c_FilterSize, xStructSimConsts::c_FilterSize };
+
+  for(const int32 m : c_Margs)
+  {
+    for(const int32 b : c_BitDs)
+    {
+      CAPTURE(fmt::format("SizeXxY={}x{} Margin={} BitDepth={} CalcL={}", Size.getX(), Size.getY(), m, b, CalcL));
+
+      //buffers create
+      xPlane<uint16>* Ref = new xPlane<uint16>(Size, b, m);
+      xPlane<uint16>* Tst = new xPlane<uint16>(Size, b, m);
+      xPlane<uint16>* Msk = new xPlane<uint16>(Size, b, m);
+
+      int32 OffT = (5 * Tst->getStride() + 5);
+      int32 OffR = (5 * Ref->getStride() + 5);
+      int32 OffM = (5 * Msk->getStride() + 5);
+
+      uint16 Max = (uint16)xBitDepth2MaxValue(b);
+      flt64  C1  = xPow2(xStructSimConsts::c_K1<flt64> * (flt64)Max);
+      flt64  C2  = xPow2(xStructSimConsts::c_K2<flt64> * (flt64)Max);
+
+      //moments of non-masked samples: AvgR=ValR, AvgT=ValT, VarR=VarT=CovRT=0 --> CS=1 and SSIM equals luminance term
+      uint16 ValR     = (uint16)(Max / 3);
+      uint16 ValT     = (uint16)(Max / 2);
+      flt64  L        = (2 * (flt64)ValR * (flt64)ValT + C1) / (xPow2((flt64)ValR) + xPow2((flt64)ValT) + C1);
+      flt64  Expected = CalcL ? L : 1.0;
+
+      Ref->zero(true);
+      Tst->zero(true);
+      Msk->zero(true);
+      for(int32 n = 0; n < c_NumRandomTests; n++)
+      {
+        State = xTestUtils::fillMidNoise(Ref->getAddr(), Ref->getStride(), Ref->getWidth(), Ref->getHeight(), b, 0, State);
+        State = xTestUtils::fillMidNoise(Tst->getAddr(), Tst->getStride(), Tst->getWidth(), Tst->getHeight(), b, 0, State);
+        State = xTestUtils::fillRandom01(Msk->getAddr(), Msk->getStride(), Msk->getWidth(), Msk->getHeight(), State);
+        Msk->getAddr()[OffM] = 1;
+        for(int32 y = 0; y < Size.getY(); y++)
+        {
+          for(int32 x = 0; x < Size.getX(); x++)
+          {
+            if(Msk->getAddr()[y * Msk->getStride() + x] == 0) { continue; }
+            Ref->getAddr()[y * Ref->getStride() + x] = ValR;
+            Tst->getAddr()[y * Tst->getStride() + x] = ValT;
+          }
+        }
+
+        flt64 A = CalcRglrM(Tst->getAddr() + OffT, Ref->getAddr() + OffR, Msk->getAddr() + OffM, Tst->getStride(), Ref->getStride(), Msk->getStride(), xStructSimConsts::c_FilterSize, C1, C2, CalcL);
+        CHECK(xIsApproximatelyEqual(A, Expected, Tolerance));
+      }
+
+      //buffers destroy
+      delete Ref;
+      delete Tst;
+      delete Msk;
+    }
+  }
+}
+void testCalcBlck(fCalcSS CalcBlckTst, fCalcSS CalcBlckRef, int32 WndSize, bool CalcL)
 {
   uint32 State = xTestUtils::c_XorShiftSeed;
 
@@ -165,8 +309,8 @@ void testCalcBlckAvg(fCalcSS CalcBlckAvg, int32 WndSize, bool CalcL)
         Ref->fill(TestVals[0], false);
         Tst->fill(TestVals[1], false);
 
-        flt64 A = xStructSimSTD::CalcBlckAvg(Tst->getAddr(), Ref->getAddr(), Tst->getStride(), Ref->getStride(), WndSize, C1, C2, CalcL);
-        flt64 B =                CalcBlckAvg(Tst->getAddr(), Ref->getAddr(), Tst->getStride(), Ref->getStride(), WndSize, C1, C2, CalcL);
+        flt64 A = CalcBlckRef(Tst->getAddr(), Ref->getAddr(), Tst->getStride(), Ref->getStride(), WndSize, C1, C2, CalcL);
+        flt64 B = CalcBlckTst(Tst->getAddr(), Ref->getAddr(), Tst->getStride(), Ref->getStride(), WndSize, C1, C2, CalcL);
         CHECK(A == B);
       }
 
@@ -178,8 +322,8 @@ void testCalcBlckAvg(fCalcSS CalcBlckAvg, int32 WndSize, bool CalcL)
       for(int32 GradOffset = 0; GradOffset <= 10; GradOffset++)
       {          
         xTestUtils::fillGradientXY(Tst->getAddr(), Tst->getStride(), Tst->getWidth(), Tst->getHeight(), Tst->getBitDepth(), GradOffset);
-        flt64 A = xStructSimSTD::CalcBlckAvg(Tst->getAddr(), Ref->getAddr(), Tst->getStride(), Ref->getStride(), WndSize, C1, C2, CalcL);
-        flt64 B =                CalcBlckAvg(Tst->getAddr(), Ref->getAddr(), Tst->getStride(), Ref->getStride(), WndSize, C1, C2, CalcL);
+        flt64 A = CalcBlckRef(Tst->getAddr(), Ref->getAddr(), Tst->getStride(), Ref->getStride(), WndSize, C1, C2, CalcL);
+        flt64 B = CalcBlckTst(Tst->getAddr(), Ref->getAddr(), Tst->getStride(), Ref->getStride(), WndSize, C1, C2, CalcL);
         CHECK(A == B);
       }
 
@@ -192,13 +336,21 @@ void testCalcBlckAvg(fCalcSS CalcBlckAvg, int32 WndSize, bool CalcL)
         State = xTestUtils::fillMidNoise(Ref->getAddr(), Ref->getStride(), Ref->getWidth(), Ref->getHeight(), b, 0, State);
         State = xTestUtils::fillMidNoise(Tst->getAddr(), Tst->getStride(), Tst->getWidth(), Tst->getHeight(), b, 0, State);
 
-        flt64 A = xStructSimSTD::CalcBlckAvg(Tst->getAddr(), Ref->getAddr(), Tst->getStride(), Ref->getStride(), WndSize, C1, C2, CalcL);
-        flt64 B =                CalcBlckAvg(Tst->getAddr(), Ref->getAddr(), Tst->getStride(), Ref->getStride(), WndSize, C1, C2, CalcL);
+        flt64 A = CalcBlckRef(Tst->getAddr(), Ref->getAddr(), Tst->getStride(), Ref->getStride(), WndSize, C1, C2, CalcL);
+        flt64 B = CalcBlckTst(Tst->getAddr(), Ref->getAddr(), Tst->getStride(), Ref->getStride(), WndSize, C1, C2, CalcL);
         CHECK(A == B);
       }
     }
   }  
 }
+void testCalcBlckAvg(fCalcSS CalcBlckAvg, int32 WndSize, bool CalcL)
+{
+  testCalcBlck(CalcBlckAvg, xStructSimSTD::CalcBlckAvg, WndSize, CalcL);
+}
+void testCalcBlckInt(fCalcSS CalcBlckInt, int32 WndSize, bool CalcL)
+{
+  testCalcBlck(CalcBlckInt, xStructSimSTD::CalcBlckInt, WndSize, CalcL);
+}
 void testCalcMultiBlckAvg(std::function<void(flt64* restrict SSIMs, const uint16* Tst, const uint16* Ref, int32 StrideT, int32 StrideR, flt64 C1, flt64 C2, bool CalcL)> CalcMultiBlckAvg, int32 WndSize, int32 Stride, int32 BlocksPerBatch, bool CalcL)
 {
   uint32 State = xTestUtils::c_XorShiftSeed;
@@ -310,6 +462,20 @@ TEST_CASE("xStructSimSTD")
   testCalcRglr(xStructSimSTD::CalcRglrAvg, xStructSimSTD::CalcRglrAvg, true , c_ToleranceSSIM_Averaged);
   testCalcRglr(xStructSimSTD::CalcRglrAvg, xStructSimSTD::CalcRglrAvg, false, c_ToleranceSSIM_Averaged);
 
+  testCalcRglr(bindFullMask(xStructSimSTD::CalcRglrFltM), xStructSimSTD::CalcRglrFlt, true , c_ToleranceSSIM_Gaussian);
+  testCalcRglr(bindFullMask(xStructSimSTD::CalcRglrFltM), xStructSimSTD::CalcRglrFlt, false, c_ToleranceSSIM_Gaussian);
+  testCalcRglr(bindFullMask(xStructSimSTD::CalcRglrIntM), xStructSimSTD::CalcRglrInt, true , c_ToleranceSSIM_Averaged);
+  testCalcRglr(bindFullMask(xStructSimSTD::CalcRglrIntM), xStructSimSTD::CalcRglrInt, false, c_ToleranceSSIM_Averaged);
+  testCalcRglr(bindFullMask(xStructSimSTD::CalcRglrAvgM), xStructSimSTD::CalcRglrAvg, true , c_ToleranceSSIM_Averaged);
+  testCalcRglr(bindFullMask(xStructSimSTD::CalcRglrAvgM), xStructSimSTD::CalcRglrAvg, false, c_ToleranceSSIM_Averaged);
+
+  testCalcRglrMFlat(xStructSimSTD::CalcRglrFltM, true , c_ToleranceSSIM_Averaged);
+  testCalcRglrMFlat(xStructSimSTD::CalcRglrFltM, false, c_ToleranceSSIM_Averaged);
+  testCalcRglrMFlat(xStructSimSTD::CalcRglrIntM, true , c_ToleranceSSIM_Averaged);
+  testCalcRglrMFlat(xStructSimSTD::CalcRglrIntM, false, c_ToleranceSSIM_Averaged);
+  testCalcRglrMFlat(xStructSimSTD::CalcRglrAvgM, true , c_ToleranceSSIM_Averaged);
+  testCalcRglrMFlat(xStructSimSTD::CalcRglrAvgM, false, c_ToleranceSSIM_Averaged);
+
   for(const int32 d : c_Dimms)
   {
     testCalcBlckAvg(xStructSimSTD::CalcBlckAvg, d, true );
@@ -320,28 +486,74 @@ TEST_CASE("xStructSimSTD")
 #if X_SIMD_CAN_USE_SSE
 TEST_CASE("xStructSimSSE")
 {
+  testCalcRglr(xStructSimSSE::CalcRglrFlt, xStructSimSTD::CalcRglrFlt, true , c_ToleranceSSIM_Gaussian);
+  testCalcRglr(xStructSimSSE::CalcRglrFlt, xStructSimSTD::CalcRglrFlt, false, c_ToleranceSSIM_Gaussian);
+  testCalcRglr(xStructSimSSE::CalcRglrInt, xStructSimSTD::CalcRglrInt, true , c_ToleranceSSIM_Averaged);
+  testCalcRglr(xStructSimSSE::CalcRglrInt, xStructSimSTD::CalcRglrInt, false, c_ToleranceSSIM_Averaged);
   testCalcRglr(xStructSimSSE::CalcRglrAvg, xStructSimSTD::CalcRglrAvg, true , c_ToleranceSSIM_Averaged);
   testCalcRglr(xStructSimSSE::CalcRglrAvg, xStructSimSTD::CalcRglrAvg, false, c_ToleranceSSIM_Averaged);
 
+  testCalcRglrM(xStructSimSSE::CalcRglrFltM, xStructSimSTD::CalcRglrFltM, true , c_ToleranceSSIM_Gaussian);
+  testCalcRglrM(xStructSimSSE::CalcRglrFltM, xStructSimSTD::CalcRglrFltM, false, c_ToleranceSSIM_Gaussian);
+  testCalcRglrM(xStructSimSSE::CalcRglrIntM, xStructSimSTD::CalcRglrIntM, true , c_ToleranceSSIM_Averaged);
+  testCalcRglrM(xStructSimSSE::CalcRglrIntM, xStructSimSTD::CalcRglrIntM, false, c_ToleranceSSIM_Averaged);
+  testCalcRglrM(xStructSimSSE::CalcRglrAvgM, xStructSimSTD::CalcRglrAvgM, true , c_ToleranceSSIM_Averaged);
+  testCalcRglrM(xStructSimSSE::CalcRglrAvgM, xStructSimSTD::CalcRglrAvgM, false, c_ToleranceSSIM_Averaged);
+
   for(const int32 d : c_Dimms)
   {
     testCalcBlckAvg(xStructSimSSE::CalcBlckAvg, d, true );
     testCalcBlckAvg(xStructSimSSE::CalcBlckAvg, d, false);
   }
+
+  for(const int32 d : c_DimmsGaussInt)
+  {
+    testCalcBlckInt(xStructSimSSE::CalcBlckInt, d, true );
+    testCalcBlckInt(xStructSimSSE::CalcBlckInt, d, false);
+  }
+
+  for(const int32V2& WS : c_MultiBlckWndStrides)
+  {
+    testCalcMultiBlckAvg(xStructSimSSE::getCalcPtrMultiBlckAvg(WS[0], WS[1]), WS[0], WS[1], xStructSimSSE::c_MultiBlckBatchSize, true );
+    testCalcMultiBlckAvg(xStructSimSSE::getCalcPtrMultiBlckAvg(WS[0], WS[1]), WS[0], WS[1], xStructSimSSE::c_MultiBlckBatchSize, false);
+  }
 }
 #endif //X_SIMD_CAN_USE_SSE
 
 #if X_SIMD_CAN_USE_AVX
 TEST_CASE("xStructSimAVX")
 {
+  testCalcRglr(xStructSimAVX::CalcRglrFlt, xStructSimSTD::CalcRglrFlt, true , c_ToleranceSSIM_Gaussian);
+  testCalcRglr(xStructSimAVX::CalcRglrFlt, xStructSimSTD::CalcRglrFlt, false, c_ToleranceSSIM_Gaussian);
+  testCalcRglr(xStructSimAVX::CalcRglrInt, xStructSimSTD::CalcRglrInt, true , c_ToleranceSSIM_Averaged);
+  testCalcRglr(xStructSimAVX::CalcRglrInt, xStructSimSTD::CalcRglrInt, false, c_ToleranceSSIM_Averaged);
   testCalcRglr(xStructSimAVX::CalcRglrAvg, xStructSimSTD::CalcRglrAvg, true , c_ToleranceSSIM_Averaged);
   testCalcRglr(xStructSimAVX::CalcRglrAvg, xStructSimSTD::CalcRglrAvg, false, c_ToleranceSSIM_Averaged);
 
+  testCalcRglrM(xStructSimAVX::CalcRglrFltM, xStructSimSTD::CalcRglrFltM, true , c_ToleranceSSIM_Gaussian);
+  testCalcRglrM(xStructSimAVX::CalcRglrFltM, xStructSimSTD::CalcRglrFltM, false, c_ToleranceSSIM_Gaussian);
+  testCalcRglrM(xStructSimAVX::CalcRglrIntM, xStructSimSTD::CalcRglrIntM, true , c_ToleranceSSIM_Averaged);
+  testCalcRglrM(xStructSimAVX::CalcRglrIntM, xStructSimSTD::CalcRglrIntM, false, c_ToleranceSSIM_Averaged);
+  testCalcRglrM(xStructSimAVX::CalcRglrAvgM, xStructSimSTD::CalcRglrAvgM, true , c_ToleranceSSIM_Averaged);
+  testCalcRglrM(xStructSimAVX::CalcRglrAvgM, xStructSimSTD::CalcRglrAvgM, false, c_ToleranceSSIM_Averaged);
+
   for(const int32 d : c_Dimms)
   { 
     testCalcBlckAvg(xStructSimAVX::CalcBlckAvg, d, true );
     testCalcBlckAvg(xStructSimAVX::CalcBlckAvg, d, false);
   }
+
+  for(const int32 d : c_DimmsGaussInt)
+  {
+    testCalcBlckInt(xStructSimAVX::CalcBlckInt, d, true );
+    testCalcBlckInt(xStructSimAVX::CalcBlckInt, d, false);
+  }
+
+  for(const int32V2& WS : c_MultiBlckWndStrides)
+  {
+    testCalcMultiBlckAvg(xStructSimAVX::getCalcPtrMultiBlckAvg(WS[0], WS[1]), WS[0], WS[1], xStructSimAVX::c_MultiBlckBatchSize, true );
+    testCalcMultiBlckAvg(xStructSimAVX::getCalcPtrMultiBlckAvg(WS[0], WS[1]), WS[0], WS[1], xStructSimAVX::c_MultiBlckBatchSize, false);
+  }
 }
 #endif //X_SIMD_CAN_USE_AVX
 
@@ -355,12 +567,25 @@ TEST_CASE("xStructSimAVX512")
   testCalcRglr(xStructSimAVX512::CalcRglrAvg, xStructSimSTD::CalcRglrAvg, true , c_ToleranceSSIM_Averaged);
   testCalcRglr(xStructSimAVX512::CalcRglrAvg, xStructSimSTD::CalcRglrAvg, false, c_ToleranceSSIM_Averaged);
 
+  testCalcRglrM(xStructSimAVX512::CalcRglrFltM, xStructSimSTD::CalcRglrFltM, true , c_ToleranceSSIM_Gaussian);
+  testCalcRglrM(xStructSimAVX512::CalcRglrFltM, xStructSimSTD::CalcRglrFltM, false, c_ToleranceSSIM_Gaussian);
+  testCalcRglrM(xStructSimAVX512::CalcRglrIntM, xStructSimSTD::CalcRglrIntM, true , c_ToleranceSSIM_Averaged);
+  testCalcRglrM(xStructSimAVX512::CalcRglrIntM, xStructSimSTD::CalcRglrIntM, false, c_ToleranceSSIM_Averaged);
+  testCalcRglrM(xStructSimAVX512::CalcRglrAvgM, xStructSimSTD::CalcRglrAvgM, true , c_ToleranceSSIM_Averaged);
+  testCalcRglrM(xStructSimAVX512::CalcRglrAvgM, xStructSimSTD::CalcRglrAvgM, false, c_ToleranceSSIM_Averaged);
+
   for(const int32 d : c_Dimms) 
   {
     testCalcBlckAvg(xStructSimAVX512::CalcBlckAvg, d, true );
     testCalcBlckAvg(xStructSimAVX512::CalcBlckAvg, d, false);
   }
 
+  for(const int32 d : c_DimmsGaussInt)
+  {
+    testCalcBlckInt(xStructSimAVX512::CalcBlckInt, d, true );
+    testCalcBlckInt(xStructSimAVX512::CalcBlckInt, d, false);
+  }
+
   testCalcMultiBlckAvg(xStructSimAVX512::CalcMultiBlckAvg8S4, 8, 4, 7, true );
   testCalcMultiBlckAvg(xStructSimAVX512::CalcMultiBlckAvg8S4, 8, 4, 7, false);
 